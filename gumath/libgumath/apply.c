@@ -55,13 +55,21 @@ sum_inner_dimensions(const xnd_t stack[], int nargs, int outer_dims)
     return sum;
 }
 
-int
-gm_apply(const gm_kernel_t *kernel, xnd_t stack[], int outer_dims,
-         ndt_context_t *ctx)
+/* With stride broadcasting all arguments have the shape of the last one. */
+static int
+sum_inner_dimensions_broadcast(const xnd_t stack[], int nargs, int outer_dims)
+{
+    const int n = stack[nargs-1].type->ndim - outer_dims;
+    return nargs * (n == 0 ? 1 : n);
+}
+
+static int
+apply_serial(const gm_kernel_t *kernel, xnd_t stack[], int outer_dims,
+             ndt_context_t *ctx)
 {
     const int nargs = (int)kernel->set->sig->Function.nargs;
 
-    switch (kernel->flag) {
+    switch (kernel->flag & ~NDT_STRIDE_BROADCAST) {
     case NDT_C: {
         return gm_xnd_map(kernel->set->C, stack, nargs, outer_dims, ctx);
     }
@@ -75,17 +83,27 @@ gm_apply(const gm_kernel_t *kernel, xnd_t stack[], int outer_dims,
     }
 
     case NDT_STRIDED: {
-        const int sum_inner = sum_inner_dimensions(stack, nargs, outer_dims);
+        const bool broadcast = kernel->flag & NDT_STRIDE_BROADCAST;
+        const int sum_inner = broadcast ?
+            sum_inner_dimensions_broadcast(stack, nargs, outer_dims) :
+            sum_inner_dimensions(stack, nargs, outer_dims);
         const int dims_size = outer_dims + sum_inner;
         const int steps_size = nargs * outer_dims + sum_inner;
         ALLOCA(char *, args, nargs);
         ALLOCA(intptr_t, dimensions, dims_size);
         ALLOCA(intptr_t, steps, steps_size);
+        int ret;
 
-        if (gm_np_convert_xnd(args, nargs,
+        ret = broadcast ?
+            gm_np_convert_xnd_broadcast(args, nargs,
+                                        dimensions, dims_size,
+                                        steps, steps_size,
+                                        stack, outer_dims, ctx) :
+            gm_np_convert_xnd(args, nargs,
                               dimensions, dims_size,
                               steps, steps_size,
-                              stack, outer_dims, ctx) < 0) {
+                              stack, outer_dims, ctx);
+        if (ret < 0) {
             return -1;
         }
 
@@ -98,6 +116,549 @@ gm_apply(const gm_kernel_t *kernel, xnd_t stack[], int outer_dims,
     ndt_internal_error("invalid tag");
 }
 
+
+/******************************************************************************/
+/*                            Parallel execution                              */
+/******************************************************************************/
+
+typedef struct {
+    const gm_kernel_t *kernel;
+    const xnd_t *stack;
+    int nargs;
+    int outer_dims;
+    int64_t shape;   /* shape of the dimension that is split */
+    int64_t nchunks;
+} apply_chunks_t;
+
+static int64_t
+fixed_nelem(const ndt_t *t)
+{
+    int64_t n = 1;
+
+    for (; t->tag == FixedDim; t = t->FixedDim.type) {
+        n *= t->FixedDim.shape;
+    }
+
+    return n;
+}
+
+/*
+ * With stride broadcasting, arguments that do not have the outermost
+ * dimension of the last argument are broadcast and not split.
+ */
+static bool
+is_split(const gm_kernel_t *kernel, const ndt_t *t, const ndt_t *target)
+{
+    if (!(kernel->flag & NDT_STRIDE_BROADCAST)) {
+        return true;
+    }
+
+    return t->ndim == target->ndim && t->tag == FixedDim &&
+           t->FixedDim.shape == target->FixedDim.shape;
+}
+
+/*
+ * Return the number of chunks for splitting the outermost dimension of
+ * the stack.  The outer dimensions are split if present, otherwise the
+ * 'N' dimension of an elementwise kernel.  All other cases are serial.
+ */
+static int64_t
+num_chunks(const gm_kernel_t *kernel, const xnd_t stack[], int nargs,
+           int outer_dims)
+{
+    int64_t max_threads = gm_get_max_threads();
+    const ndt_t *target;
+    int64_t shape, nelem = 0, n;
+    int i;
+
+    if (max_threads <= 1 || nargs == 0) {
+        return 1;
+    }
+
+    if (outer_dims == 0 && !kernel->set->elemwise) {
+        return 1;
+    }
+
+    target = stack[nargs-1].type;
+    if (target == NULL || ndt_is_abstract(target) || target->tag != FixedDim) {
+        return 1;
+    }
+
+    for (i = 0; i < nargs; i++) {
+        const ndt_t *t = stack[i].type;
+        if (t == NULL || ndt_is_abstract(t)) {
+            return 1;
+        }
+        if (!is_split(kernel, t, target)) {
+            continue;
+        }
+        if (t->tag != FixedDim || t->FixedDim.shape != target->FixedDim.shape) {
+            return 1;
+        }
+        /* Validity bits of adjacent chunks can share a byte. */
+        if (ndt_subtree_is_optional(t)) {
+            return 1;
+        }
+        n = fixed_nelem(t);
+        nelem = n > nelem ? n : nelem;
+    }
+
+    shape = target->FixedDim.shape;
+    n = nelem / gm_get_min_work();
+    n = n < max_threads ? n : max_threads;
+
+    return n < shape ? n : shape;
+}
+
+static int
+apply_chunk(void *arg, int64_t i, ndt_context_t *ctx)
+{
+    const apply_chunks_t *a = arg;
+    const int64_t q = a->shape / a->nchunks;
+    const int64_t r = a->shape % a->nchunks;
+    const int64_t start = i * q + (i < r ? i : r);
+    const int64_t shape = q + (i < r);
+    ALLOCA(xnd_t, stack, a->nargs);
+    ndt_t *types;
+    int ret, k;
+
+    types = ndt_alloc(a->nargs, sizeof *types);
+    if (types == NULL) {
+        (void)ndt_memory_error(ctx);
+        return -1;
+    }
+
+    /* Shallow copies of the outermost dimension with the new shape. */
+    for (k = 0; k < a->nargs; k++) {
+        const ndt_t *t = a->stack[k].type;
+        const int64_t step = t->Concrete.FixedDim.step;
+        const int64_t abs_step = step < 0 ? -step : step;
+
+        if (!is_split(a->kernel, t, a->stack[a->nargs-1].type)) {
+            stack[k] = a->stack[k];
+            continue;
+        }
+
+        /* The copy is a temporary and must not look like the interned parent. */
+        types[k] = *t;
+        types[k].refcnt = 1;
+        types[k].interned = false;
+        types[k].hash = 0;
+        types[k].FixedDim.shape = shape;
+        types[k].datasize = shape == 0 || t->FixedDim.type->datasize == 0 ? 0 :
+            (shape-1) * abs_step * t->Concrete.FixedDim.itemsize +
+            t->FixedDim.type->datasize;
+
+        stack[k] = a->stack[k];
+        stack[k].index += start * step;
+        stack[k].type = &types[k];
+    }
+
+    ret = apply_serial(a->kernel, stack, a->outer_dims, ctx);
+
+    ndt_free(types);
+    return ret;
+}
+
+
+/******************************************************************************/
+/*                          Flat var dimensions                               */
+/******************************************************************************/
+
+/*
+ * Return the range of leaf elements of 'x' if all dimensions are var
+ * dimensions without slices and the dtype is not optional.
+ */
+static bool
+var_leaves(int64_t *start, int64_t *end, const xnd_t *x)
+{
+    const ndt_t *t = x->type;
+    int64_t s = x->index;
+    int64_t e = x->index + 1;
+
+    if (t->tag != VarDim || ndt_subtree_is_optional(t)) {
+        return false;
+    }
+
+    for (; t->tag == VarDim; t = t->VarDim.type) {
+        if (t->Concrete.VarDim.nslices > 0) {
+            return false;
+        }
+        s = ndt_var_offset(t, s);
+        e = ndt_var_offset(t, e);
+    }
+
+    if (t->ndim != 0) {
+        return false;
+    }
+
+    *start = s;
+    *end = e;
+    return true;
+}
+
+/* Return true if 'x' and 'y' have the same ragged structure. */
+static bool
+same_offsets(const xnd_t *x, const xnd_t *y)
+{
+    const ndt_t *t = x->type;
+    const ndt_t *u = y->type;
+    int64_t s = x->index, e = x->index + 1;
+    int64_t r = y->index;
+    int64_t k;
+
+    for (; t->tag == VarDim; t = t->VarDim.type, u = u->VarDim.type) {
+        if (u->tag != VarDim) {
+            return false;
+        }
+
+        if (t->Concrete.VarDim.offsets != u->Concrete.VarDim.offsets || s != r) {
+            const int64_t sbase = ndt_var_offset(t, s);
+            const int64_t rbase = ndt_var_offset(u, r);
+
+            if (r + (e-s) >= u->Concrete.VarDim.noffsets) {
+                return false;
+            }
+
+            for (k = 1; k <= e-s; k++) {
+                if (ndt_var_offset(t, s+k) - sbase !=
+                    ndt_var_offset(u, r+k) - rbase) {
+                    return false;
+                }
+            }
+        }
+
+        r = ndt_var_offset(u, r);
+        s = ndt_var_offset(t, s);
+        e = ndt_var_offset(t, e);
+    }
+
+    return u->tag != VarDim;
+}
+
+/*
+ * Elementwise kernels do not depend on the ragged structure of var
+ * dimensions.  If all arguments have the same offsets and no slices,
+ * the Strided kernel is applied once to the contiguous leaf data.
+ *
+ * Return 1 if the kernel was applied, 0 if the arguments are not flat.
+ */
+static int
+apply_var_flat(const gm_kernel_t *kernel, const xnd_t stack[], int nargs,
+               int *ret)
+{
+    ALLOCA(char *, args, nargs);
+    ALLOCA(intptr_t, steps, nargs);
+    intptr_t dimensions[1];
+    int64_t start, end;
+    int i;
+
+    for (i = 0; i < nargs; i++) {
+        const xnd_t *x = &stack[i];
+        if (!var_leaves(&start, &end, x)) {
+            return 0;
+        }
+        if (i > 0 && !same_offsets(&stack[0], x)) {
+            return 0;
+        }
+
+        steps[i] = (intptr_t)ndt_dtype(x->type)->datasize;
+        args[i] = x->ptr + start * steps[i];
+        dimensions[0] = (intptr_t)(end - start);
+    }
+
+    *ret = kernel->set->Strided(args, dimensions, steps, NULL);
+    return 1;
+}
+
+/*
+ * Apply a kernel to the stack.  Depending on the thread pool configuration,
+ * the outermost dimension is split into chunks that are processed in parallel.
+ */
+int
+gm_apply(const gm_kernel_t *kernel, xnd_t stack[], int outer_dims,
+         ndt_context_t *ctx)
+{
+    const int nargs = (int)kernel->set->sig->Function.nargs;
+    int64_t nchunks;
+    apply_chunks_t a;
+    int ret;
+
+    if (kernel->set->var_elemwise && kernel->set->Strided != NULL &&
+        apply_var_flat(kernel, stack, nargs, &ret)) {
+        return ret;
+    }
+
+    nchunks = num_chunks(kernel, stack, nargs, outer_dims);
+    if (nchunks <= 1) {
+        return apply_serial(kernel, stack, outer_dims, ctx);
+    }
+
+    a.kernel = kernel;
+    a.stack = stack;
+    a.nargs = nargs;
+    a.outer_dims = outer_dims;
+    a.shape = stack[nargs-1].type->FixedDim.shape;
+    a.nchunks = nchunks;
+
+    return gm_run_tasks(apply_chunk, &a, nchunks, ctx);
+}
+
+
+/******************************************************************************/
+/*                            Preallocated outputs                            */
+/******************************************************************************/
+
+/*
+ * Byte range [lo, hi) of the data of 'x'.  The range of types that are not
+ * ndarrays is conservative.
+ */
+static void
+data_range(const char **lo, const char **hi, const xnd_t *x)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    const ndt_t *t = x->type;
+    ndt_ndarray_t a;
+    int64_t d;
+    int i;
+
+    if (!ndt_is_ndarray(t)) {
+        *lo = x->ptr;
+        *hi = x->ptr + t->datasize;
+        return;
+    }
+
+    (void)ndt_as_ndarray(&a, t, &ctx);
+    *lo = *hi = x->ptr + x->index * a.itemsize;
+
+    for (i = 0; i < a.ndim; i++) {
+        if (a.shape[i] == 0) {
+            return;
+        }
+        d = (a.shape[i]-1) * a.strides[i];
+        if (d < 0) {
+            *lo += d;
+        }
+        else {
+            *hi += d;
+        }
+    }
+
+    *hi += a.itemsize;
+}
+
+static bool
+overlap(const xnd_t *x, const xnd_t *y)
+{
+    const char *xlo, *xhi, *ylo, *yhi;
+
+    data_range(&xlo, &xhi, x);
+    data_range(&ylo, &yhi, y);
+
+    return xlo < xhi && ylo < yhi && xlo < yhi && ylo < xhi;
+}
+
+/* The signature is '... * T0, ... -> ... * Tn'. */
+static bool
+is_scalar_sig(const ndt_t *sig)
+{
+    int64_t i;
+
+    for (i = 0; i < sig->Function.nargs; i++) {
+        const ndt_t *t = sig->Function.types[i];
+        if (t->tag != EllipsisDim || t->EllipsisDim.type->ndim != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * An input that is identical to an output is safe if each element of the
+ * input is read before the same element of the output is written.
+ */
+static bool
+is_safe_alias(const gm_kernel_set_t *set, const xnd_t *in, const xnd_t *out)
+{
+    if (in->ptr != out->ptr || in->index != out->index ||
+        !ndt_equal(in->type, out->type)) {
+        return false;
+    }
+
+    return set->elemwise || set->var_elemwise || is_scalar_sig(set->sig);
+}
+
+static int
+check_out(const ndt_t *t, const xnd_t *out, int i, ndt_context_t *ctx)
+{
+    int ret;
+
+    if (ndt_is_abstract(t)) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "output %d: the result type must be known before the call", i);
+        return -1;
+    }
+
+    if (ndt_equal(t, out->type)) {
+        return 0;
+    }
+
+    if (ndt_is_ndarray(t)) {
+        ret = ndt_match(t, out->type, ctx);
+        if (ret < 0) {
+            return -1;
+        }
+    }
+    else {
+        ret = 0;
+    }
+
+    if (!ret) {
+        ndt_err_format(ctx, NDT_TypeError,
+            "output %d: type does not match the result type", i);
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * The kernel was selected for the layout of spec->out.  Fall back to a
+ * kernel without layout requirements if the outputs are not contiguous.
+ */
+static int
+out_kernel(gm_kernel_t *kernel, const xnd_t out[], int nout,
+           ndt_context_t *ctx)
+{
+    const gm_kernel_set_t *set = kernel->set;
+    int i;
+
+    for (i = 0; i < nout; i++) {
+        const ndt_t *t = out[i].type;
+        if (((kernel->flag & NDT_C) && !ndt_is_c_contiguous(t)) ||
+            ((kernel->flag & NDT_FORTRAN) && !ndt_is_f_contiguous(t))) {
+            break;
+        }
+    }
+
+    if (i == nout) {
+        return 0;
+    }
+
+    if (set->Strided != NULL) {
+        kernel->flag = NDT_STRIDED;
+        return 0;
+    }
+
+    if (set->Xnd != NULL) {
+        kernel->flag = NDT_XND;
+        return 0;
+    }
+
+    ndt_err_format(ctx, NDT_TypeError,
+        "could not find kernel for non-contiguous outputs");
+    return -1;
+}
+
+/* Replace the ndarray 'x' by a copy in a new buffer. */
+static xnd_master_t *
+copy_input(ndt_t **type, xnd_t *x, ndt_context_t *ctx)
+{
+    const ndt_t *t = x->type;
+    xnd_master_t *copy;
+
+    if (!ndt_is_ndarray(t)) {
+        ndt_err_format(ctx, NDT_NotImplementedError,
+            "output overlaps an input that is not an ndarray");
+        return NULL;
+    }
+
+    if (!ndt_is_c_contiguous(t) && !ndt_is_f_contiguous(t)) {
+        *type = ndt_copy_contiguous(t, ctx);
+        if (*type == NULL) {
+            return NULL;
+        }
+        t = *type;
+    }
+
+    copy = xnd_empty_from_type(t, XND_OWN_EMBEDDED, ctx);
+    if (copy == NULL) {
+        return NULL;
+    }
+
+    if (xnd_copy(&copy->master, x, copy->flags, ctx) < 0) {
+        xnd_del(copy);
+        return NULL;
+    }
+
+    *x = copy->master;
+    return copy;
+}
+
+/*
+ * Same as gm_apply(), but the outputs following the 'nin' inputs on the
+ * stack are supplied by the caller.  Their types must match spec->out.
+ *
+ * Inputs that overlap an output are copied first, unless they are identical
+ * to the output and the kernel is elementwise.
+ */
+int
+gm_apply_out(const gm_kernel_t *kernel, const xnd_t stack[], int nin,
+             const ndt_apply_spec_t *spec, ndt_context_t *ctx)
+{
+    const int nargs = nin + spec->nout;
+    gm_kernel_t k = *kernel;
+    xnd_master_t *copies[NDT_MAX_ARGS] = {NULL};
+    ndt_t *types[NDT_MAX_ARGS] = {NULL};
+    xnd_t args[NDT_MAX_ARGS];
+    int ret = -1;
+    int i, j;
+
+    if (nargs > NDT_MAX_ARGS) {
+        ndt_err_format(ctx, NDT_ValueError, "too many arguments");
+        return -1;
+    }
+
+    for (i = 0; i < nargs; i++) {
+        args[i] = stack[i];
+    }
+
+    for (i = 0; i < spec->nout; i++) {
+        if (check_out(spec->out[i], &args[nin+i], i, ctx) < 0) {
+            return -1;
+        }
+    }
+
+    if (out_kernel(&k, &args[nin], spec->nout, ctx) < 0) {
+        return -1;
+    }
+
+    for (j = 0; j < nin; j++) {
+        for (i = 0; i < spec->nout; i++) {
+            const xnd_t *out = &args[nin+i];
+            if (overlap(&args[j], out) &&
+                !is_safe_alias(k.set, &args[j], out)) {
+                copies[j] = copy_input(&types[j], &args[j], ctx);
+                if (copies[j] == NULL) {
+                    goto out;
+                }
+                break;
+            }
+        }
+    }
+
+    ret = gm_apply(&k, args, spec->outer_dims, ctx);
+
+out:
+    for (j = 0; j < nin; j++) {
+        xnd_del(copies[j]);
+        ndt_del(types[j]);
+    }
+
+    return ret;
+}
+
 static gm_kernel_t
 select_kernel(const ndt_apply_spec_t *spec, const gm_kernel_set_t *set,
               ndt_context_t *ctx)
@@ -117,7 +678,7 @@ select_kernel(const ndt_apply_spec_t *spec, const gm_kernel_set_t *set,
     }
 
     if (set->Strided != NULL && (spec->flags&NDT_STRIDED)) {
-        kernel.flag = NDT_STRIDED;
+        kernel.flag = NDT_STRIDED | (spec->flags&NDT_STRIDE_BROADCAST);
         return kernel;
     }
 
@@ -138,14 +699,248 @@ select_kernel(const ndt_apply_spec_t *spec, const gm_kernel_set_t *set,
     return kernel;
 }
 
-/* Look up a multimethod by name and select a kernel. */
+/******************************************************************************/
+/*                              Dispatch cache                                */
+/******************************************************************************/
+
+/*
+ * Concrete var dimensions refer to offsets that are owned by the input
+ * containers, so types with var dimensions cannot be cached.
+ *
+ * Each multimethod protects its cache with a spinlock, so gm_select() can
+ * be called concurrently.  Entries are only read and replaced under the
+ * lock; replaced entries are deleted after the lock has been released.
+ */
+static bool
+has_var_dim(const ndt_t *t)
+{
+    int64_t i;
+
+    switch (t->tag) {
+    case VarDim:
+        return true;
+    case FixedDim:
+        return has_var_dim(t->FixedDim.type);
+    case Tuple:
+        for (i = 0; i < t->Tuple.shape; i++) {
+            if (has_var_dim(t->Tuple.types[i])) {
+                return true;
+            }
+        }
+        return false;
+    case Record:
+        for (i = 0; i < t->Record.shape; i++) {
+            if (has_var_dim(t->Record.types[i])) {
+                return true;
+            }
+        }
+        return false;
+    case Ref:
+        return has_var_dim(t->Ref.type);
+    case Constr:
+        return has_var_dim(t->Constr.type);
+    case Nominal:
+        return has_var_dim(t->Nominal.type);
+    default:
+        return false;
+    }
+}
+
+static bool
+cacheable(const ndt_t *in[], int nin)
+{
+    int i;
+
+    for (i = 0; i < nin; i++) {
+        if (has_var_dim(in[i])) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static uint64_t
+types_hash(const ndt_t *in[], int nin)
+{
+    uint64_t h = (uint64_t)nin;
+    int i;
+
+    for (i = 0; i < nin; i++) {
+        h = (h * 1000003U) ^ ndt_structural_hash(in[i]);
+    }
+
+    return h;
+}
+
+static inline void
+cache_lock(gm_func_t *f)
+{
+    ndt_spin_lock(&f->cache_lock);
+}
+
+static inline void
+cache_unlock(gm_func_t *f)
+{
+    ndt_spin_unlock(&f->cache_lock);
+}
+
+static void
+cache_entry_del(gm_cache_entry_t *e)
+{
+    int i;
+
+    if (e == NULL) {
+        return;
+    }
+
+    for (i = 0; i < e->nin; i++) {
+        ndt_del(e->in[i]);
+    }
+    ndt_free(e->in);
+
+    ndt_apply_spec_clear(&e->spec);
+    ndt_free(e);
+}
+
+void
+gm_func_clear_cache(gm_func_t *f)
+{
+    gm_cache_entry_t *e;
+    int i;
+
+    for (i = 0; i < GM_CACHE_SIZE; i++) {
+        cache_lock(f);
+        e = f->cache[i];
+        f->cache[i] = NULL;
+        cache_unlock(f);
+        cache_entry_del(e);
+    }
+}
+
+/* Share the types of 'src' with the cleared spec 'dest'. */
+static void
+spec_copy(ndt_apply_spec_t *dest, const ndt_apply_spec_t *src)
+{
+    int i;
+
+    dest->flags = src->flags;
+    dest->outer_dims = src->outer_dims;
+
+    for (i = 0; i < src->nout; i++) {
+        dest->out[i] = ndt_incref(src->out[i]);
+        dest->nout++;
+    }
+
+    for (i = 0; i < src->nbroadcast; i++) {
+        dest->broadcast[i] = ndt_incref(src->broadcast[i]);
+        dest->nbroadcast++;
+    }
+}
+
+static const gm_cache_entry_t *
+cache_find(const gm_func_t *f, uint64_t hash, const ndt_t *in[], int nin)
+{
+    const gm_cache_entry_t *e = f->cache[hash % GM_CACHE_SIZE];
+    int i;
+
+    if (e == NULL || e->hash != hash || e->nin != nin) {
+        return NULL;
+    }
+
+    for (i = 0; i < nin; i++) {
+        if (!ndt_equal(e->in[i], in[i])) {
+            return NULL;
+        }
+    }
+
+    return e;
+}
+
+/*
+ * Add the result of a successful typecheck to the cache.  Existing entries
+ * in the same slot are replaced.  The cache is best effort, errors are not
+ * reported.
+ */
+static void
+cache_add(gm_func_t *f, uint64_t hash, const ndt_t *in[], int nin,
+          const gm_kernel_set_t *set, const ndt_apply_spec_t *spec)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    gm_cache_entry_t *e, *old;
+    int i;
+
+    e = ndt_alloc_size(sizeof *e);
+    if (e == NULL) {
+        return;
+    }
+
+    e->in = ndt_alloc(nin, sizeof *e->in);
+    if (e->in == NULL) {
+        ndt_free(e);
+        return;
+    }
+
+    e->hash = hash;
+    e->nin = 0;
+    e->set = set;
+    e->spec = ndt_apply_spec_empty;
+
+    for (i = 0; i < nin; i++) {
+        e->in[i] = ndt_intern(ndt_incref(in[i]), &ctx);
+        if (e->in[i] == NULL) {
+            goto error;
+        }
+        e->nin++;
+    }
+
+    spec_copy(&e->spec, spec);
+
+    /* Cache hits return new references to the interned types. */
+    for (i = 0; i < e->spec.nout; i++) {
+        e->spec.out[i] = ndt_intern(e->spec.out[i], &ctx);
+        if (e->spec.out[i] == NULL) {
+            goto error;
+        }
+    }
+
+    for (i = 0; i < e->spec.nbroadcast; i++) {
+        e->spec.broadcast[i] = ndt_intern(e->spec.broadcast[i], &ctx);
+        if (e->spec.broadcast[i] == NULL) {
+            goto error;
+        }
+    }
+
+    cache_lock(f);
+    old = f->cache[hash % GM_CACHE_SIZE];
+    f->cache[hash % GM_CACHE_SIZE] = e;
+    cache_unlock(f);
+
+    cache_entry_del(old);
+    return;
+
+error:
+    cache_entry_del(e);
+    ndt_err_clear(&ctx);
+}
+
+/*
+ * Look up a multimethod by name and select a kernel.  Typecheck results
+ * for concrete input types are cached per multimethod, unless the kernel
+ * has a constraint that depends on the input values or the input types
+ * have var dimensions.
+ */
 gm_kernel_t
 gm_select(ndt_apply_spec_t *spec, const gm_tbl_t *tbl, const char *name,
           const ndt_t *in_types[], int nin, const xnd_t args[],
           ndt_context_t *ctx)
 {
     gm_kernel_t empty_kernel = {0U, NULL};
-    const gm_func_t *f;
+    const gm_kernel_set_t *set = NULL;
+    const gm_cache_entry_t *e;
+    const bool use_cache = cacheable(in_types, nin);
+    gm_func_t *f;
+    uint64_t hash = 0;
     char *s;
     int i;
 
@@ -154,32 +949,62 @@ gm_select(ndt_apply_spec_t *spec, const gm_tbl_t *tbl, const char *name,
         return empty_kernel;
     }
 
+    if (use_cache) {
+        hash = types_hash(in_types, nin);
+        cache_lock(f);
+        e = cache_find(f, hash, in_types, nin);
+        if (e != NULL) {
+            spec_copy(spec, &e->spec);
+            set = e->set;
+        }
+        cache_unlock(f);
+        if (set != NULL) {
+            return select_kernel(spec, set, ctx);
+        }
+    }
+
     if (f->typecheck != NULL) {
-        const gm_kernel_set_t *set = f->typecheck(spec, f, in_types, nin, ctx);
+        set = f->typecheck(spec, f, in_types, nin, ctx);
         if (set == NULL) {
             return empty_kernel;
         }
-        return select_kernel(spec, set, ctx);
     }
+    else {
+        for (i = 0; i < f->nkernels; i++) {
+            const gm_kernel_set_t *k = &f->kernels[i];
+            int ret;
 
-    for (i = 0; i < f->nkernels; i++) {
-        const gm_kernel_set_t *set = &f->kernels[i];
-        if (ndt_typecheck(spec, set->sig, in_types, nin, set->constraint, args,
-                          ctx) < 0) {
-            ndt_err_clear(ctx);
-            continue;
+            /* Only strided kernels can broadcast with zero steps. */
+            spec->flags = k->Strided != NULL ? NDT_STRIDE_BROADCAST : 0;
+            ret = k->matcher != NULL ?
+                ndt_matcher_typecheck(spec, k->matcher, in_types, nin, args, ctx) :
+                ndt_typecheck(spec, k->sig, in_types, nin, k->constraint, args, ctx);
+            if (ret < 0) {
+                spec->flags = 0;
+                ndt_err_clear(ctx);
+                continue;
+            }
+            set = k;
+            break;
         }
-        return select_kernel(spec, set, ctx);
     }
 
-    s = ndt_list_as_string(in_types, nin, ctx);
-    if (s == NULL) {
+    if (set == NULL) {
+        s = ndt_list_as_string(in_types, nin, ctx);
+        if (s == NULL) {
+            return empty_kernel;
+        }
+
+        ndt_err_format(ctx, NDT_TypeError,
+            "could not find '%s' kernel for input types '%s'", name, s);
+        ndt_free(s);
+
         return empty_kernel;
     }
 
-    ndt_err_format(ctx, NDT_TypeError,
-        "could not find '%s' kernel for input types '%s'", name, s);
-    ndt_free(s);
+    if (use_cache && set->constraint == NULL) {
+        cache_add(f, hash, in_types, nin, set, spec);
+    }
 
-    return empty_kernel;
+    return select_kernel(spec, set, ctx);
 }
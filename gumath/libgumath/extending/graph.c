@@ -182,13 +182,16 @@ mk_return_array(int32_t p[], const int64_t N, const int32_t u,
                 ndt_context_t *ctx)
 {
     int32_t *ndim2_offsets = NULL;
-    int32_t *ndim1_offsets = NULL;
+    int64_t *ndim1_offsets = NULL;
+    void *offsets;
+    int offset_type;
     ndt_t *t;
     int64_t sum;
     int32_t v;
 
-    if (N+1 > INT32_MAX) {
-        goto offset_overflow;
+    if (N > INT32_MAX) {
+        ndt_err_format(ctx, NDT_ValueError, "too many nodes");
+        return xnd_error;
     }
 
     ndim2_offsets = ndt_alloc(2, sizeof *ndim2_offsets);
@@ -203,19 +206,16 @@ mk_return_array(int32_t p[], const int64_t N, const int32_t u,
     ndim1_offsets = ndt_alloc(N+1, sizeof *ndim1_offsets);
     if (ndim1_offsets == NULL) {
         (void)ndt_memory_error(ctx);
-        return xnd_error;
+        goto error;
     }
 
     sum = 0;
     for (v = 0; v < N; v++) {
-        ndim1_offsets[v] = (int32_t)sum;
+        ndim1_offsets[v] = sum;
         int64_t n = write_path(NULL, 0, p, N, u, v);
         sum += n;
-        if (sum > INT32_MAX) {
-            goto offset_overflow;
-        }
     }
-    ndim1_offsets[v] = (int32_t)sum;
+    ndim1_offsets[v] = sum;
 
 
     t = ndt_from_string("node", ctx);
@@ -223,8 +223,16 @@ mk_return_array(int32_t p[], const int64_t N, const int32_t u,
         goto error;
     }
 
-    t = ndt_var_dim(t, InternalOffsets, (int32_t)(N+1), ndim1_offsets, 0, NULL, ctx);
+    /* The path lengths only need int64_t offsets for very large graphs. */
+    offsets = ndim1_offsets;
+    offset_type = ndt_compact_offsets(&offsets, N+1, ctx);
+    if (offset_type < 0) {
+        ndt_del(t);
+        goto error;
+    }
     ndim1_offsets = NULL;
+
+    t = ndt_var_dim_typed(t, InternalOffsets, offset_type, N+1, offsets, 0, NULL, ctx);
     if (t == NULL) {
         goto error;
     }
@@ -244,9 +252,10 @@ mk_return_array(int32_t p[], const int64_t N, const int32_t u,
 
     t = out.type->VarDim.type;
     for (v = 0; v < N; v++) {
-        int32_t shape = t->Concrete.VarDim.offsets[v+1]-t->Concrete.VarDim.offsets[v];
-        char *ptr = out.ptr + t->Concrete.VarDim.offsets[v] * t->Concrete.VarDim.itemsize;
-        (void)write_path((int32_t *)ptr, shape, p, N, u, v);
+        int64_t start = ndt_var_offset(t, v);
+        int64_t shape = ndt_var_offset(t, v+1) - start;
+        char *ptr = out.ptr + start * t->Concrete.VarDim.itemsize;
+        (void)write_path((int32_t *)ptr, (int32_t)shape, p, N, u, v);
     }
 
     return out;
@@ -255,10 +264,6 @@ error:
     ndt_free(ndim2_offsets);
     ndt_free(ndim1_offsets);
     return xnd_error;
-
-offset_overflow:
-    ndt_err_format(ctx, NDT_ValueError, "overflow in int32_t offsets");
-    goto error;
 }
 
 static int
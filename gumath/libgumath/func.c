@@ -62,8 +62,13 @@ gm_func_new(const char *name, ndt_context_t *ctx)
         return NULL;
     }
     f->typecheck = NULL;
+    f->cache_lock = 0;
     f->nkernels = 0;
 
+    for (int i = 0; i < GM_CACHE_SIZE; i++) {
+        f->cache[i] = NULL;
+    }
+
     return f;
 }
 
@@ -72,8 +77,11 @@ gm_func_del(gm_func_t *f)
 {
     ndt_free(f->name);
 
+    gm_func_clear_cache(f);
+
     for (int i = 0; i < f->nkernels; i++) {
         ndt_del(f->kernels[i].sig);
+        ndt_matcher_del(f->kernels[i].matcher);
     }
 
     ndt_free(f);
@@ -96,21 +104,76 @@ gm_add_func(gm_tbl_t *tbl, const char *name, ndt_context_t *ctx)
     return f;
 }
 
-int
-gm_add_kernel(gm_tbl_t *tbl, const gm_kernel_init_t *k, ndt_context_t *ctx)
+/*
+ * Return true if the signature is '... * N * T0, ... -> ... * N * Tn'.  In
+ * that case the 1D kernels are elementwise and the 'N' dimension can be
+ * split into chunks.
+ */
+static bool
+is_elemwise(const ndt_t *sig)
 {
-    gm_func_t *f = gm_tbl_find(tbl, k->name, ctx);
-    gm_kernel_set_t kernel;
-    ndt_t *t;
+    const char *name = NULL;
+    const ndt_t *t;
+    int64_t i;
 
-    if (f == NULL) {
-        ndt_err_clear(ctx);
-        f = gm_add_func(tbl, k->name, ctx);
-        if (f == NULL) {
-            return -1;
+    if (sig->tag != Function || sig->Function.nargs == 0) {
+        return false;
+    }
+
+    for (i = 0; i < sig->Function.nargs; i++) {
+        t = sig->Function.types[i];
+        if (t->tag != EllipsisDim || t->EllipsisDim.name != NULL) {
+            return false;
+        }
+
+        t = t->EllipsisDim.type;
+        if (t->tag != SymbolicDim || t->SymbolicDim.type->ndim != 0) {
+            return false;
+        }
+
+        if (name == NULL) {
+            name = t->SymbolicDim.name;
+        }
+        else if (strcmp(name, t->SymbolicDim.name) != 0) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/* Return true if the signature is 'var... * T0, ... -> var... * Tn'. */
+static bool
+is_var_elemwise(const ndt_t *sig)
+{
+    int64_t i;
+
+    if (sig->tag != Function || sig->Function.nargs == 0) {
+        return false;
+    }
+
+    for (i = 0; i < sig->Function.nargs; i++) {
+        const ndt_t *t = sig->Function.types[i];
+        if (t->tag != EllipsisDim || t->EllipsisDim.name == NULL ||
+            strcmp(t->EllipsisDim.name, "var") != 0 ||
+            t->EllipsisDim.type->ndim != 0) {
+            return false;
         }
     }
 
+    return true;
+}
+
+/*
+ * Signatures of functions that are dispatched by gm_select() without a custom
+ * typecheck are precompiled.  Unsupported signatures use ndt_typecheck().
+ */
+static int
+add_kernel_set(gm_func_t *f, const gm_kernel_init_t *k, ndt_context_t *ctx)
+{
+    gm_kernel_set_t kernel;
+    ndt_t *t;
+
     t = ndt_from_string_v(k->sig, ctx);
     if (t == NULL) {
         return -1;
@@ -123,24 +186,36 @@ gm_add_kernel(gm_tbl_t *tbl, const gm_kernel_init_t *k, ndt_context_t *ctx)
         return -1;
     }
 
+    kernel.matcher = NULL;
+    if (f->typecheck == NULL) {
+        kernel.matcher = ndt_matcher_new(t, k->constraint, ctx);
+        if (kernel.matcher == NULL) {
+            if (ctx->err != NDT_NotImplementedError) {
+                ndt_del(t);
+                return -1;
+            }
+            ndt_err_clear(ctx);
+        }
+    }
+
     kernel.sig = t;
     kernel.constraint = k->constraint;
     kernel.C = k->C;
     kernel.Fortran = k->Fortran;
     kernel.Strided = k->Strided;
     kernel.Xnd = k->Xnd;
+    kernel.elemwise = is_elemwise(t);
+    kernel.var_elemwise = is_var_elemwise(t);
 
     f->kernels[f->nkernels++] = kernel;
+    gm_func_clear_cache(f);
     return 0;
 }
 
 int
-gm_add_kernel_typecheck(gm_tbl_t *tbl, const gm_kernel_init_t *k, ndt_context_t *ctx,
-                        gm_typecheck_t typecheck)
+gm_add_kernel(gm_tbl_t *tbl, const gm_kernel_init_t *k, ndt_context_t *ctx)
 {
     gm_func_t *f = gm_tbl_find(tbl, k->name, ctx);
-    gm_kernel_set_t kernel;
-    ndt_t *t;
 
     if (f == NULL) {
         ndt_err_clear(ctx);
@@ -148,28 +223,25 @@ gm_add_kernel_typecheck(gm_tbl_t *tbl, const gm_kernel_init_t *k, ndt_context_t
         if (f == NULL) {
             return -1;
         }
-        f->typecheck = typecheck;
     }
 
-    t = ndt_from_string_v(k->sig, ctx);
-    if (t == NULL) {
-        return -1;
-    }
+    return add_kernel_set(f, k, ctx);
+}
 
-    if (f->nkernels == GM_MAX_KERNELS) {
-        ndt_del(t);
-        ndt_err_format(ctx, NDT_RuntimeError,
-            "%s: maximum number of kernels reached for", f->name);
-        return -1;
-    }
+int
+gm_add_kernel_typecheck(gm_tbl_t *tbl, const gm_kernel_init_t *k, ndt_context_t *ctx,
+                        gm_typecheck_t typecheck)
+{
+    gm_func_t *f = gm_tbl_find(tbl, k->name, ctx);
 
-    kernel.sig = t;
-    kernel.constraint = k->constraint;
-    kernel.C = k->C;
-    kernel.Fortran = k->Fortran;
-    kernel.Strided = k->Strided;
-    kernel.Xnd = k->Xnd;
+    if (f == NULL) {
+        ndt_err_clear(ctx);
+        f = gm_add_func(tbl, k->name, ctx);
+        if (f == NULL) {
+            return -1;
+        }
+        f->typecheck = typecheck;
+    }
 
-    f->kernels[f->nkernels++] = kernel;
-    return 0;
+    return add_kernel_set(f, k, ctx);
 }
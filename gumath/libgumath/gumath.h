@@ -66,6 +66,7 @@
 
 
 #define GM_MAX_KERNELS 512
+#define GM_CACHE_SIZE 16
 
 typedef float float32_t;
 typedef double float64_t;
@@ -73,6 +74,7 @@ typedef double float64_t;
 
 typedef int (* gm_xnd_kernel_t)(xnd_t stack[], ndt_context_t *ctx);
 typedef int (* gm_strided_kernel_t)(char **args, intptr_t *dimensions, intptr_t *steps, void *data);
+typedef int (* gm_task_t)(void *arg, int64_t i, ndt_context_t *ctx);
 
 /* Collection of specialized kernels for a single function signature. */
 typedef struct {
@@ -86,6 +88,16 @@ typedef struct {
 
     /* NumPy signature */
     gm_strided_kernel_t Strided;
+
+    /* The signature is '... * N * T0, ... -> ... * N * Tn'. */
+    bool elemwise;
+
+    /* The signature is 'var... * T0, ... -> var... * Tn'.  If present, the
+       Strided kernel is applied once to the leaf data of var dimensions. */
+    bool var_elemwise;
+
+    /* Precompiled signature, NULL if ndt_typecheck() is used. */
+    ndt_matcher_t *matcher;
 } gm_kernel_set_t;
 
 typedef struct {
@@ -111,12 +123,23 @@ typedef struct {
     const gm_kernel_set_t *set;
 } gm_kernel_t;
 
+/* Dispatch cache entry: maps concrete input types to the selected kernel set */
+typedef struct {
+    uint64_t hash;
+    int nin;
+    ndt_t **in;
+    const gm_kernel_set_t *set;
+    ndt_apply_spec_t spec;
+} gm_cache_entry_t;
+
 /* Multimethod with associated kernels */
 typedef struct gm_func gm_func_t;
 typedef const gm_kernel_set_t *(*gm_typecheck_t)(ndt_apply_spec_t *spec, const gm_func_t *f, const ndt_t *in[], int nin, ndt_context_t *ctx);
 struct gm_func {
     char *name;
     gm_typecheck_t typecheck; /* Experimental optimized type-checking, may be NULL. */
+    ndt_spinlock_t cache_lock;
+    gm_cache_entry_t *cache[GM_CACHE_SIZE];
     int nkernels;
     gm_kernel_set_t kernels[GM_MAX_KERNELS];
 };
@@ -136,10 +159,14 @@ GM_API gm_func_t *gm_add_func(gm_tbl_t *tbl, const char *name, ndt_context_t *ct
 GM_API int gm_add_kernel(gm_tbl_t *tbl, const gm_kernel_init_t *kernel, ndt_context_t *ctx);
 GM_API int gm_add_kernel_typecheck(gm_tbl_t *tbl, const gm_kernel_init_t *kernel, ndt_context_t *ctx, gm_typecheck_t f);
 
+GM_API void gm_func_clear_cache(gm_func_t *f);
+
 GM_API gm_kernel_t gm_select(ndt_apply_spec_t *spec, const gm_tbl_t *tbl, const char *name,
                              const ndt_t *in_types[], int nin, const xnd_t args[],
                              ndt_context_t *ctx);
 GM_API int gm_apply(const gm_kernel_t *kernel, xnd_t stack[], int outer_dims, ndt_context_t *ctx);
+GM_API int gm_apply_out(const gm_kernel_t *kernel, const xnd_t stack[], int nin,
+                        const ndt_apply_spec_t *spec, ndt_context_t *ctx);
 
 
 /******************************************************************************/
@@ -156,6 +183,12 @@ GM_API int gm_np_convert_xnd(char **args, const int nargs,
                              xnd_t stack[], const int outer_dims,
                              ndt_context_t *ctx);
 
+GM_API int gm_np_convert_xnd_broadcast(char **args, const int nargs,
+                                       intptr_t *dimensions, const int dims_size,
+                                       intptr_t *steps, const int steps_size,
+                                       xnd_t stack[], const int outer_dims,
+                                       ndt_context_t *ctx);
+
 GM_API int gm_np_map(const gm_strided_kernel_t f,
                      char **args, int nargs,
                      intptr_t *dimensions,
@@ -172,9 +205,45 @@ GM_API int gm_xnd_map(const gm_xnd_kernel_t f, xnd_t stack[], const int nargs,
                       const int outer_dims, ndt_context_t *ctx);
 
 
+/******************************************************************************/
+/*                                Thread pool                                 */
+/******************************************************************************/
+
+GM_API int gm_set_max_threads(int64_t n, ndt_context_t *ctx);
+GM_API int64_t gm_get_max_threads(void);
+GM_API int gm_set_min_work(int64_t n, ndt_context_t *ctx);
+GM_API int64_t gm_get_min_work(void);
+GM_API int gm_run_tasks(gm_task_t f, void *arg, int64_t ntasks, ndt_context_t *ctx);
+GM_API void gm_thread_pool_clear(void);
+
+
+/******************************************************************************/
+/*                                 SIMD loops                                 */
+/******************************************************************************/
+
+enum gm_simd_level {
+  GM_SIMD_NONE,
+  GM_SIMD_SSE2,
+  GM_SIMD_AVX2,
+  GM_SIMD_AVX512
+};
+
+GM_API int gm_get_max_simd_level(void);
+GM_API int gm_set_simd_level(int level, ndt_context_t *ctx);
+GM_API int gm_get_simd_level(void);
+GM_API void gm_set_fast_math(int enable);
+GM_API int gm_get_fast_math(void);
+
+
 /******************************************************************************/
 /*                                Gufunc table                                */
 /******************************************************************************/
+
+/*
+ * gm_tbl_find(), gm_select() and gm_apply() may be called concurrently by
+ * several threads on a shared table.  Adding multimethods or kernels must
+ * not overlap with any other use of the table.
+ */
 GM_API gm_tbl_t *gm_tbl_new(ndt_context_t *ctx);
 GM_API void gm_tbl_del(gm_tbl_t *t);
 
@@ -190,6 +259,7 @@ GM_API int gm_tbl_map(const gm_tbl_t *tbl, int (*f)(const gm_func_t *, void *sta
 GM_API void gm_init(void);
 GM_API int gm_init_unary_kernels(gm_tbl_t *tbl, ndt_context_t *ctx);
 GM_API int gm_init_binary_kernels(gm_tbl_t *tbl, ndt_context_t *ctx);
+GM_API int gm_init_reduce_kernels(gm_tbl_t *tbl, ndt_context_t *ctx);
 GM_API int gm_init_example_kernels(gm_tbl_t *tbl, ndt_context_t *ctx);
 GM_API int gm_init_bfloat16_kernels(gm_tbl_t *tbl, ndt_context_t *ctx);
 GM_API int gm_init_graph_kernels(gm_tbl_t *tbl, ndt_context_t *ctx);
@@ -52,145 +52,146 @@ infer_return_type(int *base, const ndt_t *in0, const ndt_t *in1, ndt_context_t *
 {
     const ndt_t *t0 = ndt_dtype(in0);
     const ndt_t *t1 = ndt_dtype(in1);
+    ndt_t *dtype;
     enum ndt tag;
 
     switch (t0->tag) {
     case Int8: {
         switch (t1->tag) {
         case Int8: *base = 0; tag = Int8; break;
-        case Int16: *base = 3; tag = Int16; break;
-        case Int32: *base = 6; tag = Int32; break;
-        case Int64: *base = 9; tag = Int64; break;
-        case Uint8: *base = 12; tag = Int16; break;
-        case Uint16: *base = 15; tag = Int32; break;
-        case Uint32: *base = 18; tag = Int64; break;
-        case Float32: *base = 21; tag = Float32; break;
-        case Float64: *base = 24; tag = Float64; break;
+        case Int16: *base = 5; tag = Int16; break;
+        case Int32: *base = 10; tag = Int32; break;
+        case Int64: *base = 15; tag = Int64; break;
+        case Uint8: *base = 20; tag = Int16; break;
+        case Uint16: *base = 25; tag = Int32; break;
+        case Uint32: *base = 30; tag = Int64; break;
+        case Float32: *base = 35; tag = Float32; break;
+        case Float64: *base = 40; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Int16: {
         switch (t1->tag) {
-        case Int8: *base = 27; tag = Int16; break;
-        case Int16: *base = 30; tag = Int16; break;
-        case Int32: *base = 33; tag = Int32; break;
-        case Int64: *base = 36; tag = Int64; break;
-        case Uint8: *base = 39; tag = Int16; break;
-        case Uint16: *base = 42; tag = Int32; break;
-        case Uint32: *base = 45; tag = Int64; break;
-        case Float32: *base = 48; tag = Float32; break;
-        case Float64: *base = 51; tag = Float64; break;
+        case Int8: *base = 45; tag = Int16; break;
+        case Int16: *base = 50; tag = Int16; break;
+        case Int32: *base = 55; tag = Int32; break;
+        case Int64: *base = 60; tag = Int64; break;
+        case Uint8: *base = 65; tag = Int16; break;
+        case Uint16: *base = 70; tag = Int32; break;
+        case Uint32: *base = 75; tag = Int64; break;
+        case Float32: *base = 80; tag = Float32; break;
+        case Float64: *base = 85; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Int32: {
         switch (t1->tag) {
-        case Int8: *base = 54; tag = Int32; break;
-        case Int16: *base = 57; tag = Int32; break;
-        case Int32: *base = 60; tag = Int32; break;
-        case Int64: *base = 63; tag = Int64; break;
-        case Uint8: *base = 66; tag = Int32; break;
-        case Uint16: *base = 69; tag = Int32; break;
-        case Uint32: *base = 72; tag = Int64; break;
-        case Float64: *base = 75; tag = Float64; break;
+        case Int8: *base = 90; tag = Int32; break;
+        case Int16: *base = 95; tag = Int32; break;
+        case Int32: *base = 100; tag = Int32; break;
+        case Int64: *base = 105; tag = Int64; break;
+        case Uint8: *base = 110; tag = Int32; break;
+        case Uint16: *base = 115; tag = Int32; break;
+        case Uint32: *base = 120; tag = Int64; break;
+        case Float64: *base = 125; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Int64: {
         switch (t1->tag) {
-        case Int8: *base = 78; tag = Int64; break;
-        case Int16: *base = 81; tag = Int64; break;
-        case Int32: *base = 83; tag = Int64; break;
-        case Int64: *base = 87; tag = Int64; break;
-        case Uint8: *base = 90; tag = Int64; break;
-        case Uint16: *base = 93; tag = Int64; break;
-        case Uint32: *base = 96; tag = Int64; break;
+        case Int8: *base = 130; tag = Int64; break;
+        case Int16: *base = 135; tag = Int64; break;
+        case Int32: *base = 140; tag = Int64; break;
+        case Int64: *base = 145; tag = Int64; break;
+        case Uint8: *base = 150; tag = Int64; break;
+        case Uint16: *base = 155; tag = Int64; break;
+        case Uint32: *base = 160; tag = Int64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Uint8: {
         switch (t1->tag) {
-        case Int8: *base = 99; tag = Int16; break;
-        case Int16: *base = 102; tag = Int16; break;
-        case Int32: *base = 105; tag = Int32; break;
-        case Int64: *base = 108; tag = Int64; break;
-        case Uint8: *base = 111; tag = Uint8; break;
-        case Uint16: *base = 114; tag = Uint16; break;
-        case Uint32: *base = 117; tag = Uint32; break;
-        case Uint64: *base = 120; tag = Uint64; break;
-        case Float32: *base = 123; tag = Float32; break;
-        case Float64: *base = 126; tag = Float64; break;
+        case Int8: *base = 165; tag = Int16; break;
+        case Int16: *base = 170; tag = Int16; break;
+        case Int32: *base = 175; tag = Int32; break;
+        case Int64: *base = 180; tag = Int64; break;
+        case Uint8: *base = 185; tag = Uint8; break;
+        case Uint16: *base = 190; tag = Uint16; break;
+        case Uint32: *base = 195; tag = Uint32; break;
+        case Uint64: *base = 200; tag = Uint64; break;
+        case Float32: *base = 205; tag = Float32; break;
+        case Float64: *base = 210; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Uint16: {
         switch (t1->tag) {
-        case Int8: *base = 129; tag = Int32; break;
-        case Int16: *base = 132; tag = Int32; break;
-        case Int32: *base = 135; tag = Int32; break;
-        case Int64: *base = 138; tag = Int64; break;
-        case Uint8: *base = 141; tag = Uint16; break;
-        case Uint16: *base = 144; tag = Uint32; break;
-        case Uint32: *base = 147; tag = Uint64; break;
-        case Uint64: *base = 150; tag = Uint64; break;
-        case Float32: *base = 153; tag = Float32; break;
-        case Float64: *base = 156; tag = Float64; break;
+        case Int8: *base = 215; tag = Int32; break;
+        case Int16: *base = 220; tag = Int32; break;
+        case Int32: *base = 225; tag = Int32; break;
+        case Int64: *base = 230; tag = Int64; break;
+        case Uint8: *base = 235; tag = Uint16; break;
+        case Uint16: *base = 240; tag = Uint32; break;
+        case Uint32: *base = 245; tag = Uint64; break;
+        case Uint64: *base = 250; tag = Uint64; break;
+        case Float32: *base = 255; tag = Float32; break;
+        case Float64: *base = 260; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Uint32: {
         switch (t1->tag) {
-        case Int8: *base = 159; tag = Int64; break;
-        case Int16: *base = 162; tag = Int64; break;
-        case Int32: *base = 165; tag = Int64; break;
-        case Int64: *base = 168; tag = Int64; break;
-        case Uint8: *base = 171; tag = Uint32; break;
-        case Uint16: *base = 174; tag = Uint32; break;
-        case Uint32: *base = 177; tag = Uint32; break;
-        case Uint64: *base = 180; tag = Uint64; break;
-        case Float64: *base = 183; tag = Float64; break;
+        case Int8: *base = 265; tag = Int64; break;
+        case Int16: *base = 270; tag = Int64; break;
+        case Int32: *base = 275; tag = Int64; break;
+        case Int64: *base = 280; tag = Int64; break;
+        case Uint8: *base = 285; tag = Uint32; break;
+        case Uint16: *base = 290; tag = Uint32; break;
+        case Uint32: *base = 295; tag = Uint32; break;
+        case Uint64: *base = 300; tag = Uint64; break;
+        case Float64: *base = 305; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Uint64: {
         switch (t1->tag) {
-        case Uint8: *base = 186; tag = Uint64; break;
-        case Uint16: *base = 189; tag = Uint64; break;
-        case Uint32: *base = 192; tag = Uint64; break;
-        case Uint64: *base = 195; tag = Uint64; break;
+        case Uint8: *base = 310; tag = Uint64; break;
+        case Uint16: *base = 315; tag = Uint64; break;
+        case Uint32: *base = 320; tag = Uint64; break;
+        case Uint64: *base = 325; tag = Uint64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Float32: {
         switch (t1->tag) {
-        case Int8: *base = 198; tag = Float32; break;
-        case Int16: *base = 201; tag = Float32; break;
-        case Uint8: *base = 204; tag = Float32; break;
-        case Uint16: *base = 207; tag = Float32; break;
-        case Float32: *base = 210; tag = Float32; break;
-        case Float64: *base = 213; tag = Float64; break;
+        case Int8: *base = 330; tag = Float32; break;
+        case Int16: *base = 335; tag = Float32; break;
+        case Uint8: *base = 340; tag = Float32; break;
+        case Uint16: *base = 345; tag = Float32; break;
+        case Float32: *base = 350; tag = Float32; break;
+        case Float64: *base = 355; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
     }
     case Float64: {
         switch (t1->tag) {
-        case Int8: *base = 216; tag = Float64; break;
-        case Int16: *base = 219; tag = Float64; break;
-        case Int32: *base = 222; tag = Float64; break;
-        case Uint8: *base = 225; tag = Float64; break;
-        case Uint16: *base = 228; tag = Float64; break;
-        case Uint32: *base = 231; tag = Float64; break;
-        case Float32: *base = 234; tag = Float64; break;
-        case Float64: *base = 237; tag = Float64; break;
+        case Int8: *base = 360; tag = Float64; break;
+        case Int16: *base = 365; tag = Float64; break;
+        case Int32: *base = 370; tag = Float64; break;
+        case Uint8: *base = 375; tag = Float64; break;
+        case Uint16: *base = 380; tag = Float64; break;
+        case Uint32: *base = 385; tag = Float64; break;
+        case Float32: *base = 390; tag = Float64; break;
+        case Float64: *base = 395; tag = Float64; break;
         default: goto invalid_combination;
         }
         break;
@@ -199,7 +200,15 @@ infer_return_type(int *base, const ndt_t *in0, const ndt_t *in1, ndt_context_t *
         goto invalid_combination;
     }
 
-    return ndt_primitive(tag, 0, ctx);
+    dtype = ndt_primitive(tag, 0, ctx);
+    if (dtype == NULL) {
+        return NULL;
+    }
+    if (ndt_is_optional(t0) || ndt_is_optional(t1)) {
+        dtype = ndt_option(dtype);
+    }
+
+    return dtype;
 
 invalid_combination:
     ndt_err_format(ctx, NDT_RuntimeError, "invalid dtype");
@@ -249,8 +258,14 @@ binary_typecheck(ndt_apply_spec_t *spec, const gm_func_t *f,
     if (t0->ndim == 0 && t1->ndim == 0) {
         n += 1;
     }
- 
+
+    /* The kernels for optional dtypes follow the regular ones. */
+    if (ndt_is_optional(ndt_dtype(t0)) || ndt_is_optional(ndt_dtype(t1))) {
+        n += 3;
+    }
+
     const gm_kernel_set_t *set = &f->kernels[n];
+    spec->flags = set->Strided != NULL ? NDT_STRIDE_BROADCAST : 0;
     if (ndt_fast_binary_fixed_typecheck(spec, set->sig, in, nin, dtype, ctx) < 0) {
         return NULL;
     }
@@ -323,6 +338,54 @@ gm_fixed_##func##_1D_##t0##_##t1##_##t2(xnd_t stack[], ndt_context_t *ctx)     \
 }                                                                              \
                                                                                \
 static int                                                                     \
+gm_fixed_##func##_1D_S_##t0##_##t1##_##t2(char **args, intptr_t *dimensions,   \
+                                          intptr_t *steps, void *data)         \
+{                                                                              \
+    const char *in0 = args[0];                                                 \
+    const char *in1 = args[1];                                                 \
+    char *out = args[2];                                                       \
+    const intptr_t N = dimensions[0];                                          \
+    const intptr_t s0 = steps[0];                                              \
+    const intptr_t s1 = steps[1];                                              \
+    const intptr_t s2 = steps[2];                                              \
+    (void)data;                                                                \
+                                                                               \
+    /* A zero step is a broadcast scalar. */                                   \
+    if (N > 0 && s0 == 0) {                                                    \
+        const t0##_t x = *(const t0##_t *)in0;                                 \
+        for (intptr_t i = 0; i < N; i++) {                                     \
+            const t1##_t y = *(const t1##_t *)in1;                             \
+            *(t2##_t *)out = func(x, y);                                       \
+            in1 += s1;                                                         \
+            out += s2;                                                         \
+        }                                                                      \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    if (N > 0 && s1 == 0) {                                                    \
+        const t1##_t y = *(const t1##_t *)in1;                                 \
+        for (intptr_t i = 0; i < N; i++) {                                     \
+            const t0##_t x = *(const t0##_t *)in0;                             \
+            *(t2##_t *)out = func(x, y);                                       \
+            in0 += s0;                                                         \
+            out += s2;                                                         \
+        }                                                                      \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    for (intptr_t i = 0; i < N; i++) {                                         \
+        const t0##_t x = *(const t0##_t *)in0;                                 \
+        const t1##_t y = *(const t1##_t *)in1;                                 \
+        *(t2##_t *)out = func(x, y);                                           \
+        in0 += s0;                                                             \
+        in1 += s1;                                                             \
+        out += s2;                                                             \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static int                                                                     \
 gm_##func##_0D_##t0##_##t1##_##t2(xnd_t stack[], ndt_context_t *ctx)           \
 {                                                                              \
     const xnd_t *in0 = &stack[0];                                              \
@@ -335,12 +398,90 @@ gm_##func##_0D_##t0##_##t1##_##t2(xnd_t stack[], ndt_context_t *ctx)           \
     *(t2##_t *)out->ptr = func(x, y);                                          \
                                                                                \
     return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static int                                                                     \
+gm_fixed_##func##_1D_C_opt_##t0##_##t1##_##t2(xnd_t stack[],                   \
+                                              ndt_context_t *ctx)              \
+{                                                                              \
+    const xnd_t *in0 = &stack[0];                                              \
+    const xnd_t *in1 = &stack[1];                                              \
+    xnd_t *out = &stack[2];                                                    \
+    int64_t N = xnd_fixed_shape(in0);                                          \
+                                                                               \
+    xnd_bitmap_and(out->bitmap.data, out->index,                               \
+                   in0->bitmap.data, in0->index,                               \
+                   in1->bitmap.data, in1->index, N);                           \
+                                                                               \
+    if (func##_skips_na && IS_INTEGER(t2)) {                                   \
+        const t0##_t *x = (const t0##_t *)apply_index(in0);                    \
+        const t1##_t *y = (const t1##_t *)apply_index(in1);                    \
+        t2##_t *z = (t2##_t *)apply_index(out);                                \
+        const uint8_t *valid = out->bitmap.data;                               \
+        const int64_t start = out->index;                                      \
+        for (int64_t i = xnd_bitmap_next_valid(valid, start, start+N);         \
+             i < start+N; i = xnd_bitmap_next_valid(valid, i+1, start+N)) {    \
+            z[i-start] = func(x[i-start], y[i-start]);                         \
+        }                                                                      \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    return gm_fixed_##func##_1D_C_##t0##_##t1##_##t2(stack, ctx);              \
+}                                                                              \
+                                                                               \
+static int                                                                     \
+gm_fixed_##func##_1D_opt_##t0##_##t1##_##t2(xnd_t stack[],                     \
+                                            ndt_context_t *ctx)                \
+{                                                                              \
+    const xnd_t *in0 = &stack[0];                                              \
+    const xnd_t *in1 = &stack[1];                                              \
+    xnd_t *out = &stack[2];                                                    \
+    int64_t N = xnd_fixed_shape(in0);                                          \
+    (void)ctx;                                                                 \
+                                                                               \
+    for (int64_t i = 0; i < N; i++) {                                          \
+        const xnd_t v = xnd_fixed_dim_next(in0, i);                            \
+        const xnd_t u = xnd_fixed_dim_next(in1, i);                            \
+        xnd_t w = xnd_fixed_dim_next(out, i);                                  \
+        if (xnd_is_na(&v) || xnd_is_na(&u)) {                                  \
+            xnd_set_na(&w);                                                    \
+            continue;                                                          \
+        }                                                                      \
+        const t0##_t x = *(const t0##_t *)v.ptr;                               \
+        const t1##_t y = *(const t1##_t *)u.ptr;                               \
+        *(t2##_t *)w.ptr = func(x, y);                                         \
+        xnd_set_valid(&w);                                                     \
+    }                                                                          \
+                                                                               \
+    return 0;                                                                  \
+}                                                                              \
+                                                                               \
+static int                                                                     \
+gm_##func##_0D_opt_##t0##_##t1##_##t2(xnd_t stack[], ndt_context_t *ctx)       \
+{                                                                              \
+    const xnd_t *in0 = &stack[0];                                              \
+    const xnd_t *in1 = &stack[1];                                              \
+    xnd_t *out = &stack[2];                                                    \
+    (void)ctx;                                                                 \
+                                                                               \
+    if (xnd_is_na(in0) || xnd_is_na(in1)) {                                    \
+        xnd_set_na(out);                                                       \
+        return 0;                                                              \
+    }                                                                          \
+                                                                               \
+    const t0##_t x = *(const t0##_t *)in0->ptr;                                \
+    const t1##_t y = *(const t1##_t *)in1->ptr;                                \
+    *(t2##_t *)out->ptr = func(x, y);                                          \
+    xnd_set_valid(out);                                                        \
+                                                                               \
+    return 0;                                                                  \
 }
 
 #define XND_BINARY_INIT(func, t0, t1, t2) \
   { .name = STRINGIZE(func),                                                                       \
     .sig = "... * N * " STRINGIZE(t0) ", ... * N * " STRINGIZE(t1) " -> ... * N * " STRINGIZE(t2), \
     .C = gm_fixed_##func##_1D_C_##t0##_##t1##_##t2,                                                \
+    .Strided = gm_fixed_##func##_1D_S_##t0##_##t1##_##t2,                                          \
     .Xnd = gm_fixed_##func##_1D_##t0##_##t1##_##t2 },                                              \
                                                                                                    \
   { .name = STRINGIZE(func),                                                                       \
@@ -349,7 +490,18 @@ gm_##func##_0D_##t0##_##t1##_##t2(xnd_t stack[], ndt_context_t *ctx)           \
                                                                                                    \
   { .name = STRINGIZE(func),                                                                       \
     .sig = "var... * " STRINGIZE(t0) ", var... * " STRINGIZE(t1) " -> var... * " STRINGIZE(t2),    \
-    .Xnd = gm_##func##_0D_##t0##_##t1##_##t2 }
+    .Strided = gm_fixed_##func##_1D_S_##t0##_##t1##_##t2,                                          \
+    .Xnd = gm_##func##_0D_##t0##_##t1##_##t2 },                                                    \
+                                                                                                   \
+  { .name = STRINGIZE(func),                                                                       \
+    .sig = "... * N * ?" STRINGIZE(t0) ", ... * N * ?" STRINGIZE(t1)                               \
+           " -> ... * N * ?" STRINGIZE(t2),                                                        \
+    .C = gm_fixed_##func##_1D_C_opt_##t0##_##t1##_##t2,                                            \
+    .Xnd = gm_fixed_##func##_1D_opt_##t0##_##t1##_##t2 },                                          \
+                                                                                                   \
+  { .name = STRINGIZE(func),                                                                       \
+    .sig = "... * ?" STRINGIZE(t0) ", ... * ?" STRINGIZE(t1) " -> ... * ?" STRINGIZE(t2),          \
+    .Xnd = gm_##func##_0D_opt_##t0##_##t1##_##t2 }
 
 #define XND_ALL_BINARY(name) \
     XND_BINARY(name, int8, int8, int8)          \
@@ -534,16 +686,27 @@ gm_##func##_0D_##t0##_##t1##_##t2(xnd_t stack[], ndt_context_t *ctx)           \
     XND_BINARY_INIT(name, float64, float64, float64)
 
 
+/*
+ * The contiguous kernels for optional dtypes compute all values, including
+ * the ones behind missing elements.  Integer division would trap on the
+ * arbitrary (usually zero) divisors of missing elements, so it skips them.
+ */
+#define IS_INTEGER(t) ((t##_t)0.5 == 0)
+
 #define add(x, y) x + y
+#define add_skips_na 0
 XND_ALL_BINARY(add)
 
 #define subtract(x, y) x - y
+#define subtract_skips_na 0
 XND_ALL_BINARY(subtract)
 
 #define multiply(x, y) x * y
+#define multiply_skips_na 0
 XND_ALL_BINARY(multiply)
 
 #define divide(x, y) x / y
+#define divide_skips_na 1
 XND_ALL_BINARY(divide)
 
 
@@ -0,0 +1,614 @@
+/*
+* BSD 3-Clause License
+*
+* Copyright (c) 2017-2018, plures
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its
+*    contributors may be used to endorse or promote products derived from
+*    this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include <string.h>
+#include <math.h>
+#include <inttypes.h>
+#include <assert.h>
+#include "ndtypes.h"
+#include "xnd.h"
+#include "gumath.h"
+
+
+/****************************************************************************/
+/*                                Inner loops                               */
+/****************************************************************************/
+
+/*
+ * All inner loops reduce 'n' elements of type 't0', starting at 'in' and
+ * separated by 's' bytes, into a single value of type 't1' at 'out'.
+ */
+
+typedef bool bool_t;
+
+#define LOAD(t, p, i, s) (*(const t##_t *)((p) + (i) * (s)))
+
+#define REDUCE_ADD(a, b) ((a) + (b))
+#define REDUCE_MUL(a, b) ((a) * (b))
+
+#define REDUCE_MIN(a, b) ((b) < (a) ? (b) : (a))
+#define REDUCE_MAX(a, b) ((b) > (a) ? (b) : (a))
+
+#define REDUCE_LT(a, b) ((a) < (b))
+#define REDUCE_GT(a, b) ((a) > (b))
+#define REDUCE_ISNAN_INT(x) 0
+#define REDUCE_ISNAN_FLOAT(x) ((x) != (x))
+
+static int
+empty_error(const char *name, ndt_context_t *ctx)
+{
+    ndt_err_format(ctx, NDT_ValueError,
+        "zero-size array to reduction operation %s which has no identity",
+        name);
+    return -1;
+}
+
+
+/*
+ * Sum and product with four independent accumulators.  Integers are
+ * accumulated in uint64_t, which wraps around like NumPy's int64 and
+ * uint64 accumulators without signed overflow.
+ */
+#define REDUCE_ACCUMULATE(name, t0, t1, acc_t, OP, init) \
+static inline int                                                            \
+name##_##t0##_##t1(char *out, const char *in, int64_t n, int64_t s,          \
+                   ndt_context_t *ctx)                                       \
+{                                                                            \
+    acc_t a0 = init, a1 = init, a2 = init, a3 = init;                        \
+    int64_t i;                                                               \
+    (void)ctx;                                                               \
+                                                                             \
+    for (i = 0; i < n-3; i += 4) {                                           \
+        a0 = OP(a0, (acc_t)LOAD(t0, in, i, s));                              \
+        a1 = OP(a1, (acc_t)LOAD(t0, in, i+1, s));                            \
+        a2 = OP(a2, (acc_t)LOAD(t0, in, i+2, s));                            \
+        a3 = OP(a3, (acc_t)LOAD(t0, in, i+3, s));                            \
+    }                                                                        \
+    for (; i < n; i++) {                                                     \
+        a0 = OP(a0, (acc_t)LOAD(t0, in, i, s));                              \
+    }                                                                        \
+                                                                             \
+    *(t1##_t *)out = (t1##_t)OP(OP(a0, a1), OP(a2, a3));                     \
+    return 0;                                                                \
+}
+
+/*
+ * Pairwise summation for floating point values.  The rounding error grows
+ * with O(log n) instead of O(n) for the naive loop.  Blocks of up to
+ * PW_BLOCKSIZE elements are summed with eight accumulators.
+ */
+#define PW_BLOCKSIZE 128
+
+#define REDUCE_PAIRWISE_SUM(t0, t1) \
+static t1##_t                                                                \
+pairwise_sum_##t0##_##t1(const char *in, int64_t n, int64_t s)               \
+{                                                                            \
+    t1##_t res;                                                              \
+    int64_t i;                                                               \
+                                                                             \
+    assert(n > 0);                                                           \
+                                                                             \
+    if (n < 8) {                                                             \
+        res = (t1##_t)LOAD(t0, in, 0, s);                                    \
+        for (i = 1; i < n; i++) {                                            \
+            res += (t1##_t)LOAD(t0, in, i, s);                               \
+        }                                                                    \
+        return res;                                                          \
+    }                                                                        \
+    else if (n <= PW_BLOCKSIZE) {                                            \
+        t1##_t r[8];                                                         \
+                                                                             \
+        for (i = 0; i < 8; i++) {                                            \
+            r[i] = (t1##_t)LOAD(t0, in, i, s);                               \
+        }                                                                    \
+        for (i = 8; i < n - (n % 8); i += 8) {                               \
+            r[0] += (t1##_t)LOAD(t0, in, i, s);                              \
+            r[1] += (t1##_t)LOAD(t0, in, i+1, s);                            \
+            r[2] += (t1##_t)LOAD(t0, in, i+2, s);                            \
+            r[3] += (t1##_t)LOAD(t0, in, i+3, s);                            \
+            r[4] += (t1##_t)LOAD(t0, in, i+4, s);                            \
+            r[5] += (t1##_t)LOAD(t0, in, i+5, s);                            \
+            r[6] += (t1##_t)LOAD(t0, in, i+6, s);                            \
+            r[7] += (t1##_t)LOAD(t0, in, i+7, s);                            \
+        }                                                                    \
+                                                                             \
+        res = ((r[0] + r[1]) + (r[2] + r[3])) +                              \
+              ((r[4] + r[5]) + (r[6] + r[7]));                               \
+                                                                             \
+        for (; i < n; i++) {                                                 \
+            res += (t1##_t)LOAD(t0, in, i, s);                               \
+        }                                                                    \
+        return res;                                                          \
+    }                                                                        \
+    else {                                                                   \
+        int64_t n2 = n / 2;                                                  \
+        n2 -= n2 % 8;                                                        \
+        return pairwise_sum_##t0##_##t1(in, n2, s) +                         \
+               pairwise_sum_##t0##_##t1(in + n2 * s, n - n2, s);             \
+    }                                                                        \
+}
+
+#define REDUCE_FLOAT_SUM(t0, t1) \
+REDUCE_PAIRWISE_SUM(t0, t1)                                                  \
+                                                                             \
+static inline int                                                            \
+sum_##t0##_##t1(char *out, const char *in, int64_t n, int64_t s,             \
+                ndt_context_t *ctx)                                          \
+{                                                                            \
+    (void)ctx;                                                               \
+    *(t1##_t *)out = n == 0 ? 0 : pairwise_sum_##t0##_##t1(in, n, s);        \
+    return 0;                                                                \
+}
+
+#define REDUCE_MEAN(t0, t1) \
+static inline int                                                            \
+mean_##t0##_##t1(char *out, const char *in, int64_t n, int64_t s,            \
+                 ndt_context_t *ctx)                                         \
+{                                                                            \
+    (void)ctx;                                                               \
+    *(t1##_t *)out = n == 0 ? (t1##_t)NAN :                                  \
+                     pairwise_sum_##t0##_##t1(in, n, s) / (t1##_t)n;         \
+    return 0;                                                                \
+}
+
+/*
+ * Minimum and maximum with four independent accumulators.  NaNs are tracked
+ * separately, so the comparisons in the loop can be vectorized.
+ */
+#define REDUCE_MINMAX(name, t0, CMP, ISNAN) \
+static inline int                                                            \
+name##_##t0##_##t0(char *out, const char *in, int64_t n, int64_t s,          \
+                   ndt_context_t *ctx)                                       \
+{                                                                            \
+    t0##_t a0, a1, a2, a3;                                                   \
+    int nan;                                                                 \
+    int64_t i;                                                               \
+                                                                             \
+    if (n == 0) {                                                            \
+        return empty_error(#name, ctx);                                      \
+    }                                                                        \
+                                                                             \
+    a0 = a1 = a2 = a3 = LOAD(t0, in, 0, s);                                  \
+    nan = ISNAN(a0);                                                         \
+                                                                             \
+    for (i = 1; i < n-3; i += 4) {                                           \
+        const t0##_t x0 = LOAD(t0, in, i, s);                                \
+        const t0##_t x1 = LOAD(t0, in, i+1, s);                              \
+        const t0##_t x2 = LOAD(t0, in, i+2, s);                              \
+        const t0##_t x3 = LOAD(t0, in, i+3, s);                              \
+        a0 = CMP(a0, x0);                                                    \
+        a1 = CMP(a1, x1);                                                    \
+        a2 = CMP(a2, x2);                                                    \
+        a3 = CMP(a3, x3);                                                    \
+        nan |= ISNAN(x0) | ISNAN(x1) | ISNAN(x2) | ISNAN(x3);                \
+    }                                                                        \
+    for (; i < n; i++) {                                                     \
+        const t0##_t x0 = LOAD(t0, in, i, s);                                \
+        a0 = CMP(a0, x0);                                                    \
+        nan |= ISNAN(x0);                                                    \
+    }                                                                        \
+                                                                             \
+    a0 = CMP(a0, a1);                                                        \
+    a2 = CMP(a2, a3);                                                        \
+    *(t0##_t *)out = nan ? (t0##_t)NAN : CMP(a0, a2);                        \
+    return 0;                                                                \
+}
+
+/* Index of the first minimum or maximum.  For floats, the first NaN wins. */
+#define REDUCE_ARG(name, t0, CMP, ISNAN) \
+static inline int                                                            \
+name##_##t0##_int64(char *out, const char *in, int64_t n, int64_t s,         \
+                    ndt_context_t *ctx)                                      \
+{                                                                            \
+    t0##_t best;                                                             \
+    int64_t i, k = 0;                                                        \
+                                                                             \
+    if (n == 0) {                                                            \
+        return empty_error(#name, ctx);                                      \
+    }                                                                        \
+                                                                             \
+    best = LOAD(t0, in, 0, s);                                               \
+    if (!ISNAN(best)) {                                                      \
+        for (i = 1; i < n; i++) {                                            \
+            const t0##_t x = LOAD(t0, in, i, s);                             \
+            if (ISNAN(x)) {                                                  \
+                k = i;                                                       \
+                break;                                                       \
+            }                                                                \
+            if (CMP(x, best)) {                                              \
+                best = x;                                                    \
+                k = i;                                                       \
+            }                                                                \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    *(int64_t *)out = k;                                                     \
+    return 0;                                                                \
+}
+
+/*
+ * Short-circuiting any() and all().  't0' is not passed on to LOAD(), since
+ * 'bool' is a macro that would be expanded.
+ */
+#define REDUCE_ANY_ALL(t0) \
+static inline int                                                            \
+any_##t0##_bool(char *out, const char *in, int64_t n, int64_t s,             \
+                ndt_context_t *ctx)                                          \
+{                                                                            \
+    bool res = false;                                                        \
+    (void)ctx;                                                               \
+                                                                             \
+    for (int64_t i = 0; i < n; i++) {                                        \
+        if (*(const t0##_t *)(in + i * s) != 0) {                            \
+            res = true;                                                      \
+            break;                                                           \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    *(bool *)out = res;                                                      \
+    return 0;                                                                \
+}                                                                            \
+                                                                             \
+static inline int                                                            \
+all_##t0##_bool(char *out, const char *in, int64_t n, int64_t s,             \
+                ndt_context_t *ctx)                                          \
+{                                                                            \
+    bool res = true;                                                         \
+    (void)ctx;                                                               \
+                                                                             \
+    for (int64_t i = 0; i < n; i++) {                                        \
+        if (*(const t0##_t *)(in + i * s) == 0) {                            \
+            res = false;                                                     \
+            break;                                                           \
+        }                                                                    \
+    }                                                                        \
+                                                                             \
+    *(bool *)out = res;                                                      \
+    return 0;                                                                \
+}
+
+
+/****************************************************************************/
+/*                           Generated Xnd kernels                          */
+/****************************************************************************/
+
+static inline char *
+apply_index(const xnd_t *x)
+{
+    return xnd_fixed_apply_index(x);
+}
+
+
+/*
+ * The C kernel passes a constant step, so the inlined inner loop is
+ * specialized for contiguous input.  The Xnd kernel handles any step.
+ */
+#define XND_REDUCE(name, t0, t1) \
+static int                                                                   \
+gm_fixed_##name##_1D_C_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)        \
+{                                                                            \
+    const char *in0 = apply_index(&stack[0]);                                \
+    const int64_t N = xnd_fixed_shape(&stack[0]);                            \
+                                                                             \
+    return name##_##t0##_##t1(stack[1].ptr, in0, N,                          \
+                              (int64_t)sizeof(t0##_t), ctx);                 \
+}                                                                            \
+                                                                             \
+static int                                                                   \
+gm_fixed_##name##_1D_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)          \
+{                                                                            \
+    const char *in0 = apply_index(&stack[0]);                                \
+    const int64_t N = xnd_fixed_shape(&stack[0]);                            \
+    const int64_t s = xnd_fixed_stride(&stack[0]);                           \
+                                                                             \
+    return name##_##t0##_##t1(stack[1].ptr, in0, N, s, ctx);                 \
+}
+
+#define XND_REDUCE_INIT(func, t0, t1) \
+  { .name = #func,                                                 \
+    .sig = "... * N * " #t0 " -> ... * " #t1,                      \
+    .C = gm_fixed_##func##_1D_C_##t0##_##t1,                       \
+    .Xnd = gm_fixed_##func##_1D_##t0##_##t1 }
+
+
+/*****************************************************************************/
+/*                                Sum, product                               */
+/*****************************************************************************/
+
+#define XND_ALL_REDUCE_ACCUMULATE(name, OP, init) \
+    REDUCE_ACCUMULATE(name, int8, int64, uint64_t, OP, init)           \
+    REDUCE_ACCUMULATE(name, int16, int64, uint64_t, OP, init)          \
+    REDUCE_ACCUMULATE(name, int32, int64, uint64_t, OP, init)          \
+    REDUCE_ACCUMULATE(name, int64, int64, uint64_t, OP, init)          \
+    REDUCE_ACCUMULATE(name, uint8, uint64, uint64_t, OP, init)         \
+    REDUCE_ACCUMULATE(name, uint16, uint64, uint64_t, OP, init)        \
+    REDUCE_ACCUMULATE(name, uint32, uint64, uint64_t, OP, init)        \
+    REDUCE_ACCUMULATE(name, uint64, uint64, uint64_t, OP, init)
+
+#define XND_ALL_REDUCE_NUMERIC(name) \
+    XND_REDUCE(name, int8, int64)       \
+    XND_REDUCE(name, int16, int64)      \
+    XND_REDUCE(name, int32, int64)      \
+    XND_REDUCE(name, int64, int64)      \
+    XND_REDUCE(name, uint8, uint64)     \
+    XND_REDUCE(name, uint16, uint64)    \
+    XND_REDUCE(name, uint32, uint64)    \
+    XND_REDUCE(name, uint64, uint64)    \
+    XND_REDUCE(name, float32, float32)  \
+    XND_REDUCE(name, float64, float64)
+
+#define XND_ALL_REDUCE_NUMERIC_INIT(func) \
+    XND_REDUCE_INIT(func, int8, int64),       \
+    XND_REDUCE_INIT(func, int16, int64),      \
+    XND_REDUCE_INIT(func, int32, int64),      \
+    XND_REDUCE_INIT(func, int64, int64),      \
+    XND_REDUCE_INIT(func, uint8, uint64),     \
+    XND_REDUCE_INIT(func, uint16, uint64),    \
+    XND_REDUCE_INIT(func, uint32, uint64),    \
+    XND_REDUCE_INIT(func, uint64, uint64),    \
+    XND_REDUCE_INIT(func, float32, float32),  \
+    XND_REDUCE_INIT(func, float64, float64)
+
+XND_ALL_REDUCE_ACCUMULATE(sum, REDUCE_ADD, 0)
+REDUCE_FLOAT_SUM(float32, float32)
+REDUCE_FLOAT_SUM(float64, float64)
+XND_ALL_REDUCE_NUMERIC(sum)
+
+XND_ALL_REDUCE_ACCUMULATE(prod, REDUCE_MUL, 1)
+REDUCE_ACCUMULATE(prod, float32, float32, float32_t, REDUCE_MUL, 1)
+REDUCE_ACCUMULATE(prod, float64, float64, float64_t, REDUCE_MUL, 1)
+XND_ALL_REDUCE_NUMERIC(prod)
+
+
+/*****************************************************************************/
+/*                                    Mean                                   */
+/*****************************************************************************/
+
+REDUCE_PAIRWISE_SUM(int8, float64)
+REDUCE_PAIRWISE_SUM(int16, float64)
+REDUCE_PAIRWISE_SUM(int32, float64)
+REDUCE_PAIRWISE_SUM(int64, float64)
+REDUCE_PAIRWISE_SUM(uint8, float64)
+REDUCE_PAIRWISE_SUM(uint16, float64)
+REDUCE_PAIRWISE_SUM(uint32, float64)
+REDUCE_PAIRWISE_SUM(uint64, float64)
+
+REDUCE_MEAN(int8, float64)
+REDUCE_MEAN(int16, float64)
+REDUCE_MEAN(int32, float64)
+REDUCE_MEAN(int64, float64)
+REDUCE_MEAN(uint8, float64)
+REDUCE_MEAN(uint16, float64)
+REDUCE_MEAN(uint32, float64)
+REDUCE_MEAN(uint64, float64)
+REDUCE_MEAN(float32, float32)
+REDUCE_MEAN(float64, float64)
+
+XND_REDUCE(mean, int8, float64)
+XND_REDUCE(mean, int16, float64)
+XND_REDUCE(mean, int32, float64)
+XND_REDUCE(mean, int64, float64)
+XND_REDUCE(mean, uint8, float64)
+XND_REDUCE(mean, uint16, float64)
+XND_REDUCE(mean, uint32, float64)
+XND_REDUCE(mean, uint64, float64)
+XND_REDUCE(mean, float32, float32)
+XND_REDUCE(mean, float64, float64)
+
+
+/*****************************************************************************/
+/*                               Minimum, maximum                            */
+/*****************************************************************************/
+
+#define XND_ALL_REDUCE_MINMAX(name, CMP) \
+    REDUCE_MINMAX(name, int8, CMP, REDUCE_ISNAN_INT)       \
+    REDUCE_MINMAX(name, int16, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_MINMAX(name, int32, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_MINMAX(name, int64, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_MINMAX(name, uint8, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_MINMAX(name, uint16, CMP, REDUCE_ISNAN_INT)     \
+    REDUCE_MINMAX(name, uint32, CMP, REDUCE_ISNAN_INT)     \
+    REDUCE_MINMAX(name, uint64, CMP, REDUCE_ISNAN_INT)     \
+    REDUCE_MINMAX(name, float32, CMP, REDUCE_ISNAN_FLOAT)  \
+    REDUCE_MINMAX(name, float64, CMP, REDUCE_ISNAN_FLOAT)  \
+                                                           \
+    XND_REDUCE(name, int8, int8)        \
+    XND_REDUCE(name, int16, int16)      \
+    XND_REDUCE(name, int32, int32)      \
+    XND_REDUCE(name, int64, int64)      \
+    XND_REDUCE(name, uint8, uint8)      \
+    XND_REDUCE(name, uint16, uint16)    \
+    XND_REDUCE(name, uint32, uint32)    \
+    XND_REDUCE(name, uint64, uint64)    \
+    XND_REDUCE(name, float32, float32)  \
+    XND_REDUCE(name, float64, float64)
+
+#define XND_ALL_REDUCE_MINMAX_INIT(func) \
+    XND_REDUCE_INIT(func, int8, int8),        \
+    XND_REDUCE_INIT(func, int16, int16),      \
+    XND_REDUCE_INIT(func, int32, int32),      \
+    XND_REDUCE_INIT(func, int64, int64),      \
+    XND_REDUCE_INIT(func, uint8, uint8),      \
+    XND_REDUCE_INIT(func, uint16, uint16),    \
+    XND_REDUCE_INIT(func, uint32, uint32),    \
+    XND_REDUCE_INIT(func, uint64, uint64),    \
+    XND_REDUCE_INIT(func, float32, float32),  \
+    XND_REDUCE_INIT(func, float64, float64)
+
+XND_ALL_REDUCE_MINMAX(min, REDUCE_MIN)
+XND_ALL_REDUCE_MINMAX(max, REDUCE_MAX)
+
+
+/*****************************************************************************/
+/*                              Argmin, argmax                               */
+/*****************************************************************************/
+
+#define XND_ALL_REDUCE_ARG(name, CMP) \
+    REDUCE_ARG(name, int8, CMP, REDUCE_ISNAN_INT)       \
+    REDUCE_ARG(name, int16, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_ARG(name, int32, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_ARG(name, int64, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_ARG(name, uint8, CMP, REDUCE_ISNAN_INT)      \
+    REDUCE_ARG(name, uint16, CMP, REDUCE_ISNAN_INT)     \
+    REDUCE_ARG(name, uint32, CMP, REDUCE_ISNAN_INT)     \
+    REDUCE_ARG(name, uint64, CMP, REDUCE_ISNAN_INT)     \
+    REDUCE_ARG(name, float32, CMP, REDUCE_ISNAN_FLOAT)  \
+    REDUCE_ARG(name, float64, CMP, REDUCE_ISNAN_FLOAT)  \
+                                                        \
+    XND_REDUCE(name, int8, int64)                       \
+    XND_REDUCE(name, int16, int64)                      \
+    XND_REDUCE(name, int32, int64)                      \
+    XND_REDUCE(name, int64, int64)                      \
+    XND_REDUCE(name, uint8, int64)                      \
+    XND_REDUCE(name, uint16, int64)                     \
+    XND_REDUCE(name, uint32, int64)                     \
+    XND_REDUCE(name, uint64, int64)                     \
+    XND_REDUCE(name, float32, int64)                    \
+    XND_REDUCE(name, float64, int64)
+
+#define XND_ALL_REDUCE_ARG_INIT(func) \
+    XND_REDUCE_INIT(func, int8, int64),     \
+    XND_REDUCE_INIT(func, int16, int64),    \
+    XND_REDUCE_INIT(func, int32, int64),    \
+    XND_REDUCE_INIT(func, int64, int64),    \
+    XND_REDUCE_INIT(func, uint8, int64),    \
+    XND_REDUCE_INIT(func, uint16, int64),   \
+    XND_REDUCE_INIT(func, uint32, int64),   \
+    XND_REDUCE_INIT(func, uint64, int64),   \
+    XND_REDUCE_INIT(func, float32, int64),  \
+    XND_REDUCE_INIT(func, float64, int64)
+
+XND_ALL_REDUCE_ARG(argmin, REDUCE_LT)
+XND_ALL_REDUCE_ARG(argmax, REDUCE_GT)
+
+
+/*****************************************************************************/
+/*                                 Any, all                                  */
+/*****************************************************************************/
+
+#define XND_ALL_REDUCE_BOOL(name) \
+    XND_REDUCE(name, bool, bool)     \
+    XND_REDUCE(name, int8, bool)     \
+    XND_REDUCE(name, int16, bool)    \
+    XND_REDUCE(name, int32, bool)    \
+    XND_REDUCE(name, int64, bool)    \
+    XND_REDUCE(name, uint8, bool)    \
+    XND_REDUCE(name, uint16, bool)   \
+    XND_REDUCE(name, uint32, bool)   \
+    XND_REDUCE(name, uint64, bool)   \
+    XND_REDUCE(name, float32, bool)  \
+    XND_REDUCE(name, float64, bool)
+
+#define XND_ALL_REDUCE_BOOL_INIT(func) \
+    XND_REDUCE_INIT(func, bool, bool),     \
+    XND_REDUCE_INIT(func, int8, bool),     \
+    XND_REDUCE_INIT(func, int16, bool),    \
+    XND_REDUCE_INIT(func, int32, bool),    \
+    XND_REDUCE_INIT(func, int64, bool),    \
+    XND_REDUCE_INIT(func, uint8, bool),    \
+    XND_REDUCE_INIT(func, uint16, bool),   \
+    XND_REDUCE_INIT(func, uint32, bool),   \
+    XND_REDUCE_INIT(func, uint64, bool),   \
+    XND_REDUCE_INIT(func, float32, bool),  \
+    XND_REDUCE_INIT(func, float64, bool)
+
+REDUCE_ANY_ALL(bool)
+REDUCE_ANY_ALL(int8)
+REDUCE_ANY_ALL(int16)
+REDUCE_ANY_ALL(int32)
+REDUCE_ANY_ALL(int64)
+REDUCE_ANY_ALL(uint8)
+REDUCE_ANY_ALL(uint16)
+REDUCE_ANY_ALL(uint32)
+REDUCE_ANY_ALL(uint64)
+REDUCE_ANY_ALL(float32)
+REDUCE_ANY_ALL(float64)
+
+XND_ALL_REDUCE_BOOL(any)
+XND_ALL_REDUCE_BOOL(all)
+
+
+static const gm_kernel_init_t reduce[] = {
+  /* SUM, PRODUCT */
+  XND_ALL_REDUCE_NUMERIC_INIT(sum),
+  XND_ALL_REDUCE_NUMERIC_INIT(prod),
+
+  /* MEAN */
+  XND_REDUCE_INIT(mean, int8, float64),
+  XND_REDUCE_INIT(mean, int16, float64),
+  XND_REDUCE_INIT(mean, int32, float64),
+  XND_REDUCE_INIT(mean, int64, float64),
+  XND_REDUCE_INIT(mean, uint8, float64),
+  XND_REDUCE_INIT(mean, uint16, float64),
+  XND_REDUCE_INIT(mean, uint32, float64),
+  XND_REDUCE_INIT(mean, uint64, float64),
+  XND_REDUCE_INIT(mean, float32, float32),
+  XND_REDUCE_INIT(mean, float64, float64),
+
+  /* MINIMUM, MAXIMUM */
+  XND_ALL_REDUCE_MINMAX_INIT(min),
+  XND_ALL_REDUCE_MINMAX_INIT(max),
+
+  /* ARGMIN, ARGMAX */
+  XND_ALL_REDUCE_ARG_INIT(argmin),
+  XND_ALL_REDUCE_ARG_INIT(argmax),
+
+  /* ANY, ALL */
+  XND_ALL_REDUCE_BOOL_INIT(any),
+  XND_ALL_REDUCE_BOOL_INIT(all),
+
+  { .name = NULL, .sig = NULL }
+};
+
+
+/****************************************************************************/
+/*                       Initialize kernel table                            */
+/****************************************************************************/
+
+int
+gm_init_reduce_kernels(gm_tbl_t *tbl, ndt_context_t *ctx)
+{
+    const gm_kernel_init_t *k;
+
+    for (k = reduce; k->name != NULL; k++) {
+        if (gm_add_kernel(tbl, k, ctx) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
@@ -0,0 +1,248 @@
+/*
+* BSD 3-Clause License
+*
+* Copyright (c) 2017-2018, plures
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its
+*    contributors may be used to endorse or promote products derived from
+*    this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <math.h>
+#include "ndtypes.h"
+#include "xnd.h"
+#include "gumath.h"
+#include "simd.h"
+
+
+/****************************************************************************/
+/*                              Vector loops                                */
+/****************************************************************************/
+
+#if defined(__GNUC__) && defined(__x86_64__)
+  #define GM_HAVE_SIMD
+  #include <immintrin.h>
+#endif
+
+#ifdef GM_HAVE_SIMD
+/* SSE2 is part of the x86-64 baseline. */
+#define SIMD_ISA sse2
+#define SIMD_BYTES 16
+#define SIMD_SQRT_F32(v) ((VF)_mm_sqrt_ps((__m128)(v)))
+#define SIMD_SQRT_F64(v) ((VD)_mm_sqrt_pd((__m128d)(v)))
+#include "simd_impl.h"
+#undef SIMD_SQRT_F64
+#undef SIMD_SQRT_F32
+#undef SIMD_BYTES
+#undef SIMD_ISA
+
+#if defined(__clang__)
+  #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+  #pragma GCC push_options
+  #pragma GCC target("avx2")
+#endif
+#define SIMD_ISA avx2
+#define SIMD_BYTES 32
+#define SIMD_SQRT_F32(v) ((VF)_mm256_sqrt_ps((__m256)(v)))
+#define SIMD_SQRT_F64(v) ((VD)_mm256_sqrt_pd((__m256d)(v)))
+#include "simd_impl.h"
+#undef SIMD_SQRT_F64
+#undef SIMD_SQRT_F32
+#undef SIMD_BYTES
+#undef SIMD_ISA
+#if defined(__clang__)
+  #pragma clang attribute pop
+#else
+  #pragma GCC pop_options
+#endif
+
+#if defined(__clang__)
+  #pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+  #pragma GCC push_options
+  #pragma GCC target("avx512f")
+#endif
+#define SIMD_ISA avx512
+#define SIMD_BYTES 64
+#define SIMD_SQRT_F32(v) ((VF)_mm512_sqrt_ps((__m512)(v)))
+#define SIMD_SQRT_F64(v) ((VD)_mm512_sqrt_pd((__m512d)(v)))
+#include "simd_impl.h"
+#undef SIMD_SQRT_F64
+#undef SIMD_SQRT_F32
+#undef SIMD_BYTES
+#undef SIMD_ISA
+#if defined(__clang__)
+  #pragma clang attribute pop
+#else
+  #pragma GCC pop_options
+#endif
+#endif /* GM_HAVE_SIMD */
+
+
+/****************************************************************************/
+/*                                Dispatch                                  */
+/****************************************************************************/
+
+/*
+ * The level is detected on first use.  Concurrent first calls may run the
+ * detection more than once, but they store the same result, and a level
+ * that has been set explicitly is not overwritten.
+ */
+#if defined(__GNUC__)
+  #define LOAD(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+  #define STORE(p, v) __atomic_store_n(p, v, __ATOMIC_RELEASE)
+  #define CAS(p, e, v) \
+      __atomic_compare_exchange_n(p, e, v, 0, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE)
+#else
+  #define LOAD(p) (*(p))
+  #define STORE(p, v) (*(p) = (v))
+  #define CAS(p, e, v) (*(p) == *(e) ? (*(p) = (v), 1) : (*(e) = *(p), 0))
+#endif
+
+static int max_level = -1;
+static int level = -1;
+static int fast_math = 0;
+
+static int
+detect_level(void)
+{
+#ifdef GM_HAVE_SIMD
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx512f")) {
+        return GM_SIMD_AVX512;
+    }
+    if (__builtin_cpu_supports("avx2")) {
+        return GM_SIMD_AVX2;
+    }
+    return GM_SIMD_SSE2;
+#else
+    return GM_SIMD_NONE;
+#endif
+}
+
+static inline int
+active_level(void)
+{
+    int n = LOAD(&level);
+
+    if (n < 0) {
+        const int m = detect_level();
+        STORE(&max_level, m);
+        if (CAS(&level, &n, m)) {
+            n = m;
+        }
+    }
+
+    return n;
+}
+
+gm_simd_float32_t
+gm_simd_float32(enum gm_vec_func f)
+{
+    if (f >= GM_VEC_exp && !LOAD(&fast_math)) {
+        return NULL;
+    }
+
+    switch (active_level()) {
+#ifdef GM_HAVE_SIMD
+    case GM_SIMD_SSE2: return float32_loops_sse2[f];
+    case GM_SIMD_AVX2: return float32_loops_avx2[f];
+    case GM_SIMD_AVX512: return float32_loops_avx512[f];
+#endif
+    default: return NULL;
+    }
+}
+
+gm_simd_float64_t
+gm_simd_float64(enum gm_vec_func f)
+{
+    if (f >= GM_VEC_exp && !LOAD(&fast_math)) {
+        return NULL;
+    }
+
+    switch (active_level()) {
+#ifdef GM_HAVE_SIMD
+    case GM_SIMD_SSE2: return float64_loops_sse2[f];
+    case GM_SIMD_AVX2: return float64_loops_avx2[f];
+    case GM_SIMD_AVX512: return float64_loops_avx512[f];
+#endif
+    default: return NULL;
+    }
+}
+
+
+/****************************************************************************/
+/*                                  API                                     */
+/****************************************************************************/
+
+int
+gm_get_max_simd_level(void)
+{
+    (void)active_level();
+    return LOAD(&max_level);
+}
+
+int
+gm_get_simd_level(void)
+{
+    return active_level();
+}
+
+int
+gm_set_simd_level(int n, ndt_context_t *ctx)
+{
+    int max;
+
+    (void)active_level();
+    max = LOAD(&max_level);
+
+    if (n < GM_SIMD_NONE || n > max) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "SIMD level must be in [0, %d]", max);
+        return -1;
+    }
+
+    STORE(&level, n);
+    return 0;
+}
+
+void
+gm_set_fast_math(int enable)
+{
+    STORE(&fast_math, enable != 0);
+}
+
+int
+gm_get_fast_math(void)
+{
+    return LOAD(&fast_math);
+}
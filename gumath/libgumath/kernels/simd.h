@@ -0,0 +1,73 @@
+/*
+* BSD 3-Clause License
+*
+* Copyright (c) 2017-2018, plures
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its
+*    contributors may be used to endorse or promote products derived from
+*    this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+
+#ifndef GM_SIMD_H
+#define GM_SIMD_H
+
+
+#include <stdint.h>
+
+
+/*
+ * Vectorized 1D loops for C-contiguous float32 and float64 arrays.  The loops
+ * for the exact functions are used whenever the CPU supports SIMD, the loops
+ * for the approximations only in fast-math mode.
+ */
+
+enum gm_vec_func {
+  /* exact */
+  GM_VEC_fabs,
+  GM_VEC_sqrt,
+  GM_VEC_ceil,
+  GM_VEC_floor,
+  GM_VEC_trunc,
+
+  /* approximations */
+  GM_VEC_exp,
+  GM_VEC_log,
+  GM_VEC_sin,
+  GM_VEC_cos,
+
+  GM_VEC_NFUNCS
+};
+
+typedef void (*gm_simd_float32_t)(float *out, const float *in, int64_t n);
+typedef void (*gm_simd_float64_t)(double *out, const double *in, int64_t n);
+
+/* Return the loop for the active SIMD level or NULL. */
+gm_simd_float32_t gm_simd_float32(enum gm_vec_func f);
+gm_simd_float64_t gm_simd_float64(enum gm_vec_func f);
+
+
+#endif /* GM_SIMD_H */
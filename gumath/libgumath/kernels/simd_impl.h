@@ -0,0 +1,635 @@
+/*
+* BSD 3-Clause License
+*
+* Copyright (c) 2017-2018, plures
+* All rights reserved.
+*
+* Redistribution and use in source and binary forms, with or without
+* modification, are permitted provided that the following conditions are met:
+*
+* 1. Redistributions of source code must retain the above copyright notice,
+*    this list of conditions and the following disclaimer.
+*
+* 2. Redistributions in binary form must reproduce the above copyright notice,
+*    this list of conditions and the following disclaimer in the documentation
+*    and/or other materials provided with the distribution.
+*
+* 3. Neither the name of the copyright holder nor the names of its
+*    contributors may be used to endorse or promote products derived from
+*    this software without specific prior written permission.
+*
+* THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+* AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+* IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+* DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+* FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+* DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+* SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+* CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+* OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+* OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+*/
+
+
+/*
+ * Vector loops for one instruction set.  This file is included by simd.c
+ * once per instruction set with the following macros defined:
+ *
+ *   SIMD_ISA:          suffix for all names (sse2, avx2, avx512)
+ *   SIMD_BYTES:        vector size in bytes
+ *   SIMD_SQRT_F32(v):  vector square root for float32
+ *   SIMD_SQRT_F64(v):  vector square root for float64
+ *
+ * The code uses the GCC vector extensions, so the compiler emits the
+ * instructions of the target that is active at the point of inclusion.
+ *
+ * Every vector function returns a mask of the lanes that it could not
+ * handle.  These lanes (special values, arguments outside of the reduced
+ * range, results in the subnormal range) are recomputed with libm.
+ */
+
+
+#define SIMD_CAT2(x, y) x##_##y
+#define SIMD_CAT(x, y) SIMD_CAT2(x, y)
+#define S(name) SIMD_CAT(name, SIMD_ISA)
+
+#define VF S(vf32)
+#define VI S(vi32)
+#define VU S(vu32)
+#define VD S(vf64)
+#define VL S(vi64)
+#define VUL S(vu64)
+
+#define NF32 (SIMD_BYTES / 4)
+#define NF64 (SIMD_BYTES / 8)
+
+typedef float VF __attribute__((vector_size(SIMD_BYTES)));
+typedef int32_t VI __attribute__((vector_size(SIMD_BYTES)));
+typedef uint32_t VU __attribute__((vector_size(SIMD_BYTES)));
+typedef double VD __attribute__((vector_size(SIMD_BYTES)));
+typedef int64_t VL __attribute__((vector_size(SIMD_BYTES)));
+typedef uint64_t VUL __attribute__((vector_size(SIMD_BYTES)));
+
+
+/*****************************************************************************/
+/*                                  Helpers                                  */
+/*****************************************************************************/
+
+static inline VF
+S(splat_f32)(float c)
+{
+    return (VF){0} + c;
+}
+
+static inline VD
+S(splat_f64)(double c)
+{
+    return (VD){0} + c;
+}
+
+static inline VF
+S(select_f32)(VI m, VF a, VF b)
+{
+    return (VF)(((VU)a & (VU)m) | ((VU)b & ~(VU)m));
+}
+
+static inline VD
+S(select_f64)(VL m, VD a, VD b)
+{
+    return (VD)(((VUL)a & (VUL)m) | ((VUL)b & ~(VUL)m));
+}
+
+static inline VF
+S(abs_f32)(VF x)
+{
+    return (VF)((VU)x & 0x7fffffffU);
+}
+
+static inline VD
+S(abs_f64)(VD x)
+{
+    return (VD)((VUL)x & 0x7fffffffffffffffULL);
+}
+
+static inline VF
+S(copysign_f32)(VF x, VF y)
+{
+    return (VF)(((VU)x & 0x7fffffffU) | ((VU)y & 0x80000000U));
+}
+
+static inline VD
+S(copysign_f64)(VD x, VD y)
+{
+    return (VD)(((VUL)x & 0x7fffffffffffffffULL) | ((VUL)y & 0x8000000000000000ULL));
+}
+
+/* Round to the nearest integer (ties to even), |x| must be < 2**22. */
+static inline VF
+S(rint_small_f32)(VF x, VI *n)
+{
+    const VF magic = S(splat_f32)(0x1.8p23f);
+    const VF t = x + magic;
+    *n = (VI)t - (VI)magic;
+    return t - magic;
+}
+
+/* Round to the nearest integer (ties to even), |x| must be < 2**51. */
+static inline VD
+S(rint_small_f64)(VD x, VL *n)
+{
+    const VD magic = S(splat_f64)(0x1.8p52);
+    const VD t = x + magic;
+    *n = (VL)t - (VL)magic;
+    return t - magic;
+}
+
+/* Convert small integers to float. */
+static inline VF
+S(int_to_f32)(VI n)
+{
+    const VF magic = S(splat_f32)(0x1.8p23f);
+    return (VF)(n + (VI)magic) - magic;
+}
+
+static inline VD
+S(int_to_f64)(VL n)
+{
+    const VD magic = S(splat_f64)(0x1.8p52);
+    return (VD)(n + (VL)magic) - magic;
+}
+
+/* 2**n for n in the range of normal exponents. */
+static inline VF
+S(pow2_f32)(VI n)
+{
+    return (VF)((n + 127) << 23);
+}
+
+static inline VD
+S(pow2_f64)(VL n)
+{
+    return (VD)((n + 1023) << 52);
+}
+
+
+/*****************************************************************************/
+/*                             Exact functions                               */
+/*****************************************************************************/
+
+static inline VF
+S(fabs_f32)(VF x, VI *bad)
+{
+    *bad = (VI){0};
+    return S(abs_f32)(x);
+}
+
+static inline VD
+S(fabs_f64)(VD x, VL *bad)
+{
+    *bad = (VL){0};
+    return S(abs_f64)(x);
+}
+
+static inline VF
+S(sqrt_f32)(VF x, VI *bad)
+{
+    *bad = (VI){0};
+    return SIMD_SQRT_F32(x);
+}
+
+static inline VD
+S(sqrt_f64)(VD x, VL *bad)
+{
+    *bad = (VL){0};
+    return SIMD_SQRT_F64(x);
+}
+
+/*
+ * For |x| < 2**23 (2**52) |x| is rounded to an integer by adding and
+ * subtracting 2**23 (2**52).  Larger values, infinities and NaNs are already
+ * integral.  Copying the sign of x at the end gives the correct sign for zero
+ * results.
+ */
+#define SIMD_ROUNDING_FUNCS(T, VT, VTI, limit) \
+static inline VT                                                         \
+S(floor_##T)(VT x, VTI *bad)                                             \
+{                                                                        \
+    const VT a = S(abs_##T)(x);                                          \
+    const VTI small = (VTI)(a < limit);                                  \
+    VT r;                                                                \
+                                                                         \
+    *bad = (VTI){0};                                                     \
+    r = S(copysign_##T)((a + limit) - limit, x);                         \
+    r = r - S(select_##T)((VTI)(r > x), S(splat_##T)(1), S(splat_##T)(0)); \
+    r = S(copysign_##T)(r, x);                                           \
+                                                                         \
+    return S(select_##T)(small, r, x);                                   \
+}                                                                        \
+                                                                         \
+static inline VT                                                         \
+S(ceil_##T)(VT x, VTI *bad)                                              \
+{                                                                        \
+    const VT a = S(abs_##T)(x);                                          \
+    const VTI small = (VTI)(a < limit);                                  \
+    VT r;                                                                \
+                                                                         \
+    *bad = (VTI){0};                                                     \
+    r = S(copysign_##T)((a + limit) - limit, x);                         \
+    r = r + S(select_##T)((VTI)(r < x), S(splat_##T)(1), S(splat_##T)(0)); \
+    r = S(copysign_##T)(r, x);                                           \
+                                                                         \
+    return S(select_##T)(small, r, x);                                   \
+}                                                                        \
+                                                                         \
+static inline VT                                                         \
+S(trunc_##T)(VT x, VTI *bad)                                             \
+{                                                                        \
+    const VT a = S(abs_##T)(x);                                          \
+    const VTI small = (VTI)(a < limit);                                  \
+    VT r;                                                                \
+                                                                         \
+    *bad = (VTI){0};                                                     \
+    r = (a + limit) - limit;                                             \
+    r = r - S(select_##T)((VTI)(r > a), S(splat_##T)(1), S(splat_##T)(0)); \
+    r = S(copysign_##T)(r, x);                                           \
+                                                                         \
+    return S(select_##T)(small, r, x);                                   \
+}
+
+SIMD_ROUNDING_FUNCS(f32, VF, VI, 0x1p23f)
+SIMD_ROUNDING_FUNCS(f64, VD, VL, 0x1p52)
+
+
+/*****************************************************************************/
+/*                     Approximations (fast-math mode only)                  */
+/*****************************************************************************/
+
+/*
+ * The algorithms and coefficients are those of the Cephes library.  The
+ * argument is reduced with an extended precision representation of the
+ * constant (ln2 or pi/4), the reduced argument is evaluated with polynomial
+ * or rational approximations.
+ */
+
+static inline VF
+S(exp_f32)(VF x, VI *bad)
+{
+    const VI ok = (VI)(x >= -86.0f) & (VI)(x <= 88.0f);
+    VF n, r, z, p;
+    VI k;
+
+    *bad = ~ok;
+    x = S(select_f32)(ok, x, S(splat_f32)(0));
+
+    n = S(rint_small_f32)(x * 1.44269504088896341f, &k);
+    r = x - n * 0.693359375f;
+    r = r - n * -2.12194440e-4f;
+
+    z = r * r;
+    p = S(splat_f32)(1.9875691500e-4f);
+    p = p * r + 1.3981999507e-3f;
+    p = p * r + 8.3334519073e-3f;
+    p = p * r + 4.1665795894e-2f;
+    p = p * r + 1.6666665459e-1f;
+    p = p * r + 5.0000001201e-1f;
+    p = p * z + r + 1.0f;
+
+    return p * S(pow2_f32)(k);
+}
+
+static inline VF
+S(log_f32)(VF x, VI *bad)
+{
+    const VI ok = (VI)(x >= 0x1p-126f) & (VI)(x <= 0x1.fffffep127f);
+    VI e, small;
+    VF m, z, y, fe;
+
+    *bad = ~ok;
+    x = S(select_f32)(ok, x, S(splat_f32)(1));
+
+    /* x = m * 2**e, 0.5 <= m < 1 */
+    e = (VI)(((VU)x >> 23) & 0xff) - 126;
+    m = (VF)(((VU)x & 0x007fffffU) | 0x3f000000U);
+
+    small = (VI)(m < 0.707106781186547524f);
+    e = e + small; /* e -= 1 */
+    m = S(select_f32)(small, m + m, m) - 1.0f;
+    fe = S(int_to_f32)(e);
+
+    z = m * m;
+    y = S(splat_f32)(7.0376836292e-2f);
+    y = y * m - 1.1514610310e-1f;
+    y = y * m + 1.1676998740e-1f;
+    y = y * m - 1.2420140846e-1f;
+    y = y * m + 1.4249322787e-1f;
+    y = y * m - 1.6668057665e-1f;
+    y = y * m + 2.0000714765e-1f;
+    y = y * m - 2.4999993993e-1f;
+    y = y * m + 3.3333331174e-1f;
+    y = y * m * z;
+
+    y = y + fe * -2.12194440e-4f;
+    y = y - 0.5f * z;
+    z = m + y;
+    return z + fe * 0.693359375f;
+}
+
+/* Reduce x to [-pi/4, pi/4], return the octant in 'j'. */
+static inline VF
+S(reduce_pio4_f32)(VF x, VI *j)
+{
+    VF y;
+    VI k;
+
+    y = x * 1.27323954473516f;
+    y = S(rint_small_f32)(y, &k);
+    k = k + (VI)(y > x * 1.27323954473516f); /* floor */
+    k = (k + 1) & ~1;
+    y = S(int_to_f32)(k);
+    *j = k;
+
+    /* pi/4 in five parts, the products of the first four are exact. */
+    x = x - y * 0x1.92p-1f;
+    x = x - y * 0x1.fbp-13f;
+    x = x - y * 0x1.51p-23f;
+    x = x - y * 0x1.0bp-35f;
+    return x - y * 0x1.18469ap-45f;
+}
+
+static inline VF
+S(sincos_poly_f32)(VF x, VI use_cos)
+{
+    const VF z = x * x;
+    VF s, c;
+
+    c = S(splat_f32)(2.443315711809948e-5f);
+    c = c * z - 1.388731625493765e-3f;
+    c = c * z + 4.166664568298827e-2f;
+    c = c * z * z - 0.5f * z + 1.0f;
+
+    s = S(splat_f32)(-1.9515295891e-4f);
+    s = s * z + 8.3321608736e-3f;
+    s = s * z - 1.6666654611e-1f;
+    s = s * z * x + x;
+
+    return S(select_f32)(use_cos, c, s);
+}
+
+static inline VF
+S(sin_f32)(VF x, VI *bad)
+{
+    const VF a = S(abs_f32)(x);
+    const VI ok = (VI)(a <= 8192.0f);
+    VF y;
+    VI j;
+
+    *bad = ~ok;
+    y = S(reduce_pio4_f32)(S(select_f32)(ok, a, S(splat_f32)(0)), &j);
+    y = S(sincos_poly_f32)(y, (VI)((j & 2) != 0));
+
+    /* sign(x) ^ (j & 4) */
+    return (VF)((VU)y ^ ((VU)x & 0x80000000U) ^ ((VU)(j & 4) << 29));
+}
+
+static inline VF
+S(cos_f32)(VF x, VI *bad)
+{
+    const VF a = S(abs_f32)(x);
+    const VI ok = (VI)(a <= 8192.0f);
+    VF y;
+    VI j;
+
+    *bad = ~ok;
+    y = S(reduce_pio4_f32)(S(select_f32)(ok, a, S(splat_f32)(0)), &j);
+    y = S(sincos_poly_f32)(y, (VI)((j & 2) == 0));
+
+    return (VF)((VU)y ^ ((VU)((j + 2) & 4) << 29));
+}
+
+static inline VD
+S(exp_f64)(VD x, VL *bad)
+{
+    const VL ok = (VL)(x >= -708.0) & (VL)(x <= 709.0);
+    VD n, r, z, p, q;
+    VL k;
+
+    *bad = ~ok;
+    x = S(select_f64)(ok, x, S(splat_f64)(0));
+
+    n = S(rint_small_f64)(x * 1.4426950408889634073599, &k);
+    r = x - n * 6.93145751953125e-1;
+    r = r - n * 1.42860682030941723212e-6;
+
+    z = r * r;
+    p = S(splat_f64)(1.26177193074810590878e-4);
+    p = p * z + 3.02994407707441961300e-2;
+    p = p * z + 9.99999999999999999910e-1;
+    p = p * r;
+
+    q = S(splat_f64)(3.00198505138664455042e-6);
+    q = q * z + 2.52448340349684104192e-3;
+    q = q * z + 2.27265548208155028766e-1;
+    q = q * z + 2.00000000000000000009e0;
+
+    r = p / (q - p);
+    r = 1.0 + 2.0 * r;
+
+    return r * S(pow2_f64)(k);
+}
+
+static inline VD
+S(log_f64)(VD x, VL *bad)
+{
+    const VL ok = (VL)(x >= 0x1p-1022) & (VL)(x <= 0x1.fffffffffffffp1023);
+    VL e, small;
+    VD m, z, y, p, q, fe;
+
+    *bad = ~ok;
+    x = S(select_f64)(ok, x, S(splat_f64)(1));
+
+    /* x = m * 2**e, 0.5 <= m < 1 */
+    e = (VL)(((VUL)x >> 52) & 0x7ff) - 1022;
+    m = (VD)(((VUL)x & 0x000fffffffffffffULL) | 0x3fe0000000000000ULL);
+
+    small = (VL)(m < 0.70710678118654752440);
+    e = e + small; /* e -= 1 */
+    m = S(select_f64)(small, m + m, m) - 1.0;
+    fe = S(int_to_f64)(e);
+
+    p = S(splat_f64)(1.01875663804580931796e-4);
+    p = p * m + 4.97494994976747001425e-1;
+    p = p * m + 4.70579119878881725854e0;
+    p = p * m + 1.44989225341610930846e1;
+    p = p * m + 1.79368678507819816313e1;
+    p = p * m + 7.70838733755885391666e0;
+
+    q = m + 1.12873587189167450590e1;
+    q = q * m + 4.52279145837532221105e1;
+    q = q * m + 8.29875266912776603211e1;
+    q = q * m + 7.11544750618563894466e1;
+    q = q * m + 2.31251620126765340583e1;
+
+    z = m * m;
+    y = m * (z * p / q);
+    y = y - fe * 2.121944400546905827679e-4;
+    y = y - 0.5 * z;
+    z = m + y;
+    return z + fe * 0.693359375;
+}
+
+/* Reduce x to [-pi/4, pi/4], return the octant in 'j'. */
+static inline VD
+S(reduce_pio4_f64)(VD x, VL *j)
+{
+    VD y;
+    VL k;
+
+    y = x * 1.27323954473516268615;
+    y = S(rint_small_f64)(y, &k);
+    k = k + (VL)(y > x * 1.27323954473516268615); /* floor */
+    k = (k + 1) & ~1;
+    y = S(int_to_f64)(k);
+    *j = k;
+
+    x = x - y * 7.85398125648498535156e-1;
+    x = x - y * 3.77489470793079817668e-8;
+    return x - y * 2.69515142907905952645e-15;
+}
+
+static inline VD
+S(sincos_poly_f64)(VD x, VL use_cos)
+{
+    const VD z = x * x;
+    VD s, c;
+
+    c = S(splat_f64)(-1.13585365213876817300e-11);
+    c = c * z + 2.08757008419747316778e-9;
+    c = c * z - 2.75573141792967388112e-7;
+    c = c * z + 2.48015872888517045348e-5;
+    c = c * z - 1.38888888888730564116e-3;
+    c = c * z + 4.16666666666665929218e-2;
+    c = 1.0 - 0.5 * z + z * z * c;
+
+    s = S(splat_f64)(1.58962301576546568060e-10);
+    s = s * z - 2.50507477628578072866e-8;
+    s = s * z + 2.75573136213857245213e-6;
+    s = s * z - 1.98412698295895385996e-4;
+    s = s * z + 8.33333333332211858878e-3;
+    s = s * z - 1.66666666666666307295e-1;
+    s = x + x * z * s;
+
+    return S(select_f64)(use_cos, c, s);
+}
+
+static inline VD
+S(sin_f64)(VD x, VL *bad)
+{
+    const VD a = S(abs_f64)(x);
+    const VL ok = (VL)(a <= 0x1p19);
+    VD y;
+    VL j;
+
+    *bad = ~ok;
+    y = S(reduce_pio4_f64)(S(select_f64)(ok, a, S(splat_f64)(0)), &j);
+    y = S(sincos_poly_f64)(y, (VL)((j & 2) != 0));
+
+    return (VD)((VUL)y ^ ((VUL)x & 0x8000000000000000ULL) ^ ((VUL)(j & 4) << 61));
+}
+
+static inline VD
+S(cos_f64)(VD x, VL *bad)
+{
+    const VD a = S(abs_f64)(x);
+    const VL ok = (VL)(a <= 0x1p19);
+    VD y;
+    VL j;
+
+    *bad = ~ok;
+    y = S(reduce_pio4_f64)(S(select_f64)(ok, a, S(splat_f64)(0)), &j);
+    y = S(sincos_poly_f64)(y, (VL)((j & 2) == 0));
+
+    return (VD)((VUL)y ^ ((VUL)((j + 2) & 4) << 61));
+}
+
+
+/*****************************************************************************/
+/*                                   Loops                                   */
+/*****************************************************************************/
+
+#define SIMD_LOOP(name, sname, T, VT, VTI, N, type) \
+static void                                                              \
+S(name##_##T##_loop)(type *out, const type *in, int64_t n)               \
+{                                                                        \
+    int64_t i, k;                                                        \
+    VTI bad;                                                             \
+    VT x, y;                                                             \
+                                                                         \
+    for (i = 0; i+N <= n; i += N) {                                      \
+        memcpy(&x, in+i, sizeof x);                                      \
+        y = S(name##_##T)(x, &bad);                                      \
+        memcpy(out+i, &y, sizeof y);                                     \
+        for (k = 0; k < N; k++) {                                        \
+            if (bad[k]) {                                                \
+                out[i+k] = sname(x[k]);                                  \
+            }                                                            \
+        }                                                                \
+    }                                                                    \
+                                                                         \
+    for (; i < n; i++) {                                                 \
+        out[i] = sname(in[i]);                                           \
+    }                                                                    \
+}
+
+#define SIMD_LOOPS(name) \
+    SIMD_LOOP(name, name##f, f32, VF, VI, NF32, float) \
+    SIMD_LOOP(name, name, f64, VD, VL, NF64, double)
+
+SIMD_LOOPS(fabs)
+SIMD_LOOPS(sqrt)
+SIMD_LOOPS(ceil)
+SIMD_LOOPS(floor)
+SIMD_LOOPS(trunc)
+SIMD_LOOPS(exp)
+SIMD_LOOPS(log)
+SIMD_LOOPS(sin)
+SIMD_LOOPS(cos)
+
+static const gm_simd_float32_t S(float32_loops)[GM_VEC_NFUNCS] = {
+  [GM_VEC_fabs] = S(fabs_f32_loop),
+  [GM_VEC_sqrt] = S(sqrt_f32_loop),
+  [GM_VEC_ceil] = S(ceil_f32_loop),
+  [GM_VEC_floor] = S(floor_f32_loop),
+  [GM_VEC_trunc] = S(trunc_f32_loop),
+  [GM_VEC_exp] = S(exp_f32_loop),
+  [GM_VEC_log] = S(log_f32_loop),
+  [GM_VEC_sin] = S(sin_f32_loop),
+  [GM_VEC_cos] = S(cos_f32_loop),
+};
+
+static const gm_simd_float64_t S(float64_loops)[GM_VEC_NFUNCS] = {
+  [GM_VEC_fabs] = S(fabs_f64_loop),
+  [GM_VEC_sqrt] = S(sqrt_f64_loop),
+  [GM_VEC_ceil] = S(ceil_f64_loop),
+  [GM_VEC_floor] = S(floor_f64_loop),
+  [GM_VEC_trunc] = S(trunc_f64_loop),
+  [GM_VEC_exp] = S(exp_f64_loop),
+  [GM_VEC_log] = S(log_f64_loop),
+  [GM_VEC_sin] = S(sin_f64_loop),
+  [GM_VEC_cos] = S(cos_f64_loop),
+};
+
+
+#undef SIMD_LOOPS
+#undef SIMD_LOOP
+#undef SIMD_ROUNDING_FUNCS
+#undef NF64
+#undef NF32
+#undef VUL
+#undef VL
+#undef VD
+#undef VU
+#undef VI
+#undef VF
+#undef S
+#undef SIMD_CAT
+#undef SIMD_CAT2
@@ -33,6 +33,7 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <stdbool.h>
 #include <string.h>
 #include <math.h>
 #include <complex.h>
@@ -40,6 +41,7 @@
 #include "ndtypes.h"
 #include "xnd.h"
 #include "gumath.h"
+#include "simd.h"
 
 
 /****************************************************************************/
@@ -55,15 +57,15 @@ infer_id_return(int *base, const ndt_t *in, ndt_context_t *ctx)
 
     switch (ndt_dtype(in)->tag) {
     case Int8: *base = 0; tag = Int8; break;
-    case Int16: *base = 3; tag = Int16; break;
-    case Int32: *base = 6; tag = Int32; break;
-    case Int64: *base = 9; tag = Int64; break;
-    case Uint8: *base = 12; tag = Uint8; break;
-    case Uint16: *base = 15; tag = Uint16; break;
-    case Uint32: *base = 18; tag = Uint32; break;
-    case Uint64: *base = 21; tag = Uint64; break;
-    case Float32: *base = 24; tag = Float32; break;
-    case Float64: *base = 27; tag = Float64; break;
+    case Int16: *base = 6; tag = Int16; break;
+    case Int32: *base = 12; tag = Int32; break;
+    case Int64: *base = 18; tag = Int64; break;
+    case Uint8: *base = 24; tag = Uint8; break;
+    case Uint16: *base = 30; tag = Uint16; break;
+    case Uint32: *base = 36; tag = Uint32; break;
+    case Uint64: *base = 42; tag = Uint64; break;
+    case Float32: *base = 48; tag = Float32; break;
+    case Float64: *base = 54; tag = Float64; break;
     default:
         ndt_err_format(ctx, NDT_RuntimeError, "invalid dtype");
         return NULL;
@@ -73,6 +75,9 @@ infer_id_return(int *base, const ndt_t *in, ndt_context_t *ctx)
     if (dtype == NULL) {
         return NULL;
     }
+    if (ndt_is_optional(ndt_dtype(in))) {
+        dtype = ndt_option(dtype);
+    }
 
     return ndt_copy_contiguous_dtype(in, dtype, ctx);
 }
@@ -91,13 +96,13 @@ infer_float_return(int *base, const ndt_t *in, ndt_context_t *ctx)
 
     switch (ndt_dtype(in)->tag) {
     case Int8: *base = 0; tag = Float32; break;
-    case Int16: *base = 3; tag = Float32; break;
-    case Uint8: *base = 6; tag = Float32; break;
-    case Uint16: *base = 9; tag = Float32; break;
-    case Float32: *base = 12; tag = Float32; break;
-    case Int32: *base = 15; tag = Float64; break;
-    case Uint32: *base = 18; tag = Float64; break;
-    case Float64: *base = 21; tag = Float64; break;
+    case Int16: *base = 6; tag = Float32; break;
+    case Uint8: *base = 12; tag = Float32; break;
+    case Uint16: *base = 18; tag = Float32; break;
+    case Float32: *base = 24; tag = Float32; break;
+    case Int32: *base = 30; tag = Float64; break;
+    case Uint32: *base = 36; tag = Float64; break;
+    case Float64: *base = 42; tag = Float64; break;
     default:
         ndt_err_format(ctx, NDT_RuntimeError, "invalid dtype");
         return NULL;
@@ -107,6 +112,9 @@ infer_float_return(int *base, const ndt_t *in, ndt_context_t *ctx)
     if (dtype == NULL) {
         return NULL;
     }
+    if (ndt_is_optional(ndt_dtype(in))) {
+        dtype = ndt_option(dtype);
+    }
 
     return ndt_copy_contiguous_dtype(in, dtype, ctx);
 }
@@ -123,6 +131,7 @@ unary_typecheck(ndt_apply_spec_t *spec, const gm_func_t *f,
                 ndt_context_t *ctx)
 {
     const ndt_t *t;
+    bool opt;
     int n;
 
     if (nin != 1) {
@@ -141,23 +150,29 @@ unary_typecheck(ndt_apply_spec_t *spec, const gm_func_t *f,
     spec->nout = 1;
     spec->nbroadcast = 0;
 
+    /* The kernels for optional dtypes follow the regular ones. */
+    opt = ndt_is_optional(ndt_dtype(t));
+
     switch (t->tag) {
     case FixedDim:
         spec->flags = NDT_XND;
+        if (!ndt_subtree_is_optional(t)) {
+            spec->flags |= NDT_STRIDED;
+        }
         if (ndt_is_c_contiguous(t)) {
             spec->flags = NDT_C;
         }
         spec->outer_dims = t->ndim - 1;
-        return &f->kernels[n];
+        return &f->kernels[opt ? n+3 : n];
     case VarDim:
         spec->flags = NDT_C;
         spec->outer_dims = t->ndim;
-        return &f->kernels[n+2];
+        return &f->kernels[opt ? n+5 : n+2];
     default:
         assert(t->ndim == 0);
         spec->flags = NDT_C;
         spec->outer_dims = 0;
-        return &f->kernels[n+1];
+        return &f->kernels[opt ? n+4 : n+1];
     }
 }
 
@@ -192,7 +207,7 @@ apply_index(const xnd_t *x)
 }
 
 
-#define XND_UNARY(func, t0, t1) \
+#define XND_UNARY_0D(func, t0, t1) \
 static int                                                                   \
 gm_##func##_0D_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)                \
 {                                                                            \
@@ -204,8 +219,9 @@ gm_##func##_0D_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)                \
     *(t1##_t *)out->ptr = func(x);                                           \
                                                                              \
     return 0;                                                                \
-}                                                                            \
-                                                                             \
+}
+
+#define XND_UNARY_1D_C(func, t0, t1) \
 static int                                                                   \
 gm_fixed_##func##_1D_C_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)        \
 {                                                                            \
@@ -219,8 +235,32 @@ gm_fixed_##func##_1D_C_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)        \
     }                                                                        \
                                                                              \
     return 0;                                                                \
-}                                                                            \
+}
+
+/* Use the vector loop for 'name' if one is available. */
+#define XND_UNARY_1D_C_VEC(func, name, t) \
+static int                                                                   \
+gm_fixed_##func##_1D_C_##t##_##t(xnd_t stack[], ndt_context_t *ctx)          \
+{                                                                            \
+    const t##_t *in0 = (const t##_t *)apply_index(&stack[0]);                \
+    t##_t *out = (t##_t *)apply_index(&stack[1]);                            \
+    int64_t N = xnd_fixed_shape(&stack[0]);                                  \
+    const gm_simd_##t##_t f = gm_simd_##t(GM_VEC_##name);                    \
+    (void)ctx;                                                               \
+                                                                             \
+    if (f != NULL) {                                                         \
+        f(out, in0, N);                                                      \
+        return 0;                                                            \
+    }                                                                        \
                                                                              \
+    for (int64_t i = 0; i < N; i++) {                                        \
+        out[i] = func(in0[i]);                                               \
+    }                                                                        \
+                                                                             \
+    return 0;                                                                \
+}
+
+#define XND_UNARY_1D(func, t0, t1) \
 static int                                                                   \
 gm_fixed_##func##_1D_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)          \
 {                                                                            \
@@ -239,19 +279,137 @@ gm_fixed_##func##_1D_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)          \
     return 0;                                                                \
 }
 
+#define XND_UNARY_1D_S(func, t0, t1) \
+static int                                                                   \
+gm_fixed_##func##_1D_S_##t0##_##t1(char **args, intptr_t *dimensions,        \
+                                   intptr_t *steps, void *data)              \
+{                                                                            \
+    const char *in0 = args[0];                                               \
+    char *out = args[1];                                                     \
+    const intptr_t N = dimensions[0];                                        \
+    const intptr_t s0 = steps[0];                                            \
+    const intptr_t s1 = steps[1];                                            \
+    (void)data;                                                              \
+                                                                             \
+    for (intptr_t i = 0; i < N; i++) {                                       \
+        const t0##_t x = *(const t0##_t *)in0;                               \
+        *(t1##_t *)out = func(x);                                            \
+        in0 += s0;                                                           \
+        out += s1;                                                           \
+    }                                                                        \
+                                                                             \
+    return 0;                                                                \
+}
+
+/*
+ * Kernels for optional dtypes.  The contiguous kernel runs the regular loop
+ * over all values, including the ones that are missing, and copies the
+ * validity bits of the input in 64-bit words.
+ */
+#define XND_UNARY_0D_OPT(func, t0, t1) \
+static int                                                                   \
+gm_##func##_0D_opt_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)            \
+{                                                                            \
+    const xnd_t *in0 = &stack[0];                                            \
+    xnd_t *out = &stack[1];                                                  \
+    (void)ctx;                                                               \
+                                                                             \
+    if (xnd_is_na(in0)) {                                                    \
+        xnd_set_na(out);                                                     \
+        return 0;                                                            \
+    }                                                                        \
+                                                                             \
+    const t0##_t x = *(const t0##_t *)in0->ptr;                              \
+    *(t1##_t *)out->ptr = func(x);                                           \
+    xnd_set_valid(out);                                                      \
+                                                                             \
+    return 0;                                                                \
+}
+
+#define XND_UNARY_1D_C_OPT(func, t0, t1) \
+static int                                                                   \
+gm_fixed_##func##_1D_C_opt_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)    \
+{                                                                            \
+    const xnd_t *in0 = &stack[0];                                            \
+    xnd_t *out = &stack[1];                                                  \
+    int64_t N = xnd_fixed_shape(in0);                                        \
+                                                                             \
+    xnd_bitmap_and(out->bitmap.data, out->index,                             \
+                   in0->bitmap.data, in0->index, NULL, 0, N);                \
+                                                                             \
+    return gm_fixed_##func##_1D_C_##t0##_##t1(stack, ctx);                   \
+}
+
+#define XND_UNARY_1D_OPT(func, t0, t1) \
+static int                                                                   \
+gm_fixed_##func##_1D_opt_##t0##_##t1(xnd_t stack[], ndt_context_t *ctx)      \
+{                                                                            \
+    const xnd_t *in0 = &stack[0];                                            \
+    xnd_t *out = &stack[1];                                                  \
+    int64_t N = xnd_fixed_shape(in0);                                        \
+    (void)ctx;                                                               \
+                                                                             \
+    for (int64_t i = 0; i < N; i++) {                                        \
+        const xnd_t v = xnd_fixed_dim_next(in0, i);                          \
+        xnd_t u = xnd_fixed_dim_next(out, i);                                \
+        if (xnd_is_na(&v)) {                                                 \
+            xnd_set_na(&u);                                                  \
+            continue;                                                        \
+        }                                                                    \
+        const t0##_t x = *(const t0##_t *)v.ptr;                             \
+        *(t1##_t *)u.ptr = func(x);                                          \
+        xnd_set_valid(&u);                                                   \
+    }                                                                        \
+                                                                             \
+    return 0;                                                                \
+}
+
+#define XND_UNARY(func, t0, t1) \
+    XND_UNARY_0D(func, t0, t1)       \
+    XND_UNARY_1D_C(func, t0, t1)     \
+    XND_UNARY_1D_S(func, t0, t1)     \
+    XND_UNARY_1D(func, t0, t1)       \
+    XND_UNARY_0D_OPT(func, t0, t1)   \
+    XND_UNARY_1D_C_OPT(func, t0, t1) \
+    XND_UNARY_1D_OPT(func, t0, t1)
+
+#define XND_UNARY_VEC(func, name, t) \
+    XND_UNARY_0D(func, t, t)             \
+    XND_UNARY_1D_C_VEC(func, name, t)    \
+    XND_UNARY_1D_S(func, t, t)           \
+    XND_UNARY_1D(func, t, t)             \
+    XND_UNARY_0D_OPT(func, t, t)         \
+    XND_UNARY_1D_C_OPT(func, t, t)       \
+    XND_UNARY_1D_OPT(func, t, t)
+
 #define XND_UNARY_INIT(funcname, func, t0, t1) \
-  { .name = STRINGIZE(funcname),                                      \
-    .sig = "... * N * " STRINGIZE(t0) " -> ... * N * " STRINGIZE(t1), \
-    .C = gm_fixed_##func##_1D_C_##t0##_##t1,                          \
-    .Xnd = gm_fixed_##func##_1D_##t0##_##t1 },                        \
-                                                                      \
-  { .name = STRINGIZE(funcname),                                      \
-    .sig = "... * " STRINGIZE(t0) " -> ... * " STRINGIZE(t1),         \
-    .C = gm_##func##_0D_##t0##_##t1 },                                \
-                                                                      \
-  { .name = STRINGIZE(funcname),                                      \
-    .sig = "var... * " STRINGIZE(t0) " -> var... * " STRINGIZE(t1),   \
-    .C = gm_##func##_0D_##t0##_##t1 }
+  { .name = STRINGIZE(funcname),                                        \
+    .sig = "... * N * " STRINGIZE(t0) " -> ... * N * " STRINGIZE(t1),   \
+    .C = gm_fixed_##func##_1D_C_##t0##_##t1,                            \
+    .Strided = gm_fixed_##func##_1D_S_##t0##_##t1,                      \
+    .Xnd = gm_fixed_##func##_1D_##t0##_##t1 },                          \
+                                                                        \
+  { .name = STRINGIZE(funcname),                                        \
+    .sig = "... * " STRINGIZE(t0) " -> ... * " STRINGIZE(t1),           \
+    .C = gm_##func##_0D_##t0##_##t1 },                                  \
+                                                                        \
+  { .name = STRINGIZE(funcname),                                        \
+    .sig = "var... * " STRINGIZE(t0) " -> var... * " STRINGIZE(t1),     \
+    .C = gm_##func##_0D_##t0##_##t1,                                    \
+    .Strided = gm_fixed_##func##_1D_S_##t0##_##t1 },                    \
+                                                                        \
+  { .name = STRINGIZE(funcname),                                        \
+    .sig = "... * N * ?" STRINGIZE(t0) " -> ... * N * ?" STRINGIZE(t1), \
+    .C = gm_fixed_##func##_1D_C_opt_##t0##_##t1,                        \
+    .Xnd = gm_fixed_##func##_1D_opt_##t0##_##t1 },                      \
+                                                                        \
+  { .name = STRINGIZE(funcname),                                        \
+    .sig = "... * ?" STRINGIZE(t0) " -> ... * ?" STRINGIZE(t1),         \
+    .C = gm_##func##_0D_opt_##t0##_##t1 },                              \
+                                                                        \
+  { .name = STRINGIZE(funcname),                                        \
+    .sig = "var... * ?" STRINGIZE(t0) " -> var... * ?" STRINGIZE(t1),   \
+    .C = gm_##func##_0D_opt_##t0##_##t1 }
 
 
 /*****************************************************************************/
@@ -302,14 +460,25 @@ static const gm_kernel_init_t unary_id[] = {
     XND_UNARY(name, uint32, float64)     \
     XND_UNARY(name, float64, float64)
 
+/* Same as above, with vector loops for float32 and float64. */
+#define XND_ALL_UNARY_FLOAT_VEC(name) \
+    XND_UNARY(name##f, int8, float32)        \
+    XND_UNARY(name##f, int16, float32)       \
+    XND_UNARY(name##f, uint8, float32)       \
+    XND_UNARY(name##f, uint16, float32)      \
+    XND_UNARY_VEC(name##f, name, float32)    \
+    XND_UNARY(name, int32, float64)          \
+    XND_UNARY(name, uint32, float64)         \
+    XND_UNARY_VEC(name, name, float64)
+
 #define XND_ALL_UNARY_FLOAT_INIT(name) \
     XND_UNARY_INIT(name, name##f, int8, float32),    \
     XND_UNARY_INIT(name, name##f, int16, float32),   \
     XND_UNARY_INIT(name, name##f, uint8, float32),   \
     XND_UNARY_INIT(name, name##f, uint16, float32),  \
     XND_UNARY_INIT(name, name##f, float32, float32), \
-    XND_UNARY_INIT(name, name, uint32, float64),     \
     XND_UNARY_INIT(name, name, int32, float64),      \
+    XND_UNARY_INIT(name, name, uint32, float64),     \
     XND_UNARY_INIT(name, name, float64, float64)
 
 
@@ -317,14 +486,14 @@ static const gm_kernel_init_t unary_id[] = {
 /*                                Abs functions                              */
 /*****************************************************************************/
 
-XND_ALL_UNARY_FLOAT(fabs)
+XND_ALL_UNARY_FLOAT_VEC(fabs)
 
 
 /*****************************************************************************/
 /*                             Exponential functions                         */
 /*****************************************************************************/
 
-XND_ALL_UNARY_FLOAT(exp)
+XND_ALL_UNARY_FLOAT_VEC(exp)
 XND_ALL_UNARY_FLOAT(exp2)
 XND_ALL_UNARY_FLOAT(expm1)
 
@@ -333,7 +502,7 @@ XND_ALL_UNARY_FLOAT(expm1)
 /*                              Logarithm functions                          */
 /*****************************************************************************/
 
-XND_ALL_UNARY_FLOAT(log)
+XND_ALL_UNARY_FLOAT_VEC(log)
 XND_ALL_UNARY_FLOAT(log2)
 XND_ALL_UNARY_FLOAT(log10)
 XND_ALL_UNARY_FLOAT(log1p)
@@ -344,7 +513,7 @@ XND_ALL_UNARY_FLOAT(logb)
 /*                              Power functions                              */
 /*****************************************************************************/
 
-XND_ALL_UNARY_FLOAT(sqrt)
+XND_ALL_UNARY_FLOAT_VEC(sqrt)
 XND_ALL_UNARY_FLOAT(cbrt)
 
 
@@ -352,8 +521,8 @@ XND_ALL_UNARY_FLOAT(cbrt)
 /*                           Trigonometric functions                         */
 /*****************************************************************************/
 
-XND_ALL_UNARY_FLOAT(sin)
-XND_ALL_UNARY_FLOAT(cos)
+XND_ALL_UNARY_FLOAT_VEC(sin)
+XND_ALL_UNARY_FLOAT_VEC(cos)
 XND_ALL_UNARY_FLOAT(tan)
 XND_ALL_UNARY_FLOAT(asin)
 XND_ALL_UNARY_FLOAT(acos)
@@ -386,9 +555,9 @@ XND_ALL_UNARY_FLOAT(tgamma)
 /*                              Ceiling, floor, trunc                        */
 /*****************************************************************************/
 
-XND_ALL_UNARY_FLOAT(ceil)
-XND_ALL_UNARY_FLOAT(floor)
-XND_ALL_UNARY_FLOAT(trunc)
+XND_ALL_UNARY_FLOAT_VEC(ceil)
+XND_ALL_UNARY_FLOAT_VEC(floor)
+XND_ALL_UNARY_FLOAT_VEC(trunc)
 XND_ALL_UNARY_FLOAT(round)
 XND_ALL_UNARY_FLOAT(nearbyint)
 
@@ -109,14 +109,33 @@ gm_as_ndarray(gm_ndarray_t *a, const xnd_t *x, ndt_context_t *ctx)
 }
 
 /*
- * Convert an xnd container into the {args, dimensions, strides} representation.
+ * Broadcast 'a' to the shape of 'target'.  Missing dimensions and
+ * dimensions of size 1 get a zero stride.
  */
-int
-gm_np_convert_xnd(char **args, const int nargs,
-                  intptr_t *dimensions, const int dims_size,
-                  intptr_t *steps, const int steps_size,
-                  xnd_t stack[], const int outer_dims,
-                  ndt_context_t *ctx)
+static void
+gm_broadcast_ndarray(gm_ndarray_t *a, const gm_ndarray_t *target)
+{
+    int i, k;
+
+    for (i=target->ndim-1, k=a->ndim-1; i >= 0; i--, k--) {
+        if (k >= 0 && a->shape[k] == target->shape[i]) {
+            a->strides[i] = a->strides[k];
+        }
+        else {
+            a->strides[i] = 0;
+        }
+        a->shape[i] = target->shape[i];
+    }
+
+    a->ndim = target->ndim;
+}
+
+static int
+convert_xnd(char **args, const int nargs,
+            intptr_t *dimensions, const int dims_size,
+            intptr_t *steps, const int steps_size,
+            xnd_t stack[], const int outer_dims,
+            bool broadcast, ndt_context_t *ctx)
 {
     ALLOCA(gm_ndarray_t, nd, nargs);
     int64_t shape;
@@ -134,6 +153,12 @@ gm_np_convert_xnd(char **args, const int nargs,
         args[i] = nd[i].ptr;
     }
 
+    if (broadcast) {
+        for (i = 0; i < nargs-1; i++) {
+            gm_broadcast_ndarray(&nd[i], &nd[nargs-1]);
+        }
+    }
+
     for (i = 0; i < outer_dims; i++) {
         shape = nd[0].shape[i];
         ASSIGN_OVERFLOW(dimensions, n, dims_size, shape, INTPTR_MAX, ctx);
@@ -159,6 +184,36 @@ gm_np_convert_xnd(char **args, const int nargs,
     return 0;
 }
 
+/*
+ * Convert an xnd container into the {args, dimensions, strides} representation.
+ */
+int
+gm_np_convert_xnd(char **args, const int nargs,
+                  intptr_t *dimensions, const int dims_size,
+                  intptr_t *steps, const int steps_size,
+                  xnd_t stack[], const int outer_dims,
+                  ndt_context_t *ctx)
+{
+    return convert_xnd(args, nargs, dimensions, dims_size, steps, steps_size,
+                       stack, outer_dims, false, ctx);
+}
+
+/*
+ * Same as gm_np_convert_xnd(), but all arguments are broadcast to the shape
+ * of the last argument by using zero steps.  The broadcast types are never
+ * created.
+ */
+int
+gm_np_convert_xnd_broadcast(char **args, const int nargs,
+                            intptr_t *dimensions, const int dims_size,
+                            intptr_t *steps, const int steps_size,
+                            xnd_t stack[], const int outer_dims,
+                            ndt_context_t *ctx)
+{
+    return convert_xnd(args, nargs, dimensions, dims_size, steps, steps_size,
+                       stack, outer_dims, true, ctx);
+}
+
 /*
  * Flatten an xnd container into a 1D representation for direct elementwise
  * kernel application.  A scalar is expanded into a 1D array of size 1.
@@ -185,6 +240,12 @@ gm_np_flatten(char **args, const int nargs,
     return 0;
 }
 
+/*
+ * Apply a strided kernel to all outer dimensions.  The kernel receives the
+ * inner dimensions and steps of all arguments, so for an elementwise kernel
+ * 'dimensions[0]' is the loop count and 'steps[0]' ... 'steps[nargs-1]' are
+ * the per-argument steps in bytes.
+ */
 int
 gm_np_map(const gm_strided_kernel_t f,
           char **args, int nargs,
@@ -197,7 +258,7 @@ gm_np_map(const gm_strided_kernel_t f,
     intptr_t shape, i;
     int ret, k;
 
-    if (outer_dims <= 1) {
+    if (outer_dims == 0) {
         return f(args, dimensions, steps, data);
     }
 
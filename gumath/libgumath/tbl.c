@@ -215,9 +215,17 @@ gm_init(void)
 
     if (!initialized) {
         init_charmap();
+        /* Detect the SIMD level before kernels run concurrently. */
+        (void)gm_get_max_simd_level();
     }
     else {
         fprintf(stderr, "gm_init: warning: ignoring attempt to initialize "
                         "libgumath a second time\n");
     }
 }
+
+void
+gm_finalize(void)
+{
+    gm_thread_pool_clear();
+}
@@ -0,0 +1,411 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <stdbool.h>
+#include "ndtypes.h"
+#include "gumath.h"
+
+#ifndef _MSC_VER
+  #include <pthread.h>
+#endif
+
+
+/*
+ * Persistent worker pool for running independent tasks in parallel.
+ *
+ * Workers are started lazily on the first parallel call and are kept alive
+ * until the thread count changes or gm_finalize() is called.  The calling
+ * thread always participates in the work.  Only one job can run at a time;
+ * if the pool is busy (e.g. a kernel itself calls gm_apply()), the tasks
+ * are executed serially on the calling thread.
+ */
+
+
+/* Default minimum number of elements per thread. */
+#define GM_DEFAULT_MIN_WORK 65536
+
+
+#ifndef _MSC_VER
+typedef struct {
+    gm_task_t f;
+    void *arg;
+    int64_t ntasks;
+    int64_t next;   /* next task to be started */
+    int64_t done;   /* number of finished tasks */
+    ndt_context_t ctx;
+} gm_job_t;
+
+static struct {
+    pthread_mutex_t lock;
+    pthread_cond_t start;
+    pthread_cond_t finish;
+    int64_t max_threads;
+    int64_t min_work;
+    pthread_t *threads;
+    int64_t nworkers;
+    gm_job_t *job;
+    uint64_t generation;
+    bool shutdown;
+} pool = {
+    PTHREAD_MUTEX_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    PTHREAD_COND_INITIALIZER,
+    1,
+    GM_DEFAULT_MIN_WORK,
+    NULL,
+    0,
+    NULL,
+    0,
+    false
+};
+
+
+/* Run tasks of the current job until none are left.  Called with the lock held. */
+static void
+run_tasks(gm_job_t *job)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    int64_t i;
+    int ret;
+
+    while (job->next < job->ntasks) {
+        i = job->next++;
+
+        pthread_mutex_unlock(&pool.lock);
+        ret = job->f(job->arg, i, &ctx);
+        pthread_mutex_lock(&pool.lock);
+
+        if (ret < 0) {
+            if (!ndt_err_occurred(&job->ctx)) {
+                ndt_err_format(&job->ctx, ctx.err, "%s", ndt_context_msg(&ctx));
+            }
+            ndt_err_clear(&ctx);
+        }
+
+        if (++job->done == job->ntasks) {
+            pthread_cond_broadcast(&pool.finish);
+        }
+    }
+}
+
+static void *
+worker(void *arg)
+{
+    uint64_t seen = 0;
+    (void)arg;
+
+    pthread_mutex_lock(&pool.lock);
+
+    while (1) {
+        while (!pool.shutdown &&
+               (pool.job == NULL || pool.generation == seen)) {
+            pthread_cond_wait(&pool.start, &pool.lock);
+        }
+
+        if (pool.shutdown) {
+            break;
+        }
+
+        seen = pool.generation;
+        run_tasks(pool.job);
+    }
+
+    pthread_mutex_unlock(&pool.lock);
+    return NULL;
+}
+
+/* Stop and join all workers.  Called with the lock held, no job is running. */
+static void
+stop_workers(void)
+{
+    pthread_t *threads = pool.threads;
+    int64_t nworkers = pool.nworkers;
+    int64_t i;
+
+    pool.shutdown = true;
+    pthread_cond_broadcast(&pool.start);
+
+    /* Jobs started in the meantime are executed serially. */
+    pool.threads = NULL;
+    pool.nworkers = 0;
+
+    pthread_mutex_unlock(&pool.lock);
+    for (i = 0; i < nworkers; i++) {
+        pthread_join(threads[i], NULL);
+    }
+    ndt_free(threads);
+    pthread_mutex_lock(&pool.lock);
+
+    pool.shutdown = false;
+}
+
+/* Start workers until there are n.  Called with the lock held. */
+static void
+start_workers(int64_t n)
+{
+    if (pool.threads == NULL) {
+        pool.threads = ndt_alloc(pool.max_threads, sizeof *pool.threads);
+        if (pool.threads == NULL) {
+            return;
+        }
+    }
+
+    while (pool.nworkers < n) {
+        if (pthread_create(&pool.threads[pool.nworkers], NULL, worker, NULL) != 0) {
+            return;
+        }
+        pool.nworkers++;
+    }
+}
+#endif
+
+
+/******************************************************************************/
+/*                              Configuration                                 */
+/******************************************************************************/
+
+#ifndef _MSC_VER
+int
+gm_set_max_threads(int64_t n, ndt_context_t *ctx)
+{
+    if (n < 1) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "number of threads must be greater than zero");
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+
+    while (pool.job != NULL) {
+        pthread_cond_wait(&pool.finish, &pool.lock);
+    }
+
+    if (n != pool.max_threads) {
+        if (pool.threads != NULL) {
+            stop_workers();
+        }
+        pool.max_threads = n;
+    }
+
+    pthread_mutex_unlock(&pool.lock);
+
+    return 0;
+}
+
+int64_t
+gm_get_max_threads(void)
+{
+    int64_t n;
+
+    pthread_mutex_lock(&pool.lock);
+    n = pool.max_threads;
+    pthread_mutex_unlock(&pool.lock);
+
+    return n;
+}
+
+int
+gm_set_min_work(int64_t n, ndt_context_t *ctx)
+{
+    if (n < 1) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "minimum work per thread must be greater than zero");
+        return -1;
+    }
+
+    pthread_mutex_lock(&pool.lock);
+    pool.min_work = n;
+    pthread_mutex_unlock(&pool.lock);
+
+    return 0;
+}
+
+int64_t
+gm_get_min_work(void)
+{
+    int64_t n;
+
+    pthread_mutex_lock(&pool.lock);
+    n = pool.min_work;
+    pthread_mutex_unlock(&pool.lock);
+
+    return n;
+}
+#else
+/* Serial fallback: the settings are recorded but tasks run on the caller. */
+static int64_t max_threads = 1;
+static int64_t min_work = GM_DEFAULT_MIN_WORK;
+
+int
+gm_set_max_threads(int64_t n, ndt_context_t *ctx)
+{
+    if (n < 1) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "number of threads must be greater than zero");
+        return -1;
+    }
+
+    max_threads = n;
+    return 0;
+}
+
+int64_t
+gm_get_max_threads(void)
+{
+    return max_threads;
+}
+
+int
+gm_set_min_work(int64_t n, ndt_context_t *ctx)
+{
+    if (n < 1) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "minimum work per thread must be greater than zero");
+        return -1;
+    }
+
+    min_work = n;
+    return 0;
+}
+
+int64_t
+gm_get_min_work(void)
+{
+    return min_work;
+}
+#endif
+
+
+/******************************************************************************/
+/*                               Run tasks                                    */
+/******************************************************************************/
+
+static int
+run_serial(gm_task_t f, void *arg, int64_t ntasks, ndt_context_t *ctx)
+{
+    int64_t i;
+
+    for (i = 0; i < ntasks; i++) {
+        if (f(arg, i, ctx) < 0) {
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+/*
+ * Execute f(arg, i, ctx) for all i in [0, ntasks).  The tasks must be
+ * independent.  On failure, return -1 and set the first error that occurred.
+ */
+int
+gm_run_tasks(gm_task_t f, void *arg, int64_t ntasks, ndt_context_t *ctx)
+{
+#ifndef _MSC_VER
+    gm_job_t job;
+    int64_t nworkers;
+
+    if (ntasks <= 1) {
+        return run_serial(f, arg, ntasks, ctx);
+    }
+
+    pthread_mutex_lock(&pool.lock);
+
+    if (pool.job != NULL || pool.shutdown || pool.max_threads <= 1) {
+        pthread_mutex_unlock(&pool.lock);
+        return run_serial(f, arg, ntasks, ctx);
+    }
+
+    nworkers = ntasks < pool.max_threads ? ntasks-1 : pool.max_threads-1;
+    start_workers(nworkers);
+    if (pool.nworkers == 0) {
+        pthread_mutex_unlock(&pool.lock);
+        return run_serial(f, arg, ntasks, ctx);
+    }
+
+    job.f = f;
+    job.arg = arg;
+    job.ntasks = ntasks;
+    job.next = 0;
+    job.done = 0;
+    job.ctx.flags = 0;
+    job.ctx.err = NDT_Success;
+    job.ctx.msg = ConstMsg;
+    job.ctx.ConstMsg = "Success";
+
+    pool.job = &job;
+    pool.generation++;
+    pthread_cond_broadcast(&pool.start);
+
+    run_tasks(&job);
+    while (job.done < job.ntasks) {
+        pthread_cond_wait(&pool.finish, &pool.lock);
+    }
+
+    pool.job = NULL;
+    pthread_cond_broadcast(&pool.finish);
+    pthread_mutex_unlock(&pool.lock);
+
+    if (ndt_err_occurred(&job.ctx)) {
+        ndt_err_format(ctx, job.ctx.err, "%s", ndt_context_msg(&job.ctx));
+        ndt_err_clear(&job.ctx);
+        return -1;
+    }
+
+    return 0;
+#else
+    return run_serial(f, arg, ntasks, ctx);
+#endif
+}
+
+/* Stop all workers.  Subsequent parallel calls restart the pool. */
+void
+gm_thread_pool_clear(void)
+{
+#ifndef _MSC_VER
+    pthread_mutex_lock(&pool.lock);
+
+    while (pool.job != NULL) {
+        pthread_cond_wait(&pool.finish, &pool.lock);
+    }
+
+    if (pool.threads != NULL) {
+        stop_workers();
+    }
+
+    pthread_mutex_unlock(&pool.lock);
+#endif
+}
@@ -57,6 +57,9 @@ static gm_tbl_t *table = NULL;
 /* Xnd type */
 static PyTypeObject *xnd = NULL;
 
+/* Number of gufunc calls that have released the GIL */
+static Py_ssize_t running_calls = 0;
+
 
 /****************************************************************************/
 /*                               Error handling                             */
@@ -108,6 +111,73 @@ gufunc_dealloc(GufuncObject *self)
 /*                              Function calls                              */
 /****************************************************************************/
 
+/*
+ * Kernel selection and execution release the GIL if types can be shared
+ * between threads.  The arguments are pinned for the duration of the call:
+ * inputs can be read by other calls but not written, outputs are exclusive
+ * to the call.  Outputs allocated by the call are not visible to other
+ * threads until the call returns.
+ */
+#if NDT_THREAD_SAFE
+  #define GM_BEGIN_ALLOW_THREADS Py_BEGIN_ALLOW_THREADS
+  #define GM_END_ALLOW_THREADS Py_END_ALLOW_THREADS
+#else
+  #define GM_BEGIN_ALLOW_THREADS {
+  #define GM_END_ALLOW_THREADS }
+#endif
+
+static int
+pin_args(PyObject **a, Py_ssize_t nin, PyObject *out)
+{
+    Py_ssize_t i;
+
+    /* Check everything first: an argument may be both an input and an output. */
+    for (i = 0; i < nin; i++) {
+        if (Xnd_CheckPin(a[i], 0) < 0) {
+            return -1;
+        }
+    }
+
+    if (out != NULL) {
+        for (i = 0; i < PyTuple_GET_SIZE(out); i++) {
+            if (Xnd_CheckPin(PyTuple_GET_ITEM(out, i), 1) < 0) {
+                return -1;
+            }
+        }
+    }
+
+    for (i = 0; i < nin; i++) {
+        Xnd_Pin(a[i], 0);
+    }
+
+    if (out != NULL) {
+        for (i = 0; i < PyTuple_GET_SIZE(out); i++) {
+            Xnd_Pin(PyTuple_GET_ITEM(out, i), 1);
+        }
+    }
+
+    running_calls++;
+    return 0;
+}
+
+static void
+unpin_args(PyObject **a, Py_ssize_t nin, PyObject *out)
+{
+    Py_ssize_t i;
+
+    for (i = 0; i < nin; i++) {
+        Xnd_Unpin(a[i], 0);
+    }
+
+    if (out != NULL) {
+        for (i = 0; i < PyTuple_GET_SIZE(out); i++) {
+            Xnd_Unpin(PyTuple_GET_ITEM(out, i), 1);
+        }
+    }
+
+    running_calls--;
+}
+
 static void
 clear_objects(PyObject **a, Py_ssize_t len)
 {
@@ -118,6 +188,95 @@ clear_objects(PyObject **a, Py_ssize_t len)
     }
 }
 
+/*
+ * Convert the 'out' keyword argument to a tuple of writable xnd objects.
+ * Return a new reference or NULL with an exception set.
+ */
+static PyObject *
+out_tuple(PyObject *kwds)
+{
+    PyObject *out;
+    Py_ssize_t i;
+
+    if (PyDict_Size(kwds) != 1 ||
+        (out = PyDict_GetItemString(kwds, "out")) == NULL) {
+        PyErr_SetString(PyExc_TypeError,
+            "gufunc calls only support the 'out' keyword");
+        return NULL;
+    }
+
+    if (PyTuple_Check(out)) {
+        Py_INCREF(out);
+    }
+    else {
+        out = PyTuple_Pack(1, out);
+        if (out == NULL) {
+            return NULL;
+        }
+    }
+
+    for (i = 0; i < PyTuple_GET_SIZE(out); i++) {
+        PyObject *x = PyTuple_GET_ITEM(out, i);
+        if (!Xnd_Check(x)) {
+            PyErr_SetString(PyExc_TypeError, "'out' arguments must be xnd");
+            Py_DECREF(out);
+            return NULL;
+        }
+        if (Xnd_IsReadonly(x)) {
+            PyErr_SetString(PyExc_TypeError, "'out' arguments must be writable");
+            Py_DECREF(out);
+            return NULL;
+        }
+    }
+
+    return out;
+}
+
+/* Apply the kernel to caller supplied outputs and return the outputs. */
+static PyObject *
+gufunc_call_out(const gm_kernel_t *kernel, ndt_apply_spec_t *spec,
+                xnd_t stack[], int nin, PyObject *out)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    PyObject *x;
+    int i, ret;
+
+    if (PyTuple_GET_SIZE(out) != spec->nout) {
+        PyErr_Format(PyExc_TypeError,
+            "expected %d 'out' arguments, got %zd",
+            spec->nout, PyTuple_GET_SIZE(out));
+        ndt_apply_spec_clear(spec);
+        return NULL;
+    }
+
+    if (spec->nbroadcast > 0) {
+        for (i = 0; i < nin; i++) {
+            stack[i].type = spec->broadcast[i];
+        }
+    }
+
+    for (i = 0; i < spec->nout; i++) {
+        stack[nin+i] = *CONST_XND(PyTuple_GET_ITEM(out, i));
+    }
+
+    GM_BEGIN_ALLOW_THREADS
+    ret = gm_apply_out(kernel, stack, nin, spec, &ctx);
+    ndt_apply_spec_clear(spec);
+    GM_END_ALLOW_THREADS
+    if (ret < 0) {
+        return seterr(&ctx);
+    }
+
+    if (PyTuple_GET_SIZE(out) == 1) {
+        x = PyTuple_GET_ITEM(out, 0);
+        Py_INCREF(x);
+        return x;
+    }
+
+    Py_INCREF(out);
+    return out;
+}
+
 static PyObject *
 gufunc_call(GufuncObject *self, PyObject *args, PyObject *kwds)
 {
@@ -129,13 +288,8 @@ gufunc_call(GufuncObject *self, PyObject *args, PyObject *kwds)
     const ndt_t *in_types[NDT_MAX_ARGS];
     xnd_t stack[NDT_MAX_ARGS];
     gm_kernel_t kernel;
-    int i, k;
-
-    if (kwds && PyDict_Size(kwds) > 0) {
-        PyErr_SetString(PyExc_TypeError,
-            "gufunc calls do not support keywords");
-        return NULL;
-    }
+    PyObject *out = NULL;
+    int i, k, ret;
 
     if (nin > NDT_MAX_ARGS) {
         PyErr_SetString(PyExc_TypeError,
@@ -152,11 +306,35 @@ gufunc_call(GufuncObject *self, PyObject *args, PyObject *kwds)
         in_types[i] = stack[i].type;
     }
 
+    if (kwds && PyDict_Size(kwds) > 0) {
+        out = out_tuple(kwds);
+        if (out == NULL) {
+            return NULL;
+        }
+    }
+
+    if (pin_args(a, nin, out) < 0) {
+        Py_XDECREF(out);
+        return NULL;
+    }
+
+    GM_BEGIN_ALLOW_THREADS
     kernel = gm_select(&spec, self->tbl, self->name, in_types, (int)nin, stack, &ctx);
+    GM_END_ALLOW_THREADS
+
     if (kernel.set == NULL) {
+        unpin_args(a, nin, out);
+        Py_XDECREF(out);
         return seterr(&ctx);
     }
 
+    if (out != NULL) {
+        PyObject *res = gufunc_call_out(&kernel, &spec, stack, (int)nin, out);
+        unpin_args(a, nin, out);
+        Py_DECREF(out);
+        return res;
+    }
+
     if (spec.nbroadcast > 0) {
         for (i = 0; i < nin; i++) {
             stack[i].type = spec.broadcast[i];
@@ -167,6 +345,7 @@ gufunc_call(GufuncObject *self, PyObject *args, PyObject *kwds)
         if (ndt_is_concrete(spec.out[i])) {
             PyObject *x = Xnd_EmptyFromType(xnd, spec.out[i]);
             if (x == NULL) {
+                unpin_args(a, nin, NULL);
                 clear_objects(result, i);
                 ndt_apply_spec_clear(&spec);
                 return NULL;
@@ -180,7 +359,13 @@ gufunc_call(GufuncObject *self, PyObject *args, PyObject *kwds)
          }
     }
 
-    if (gm_apply(&kernel, stack, spec.outer_dims, &ctx) < 0) {
+    GM_BEGIN_ALLOW_THREADS
+    ret = gm_apply(&kernel, stack, spec.outer_dims, &ctx);
+    GM_END_ALLOW_THREADS
+
+    unpin_args(a, nin, NULL);
+
+    if (ret < 0) {
         clear_objects(result, spec.nout);
         return seterr(&ctx);
     }
@@ -353,6 +538,13 @@ unsafe_add_kernel(PyObject *m GM_UNUSED, PyObject *args, PyObject *kwds)
         return NULL;
     }
 
+    /* The function table must not change while calls are running. */
+    if (running_calls > 0) {
+        PyErr_SetString(PyExc_RuntimeError,
+            "cannot add kernels while gufunc calls are running");
+        return NULL;
+    }
+
     p = PyLong_AsVoidPtr(ptr);
     if (p == NULL) {
         return NULL;
@@ -391,10 +583,121 @@ unsafe_add_kernel(PyObject *m GM_UNUSED, PyObject *args, PyObject *kwds)
     return gufunc_new(table, f->name);
 }
 
+static PyObject *
+set_max_threads(PyObject *m GM_UNUSED, PyObject *obj)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    int64_t n;
+
+    n = PyLong_AsLongLong(obj);
+    if (n == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (gm_set_max_threads(n, &ctx) < 0) {
+        return seterr(&ctx);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+get_max_threads(PyObject *m GM_UNUSED, PyObject *args GM_UNUSED)
+{
+    return PyLong_FromLongLong(gm_get_max_threads());
+}
+
+static PyObject *
+set_min_work(PyObject *m GM_UNUSED, PyObject *obj)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    int64_t n;
+
+    n = PyLong_AsLongLong(obj);
+    if (n == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (gm_set_min_work(n, &ctx) < 0) {
+        return seterr(&ctx);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+get_min_work(PyObject *m GM_UNUSED, PyObject *args GM_UNUSED)
+{
+    return PyLong_FromLongLong(gm_get_min_work());
+}
+
+static PyObject *
+set_simd_level(PyObject *m GM_UNUSED, PyObject *obj)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    long n;
+
+    n = PyLong_AsLong(obj);
+    if (n == -1 && PyErr_Occurred()) {
+        return NULL;
+    }
+
+    if (n < INT_MIN || n > INT_MAX) {
+        PyErr_SetString(PyExc_ValueError, "SIMD level out of range");
+        return NULL;
+    }
+
+    if (gm_set_simd_level((int)n, &ctx) < 0) {
+        return seterr(&ctx);
+    }
+
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+get_simd_level(PyObject *m GM_UNUSED, PyObject *args GM_UNUSED)
+{
+    return PyLong_FromLong(gm_get_simd_level());
+}
+
+static PyObject *
+get_max_simd_level(PyObject *m GM_UNUSED, PyObject *args GM_UNUSED)
+{
+    return PyLong_FromLong(gm_get_max_simd_level());
+}
+
+static PyObject *
+set_fast_math(PyObject *m GM_UNUSED, PyObject *obj)
+{
+    int enable = PyObject_IsTrue(obj);
+
+    if (enable < 0) {
+        return NULL;
+    }
+
+    gm_set_fast_math(enable);
+    Py_RETURN_NONE;
+}
+
+static PyObject *
+get_fast_math(PyObject *m GM_UNUSED, PyObject *args GM_UNUSED)
+{
+    return PyBool_FromLong(gm_get_fast_math());
+}
+
 static PyMethodDef gumath_methods [] =
 {
   /* Methods */
   { "unsafe_add_kernel", (PyCFunction)unsafe_add_kernel, METH_VARARGS|METH_KEYWORDS, NULL },
+  { "set_max_threads", (PyCFunction)set_max_threads, METH_O, NULL },
+  { "get_max_threads", (PyCFunction)get_max_threads, METH_NOARGS, NULL },
+  { "set_min_work", (PyCFunction)set_min_work, METH_O, NULL },
+  { "get_min_work", (PyCFunction)get_min_work, METH_NOARGS, NULL },
+  { "set_simd_level", (PyCFunction)set_simd_level, METH_O, NULL },
+  { "get_simd_level", (PyCFunction)get_simd_level, METH_NOARGS, NULL },
+  { "get_max_simd_level", (PyCFunction)get_max_simd_level, METH_NOARGS, NULL },
+  { "set_fast_math", (PyCFunction)set_fast_math, METH_O, NULL },
+  { "get_fast_math", (PyCFunction)get_fast_math, METH_NOARGS, NULL },
   { NULL, NULL, 1 }
 };
 
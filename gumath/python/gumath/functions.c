@@ -56,6 +56,9 @@ PyInit_functions(void)
        if (gm_init_binary_kernels(table, &ctx) < 0) {
            return Ndt_SetError(&ctx);
        }
+       if (gm_init_reduce_kernels(table, &ctx) < 0) {
+           return Ndt_SetError(&ctx);
+       }
 
        initialized = 1;
     }
@@ -37,7 +37,9 @@ from xnd import xnd
 from ndtypes import ndt
 from extending import Graph, bfloat16
 import sys, time
+import threading
 import math
+import struct
 import unittest
 import argparse
 
@@ -138,6 +140,33 @@ class TestCall(unittest.TestCase):
                 c = np.copy(b)
                 np.testing.assert_equal(y, b)
 
+    def test_add_strided(self):
+
+        lst = [[i * i + j for j in range(10)] for i in range(8)]
+
+        for t in ["int8", "int64", "uint8", "float32", "float64"]:
+            x = xnd(lst, dtype=t)
+            y = x[::-2, 1::3]
+            z = x[::2, 8::-3]
+            ylst = [row[1::3] for row in lst[::-2]]
+            zlst = [row[8::-3] for row in lst[::2]]
+
+            ans = fn.add(y, z)
+            self.assertEqual(ans.type, ndt("4 * 3 * %s" % t))
+            self.assertEqual(ans.value, [[a + b for a, b in zip(r, s)]
+                                         for r, s in zip(ylst, zlst)])
+
+            ans = fn.add(y, z[0])
+            self.assertEqual(ans.value, [[a + b for a, b in zip(r, zlst[0])]
+                                         for r in ylst])
+
+            ans = fn.copy(y)
+            self.assertEqual(ans.value, ylst)
+
+            if t != "int64":
+                ans = fn.fabs(z)
+                self.assertEqual(ans.value, [[float(v) for v in r] for r in zlst])
+
     @unittest.skipIf(sys.platform == "win32", "missing C99 complex support")
     def test_quaternion(self):
   
@@ -180,6 +209,23 @@ class TestCall(unittest.TestCase):
         x = xnd(lst, type="3 * Foo(2 * 2 * complex64)")
         self.assertRaises(TypeError, ex.multiply, x, x)
 
+    def test_dispatch_cache(self):
+
+        x = xnd([1.0, 2.0, 3.0])
+        y = xnd([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]])
+        z = xnd([1, 2, 3], dtype="int32")
+
+        expected = [fn.sin(x).value, fn.sin(y).value, fn.sin(y[::-1, ::2]).value,
+                    fn.sin(z).value, fn.add(x, y).value]
+
+        for _ in range(3):
+            result = [fn.sin(x).value, fn.sin(y).value, fn.sin(y[::-1, ::2]).value,
+                      fn.sin(z).value, fn.add(x, y).value]
+            self.assertEqual(result, expected)
+
+            self.assertEqual(fn.sin(y[::-1, ::2]).type, ndt("2 * 2 * float64"))
+            self.assertRaises(TypeError, fn.add, x, xnd([1.0, 2.0]))
+
     def test_void(self):
 
         x = ex.randint()
@@ -213,6 +259,80 @@ class TestMissingValues(unittest.TestCase):
 
         self.assertEqual(ans.value, [{'valid': 2, 'missing': 1}, {'valid': 1, 'missing': 2}])
 
+    def test_unary_optional(self):
+
+        # Rows of 11 elements: the validity bits of a row are not byte aligned.
+        lst = [[None if (i+j) % 3 == 0 else float(i*11+j) for j in range(11)]
+               for i in range(5)]
+        ans = [[None if v is None else math.sqrt(v) for v in row] for row in lst]
+
+        x = xnd(lst, dtype="?float64")
+        y = fn.sqrt(x)
+        self.assertEqual(y.type, ndt("5 * 11 * ?float64"))
+        self.assertEqual(y.value, ans)
+
+        # Non-contiguous input.
+        y = fn.sqrt(x[::-2, 1::3])
+        self.assertEqual(y.value, [row[1::3] for row in ans[::-2]])
+
+        x = xnd([None if i % 7 == 0 else i for i in range(100)], dtype="?int64")
+        y = fn.copy(x)
+        self.assertEqual(y.type, ndt("100 * ?int64"))
+        self.assertEqual(y.value, x.value)
+
+        x = xnd([[1.0, None], [None], []], dtype="?float64")
+        y = fn.sqrt(x)
+        self.assertEqual(y.value, [[1.0, None], [None], []])
+
+        x = xnd(None, type="?float64")
+        self.assertIsNone(fn.sqrt(x).value)
+
+    def test_binary_optional(self):
+
+        lst0 = [[None if (i+j) % 3 == 0 else i*13+j for j in range(13)]
+                for i in range(4)]
+        lst1 = [[None if (i*j) % 5 == 4 else j+1 for j in range(13)]
+                for i in range(4)]
+        add = lambda a, b: None if a is None or b is None else a + b
+
+        for t in "int8", "int64", "float32", "float64":
+            x = xnd(lst0, dtype="?" + t)
+            y = xnd(lst1, dtype="?" + t)
+            z = fn.add(x, y)
+            self.assertEqual(z.type, ndt("4 * 13 * ?" + t))
+            self.assertEqual(z.value, [[add(a, b) for a, b in zip(r0, r1)]
+                                       for r0, r1 in zip(lst0, lst1)])
+
+            # Non-contiguous input.
+            z = fn.add(x[:, :12:2], y[:, 1::2])
+            self.assertEqual(z.value, [[add(a, b) for a, b in zip(r0[:12:2], r1[1::2])]
+                                       for r0, r1 in zip(lst0, lst1)])
+
+        # Mixed optional and non-optional input.
+        x = xnd(lst0, dtype="?int64")
+        y = xnd([list(range(13))] * 4, dtype="int64")
+        z = fn.multiply(x, y)
+        self.assertEqual(z.type, ndt("4 * 13 * ?int64"))
+        self.assertEqual(z.value, [[None if a is None else a * b for a, b in zip(r0, r1)]
+                                   for r0, r1 in zip(lst0, y.value)])
+
+        # Broadcasting.
+        z = fn.add(x, xnd(None, type="?int64"))
+        self.assertEqual(z.value, [[None] * 13] * 4)
+
+        z = fn.subtract(xnd([1.5, None, 2.5], dtype="?float64"), xnd(1.0))
+        self.assertEqual(z.value, [0.5, None, 1.5])
+
+        # The divisors of missing values are not used.
+        x = xnd([10, 20, None, 40], dtype="?int64")
+        y = xnd([2, None, None, 4], dtype="?int64")
+        z = fn.divide(x, y)
+        self.assertEqual(z.value, [5, None, None, 10])
+
+        # Missing values in var dimensions are not supported.
+        x = xnd([[1.0, None], [2.0]], dtype="?float64")
+        self.assertRaises(TypeError, fn.add, x, x)
+
 
 class TestRaggedArrays(unittest.TestCase):
 
@@ -236,6 +356,32 @@ class TestRaggedArrays(unittest.TestCase):
         y = fn.sin(x)
         self.assertEqual(y.value, ans)
 
+    def test_binary(self):
+        lst = [[[1.0],
+                [2.0, 3.0],
+                [4.0, 5.0, 6.0]],
+               [[],
+                [8.0, 9.0]]]
+
+        ans = [[[2.0],
+                [4.0, 6.0],
+                [8.0, 10.0, 12.0]],
+               [[],
+                [16.0, 18.0]]]
+
+        x = xnd(lst)
+        y = xnd(lst)
+        self.assertEqual(fn.add(x, y).value, ans)
+        self.assertEqual(fn.add(x, x).value, ans)
+        self.assertEqual(fn.add(x[::-1], y[::-1]).value, ans[::-1])
+
+        fn.add(x, y, out=x)
+        self.assertEqual(x.value, ans)
+
+        x = xnd([[1.0, 2.0], [3.0]])
+        y = xnd([[1.0], [2.0, 3.0]])
+        self.assertRaises(TypeError, fn.add, x, y)
+
 
 class TestGraphs(unittest.TestCase):
 
@@ -373,6 +519,391 @@ class TestNumba(unittest.TestCase):
         np.testing.assert_equal(z, c)
 
 
+class TestThreads(unittest.TestCase):
+
+    def setUp(self):
+        self.max_threads = gm.get_max_threads()
+        self.min_work = gm.get_min_work()
+
+    def tearDown(self):
+        gm.set_max_threads(self.max_threads)
+        gm.set_min_work(self.min_work)
+
+    def test_config(self):
+        gm.set_max_threads(4)
+        self.assertEqual(gm.get_max_threads(), 4)
+        gm.set_min_work(100)
+        self.assertEqual(gm.get_min_work(), 100)
+
+        self.assertRaises(ValueError, gm.set_max_threads, 0)
+        self.assertRaises(ValueError, gm.set_min_work, -1)
+        self.assertRaises(TypeError, gm.set_max_threads, "4")
+
+    def test_threads(self):
+        cases = TEST_CASES + [
+          ([float(i) for i in range(5)], "5 * float64", "float64"),
+          ([[float(i)] for i in range(7)], "7 * 1 * float64", "float64"),
+          ([], "0 * float64", "float64"),
+        ]
+
+        for lst, t, dtype in cases:
+            x = xnd(lst, type=t)
+            y = xnd(lst, type=t)
+
+            gm.set_max_threads(1)
+            expected = [fn.exp(x).value, fn.add(x, y).value,
+                        fn.multiply(x, y).value, fn.copy(x).value]
+            if x.type.ndim == 2:
+                expected.append(fn.sin(x[::-1, ::2]).value)
+
+            for n in (2, 3, 8):
+                gm.set_max_threads(n)
+                gm.set_min_work(1)
+
+                result = [fn.exp(x).value, fn.add(x, y).value,
+                          fn.multiply(x, y).value, fn.copy(x).value]
+                if x.type.ndim == 2:
+                    result.append(fn.sin(x[::-1, ::2]).value)
+
+                self.assertEqual(result, expected)
+
+    def test_threads_broadcast(self):
+        x = xnd([[float(i) for i in range(10)] for _ in range(100)])
+        y = xnd([float(i) for i in range(10)])
+
+        expected = fn.add(x, y).value
+
+        gm.set_max_threads(4)
+        gm.set_min_work(1)
+        self.assertEqual(fn.add(x, y).value, expected)
+        self.assertEqual(fn.add(y, x).value, expected)
+
+    def test_threads_cached(self):
+        # Repeated calls hit the dispatch cache and get interned output
+        # types.  The chunk types of a split call must be temporaries.
+        x = xnd([[float(i+j) for i in range(10)] for j in range(1000)])
+
+        gm.set_max_threads(1)
+        expected = [fn.exp(x).value, fn.copy(x[::-1]).value]
+
+        gm.set_max_threads(4)
+        gm.set_min_work(1)
+        for _ in range(3):
+            y = fn.exp(x)
+            z = fn.copy(x[::-1])
+            self.assertEqual([y.value, z.value], expected)
+            self.assertEqual(y.type, x.type)
+            self.assertEqual(z.type, x.type)
+
+    def test_concurrent_calls(self):
+        x = xnd([[float(i+j) for i in range(100)] for j in range(100)])
+        y = xnd([float(i) for i in range(100)])
+        s = xnd(["a", "b"])
+
+        expected = [fn.exp(x).value, fn.add(x, y).value, fn.copy(x).value]
+        errors = []
+
+        def run():
+            try:
+                out = xnd.empty(x.type)
+                for _ in range(20):
+                    result = [fn.exp(x).value, fn.add(x, y).value,
+                              fn.copy(x, out=out).value]
+                    if result != expected:
+                        errors.append(result)
+                    self.assertRaises(RuntimeError, fn.sin, s)
+            except Exception as e:
+                errors.append(e)
+
+        for n in (1, 4):
+            gm.set_max_threads(n)
+            threads = [threading.Thread(target=run) for _ in range(8)]
+            for t in threads:
+                t.start()
+            for t in threads:
+                t.join()
+            self.assertEqual(errors, [])
+
+        # The arguments are released after the calls.
+        x[0, 0] = 1.0
+        s[0] = "c"
+        self.assertEqual(x[0, 0].value, 1.0)
+        self.assertEqual(s.value, ["c", "b"])
+
+        # An argument can be both an input and an output of the same call.
+        self.assertEqual(fn.copy(y, out=y).value, [float(i) for i in range(100)])
+
+
+class TestOut(unittest.TestCase):
+
+    def test_out(self):
+        x = xnd([1.0, 2.0, 3.0])
+        y = xnd([[1.0, 2.0, 3.0], [4.0, 5.0, 6.0]])
+        z = xnd([[0.0, 0.0, 0.0], [0.0, 0.0, 0.0]])
+
+        expected = fn.add(x, y).value
+        ret = fn.add(x, y, out=z)
+        self.assertIs(ret, z)
+        self.assertEqual(z.value, expected)
+
+        ret = fn.add(x, y, out=(z,))
+        self.assertIs(ret, z)
+
+        z = xnd([0.0, 0.0, 0.0, 0.0, 0.0, 0.0])
+        fn.sin(x, out=z[::2])
+        self.assertEqual(z[::2].value, fn.sin(x).value)
+        self.assertEqual(z[1::2].value, [0.0, 0.0, 0.0])
+
+        q, r = xnd(0), xnd(0)
+        ret = ex.divmod10(xnd(233), out=(q, r))
+        self.assertEqual(ret, (q, r))
+        self.assertEqual(q.value, 23)
+        self.assertEqual(r.value, 3)
+
+    def test_out_inplace(self):
+        x = xnd([1.0, 2.0, 3.0])
+        y = xnd([10.0, 20.0, 30.0])
+
+        fn.add(x, y, out=x)
+        self.assertEqual(x.value, [11.0, 22.0, 33.0])
+
+        fn.multiply(x, xnd(2.0), out=x)
+        self.assertEqual(x.value, [22.0, 44.0, 66.0])
+
+        y = xnd([[1.0, 2.0], [3.0, 4.0]])
+        fn.add(y, y, out=y)
+        self.assertEqual(y.value, [[2.0, 4.0], [6.0, 8.0]])
+
+    def test_out_overlap(self):
+        lst = [float(i) for i in range(10)]
+
+        x = xnd(lst)
+        expected = fn.add(x[:-1], x[1:]).value
+        fn.add(x[:-1], x[1:], out=x[1:])
+        self.assertEqual(x[1:].value, expected)
+
+        x = xnd(lst)
+        expected = fn.copy(x[::-1]).value
+        fn.copy(x[::-1], out=x)
+        self.assertEqual(x.value, expected)
+
+        x = xnd([lst, lst])
+        expected = fn.add(x[0], x).value
+        fn.add(x[0], x, out=x)
+        self.assertEqual(x.value, expected)
+
+    def test_out_error(self):
+        x = xnd([1.0, 2.0, 3.0])
+
+        self.assertRaises(TypeError, fn.add, x, x, out=xnd([1.0, 2.0]))
+        self.assertRaises(TypeError, fn.add, x, x, out=xnd([1, 2, 3]))
+        self.assertRaises(TypeError, fn.add, x, x, out=[1.0, 2.0, 3.0])
+        self.assertRaises(TypeError, fn.add, x, x, out=(x, x))
+        self.assertRaises(TypeError, fn.add, x, x, where=x)
+
+
+def float32(x):
+    return struct.unpack("f", struct.pack("f", x))[0]
+
+def same_float(x, y):
+    if math.isnan(x):
+        return math.isnan(y)
+    return x == y and math.copysign(1, x) == math.copysign(1, y)
+
+SIMD_SPECIAL = [0.0, -0.0, float("inf"), float("-inf"), float("nan"), 0.5, -0.5,
+                1.5, -1.5, 2.5, -2.5, 0.3, -0.7, 1e-40, -1e-40, 1e300, -1e300,
+                8388607.5, -8388607.5, 4503599627370495.5, 123456.789, -0.0001]
+
+class TestSimd(unittest.TestCase):
+
+    def setUp(self):
+        self.level = gm.get_simd_level()
+        self.fast_math = gm.get_fast_math()
+
+    def tearDown(self):
+        gm.set_simd_level(self.level)
+        gm.set_fast_math(self.fast_math)
+
+    def levels(self):
+        return range(gm.get_max_simd_level() + 1)
+
+    def test_config(self):
+        self.assertRaises(ValueError, gm.set_simd_level, -1)
+        self.assertRaises(ValueError, gm.set_simd_level,
+                          gm.get_max_simd_level() + 1)
+
+        gm.set_simd_level(0)
+        self.assertEqual(gm.get_simd_level(), 0)
+
+        gm.set_fast_math(True)
+        self.assertTrue(gm.get_fast_math())
+        gm.set_fast_math(False)
+        self.assertFalse(gm.get_fast_math())
+
+    def test_exact(self):
+        funcs = [("fabs", math.fabs), ("sqrt", math.sqrt), ("ceil", math.ceil),
+                 ("floor", math.floor), ("trunc", math.trunc)]
+
+        def ref(f, x):
+            if math.isnan(x) or math.isinf(x):
+                return abs(x) if f is math.fabs else \
+                       float("nan") if f is math.sqrt and x < 0 else x
+            if f is math.sqrt and x < 0:
+                return float("nan")
+            return math.copysign(float(f(x)), x) if f is not math.fabs else f(x)
+
+        for dtype, conv in [("float32", float32), ("float64", float)]:
+            lst = [conv(v) for v in SIMD_SPECIAL] * 3 + \
+                  [conv(i * 0.37 - 10) for i in range(61)]
+            x = xnd(lst, dtype=dtype)
+
+            for level in self.levels():
+                gm.set_simd_level(level)
+                for name, f in funcs:
+                    y = getattr(fn, name)(x).value
+                    for v, w in zip(lst, y):
+                        expected = conv(ref(f, v))
+                        self.assertTrue(same_float(w, expected),
+                                        (level, dtype, name, v, w, expected))
+
+    def test_fast_math(self):
+        def call(f, x):
+            try:
+                return f(x)
+            except OverflowError:
+                return float("inf")
+            except ValueError:
+                if f is math.log and x == 0:
+                    return float("-inf")
+                return float("nan")
+
+        funcs = [("exp", math.exp), ("log", math.log), ("sin", math.sin),
+                 ("cos", math.cos)]
+
+        gm.set_fast_math(True)
+
+        for dtype, conv, tol in [("float32", float32, 5e-7),
+                                 ("float64", float, 1e-15)]:
+            lst = [conv(v) for v in SIMD_SPECIAL] * 3 + \
+                  [conv(i * 3.7 - 100) for i in range(201)] + \
+                  [conv(1.1 ** i) for i in range(-300, 300, 7)]
+            x = xnd(lst, dtype=dtype)
+
+            for level in self.levels():
+                gm.set_simd_level(level)
+                for name, f in funcs:
+                    y = getattr(fn, name)(x).value
+                    for v, w in zip(lst, y):
+                        expected = conv(call(f, v))
+                        if math.isnan(expected) or math.isinf(expected) or \
+                           expected == 0:
+                            self.assertTrue(same_float(w, expected),
+                                            (level, dtype, name, v, w, expected))
+                        else:
+                            self.assertTrue(math.isclose(w, expected, rel_tol=tol),
+                                            (level, dtype, name, v, w, expected))
+
+class TestReduce(unittest.TestCase):
+
+    def test_sum_prod(self):
+        lst = [[i * 7 - j for j in range(11)] for i in range(5)]
+
+        for dtype, rtype in [("int8", "int64"), ("int32", "int64"),
+                             ("uint16", "uint64"), ("float32", "float32"),
+                             ("float64", "float64")]:
+            x = xnd([[abs(v) for v in row] for row in lst], dtype=dtype)
+            ans = fn.sum(x)
+            self.assertEqual(ans.type, ndt("5 * %s" % rtype))
+            self.assertEqual(ans.value, [sum(abs(v) for v in row) for row in lst])
+
+            y = x[::-2, 1::3]
+            ans = fn.sum(y)
+            self.assertEqual(ans.value, [sum(abs(v) for v in row[1::3])
+                                         for row in lst[::-2]])
+
+            ans = fn.prod(x[:, :4])
+            self.assertEqual(ans.value, [math.prod(abs(v) for v in row[:4])
+                                         for row in lst])
+
+            self.assertEqual(fn.sum(x[0, :0]).value, 0)
+            self.assertEqual(fn.prod(x[0, :0]).value, 1)
+
+        x = xnd([127] * 100, dtype="int8")
+        self.assertEqual(fn.sum(x).value, 12700)
+
+        x = xnd([-1] * 3, dtype="int64")
+        self.assertEqual(fn.prod(x).value, -1)
+
+    def test_pairwise_sum(self):
+        for n in [1, 7, 8, 9, 127, 128, 129, 1000, 10001]:
+            lst = [0.1] * n
+            x = xnd(lst)
+            self.assertAlmostEqual(fn.sum(x).value, math.fsum(lst), delta=n*1e-16)
+            self.assertAlmostEqual(fn.mean(x).value, 0.1, delta=1e-15)
+
+        # The relative error of the naive float32 loop is around 1e-4 here.
+        lst = [float32(0.1)] * 100000
+        x = xnd(lst, dtype="float32")
+        self.assertAlmostEqual(fn.sum(x).value / math.fsum(lst), 1.0, delta=1e-6)
+
+    def test_mean(self):
+        x = xnd([[1, 2, 3, 4], [5, 6, 7, 9]], dtype="int16")
+        ans = fn.mean(x)
+        self.assertEqual(ans.type, ndt("2 * float64"))
+        self.assertEqual(ans.value, [2.5, 6.75])
+
+        x = xnd([1.0, 2.0], dtype="float32")
+        self.assertEqual(fn.mean(x).type, ndt("float32"))
+
+        self.assertTrue(math.isnan(fn.mean(xnd([], dtype="float64")).value))
+
+    def test_min_max(self):
+        lst = [[3, -1, 4, 1, -5, 9, 2, -6, 5, 3], [2, 7, 1, 8, 2, 8, 1, 8, 2, 8]]
+
+        for dtype in ["int8", "int64", "float32", "float64"]:
+            x = xnd(lst, dtype=dtype)
+            self.assertEqual(fn.min(x).value, [min(row) for row in lst])
+            self.assertEqual(fn.max(x).value, [max(row) for row in lst])
+            self.assertEqual(fn.argmin(x).value, [row.index(min(row)) for row in lst])
+            self.assertEqual(fn.argmax(x).value, [row.index(max(row)) for row in lst])
+            self.assertEqual(fn.min(x).type, ndt("2 * %s" % dtype))
+            self.assertEqual(fn.argmin(x).type, ndt("2 * int64"))
+
+            y = x[:, ::-3]
+            self.assertEqual(fn.max(y).value, [max(row[::-3]) for row in lst])
+
+            self.assertRaises(ValueError, fn.min, x[0, :0])
+            self.assertRaises(ValueError, fn.argmax, x[0, :0])
+
+        x = xnd([1, 255, 0, 7], dtype="uint8")
+        self.assertEqual(fn.max(x).value, 255)
+        self.assertEqual(fn.argmin(x).value, 2)
+
+        nan = float("nan")
+        x = xnd([1.0, nan, -1.0, nan, 5.0])
+        self.assertTrue(math.isnan(fn.min(x).value))
+        self.assertTrue(math.isnan(fn.max(x).value))
+        self.assertEqual(fn.argmin(x).value, 1)
+        self.assertEqual(fn.argmax(x).value, 1)
+
+    def test_any_all(self):
+        x = xnd([[False, False], [True, False], [True, True]])
+        self.assertEqual(fn.any(x).value, [False, True, True])
+        self.assertEqual(fn.all(x).value, [False, False, True])
+        self.assertEqual(fn.any(x).type, ndt("3 * bool"))
+
+        x = xnd([[0, 0, 0], [0, 3, 0], [1, 2, 3]], dtype="int32")
+        self.assertEqual(fn.any(x).value, [False, True, True])
+        self.assertEqual(fn.all(x).value, [False, False, True])
+
+        x = xnd([0.0, float("nan")])
+        self.assertTrue(fn.any(x).value)
+        self.assertFalse(fn.all(x).value)
+
+        x = xnd([], dtype="float64")
+        self.assertFalse(fn.any(x).value)
+        self.assertTrue(fn.all(x).value)
+
 
 ALL_TESTS = [
   TestCall,
@@ -382,6 +913,10 @@ ALL_TESTS = [
   TestBFloat16,
   TestPdist,
   TestNumba,
+  TestThreads,
+  TestOut,
+  TestSimd,
+  TestReduce,
 ]
 
 
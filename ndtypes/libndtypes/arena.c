@@ -0,0 +1,198 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "ndtypes.h"
+#include "overflow.h"
+#include "arena.h"
+
+
+struct ndt_arena_chunk {
+    ndt_arena_chunk_t *next;
+    alignas(MAX_ALIGN) char data[];
+};
+
+
+void
+ndt_arena_init(ndt_arena_t *arena)
+{
+    arena->ptr = arena->initial;
+    arena->end = arena->initial + NDT_ARENA_INLINE_SIZE;
+    arena->last = NULL;
+    arena->chunk_size = NDT_ARENA_MIN_CHUNK;
+    arena->chunks = NULL;
+}
+
+/* Release all heap blocks.  The arena can be reused afterwards. */
+void
+ndt_arena_clear(ndt_arena_t *arena)
+{
+    ndt_arena_chunk_t *chunk, *next;
+
+    for (chunk = arena->chunks; chunk != NULL; chunk = next) {
+        next = chunk->next;
+        ndt_free(chunk);
+    }
+
+    ndt_arena_init(arena);
+}
+
+/* Return the rounded request size or -1 on overflow. */
+static int64_t
+request_size(int64_t nmemb, int64_t size)
+{
+    const int64_t align = (int64_t)MAX_ALIGN;
+    bool overflow = 0;
+    int64_t req;
+
+    assert(nmemb >= 0 && size >= 0);
+
+    req = MULi64(nmemb, size, &overflow);
+    req = ADDi64(req, align-1, &overflow);
+    if (overflow) {
+        return -1;
+    }
+
+    /* zero-sized requests still get a distinct address */
+    req = req - (req % align);
+    if (req == 0) {
+        req = align;
+    }
+
+#if SIZE_MAX < INT64_MAX
+    if (req > INT32_MAX) {
+        return -1;
+    }
+#endif
+
+    return req;
+}
+
+static int
+new_chunk(ndt_arena_t *arena, int64_t req)
+{
+    ndt_arena_chunk_t *chunk;
+    size_t size = arena->chunk_size;
+
+    if ((size_t)req > size) {
+        size = (size_t)req;
+    }
+
+    if (size > SIZE_MAX - sizeof *chunk) {
+        return -1;
+    }
+
+    chunk = ndt_alloc_size(sizeof *chunk + size);
+    if (chunk == NULL) {
+        return -1;
+    }
+
+    chunk->next = arena->chunks;
+    arena->chunks = chunk;
+    arena->ptr = chunk->data;
+    arena->end = chunk->data + size;
+
+    if (arena->chunk_size < NDT_ARENA_MAX_CHUNK) {
+        arena->chunk_size *= 2;
+    }
+
+    return 0;
+}
+
+/* Allocate memory for nmemb items of 'size' bytes.  The memory is aligned to
+   MAX_ALIGN and uninitialized.  Return NULL on overflow or allocation failure. */
+void *
+ndt_arena_alloc(ndt_arena_t *arena, int64_t nmemb, int64_t size)
+{
+    int64_t req;
+    char *p;
+
+    req = request_size(nmemb, size);
+    if (req < 0) {
+        return NULL;
+    }
+
+    if (req > arena->end - arena->ptr) {
+        if (new_chunk(arena, req) < 0) {
+            return NULL;
+        }
+    }
+
+    p = arena->ptr;
+    arena->ptr += req;
+    arena->last = p;
+
+    return p;
+}
+
+/*
+ * Resize an allocation from old_nmemb to new_nmemb items.  The most recent
+ * allocation is extended in place if the current block has room, otherwise
+ * the contents are copied to a new allocation.  On failure the original
+ * allocation remains valid.
+ */
+void *
+ndt_arena_realloc(ndt_arena_t *arena, void *ptr, int64_t old_nmemb,
+                  int64_t new_nmemb, int64_t size)
+{
+    int64_t req;
+    char *p;
+
+    assert(old_nmemb <= new_nmemb);
+
+    if (ptr == NULL) {
+        return ndt_arena_alloc(arena, new_nmemb, size);
+    }
+
+    req = request_size(new_nmemb, size);
+    if (req < 0) {
+        return NULL;
+    }
+
+    if (ptr == arena->last && req <= arena->end - arena->last) {
+        arena->ptr = arena->last + req;
+        return ptr;
+    }
+
+    p = ndt_arena_alloc(arena, new_nmemb, size);
+    if (p == NULL) {
+        return NULL;
+    }
+
+    memcpy(p, ptr, (size_t)(old_nmemb * size));
+    return p;
+}
@@ -0,0 +1,86 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef ARENA_H
+#define ARENA_H
+
+
+#include <stddef.h>
+#include <stdint.h>
+#include "ndtypes.h"
+
+
+/* LOCAL SCOPE */
+NDT_PRAGMA(NDT_HIDE_SYMBOLS_START)
+
+
+/*****************************************************************************/
+/*                         Arena for parser temporaries                      */
+/*****************************************************************************/
+
+/*
+ * Bump allocator for the short-lived objects that the parsers create while
+ * building a type (sequences, fields, attributes, the lexer input buffer).
+ * Individual allocations are never freed; ndt_arena_clear() releases all of
+ * them at once.  The first block is embedded in the arena, larger blocks are
+ * obtained through ndt_alloc_size() and hence through ndt_mallocfunc.
+ */
+
+#define NDT_ARENA_INLINE_SIZE 2048
+#define NDT_ARENA_MIN_CHUNK 8192
+#define NDT_ARENA_MAX_CHUNK 262144
+
+typedef struct ndt_arena_chunk ndt_arena_chunk_t;
+
+typedef struct {
+    char *ptr;                 /* next free byte in the current block */
+    char *end;                 /* end of the current block */
+    char *last;                /* most recent allocation, for in-place growth */
+    size_t chunk_size;         /* size of the next heap block */
+    ndt_arena_chunk_t *chunks; /* heap blocks, most recent first */
+    alignas(MAX_ALIGN) char initial[NDT_ARENA_INLINE_SIZE];
+} ndt_arena_t;
+
+void ndt_arena_init(ndt_arena_t *arena);
+void ndt_arena_clear(ndt_arena_t *arena);
+void *ndt_arena_alloc(ndt_arena_t *arena, int64_t nmemb, int64_t size);
+void *ndt_arena_realloc(ndt_arena_t *arena, void *ptr, int64_t old_nmemb,
+                        int64_t new_nmemb, int64_t size);
+
+
+/* END LOCAL SCOPE */
+NDT_PRAGMA(NDT_HIDE_SYMBOLS_END)
+
+
+#endif /* ARENA_H */
@@ -45,8 +45,10 @@
 /*                    Type attributes used in the parser                     */
 /*****************************************************************************/
 
+/* Attributes and the item lists of AttrList are allocated from the parse
+   arena.  Release the strings only. */
 void
-ndt_attr_del(ndt_attr_t *attr)
+ndt_attr_clear(ndt_attr_t *attr)
 {
     int64_t i;
 
@@ -59,14 +61,11 @@ ndt_attr_del(ndt_attr_t *attr)
     switch (attr->tag) {
     case AttrValue:
         ndt_free(attr->AttrValue);
-        ndt_free(attr);
         return;
     case AttrList:
         for (i = 0; i < attr->AttrList.len; i++) {
             ndt_free(attr->AttrList.items[i]);
         }
-        ndt_free(attr->AttrList.items);
-        ndt_free(attr);
         return;
     }
 
@@ -74,43 +73,11 @@ ndt_attr_del(ndt_attr_t *attr)
     ndt_internal_error("invalid attribute");
 }
 
-void
-ndt_attr_array_del(ndt_attr_t *attr, int64_t nattr)
-{
-    int64_t i, k;
-
-    if (attr == NULL) {
-        return;
-    }
-
-    for (i = 0; i < nattr; i++) {
-        ndt_free(attr[i].name);
-
-        switch (attr[i].tag) {
-        case AttrValue:
-            ndt_free(attr[i].AttrValue);
-            continue;
-        case AttrList:
-            for (k = 0; k < attr[i].AttrList.len; k++) {
-                ndt_free(attr[i].AttrList.items[k]);
-            }
-            ndt_free(attr[i].AttrList.items);
-            continue;
-        }
-
-        /* NOT REACHED: tags should be exhaustive. */
-        ndt_internal_error("invalid attribute");
-    }
-
-    ndt_free(attr);
-}
-
 /* Attribute sequences */
 NDT_SEQ_NEW(ndt_attr)
 NDT_SEQ_DEL(ndt_attr)
 NDT_SEQ_GROW(ndt_attr)
 NDT_SEQ_APPEND(ndt_attr)
-NDT_SEQ_FINALIZE(ndt_attr)
 
 
 int
@@ -229,8 +196,8 @@ ndt_parse_attr(const attr_spec *spec, ndt_context_t *ctx,
             goto endloop;
         }
 
-        case AttrInt32List: {
-            int32_t *values = ndt_alloc(v[i]->AttrList.len, sizeof(int32_t));
+        case AttrInt64List: {
+            int64_t *values = ndt_alloc(v[i]->AttrList.len, sizeof(int64_t));
 
             if (values == NULL) {
                 ndt_err_format(ctx, NDT_MemoryError, "out of memory");
@@ -238,14 +205,14 @@ ndt_parse_attr(const attr_spec *spec, ndt_context_t *ctx,
             }
 
             for (k = 0; k < v[i]->AttrList.len; k++) {
-                values[k] = (int32_t)ndt_strtol(v[i]->AttrList.items[k], 0, INT32_MAX, ctx);
+                values[k] = (int64_t)ndt_strtoll(v[i]->AttrList.items[k], 0, INT64_MAX, ctx);
                 if (ndt_err_occurred(ctx)) {
                     ndt_free(values);
                     return -1;
                 }
             }
 
-            *(int32_t **)ptr = values;
+            *(int64_t **)ptr = values;
 
             ptr = va_arg(ap, void *);
             *(int64_t *)ptr = v[i]->AttrList.len;
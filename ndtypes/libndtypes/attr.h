@@ -58,7 +58,7 @@ enum ndt_attr {
   AttrFloat32,
   AttrFloat64,
   AttrString,
-  AttrInt32List,
+  AttrInt64List,
   AttrCharOpt,
   AttrInt64Opt,
   AttrUint16Opt
@@ -95,13 +95,11 @@ typedef struct {
     ndt_attr_t *ptr;
 } ndt_attr_seq_t;
 
-void ndt_attr_del(ndt_attr_t *attr);
-void ndt_attr_array_del(ndt_attr_t *attr, int64_t nattr);
+void ndt_attr_clear(ndt_attr_t *attr);
 
-ndt_attr_seq_t *ndt_attr_seq_new(ndt_attr_t *, ndt_context_t *ctx);
+ndt_attr_seq_t *ndt_attr_seq_new(ndt_attr_t *, ndt_arena_t *arena, ndt_context_t *ctx);
 void ndt_attr_seq_del(ndt_attr_seq_t *);
-ndt_attr_seq_t *ndt_attr_seq_append(ndt_attr_seq_t *, ndt_attr_t *, ndt_context_t *ctx);
-ndt_attr_seq_t *ndt_attr_seq_finalize(ndt_attr_seq_t *);
+ndt_attr_seq_t *ndt_attr_seq_append(ndt_attr_seq_t *, ndt_attr_t *, ndt_arena_t *arena, ndt_context_t *ctx);
 
 int ndt_parse_attr(const attr_spec *spec, ndt_context_t *ctx, const ndt_attr_seq_t *seq, ...);
 
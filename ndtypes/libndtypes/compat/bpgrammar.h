@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_NDT_BP_BPGRAMMAR_H_INCLUDED
 # define YY_NDT_BP_BPGRAMMAR_H_INCLUDED
 /* Debug traces.  */
@@ -40,53 +45,57 @@
 extern int ndt_bpdebug;
 #endif
 /* "%code requires" blocks.  */
-#line 292 "bpgrammar.y" /* yacc.c:1909  */
+#line 309 "bpgrammar.y"
 
   #include <ctype.h>
   #include <assert.h>
   #include "ndtypes.h"
+  #include "arena.h"
   #include "parsefuncs.h"
   #include "seq.h"
   #include "overflow.h"
   #define YY_TYPEDEF_YY_SCANNER_T
   typedef void * yyscan_t;
 
-#line 55 "bpgrammar.h" /* yacc.c:1909  */
+#line 61 "bpgrammar.h"
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    ENDMARKER = 0,
-    BYTES = 258,
-    RECORD = 259,
-    PAD = 260,
-    AT = 261,
-    EQUAL = 262,
-    LESS = 263,
-    GREATER = 264,
-    BANG = 265,
-    COMMA = 266,
-    COLON = 267,
-    LPAREN = 268,
-    RPAREN = 269,
-    LBRACE = 270,
-    RBRACE = 271,
-    RARROW = 272,
-    ERRTOKEN = 273,
-    DTYPE = 274,
-    INTEGER = 275,
-    NAME = 276
+    YYEMPTY = -2,
+    ENDMARKER = 0,                 /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    BYTES = 258,                   /* BYTES  */
+    RECORD = 259,                  /* RECORD  */
+    PAD = 260,                     /* PAD  */
+    AT = 261,                      /* AT  */
+    EQUAL = 262,                   /* EQUAL  */
+    LESS = 263,                    /* LESS  */
+    GREATER = 264,                 /* GREATER  */
+    BANG = 265,                    /* BANG  */
+    COMMA = 266,                   /* COMMA  */
+    COLON = 267,                   /* COLON  */
+    LPAREN = 268,                  /* LPAREN  */
+    RPAREN = 269,                  /* RPAREN  */
+    LBRACE = 270,                  /* LBRACE  */
+    RBRACE = 271,                  /* RBRACE  */
+    RARROW = 272,                  /* RARROW  */
+    ERRTOKEN = 273,                /* ERRTOKEN  */
+    DTYPE = 274,                   /* DTYPE  */
+    INTEGER = 275,                 /* INTEGER  */
+    NAME = 276                     /* NAME  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
 union YYSTYPE
 {
-#line 325 "bpgrammar.y" /* yacc.c:1909  */
+#line 343 "bpgrammar.y"
 
     ndt_t *ndt;
     ndt_field_t *field;
@@ -97,9 +106,9 @@ union YYSTYPE
     unsigned char uchar;
     uint16_t uint16;
 
-#line 101 "bpgrammar.h" /* yacc.c:1909  */
-};
+#line 110 "bpgrammar.h"
 
+};
 typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
@@ -121,14 +130,16 @@ struct YYLTYPE
 
 
 
-int ndt_bpparse (yyscan_t scanner, ndt_t **ast, ndt_context_t *ctx);
+
+int ndt_bpparse (yyscan_t scanner, ndt_t **ast, ndt_arena_t *arena, ndt_context_t *ctx);
+
 /* "%code provides" blocks.  */
-#line 303 "bpgrammar.y" /* yacc.c:1909  */
+#line 321 "bpgrammar.y"
 
   #define YY_DECL extern int ndt_bplexfunc(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner, ndt_context_t *ctx)
   extern int ndt_bplexfunc(YYSTYPE *, YYLTYPE *, yyscan_t, ndt_context_t *);
-  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_context_t *ctx, const char *msg);
+  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_arena_t *arena, ndt_context_t *ctx, const char *msg);
 
-#line 133 "bpgrammar.h" /* yacc.c:1909  */
+#line 144 "bpgrammar.h"
 
 #endif /* !YY_NDT_BP_BPGRAMMAR_H_INCLUDED  */
@@ -37,11 +37,12 @@
 
 
 void
-yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_context_t *ctx,
-        const char *msg)
+yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_arena_t *arena,
+        ndt_context_t *ctx, const char *msg)
 {
     (void)scanner;
     (void)ast;
+    (void)arena;
 
     ndt_err_format(ctx, NDT_ParseError, "%d:%d: %s\n", loc->first_line,
                    loc->first_column, msg);
@@ -218,14 +219,27 @@ make_dimensions(ndt_string_seq_t *seq, ndt_t *type, ndt_context_t *ctx)
 }
 
 static ndt_field_t *
-make_field(char *name, ndt_t *type, uint16_t padding, ndt_context_t *ctx)
+make_field(char *name, ndt_t *type, uint16_t padding, ndt_arena_t *arena,
+           ndt_context_t *ctx)
 {
     uint16_opt_t align = {None, 0};
     uint16_opt_t pack = {None, 0};
     uint16_opt_t pad = {Some, 0};
+    ndt_field_t *field;
+
+    field = ndt_arena_alloc(arena, 1, sizeof *field);
+    if (field == NULL) {
+        ndt_free(name);
+        ndt_del(type);
+        return ndt_memory_error(ctx);
+    }
 
     pad.Some = padding;
-    return ndt_field(name, type, align, pack, pad, ctx);
+    if (ndt_field_init(field, name, type, align, pack, pad, ctx) < 0) {
+        return NULL;
+    }
+
+    return field;
 }
 
 static ndt_t *
@@ -233,10 +247,9 @@ make_record(ndt_field_seq_t *fields, ndt_context_t *ctx)
 {
     uint16_opt_t align = {None, 0};
     uint16_opt_t pack = {None, 0};
-    ndt_t *t;
-    int64_t i;
+    ndt_field_t *ptr;
+    int64_t len, i;
 
-    fields = ndt_field_seq_finalize(fields);
     if (fields == NULL) {
         return ndt_record(Nonvariadic, NULL, 0, align, pack, ctx);
     }
@@ -255,14 +268,17 @@ make_record(ndt_field_seq_t *fields, ndt_context_t *ctx)
         fields->ptr[i].Concrete.explicit_align = true;
     }
 
-    t = ndt_record(Nonvariadic, fields->ptr, fields->len, align, pack, ctx);
-    ndt_free(fields);
+    len = fields->len;
+    ptr = ndt_field_seq_finalize(fields, ctx);
+    if (ptr == NULL) {
+        return NULL;
+    }
 
-    return t;
+    return ndt_record(Nonvariadic, ptr, len, align, pack, ctx);
 }
 
 static ndt_type_seq_t *
-broadcast_seq_new(ndt_t *type, ndt_context_t *ctx)
+broadcast_seq_new(ndt_t *type, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     ndt_t *t;
 
@@ -271,11 +287,12 @@ broadcast_seq_new(ndt_t *type, ndt_context_t *ctx)
         return NULL;
     }
 
-    return ndt_type_seq_new(t, ctx);
+    return ndt_type_seq_new(t, arena, ctx);
 }
 
 static ndt_type_seq_t *
-broadcast_seq_append(ndt_type_seq_t *seq, ndt_t *type, ndt_context_t *ctx)
+broadcast_seq_append(ndt_type_seq_t *seq, ndt_t *type, ndt_arena_t *arena,
+                     ndt_context_t *ctx)
 {
     ndt_t *t;
 
@@ -285,7 +302,7 @@ broadcast_seq_append(ndt_type_seq_t *seq, ndt_t *type, ndt_context_t *ctx)
         return NULL;
     }
 
-    return ndt_type_seq_append(seq, t, ctx);
+    return ndt_type_seq_append(seq, t, arena, ctx);
 }
 %}
 
@@ -293,6 +310,7 @@ broadcast_seq_append(ndt_type_seq_t *seq, ndt_t *type, ndt_context_t *ctx)
   #include <ctype.h>
   #include <assert.h>
   #include "ndtypes.h"
+  #include "arena.h"
   #include "parsefuncs.h"
   #include "seq.h"
   #include "overflow.h"
@@ -303,7 +321,7 @@ broadcast_seq_append(ndt_type_seq_t *seq, ndt_t *type, ndt_context_t *ctx)
 %code provides {
   #define YY_DECL extern int ndt_bplexfunc(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner, ndt_context_t *ctx)
   extern int ndt_bplexfunc(YYSTYPE *, YYLTYPE *, yyscan_t, ndt_context_t *);
-  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_context_t *ctx, const char *msg);
+  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_arena_t *arena, ndt_context_t *ctx, const char *msg);
 }
 
 
@@ -320,7 +338,7 @@ broadcast_seq_append(ndt_type_seq_t *seq, ndt_t *type, ndt_context_t *ctx)
 }
 
 %lex-param   {yyscan_t scanner} {ndt_context_t *ctx}
-%parse-param {yyscan_t scanner} {ndt_t **ast} {ndt_context_t *ctx}
+%parse-param {yyscan_t scanner} {ndt_t **ast} {ndt_arena_t *arena} {ndt_context_t *ctx}
 
 %union {
     ndt_t *ndt;
@@ -367,7 +385,7 @@ ERRTOKEN
 %token ENDMARKER 0 "end of file"
 
 %destructor { ndt_del($$); } <ndt>
-%destructor { ndt_field_del($$); } <field>
+%destructor { ndt_field_clear($$); } <field>
 %destructor { ndt_field_seq_del($$); } <field_seq>
 %destructor { ndt_string_seq_del($$); } <string_seq>
 %destructor { ndt_type_seq_del($$); } <type_seq>
@@ -384,8 +402,8 @@ datatype:
 | function                       { $$ = $1; }
 
 dimensions:
-  INTEGER                  { $$ = ndt_string_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| dimensions COMMA INTEGER { $$ = ndt_string_seq_append($1, $3, ctx); if ($$ == NULL) YYABORT; }
+  INTEGER                  { $$ = ndt_string_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| dimensions COMMA INTEGER { $$ = ndt_string_seq_append($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
 
 dtype:
   modifier DTYPE { $$ = make_dtype($1, $2, ctx); if ($$ == NULL) YYABORT; }
@@ -396,18 +414,18 @@ record:
   RECORD LBRACE field_seq RBRACE { $$ = make_record($3, ctx); if ($$ == NULL) YYABORT; }
 
 field_seq:
-  field           { $$ = ndt_field_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| field_seq field { $$ = ndt_field_seq_append($1, $2, ctx); if ($$ == NULL) YYABORT; }
+  field           { $$ = ndt_field_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| field_seq field { $$ = ndt_field_seq_append($1, $2, arena, ctx); if ($$ == NULL) YYABORT; }
 
 field:
-  datatype COLON NAME COLON padding { $$ = make_field($3, $1, $5, ctx); if ($$ == NULL) YYABORT; }
+  datatype COLON NAME COLON padding { $$ = make_field($3, $1, $5, arena, ctx); if ($$ == NULL) YYABORT; }
 
 function:
   dtype_seq RARROW dtype_seq { $$ = mk_function($1, $3, ctx); if ($$ == NULL) YYABORT; }
 
 dtype_seq:
-  dtype           { $$ = broadcast_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| dtype_seq dtype { $$ = broadcast_seq_append($1, $2, ctx); if ($$ == NULL) YYABORT; }
+  dtype           { $$ = broadcast_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| dtype_seq dtype { $$ = broadcast_seq_append($1, $2, arena, ctx); if ($$ == NULL) YYABORT; }
 
 modifier:
  %empty   { $$ = '@'; }
@@ -35,6 +35,8 @@
 #include <assert.h>
 #include <setjmp.h>
 #include "ndtypes.h"
+#include "arena.h"
+#include "typecache.h"
 #include "bpgrammar.h"
 #include "bplexer.h"
 
@@ -49,8 +51,10 @@ int ndt_bpdebug = 1;
 jmp_buf ndt_bp_lexerror;
 
 
-ndt_t *
-ndt_from_bpformat(const char *input, ndt_context_t *ctx)
+/* Parse-time temporaries are allocated from the arena, which belongs to
+   the caller of the function that uses setjmp(). */
+static ndt_t *
+parse_bpformat(const char *input, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     volatile yyscan_t scanner = NULL;
     volatile YY_BUFFER_STATE state = NULL;
@@ -66,7 +70,7 @@ ndt_from_bpformat(const char *input, ndt_context_t *ctx)
         return NULL;
     }
 
-    buffer = ndt_alloc_size(size+2);
+    buffer = ndt_arena_alloc(arena, 1, size+2);
     if (buffer == NULL) {
         return ndt_memory_error(ctx);
     }
@@ -77,7 +81,6 @@ ndt_from_bpformat(const char *input, ndt_context_t *ctx)
     if (setjmp(ndt_bp_lexerror) == 0) {
         if (ndt_bplex_init_extra(ctx, (yyscan_t *)&scanner) != 0) {
             ndt_err_format(ctx, NDT_LexError, "lexer initialization failed");
-            ndt_free(buffer);
             return NULL;
         }
 
@@ -85,10 +88,9 @@ ndt_from_bpformat(const char *input, ndt_context_t *ctx)
         state->yy_bs_lineno = 1;
         state->yy_bs_column = 1;
 
-        ret = ndt_bpparse(scanner, &ast, ctx);
+        ret = ndt_bpparse(scanner, &ast, arena, ctx);
         ndt_bp_delete_buffer(state, scanner);
         ndt_bplex_destroy(scanner);
-        ndt_free(buffer);
 
         if (ret == 2) {
             ndt_err_format(ctx, NDT_MemoryError, "out of memory");
@@ -103,8 +105,29 @@ ndt_from_bpformat(const char *input, ndt_context_t *ctx)
         if (scanner) {
             ndt_bplex_destroy(scanner);
         }
-        ndt_free(buffer);
         ndt_err_format(ctx, NDT_MemoryError, "flex: internal lexer error");
         return NULL;
     }
 }
+
+ndt_t *
+ndt_from_bpformat(const char *input, ndt_context_t *ctx)
+{
+    ndt_arena_t arena;
+    ndt_t *t;
+
+    t = ndt_type_cache_lookup(BpFormatSyntax, input);
+    if (t != NULL) {
+        return t;
+    }
+
+    ndt_arena_init(&arena);
+    t = parse_bpformat(input, &arena, ctx);
+    ndt_arena_clear(&arena);
+
+    if (t != NULL) {
+        ndt_type_cache_insert(BpFormatSyntax, input, t);
+    }
+
+    return t;
+}
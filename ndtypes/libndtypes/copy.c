@@ -57,6 +57,7 @@ ndt_copy_var_dim(const ndt_t *t, ndt_context_t *ctx)
 
     assert(t->tag == VarDim);
 
+    /* Nested var dimensions must all use external offsets. */
     type = ndt_copy(t->VarDim.type, ctx);
     if (type == NULL) {
         return NULL;
@@ -78,11 +79,12 @@ ndt_copy_var_dim(const ndt_t *t, ndt_context_t *ctx)
                nslices * (sizeof *slices));
     }
 
-    return ndt_var_dim(type, ExternalOffsets,
-                       t->Concrete.VarDim.noffsets,
-                       t->Concrete.VarDim.offsets,
-                       nslices,
-                       slices, ctx);
+    return ndt_var_dim_typed(type, ExternalOffsets,
+                             t->Concrete.VarDim.offset_type,
+                             t->Concrete.VarDim.noffsets,
+                             t->Concrete.VarDim.offsets,
+                             nslices,
+                             slices, ctx);
 }
 
 static ndt_t *
@@ -103,11 +105,7 @@ ndt_copy_function(const ndt_t *t, ndt_context_t *ctx)
     copy_common(u, t);
 
     for (i = 0; i < t->Function.nargs; i++) {
-        u->Function.types[i] = ndt_copy(t->Function.types[i], ctx);
-        if (u->Function.types[i] == NULL) {
-            ndt_del(u);
-            return NULL;
-        }
+        u->Function.types[i] = ndt_incref(t->Function.types[i]);
     }
 
     return u;
@@ -129,11 +127,7 @@ ndt_copy_tuple(const ndt_t *t, ndt_context_t *ctx)
     copy_common(u, t);
 
     for (i = 0; i < t->Tuple.shape; i++) {
-        u->Tuple.types[i] = ndt_copy(t->Tuple.types[i], ctx);
-        if (u->Tuple.types[i] == NULL) {
-            ndt_del(u);
-            return NULL;
-        }
+        u->Tuple.types[i] = ndt_incref(t->Tuple.types[i]);
 
         u->Concrete.Tuple.offset[i] = t->Concrete.Tuple.offset[i];
         u->Concrete.Tuple.align[i] = t->Concrete.Tuple.align[i];
@@ -165,11 +159,7 @@ ndt_copy_record(const ndt_t *t, ndt_context_t *ctx)
             return NULL;
         }
 
-        u->Record.types[i] = ndt_copy(t->Record.types[i], ctx);
-        if (u->Record.types[i] == NULL) {
-            ndt_del(u);
-            return NULL;
-        }
+        u->Record.types[i] = ndt_incref(t->Record.types[i]);
 
         u->Concrete.Record.offset[i] = t->Concrete.Record.offset[i];
         u->Concrete.Record.align[i] = t->Concrete.Record.align[i];
@@ -234,12 +224,14 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
     ndt_t *u = NULL;
     ndt_t *type;
 
+    /* Interned types are immutable and shared. */
+    if (t->interned) {
+        return ndt_incref(t);
+    }
+
     switch (t->tag) {
     case FixedDim: {
-        type = ndt_copy(t->FixedDim.type, ctx);
-        if (type == NULL) {
-            return NULL;
-        }
+        type = ndt_incref(t->FixedDim.type);
 
         u = ndt_fixed_dim(type, t->FixedDim.shape, t->Concrete.FixedDim.step, ctx);
         goto copy_common_fields;
@@ -253,10 +245,7 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
     case SymbolicDim: {
         char *name;
 
-        type = ndt_copy(t->SymbolicDim.type, ctx);
-        if (type == NULL) {
-            return NULL;
-        }
+        type = ndt_incref(t->SymbolicDim.type);
 
         name = ndt_strdup(t->SymbolicDim.name, ctx);
         if (name == NULL) {
@@ -271,10 +260,7 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
     case EllipsisDim: {
         char *name = NULL;
 
-        type = ndt_copy(t->EllipsisDim.type, ctx);
-        if (type == NULL) {
-            return NULL;
-        }
+        type = ndt_incref(t->EllipsisDim.type);
 
         if (t->EllipsisDim.name != NULL) {
             name = ndt_strdup(t->SymbolicDim.name, ctx);
@@ -297,10 +283,7 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
     }
 
     case Ref: {
-        type = ndt_copy(t->Ref.type, ctx);
-        if (type == NULL) {
-            return NULL;
-        }
+        type = ndt_incref(t->Ref.type);
 
         u = ndt_ref(type, ctx);
         goto copy_common_fields;
@@ -312,11 +295,7 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
             return NULL;
         }
 
-        type = ndt_copy(t->Constr.type, ctx);
-        if (type == NULL) {
-            ndt_free(name);
-            return NULL;
-        }
+        type = ndt_incref(t->Constr.type);
 
         u = ndt_constr(name, type, ctx);
         goto copy_common_fields;
@@ -328,11 +307,7 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
             return NULL;
         }
 
-        type = ndt_copy(t->Nominal.type, ctx);
-        if (type == NULL) {
-            ndt_free(name);
-            return NULL;
-        }
+        type = ndt_incref(t->Nominal.type);
 
         u = ndt_nominal(name, type, ctx);
         goto copy_common_fields;
@@ -362,10 +337,7 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
     case Module: {
         char *name;
 
-        type = ndt_copy(t->Module.type, ctx);
-        if (type == NULL) {
-            return NULL;
-        }
+        type = ndt_incref(t->Module.type);
 
         name = ndt_strdup(t->Module.name, ctx);
         if (name == NULL) {
@@ -395,6 +367,7 @@ ndt_copy(const ndt_t *t, ndt_context_t *ctx)
             return NULL;
         }
         *u = *t;
+        u->refcnt = 1;
         return u;
       }
     }
@@ -436,9 +409,9 @@ fixed_copy_contiguous(const ndt_t *t, ndt_t *type, ndt_context_t *ctx)
 
 typedef struct {
     int maxdim;
-    int32_t index[NDT_MAX_DIM+1];
-    int32_t noffsets[NDT_MAX_DIM+1];
-    int32_t *offsets[NDT_MAX_DIM+1];
+    int64_t index[NDT_MAX_DIM+1];
+    int64_t noffsets[NDT_MAX_DIM+1];
+    int64_t *offsets[NDT_MAX_DIM+1];
 } offsets_t;
 
 static void
@@ -450,12 +423,12 @@ clear_offsets(offsets_t *m)
 }
 
 static int
-var_init_offsets(offsets_t *m, const ndt_t *t, int32_t noffsets, ndt_context_t *ctx)
+var_init_offsets(offsets_t *m, const ndt_t *t, int64_t noffsets, ndt_context_t *ctx)
 {
-    int32_t *offsets;
+    int64_t *offsets;
     int64_t shape, start, step;
     int64_t sum;
-    int32_t i;
+    int64_t i;
 
     assert(t->ndim >= 1);
 
@@ -481,7 +454,7 @@ var_init_offsets(offsets_t *m, const ndt_t *t, int32_t noffsets, ndt_context_t *
         sum += shape;
     }
 
-    return var_init_offsets(m, t->VarDim.type, (int32_t)sum+1, ctx);
+    return var_init_offsets(m, t->VarDim.type, sum+1, ctx);
 }
 
 static int
@@ -498,8 +471,8 @@ var_copy_shapes(offsets_t *m, int64_t src_index, const ndt_t *t, ndt_context_t *
         clear_offsets(m);
         return -1;
     }
-    int32_t dst_index = m->index[t->ndim]++;
-    m->offsets[t->ndim][dst_index] = (int32_t)shape;
+    int64_t dst_index = m->index[t->ndim]++;
+    m->offsets[t->ndim][dst_index] = shape;
 
     for (int64_t i = 0; i < shape; i++) {
         int64_t src_next = start + i * step;
@@ -515,18 +488,38 @@ var_copy_shapes(offsets_t *m, int64_t src_index, const ndt_t *t, ndt_context_t *
 static void
 var_sum_shapes(offsets_t *m)
 {
-    int i, k;
+    int64_t k;
+    int i;
 
     for (i = 1; i <= m->maxdim; i++) {
-        int32_t sum = 0;
+        int64_t sum = 0;
         for (k = 0; k < m->noffsets[i]; k++) {
-            int32_t s = m->offsets[i][k];
+            int64_t s = m->offsets[i][k];
             m->offsets[i][k] = sum;
             sum += s;
         }
    }
 }
 
+/* The offsets are stored as int32_t unless the dimension is too large. */
+static ndt_t *
+var_dim_from_offsets(ndt_t *type, int64_t noffsets, int64_t *offsets,
+                     ndt_context_t *ctx)
+{
+    void *v = offsets;
+    int offset_type;
+
+    offset_type = ndt_compact_offsets(&v, noffsets, ctx);
+    if (offset_type < 0) {
+        ndt_free(offsets);
+        ndt_del(type);
+        return NULL;
+    }
+
+    return ndt_var_dim_typed(type, InternalOffsets, offset_type, noffsets, v,
+                             0, NULL, ctx);
+}
+
 ndt_t *
 var_from_offsets_and_dtype(offsets_t *m, ndt_t *type, ndt_context_t *ctx)
 {
@@ -534,8 +527,7 @@ var_from_offsets_and_dtype(offsets_t *m, ndt_t *type, ndt_context_t *ctx)
     int i;
 
     for (i=1, t=type; i <= m->maxdim; i++, type=t) {
-        t = ndt_var_dim(type, InternalOffsets, m->noffsets[i], m->offsets[i],
-                        0, NULL, ctx);
+        t = var_dim_from_offsets(type, m->noffsets[i], m->offsets[i], ctx);
         m->offsets[i] = NULL;
         if (t == NULL) {
             clear_offsets(m);
@@ -595,10 +587,7 @@ ndt_copy_contiguous_dtype(const ndt_t *t, ndt_t *dtype, ndt_context_t *ctx)
 ndt_t *
 ndt_copy_contiguous(const ndt_t *t, ndt_context_t *ctx)
 {
-    ndt_t *dtype = ndt_copy(ndt_dtype(t), ctx);
-    if (dtype == NULL) {
-        return NULL;
-    }
+    ndt_t *dtype = ndt_incref(ndt_dtype(t));
 
     return ndt_copy_contiguous_dtype(t, dtype, ctx);
 }
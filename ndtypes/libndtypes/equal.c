@@ -33,6 +33,7 @@
 
 #include <stdio.h>
 #include <stdlib.h>
+#include <stdint.h>
 #include <string.h>
 #include <assert.h>
 #include "ndtypes.h"
@@ -135,9 +136,45 @@ categorical_equal(ndt_value_t *t, ndt_value_t *u, int64_t shape)
     return 1;
 }
 
+/* Offsets are equal if the values are equal, regardless of their width. */
+static int
+offsets_equal(const ndt_t *t, const ndt_t *u)
+{
+    const int64_t noffsets = t->Concrete.VarDim.noffsets;
+    int64_t i;
+
+    if (noffsets == 0) {
+        return 1;
+    }
+
+    if (t->Concrete.VarDim.offset_type == u->Concrete.VarDim.offset_type) {
+        const size_t size = t->Concrete.VarDim.offset_type == Int64Offsets ?
+                            sizeof(int64_t) : sizeof(int32_t);
+        return memcmp(t->Concrete.VarDim.offsets, u->Concrete.VarDim.offsets,
+                      (size_t)noffsets * size) == 0;
+    }
+
+    for (i = 0; i < noffsets; i++) {
+        if (ndt_var_offset(t, i) != ndt_var_offset(u, i)) {
+            return 0;
+        }
+    }
+
+    return 1;
+}
+
 int
 ndt_equal(const ndt_t *t, const ndt_t *u)
 {
+    if (t == u) {
+        return 1;
+    }
+
+    /* Distinct interned types are never equal. */
+    if (t->interned && u->interned) {
+        return 0;
+    }
+
     if (!ndt_common_equal(t, u)) {
         return 0;
     }
@@ -172,8 +209,7 @@ ndt_equal(const ndt_t *t, const ndt_t *u)
             return 0;
         }
 
-        if (memcmp(t->Concrete.VarDim.offsets, u->Concrete.VarDim.offsets,
-                   t->Concrete.VarDim.noffsets * (sizeof *t->Concrete.VarDim.offsets)) ||
+        if (!offsets_equal(t, u) ||
             memcmp(t->Concrete.VarDim.slices, u->Concrete.VarDim.slices,
                    t->Concrete.VarDim.nslices * (sizeof *t->Concrete.VarDim.slices))) {
             return 0;
@@ -280,3 +316,165 @@ ndt_equal(const ndt_t *t, const ndt_t *u)
     /* NOT REACHED: tags should be exhaustive. */
     ndt_internal_error("invalid type");
 }
+
+/*
+ * Return 1 if 't' and 'u' are categorical types with the same categories.
+ * Unlike ndt_equal(), the code width and the flags are not compared, so
+ * values can be converted between the types.
+ */
+int
+ndt_categories_equal(const ndt_t *t, const ndt_t *u)
+{
+    if (t->tag != Categorical || u->tag != Categorical ||
+        t->Categorical.ntypes != u->Categorical.ntypes) {
+        return 0;
+    }
+
+    return categorical_equal(t->Categorical.types, u->Categorical.types,
+                             t->Categorical.ntypes);
+}
+
+
+/*****************************************************************************/
+/*                            Structural hash                                */
+/*****************************************************************************/
+
+/*
+ * Equal types (in the sense of ndt_equal) have equal hashes.  The hash of
+ * interned types is cached.
+ */
+
+static inline uint64_t
+hash_combine(uint64_t h, uint64_t v)
+{
+    return (h * 1000003U) ^ v;
+}
+
+static uint64_t
+hash_string(uint64_t h, const char *s)
+{
+    const unsigned char *cp = (const unsigned char *)s;
+
+    while (*cp != '\0') {
+        h = hash_combine(h, *cp++);
+    }
+
+    return h;
+}
+
+uint64_t
+ndt_structural_hash(const ndt_t *t)
+{
+    uint64_t h = 0x345678U;
+    int64_t i;
+
+    if (t->interned) {
+        return t->hash;
+    }
+
+    h = hash_combine(h, (uint64_t)t->tag);
+    h = hash_combine(h, (uint64_t)t->access);
+    h = hash_combine(h, (uint64_t)t->flags);
+    h = hash_combine(h, (uint64_t)t->ndim);
+    h = hash_combine(h, (uint64_t)t->datasize);
+    h = hash_combine(h, (uint64_t)t->align);
+
+    switch (t->tag) {
+    case Module:
+        h = hash_string(h, t->Module.name);
+        return hash_combine(h, ndt_structural_hash(t->Module.type));
+
+    case Function:
+        h = hash_combine(h, (uint64_t)t->Function.nin);
+        h = hash_combine(h, (uint64_t)t->Function.nout);
+        for (i = 0; i < t->Function.nargs; i++) {
+            h = hash_combine(h, ndt_structural_hash(t->Function.types[i]));
+        }
+        return h;
+
+    case FixedDim:
+        h = hash_combine(h, (uint64_t)t->FixedDim.shape);
+        h = hash_combine(h, (uint64_t)t->Concrete.FixedDim.itemsize);
+        h = hash_combine(h, (uint64_t)t->Concrete.FixedDim.step);
+        return hash_combine(h, ndt_structural_hash(t->FixedDim.type));
+
+    case VarDim:
+        /* The offsets and slices are not hashed. */
+        h = hash_combine(h, (uint64_t)t->Concrete.VarDim.itemsize);
+        h = hash_combine(h, (uint64_t)t->Concrete.VarDim.noffsets);
+        h = hash_combine(h, (uint64_t)t->Concrete.VarDim.nslices);
+        return hash_combine(h, ndt_structural_hash(t->VarDim.type));
+
+    case SymbolicDim:
+        h = hash_string(h, t->SymbolicDim.name);
+        return hash_combine(h, ndt_structural_hash(t->SymbolicDim.type));
+
+    case EllipsisDim:
+        if (t->EllipsisDim.name != NULL) {
+            h = hash_string(h, t->EllipsisDim.name);
+        }
+        return hash_combine(h, ndt_structural_hash(t->EllipsisDim.type));
+
+    case Tuple:
+        h = hash_combine(h, (uint64_t)t->Tuple.flag);
+        for (i = 0; i < t->Tuple.shape; i++) {
+            h = hash_combine(h, ndt_structural_hash(t->Tuple.types[i]));
+        }
+        return h;
+
+    case Record:
+        h = hash_combine(h, (uint64_t)t->Record.flag);
+        for (i = 0; i < t->Record.shape; i++) {
+            h = hash_string(h, t->Record.names[i]);
+            h = hash_combine(h, ndt_structural_hash(t->Record.types[i]));
+        }
+        return h;
+
+    case Ref:
+        return hash_combine(h, ndt_structural_hash(t->Ref.type));
+
+    case Constr:
+        h = hash_string(h, t->Constr.name);
+        return hash_combine(h, ndt_structural_hash(t->Constr.type));
+
+    case Nominal:
+        h = hash_string(h, t->Nominal.name);
+        return hash_combine(h, ndt_structural_hash(t->Nominal.type));
+
+    case Categorical:
+        return hash_combine(h, (uint64_t)t->Categorical.ntypes);
+
+    case FixedString:
+        h = hash_combine(h, (uint64_t)t->FixedString.size);
+        return hash_combine(h, (uint64_t)t->FixedString.encoding);
+
+    case FixedBytes:
+        h = hash_combine(h, (uint64_t)t->FixedBytes.size);
+        return hash_combine(h, (uint64_t)t->FixedBytes.align);
+
+    case Bytes:
+        return hash_combine(h, (uint64_t)t->Bytes.target_align);
+
+    case Char:
+        return hash_combine(h, (uint64_t)t->Char.encoding);
+
+    case Typevar:
+        return hash_string(h, t->Typevar.name);
+
+    case AnyKind:
+    case ScalarKind:
+    case SignedKind: case UnsignedKind:
+    case FloatKind: case ComplexKind:
+    case FixedStringKind: case FixedBytesKind:
+    case Bool:
+    case Int8: case Int16: case Int32: case Int64:
+    case Uint8: case Uint16: case Uint32: case Uint64:
+    case Float16: case Float32: case Float64:
+    case Complex32: case Complex64: case Complex128:
+    case String:
+        return h;
+    }
+
+    /* NOT REACHED: tags should be exhaustive. */
+    ndt_internal_error("invalid type");
+}
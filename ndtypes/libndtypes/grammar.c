@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison implementation for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -33,6 +34,10 @@
 /* C LALR(1) parser skeleton written by Richard Stallman, by
    simplifying the original so-called "semantic" parser.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 /* All symbols defined below should begin with yy or YY, to avoid
    infringing on user name space.  This should be done even for local
    variables, as they might otherwise be expanded by user macros.
@@ -40,11 +45,11 @@
    define necessary library symbols; they are noted "INFRINGES ON
    USER NAME SPACE" below.  */
 
-/* Identify Bison output.  */
-#define YYBISON 1
+/* Identify Bison output, and Bison version.  */
+#define YYBISON 30802
 
-/* Bison version.  */
-#define YYBISON_VERSION "3.0.4"
+/* Bison version string.  */
+#define YYBISON_VERSION "3.8.2"
 
 /* Skeleton name.  */
 #define YYSKELETON_NAME "yacc.c"
@@ -66,9 +71,8 @@
 #define yydebug         ndt_yydebug
 #define yynerrs         ndt_yynerrs
 
-
-/* Copy the first part of user declarations.  */
-#line 1 "grammar.y" /* yacc.c:339  */
+/* First part of user prologue.  */
+#line 1 "grammar.y"
 
 /*
  * BSD 3-Clause License
@@ -108,11 +112,12 @@
 
 void
 yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta,
-        ndt_context_t *ctx, const char *msg)
+        ndt_arena_t *arena, ndt_context_t *ctx, const char *msg)
 {
     (void)scanner;
     (void)ast;
     (void)meta;
+    (void)arena;
 
     ndt_err_format(ctx, NDT_ParseError, "%d:%d: %s", loc->first_line,
                    loc->first_column, msg);
@@ -124,205 +129,233 @@ yylex(YYSTYPE *val, YYLTYPE *loc, yyscan_t scanner, ndt_context_t *ctx)
     return ndt_yylexfunc(val, loc, scanner, ctx);
 }
 
-#line 128 "grammar.c" /* yacc.c:339  */
+#line 133 "grammar.c"
 
+# ifndef YY_CAST
+#  ifdef __cplusplus
+#   define YY_CAST(Type, Val) static_cast<Type> (Val)
+#   define YY_REINTERPRET_CAST(Type, Val) reinterpret_cast<Type> (Val)
+#  else
+#   define YY_CAST(Type, Val) ((Type) (Val))
+#   define YY_REINTERPRET_CAST(Type, Val) ((Type) (Val))
+#  endif
+# endif
 # ifndef YY_NULLPTR
-#  if defined __cplusplus && 201103L <= __cplusplus
-#   define YY_NULLPTR nullptr
+#  if defined __cplusplus
+#   if 201103L <= __cplusplus
+#    define YY_NULLPTR nullptr
+#   else
+#    define YY_NULLPTR 0
+#   endif
 #  else
-#   define YY_NULLPTR 0
+#   define YY_NULLPTR ((void*)0)
 #  endif
 # endif
 
-/* Enabling verbose error messages.  */
-#ifdef YYERROR_VERBOSE
-# undef YYERROR_VERBOSE
-# define YYERROR_VERBOSE 1
-#else
-# define YYERROR_VERBOSE 1
-#endif
-
-/* In a future release of Bison, this section will be replaced
-   by #include "grammar.h".  */
-#ifndef YY_NDT_YY_GRAMMAR_H_INCLUDED
-# define YY_NDT_YY_GRAMMAR_H_INCLUDED
-/* Debug traces.  */
-#ifndef YYDEBUG
-# define YYDEBUG 0
-#endif
-#if YYDEBUG
-extern int ndt_yydebug;
-#endif
-/* "%code requires" blocks.  */
-#line 57 "grammar.y" /* yacc.c:355  */
-
-  #include "ndtypes.h"
-  #include "seq.h"
-  #include "attr.h"
-  #include "parsefuncs.h"
-  #define YY_TYPEDEF_YY_SCANNER_T
-  typedef void * yyscan_t;
-
-#line 167 "grammar.c" /* yacc.c:355  */
-
-/* Token type.  */
-#ifndef YYTOKENTYPE
-# define YYTOKENTYPE
-  enum yytokentype
-  {
-    ENDMARKER = 0,
-    ANY_KIND = 258,
-    SCALAR_KIND = 259,
-    VOID = 260,
-    BOOL = 261,
-    SIGNED_KIND = 262,
-    INT8 = 263,
-    INT16 = 264,
-    INT32 = 265,
-    INT64 = 266,
-    UNSIGNED_KIND = 267,
-    UINT8 = 268,
-    UINT16 = 269,
-    UINT32 = 270,
-    UINT64 = 271,
-    FLOAT_KIND = 272,
-    FLOAT16 = 273,
-    FLOAT32 = 274,
-    FLOAT64 = 275,
-    COMPLEX_KIND = 276,
-    COMPLEX32 = 277,
-    COMPLEX64 = 278,
-    COMPLEX128 = 279,
-    CATEGORICAL = 280,
-    NA = 281,
-    INTPTR = 282,
-    UINTPTR = 283,
-    SIZE = 284,
-    CHAR = 285,
-    STRING = 286,
-    FIXED_STRING_KIND = 287,
-    FIXED_STRING = 288,
-    BYTES = 289,
-    FIXED_BYTES_KIND = 290,
-    FIXED_BYTES = 291,
-    REF = 292,
-    FIXED = 293,
-    VAR = 294,
-    COMMA = 295,
-    COLON = 296,
-    LPAREN = 297,
-    RPAREN = 298,
-    LBRACE = 299,
-    RBRACE = 300,
-    LBRACK = 301,
-    RBRACK = 302,
-    STAR = 303,
-    ELLIPSIS = 304,
-    RARROW = 305,
-    EQUAL = 306,
-    LESS = 307,
-    GREATER = 308,
-    QUESTIONMARK = 309,
-    BANG = 310,
-    AMPERSAND = 311,
-    BAR = 312,
-    ERRTOKEN = 313,
-    INTEGER = 314,
-    FLOATNUMBER = 315,
-    STRINGLIT = 316,
-    NAME_LOWER = 317,
-    NAME_UPPER = 318,
-    NAME_OTHER = 319
-  };
-#endif
-
-/* Value type.  */
-#if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
-union YYSTYPE
+#include "grammar.h"
+/* Symbol kind.  */
+enum yysymbol_kind_t
 {
-#line 86 "grammar.y" /* yacc.c:355  */
-
-    ndt_t *ndt;
-    ndt_field_t *field;
-    ndt_field_seq_t *field_seq;
-    ndt_value_t *typed_value;
-    ndt_value_seq_t *typed_value_seq;
-    ndt_attr_t *attribute;
-    ndt_attr_seq_t *attribute_seq;
-    enum ndt_variadic variadic_flag;
-    enum ndt_encoding encoding;
-    uint32_t uint32;
-    char *string;
-    ndt_string_seq_t *string_seq;
-    ndt_type_seq_t *type_seq;
-
-#line 261 "grammar.c" /* yacc.c:355  */
+  YYSYMBOL_YYEMPTY = -2,
+  YYSYMBOL_YYEOF = 0,                      /* "end of file"  */
+  YYSYMBOL_YYerror = 1,                    /* error  */
+  YYSYMBOL_YYUNDEF = 2,                    /* "invalid token"  */
+  YYSYMBOL_ANY_KIND = 3,                   /* ANY_KIND  */
+  YYSYMBOL_SCALAR_KIND = 4,                /* SCALAR_KIND  */
+  YYSYMBOL_VOID = 5,                       /* VOID  */
+  YYSYMBOL_BOOL = 6,                       /* BOOL  */
+  YYSYMBOL_SIGNED_KIND = 7,                /* SIGNED_KIND  */
+  YYSYMBOL_INT8 = 8,                       /* INT8  */
+  YYSYMBOL_INT16 = 9,                      /* INT16  */
+  YYSYMBOL_INT32 = 10,                     /* INT32  */
+  YYSYMBOL_INT64 = 11,                     /* INT64  */
+  YYSYMBOL_UNSIGNED_KIND = 12,             /* UNSIGNED_KIND  */
+  YYSYMBOL_UINT8 = 13,                     /* UINT8  */
+  YYSYMBOL_UINT16 = 14,                    /* UINT16  */
+  YYSYMBOL_UINT32 = 15,                    /* UINT32  */
+  YYSYMBOL_UINT64 = 16,                    /* UINT64  */
+  YYSYMBOL_FLOAT_KIND = 17,                /* FLOAT_KIND  */
+  YYSYMBOL_FLOAT16 = 18,                   /* FLOAT16  */
+  YYSYMBOL_FLOAT32 = 19,                   /* FLOAT32  */
+  YYSYMBOL_FLOAT64 = 20,                   /* FLOAT64  */
+  YYSYMBOL_COMPLEX_KIND = 21,              /* COMPLEX_KIND  */
+  YYSYMBOL_COMPLEX32 = 22,                 /* COMPLEX32  */
+  YYSYMBOL_COMPLEX64 = 23,                 /* COMPLEX64  */
+  YYSYMBOL_COMPLEX128 = 24,                /* COMPLEX128  */
+  YYSYMBOL_CATEGORICAL = 25,               /* CATEGORICAL  */
+  YYSYMBOL_NA = 26,                        /* NA  */
+  YYSYMBOL_INTPTR = 27,                    /* INTPTR  */
+  YYSYMBOL_UINTPTR = 28,                   /* UINTPTR  */
+  YYSYMBOL_SIZE = 29,                      /* SIZE  */
+  YYSYMBOL_CHAR = 30,                      /* CHAR  */
+  YYSYMBOL_STRING = 31,                    /* STRING  */
+  YYSYMBOL_FIXED_STRING_KIND = 32,         /* FIXED_STRING_KIND  */
+  YYSYMBOL_FIXED_STRING = 33,              /* FIXED_STRING  */
+  YYSYMBOL_BYTES = 34,                     /* BYTES  */
+  YYSYMBOL_FIXED_BYTES_KIND = 35,          /* FIXED_BYTES_KIND  */
+  YYSYMBOL_FIXED_BYTES = 36,               /* FIXED_BYTES  */
+  YYSYMBOL_REF = 37,                       /* REF  */
+  YYSYMBOL_FIXED = 38,                     /* FIXED  */
+  YYSYMBOL_VAR = 39,                       /* VAR  */
+  YYSYMBOL_COMMA = 40,                     /* COMMA  */
+  YYSYMBOL_COLON = 41,                     /* COLON  */
+  YYSYMBOL_LPAREN = 42,                    /* LPAREN  */
+  YYSYMBOL_RPAREN = 43,                    /* RPAREN  */
+  YYSYMBOL_LBRACE = 44,                    /* LBRACE  */
+  YYSYMBOL_RBRACE = 45,                    /* RBRACE  */
+  YYSYMBOL_LBRACK = 46,                    /* LBRACK  */
+  YYSYMBOL_RBRACK = 47,                    /* RBRACK  */
+  YYSYMBOL_STAR = 48,                      /* STAR  */
+  YYSYMBOL_ELLIPSIS = 49,                  /* ELLIPSIS  */
+  YYSYMBOL_RARROW = 50,                    /* RARROW  */
+  YYSYMBOL_EQUAL = 51,                     /* EQUAL  */
+  YYSYMBOL_LESS = 52,                      /* LESS  */
+  YYSYMBOL_GREATER = 53,                   /* GREATER  */
+  YYSYMBOL_QUESTIONMARK = 54,              /* QUESTIONMARK  */
+  YYSYMBOL_BANG = 55,                      /* BANG  */
+  YYSYMBOL_AMPERSAND = 56,                 /* AMPERSAND  */
+  YYSYMBOL_BAR = 57,                       /* BAR  */
+  YYSYMBOL_ERRTOKEN = 58,                  /* ERRTOKEN  */
+  YYSYMBOL_INTEGER = 59,                   /* INTEGER  */
+  YYSYMBOL_FLOATNUMBER = 60,               /* FLOATNUMBER  */
+  YYSYMBOL_STRINGLIT = 61,                 /* STRINGLIT  */
+  YYSYMBOL_NAME_LOWER = 62,                /* NAME_LOWER  */
+  YYSYMBOL_NAME_UPPER = 63,                /* NAME_UPPER  */
+  YYSYMBOL_NAME_OTHER = 64,                /* NAME_OTHER  */
+  YYSYMBOL_YYACCEPT = 65,                  /* $accept  */
+  YYSYMBOL_input = 66,                     /* input  */
+  YYSYMBOL_datashape_or_module = 67,       /* datashape_or_module  */
+  YYSYMBOL_datashape_with_ellipsis = 68,   /* datashape_with_ellipsis  */
+  YYSYMBOL_datashape = 69,                 /* datashape  */
+  YYSYMBOL_dimensions = 70,                /* dimensions  */
+  YYSYMBOL_dimensions_nooption = 71,       /* dimensions_nooption  */
+  YYSYMBOL_dimensions_tail = 72,           /* dimensions_tail  */
+  YYSYMBOL_dtype = 73,                     /* dtype  */
+  YYSYMBOL_scalar = 74,                    /* scalar  */
+  YYSYMBOL_signed = 75,                    /* signed  */
+  YYSYMBOL_unsigned = 76,                  /* unsigned  */
+  YYSYMBOL_ieee_float = 77,                /* ieee_float  */
+  YYSYMBOL_ieee_complex = 78,              /* ieee_complex  */
+  YYSYMBOL_alias = 79,                     /* alias  */
+  YYSYMBOL_character = 80,                 /* character  */
+  YYSYMBOL_string = 81,                    /* string  */
+  YYSYMBOL_fixed_string = 82,              /* fixed_string  */
+  YYSYMBOL_endian_opt = 83,                /* endian_opt  */
+  YYSYMBOL_encoding = 84,                  /* encoding  */
+  YYSYMBOL_bytes = 85,                     /* bytes  */
+  YYSYMBOL_fixed_bytes = 86,               /* fixed_bytes  */
+  YYSYMBOL_ref = 87,                       /* ref  */
+  YYSYMBOL_categorical = 88,               /* categorical  */
+  YYSYMBOL_typed_value_seq = 89,           /* typed_value_seq  */
+  YYSYMBOL_typed_value = 90,               /* typed_value  */
+  YYSYMBOL_variadic_flag = 91,             /* variadic_flag  */
+  YYSYMBOL_comma_variadic_flag = 92,       /* comma_variadic_flag  */
+  YYSYMBOL_tuple_type = 93,                /* tuple_type  */
+  YYSYMBOL_tuple_field_seq = 94,           /* tuple_field_seq  */
+  YYSYMBOL_tuple_field = 95,               /* tuple_field  */
+  YYSYMBOL_record_type = 96,               /* record_type  */
+  YYSYMBOL_record_field_seq = 97,          /* record_field_seq  */
+  YYSYMBOL_record_field = 98,              /* record_field  */
+  YYSYMBOL_record_field_name = 99,         /* record_field_name  */
+  YYSYMBOL_arguments_opt = 100,            /* arguments_opt  */
+  YYSYMBOL_attribute_seq = 101,            /* attribute_seq  */
+  YYSYMBOL_attribute = 102,                /* attribute  */
+  YYSYMBOL_untyped_value_seq = 103,        /* untyped_value_seq  */
+  YYSYMBOL_untyped_value = 104,            /* untyped_value  */
+  YYSYMBOL_function_type = 105,            /* function_type  */
+  YYSYMBOL_type_seq_or_void = 106,         /* type_seq_or_void  */
+  YYSYMBOL_type_seq = 107                  /* type_seq  */
 };
+typedef enum yysymbol_kind_t yysymbol_kind_t;
 
-typedef union YYSTYPE YYSTYPE;
-# define YYSTYPE_IS_TRIVIAL 1
-# define YYSTYPE_IS_DECLARED 1
-#endif
-
-/* Location type.  */
-#if ! defined YYLTYPE && ! defined YYLTYPE_IS_DECLARED
-typedef struct YYLTYPE YYLTYPE;
-struct YYLTYPE
-{
-  int first_line;
-  int first_column;
-  int last_line;
-  int last_column;
-};
-# define YYLTYPE_IS_DECLARED 1
-# define YYLTYPE_IS_TRIVIAL 1
-#endif
 
 
 
-int ndt_yyparse (yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx);
-/* "%code provides" blocks.  */
-#line 66 "grammar.y" /* yacc.c:355  */
-
-  #define YY_DECL extern int ndt_yylexfunc(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner, ndt_context_t *ctx)
-  extern int ndt_yylexfunc(YYSTYPE *, YYLTYPE *, yyscan_t, ndt_context_t *);
-  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx, const char *msg);
-
-#line 293 "grammar.c" /* yacc.c:355  */
+#ifdef short
+# undef short
+#endif
 
-#endif /* !YY_NDT_YY_GRAMMAR_H_INCLUDED  */
+/* On compilers that do not define __PTRDIFF_MAX__ etc., make sure
+   <limits.h> and (if available) <stdint.h> are included
+   so that the code can choose integer types of a good width.  */
 
-/* Copy the second part of user declarations.  */
+#ifndef __PTRDIFF_MAX__
+# include <limits.h> /* INFRINGES ON USER NAME SPACE */
+# if defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
+#  include <stdint.h> /* INFRINGES ON USER NAME SPACE */
+#  define YY_STDINT_H
+# endif
+#endif
 
-#line 299 "grammar.c" /* yacc.c:358  */
+/* Narrow types that promote to a signed type and that can represent a
+   signed or unsigned integer of at least N bits.  In tables they can
+   save space and decrease cache pressure.  Promoting to a signed type
+   helps avoid bugs in integer arithmetic.  */
 
-#ifdef short
-# undef short
+#ifdef __INT_LEAST8_MAX__
+typedef __INT_LEAST8_TYPE__ yytype_int8;
+#elif defined YY_STDINT_H
+typedef int_least8_t yytype_int8;
+#else
+typedef signed char yytype_int8;
 #endif
 
-#ifdef YYTYPE_UINT8
-typedef YYTYPE_UINT8 yytype_uint8;
+#ifdef __INT_LEAST16_MAX__
+typedef __INT_LEAST16_TYPE__ yytype_int16;
+#elif defined YY_STDINT_H
+typedef int_least16_t yytype_int16;
 #else
-typedef unsigned char yytype_uint8;
+typedef short yytype_int16;
 #endif
 
-#ifdef YYTYPE_INT8
-typedef YYTYPE_INT8 yytype_int8;
-#else
-typedef signed char yytype_int8;
+/* Work around bug in HP-UX 11.23, which defines these macros
+   incorrectly for preprocessor constants.  This workaround can likely
+   be removed in 2023, as HPE has promised support for HP-UX 11.23
+   (aka HP-UX 11i v2) only through the end of 2022; see Table 2 of
+   <https://h20195.www2.hpe.com/V2/getpdf.aspx/4AA4-7673ENW.pdf>.  */
+#ifdef __hpux
+# undef UINT_LEAST8_MAX
+# undef UINT_LEAST16_MAX
+# define UINT_LEAST8_MAX 255
+# define UINT_LEAST16_MAX 65535
 #endif
 
-#ifdef YYTYPE_UINT16
-typedef YYTYPE_UINT16 yytype_uint16;
+#if defined __UINT_LEAST8_MAX__ && __UINT_LEAST8_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST8_TYPE__ yytype_uint8;
+#elif (!defined __UINT_LEAST8_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST8_MAX <= INT_MAX)
+typedef uint_least8_t yytype_uint8;
+#elif !defined __UINT_LEAST8_MAX__ && UCHAR_MAX <= INT_MAX
+typedef unsigned char yytype_uint8;
 #else
-typedef unsigned short int yytype_uint16;
+typedef short yytype_uint8;
 #endif
 
-#ifdef YYTYPE_INT16
-typedef YYTYPE_INT16 yytype_int16;
+#if defined __UINT_LEAST16_MAX__ && __UINT_LEAST16_MAX__ <= __INT_MAX__
+typedef __UINT_LEAST16_TYPE__ yytype_uint16;
+#elif (!defined __UINT_LEAST16_MAX__ && defined YY_STDINT_H \
+       && UINT_LEAST16_MAX <= INT_MAX)
+typedef uint_least16_t yytype_uint16;
+#elif !defined __UINT_LEAST16_MAX__ && USHRT_MAX <= INT_MAX
+typedef unsigned short yytype_uint16;
 #else
-typedef short int yytype_int16;
+typedef int yytype_uint16;
+#endif
+
+#ifndef YYPTRDIFF_T
+# if defined __PTRDIFF_TYPE__ && defined __PTRDIFF_MAX__
+#  define YYPTRDIFF_T __PTRDIFF_TYPE__
+#  define YYPTRDIFF_MAXIMUM __PTRDIFF_MAX__
+# elif defined PTRDIFF_MAX
+#  ifndef ptrdiff_t
+#   include <stddef.h> /* INFRINGES ON USER NAME SPACE */
+#  endif
+#  define YYPTRDIFF_T ptrdiff_t
+#  define YYPTRDIFF_MAXIMUM PTRDIFF_MAX
+# else
+#  define YYPTRDIFF_T long
+#  define YYPTRDIFF_MAXIMUM LONG_MAX
+# endif
 #endif
 
 #ifndef YYSIZE_T
@@ -330,15 +363,28 @@ typedef short int yytype_int16;
 #  define YYSIZE_T __SIZE_TYPE__
 # elif defined size_t
 #  define YYSIZE_T size_t
-# elif ! defined YYSIZE_T
+# elif defined __STDC_VERSION__ && 199901 <= __STDC_VERSION__
 #  include <stddef.h> /* INFRINGES ON USER NAME SPACE */
 #  define YYSIZE_T size_t
 # else
-#  define YYSIZE_T unsigned int
+#  define YYSIZE_T unsigned
 # endif
 #endif
 
-#define YYSIZE_MAXIMUM ((YYSIZE_T) -1)
+#define YYSIZE_MAXIMUM                                  \
+  YY_CAST (YYPTRDIFF_T,                                 \
+           (YYPTRDIFF_MAXIMUM < YY_CAST (YYSIZE_T, -1)  \
+            ? YYPTRDIFF_MAXIMUM                         \
+            : YY_CAST (YYSIZE_T, -1)))
+
+#define YYSIZEOF(X) YY_CAST (YYPTRDIFF_T, sizeof (X))
+
+
+/* Stored state numbers (used for stacks). */
+typedef yytype_uint8 yy_state_t;
+
+/* State numbers in computations.  */
+typedef int yy_state_fast_t;
 
 #ifndef YY_
 # if defined YYENABLE_NLS && YYENABLE_NLS
@@ -352,47 +398,43 @@ typedef short int yytype_int16;
 # endif
 #endif
 
-#ifndef YY_ATTRIBUTE
-# if (defined __GNUC__                                               \
-      && (2 < __GNUC__ || (__GNUC__ == 2 && 96 <= __GNUC_MINOR__)))  \
-     || defined __SUNPRO_C && 0x5110 <= __SUNPRO_C
-#  define YY_ATTRIBUTE(Spec) __attribute__(Spec)
-# else
-#  define YY_ATTRIBUTE(Spec) /* empty */
-# endif
-#endif
 
 #ifndef YY_ATTRIBUTE_PURE
-# define YY_ATTRIBUTE_PURE   YY_ATTRIBUTE ((__pure__))
+# if defined __GNUC__ && 2 < __GNUC__ + (96 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_PURE __attribute__ ((__pure__))
+# else
+#  define YY_ATTRIBUTE_PURE
+# endif
 #endif
 
 #ifndef YY_ATTRIBUTE_UNUSED
-# define YY_ATTRIBUTE_UNUSED YY_ATTRIBUTE ((__unused__))
-#endif
-
-#if !defined _Noreturn \
-     && (!defined __STDC_VERSION__ || __STDC_VERSION__ < 201112)
-# if defined _MSC_VER && 1200 <= _MSC_VER
-#  define _Noreturn __declspec (noreturn)
+# if defined __GNUC__ && 2 < __GNUC__ + (7 <= __GNUC_MINOR__)
+#  define YY_ATTRIBUTE_UNUSED __attribute__ ((__unused__))
 # else
-#  define _Noreturn YY_ATTRIBUTE ((__noreturn__))
+#  define YY_ATTRIBUTE_UNUSED
 # endif
 #endif
 
 /* Suppress unused-variable warnings by "using" E.  */
 #if ! defined lint || defined __GNUC__
-# define YYUSE(E) ((void) (E))
+# define YY_USE(E) ((void) (E))
 #else
-# define YYUSE(E) /* empty */
+# define YY_USE(E) /* empty */
 #endif
 
-#if defined __GNUC__ && 407 <= __GNUC__ * 100 + __GNUC_MINOR__
 /* Suppress an incorrect diagnostic about yylval being uninitialized.  */
-# define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN \
-    _Pragma ("GCC diagnostic push") \
-    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")\
+#if defined __GNUC__ && ! defined __ICC && 406 <= __GNUC__ * 100 + __GNUC_MINOR__
+# if __GNUC__ * 100 + __GNUC_MINOR__ < 407
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")
+# else
+#  define YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN                           \
+    _Pragma ("GCC diagnostic push")                                     \
+    _Pragma ("GCC diagnostic ignored \"-Wuninitialized\"")              \
     _Pragma ("GCC diagnostic ignored \"-Wmaybe-uninitialized\"")
-# define YY_IGNORE_MAYBE_UNINITIALIZED_END \
+# endif
+# define YY_IGNORE_MAYBE_UNINITIALIZED_END      \
     _Pragma ("GCC diagnostic pop")
 #else
 # define YY_INITIAL_VALUE(Value) Value
@@ -405,8 +447,22 @@ typedef short int yytype_int16;
 # define YY_INITIAL_VALUE(Value) /* Nothing. */
 #endif
 
+#if defined __cplusplus && defined __GNUC__ && ! defined __ICC && 6 <= __GNUC__
+# define YY_IGNORE_USELESS_CAST_BEGIN                          \
+    _Pragma ("GCC diagnostic push")                            \
+    _Pragma ("GCC diagnostic ignored \"-Wuseless-cast\"")
+# define YY_IGNORE_USELESS_CAST_END            \
+    _Pragma ("GCC diagnostic pop")
+#endif
+#ifndef YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_BEGIN
+# define YY_IGNORE_USELESS_CAST_END
+#endif
 
-#if ! defined yyoverflow || YYERROR_VERBOSE
+
+#define YY_ASSERT(E) ((void) (0 && (E)))
+
+#if 1
 
 /* The parser invokes alloca or malloc; define the necessary symbols.  */
 
@@ -471,8 +527,7 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 #   endif
 #  endif
 # endif
-#endif /* ! defined yyoverflow || YYERROR_VERBOSE */
-
+#endif /* 1 */
 
 #if (! defined yyoverflow \
      && (! defined __cplusplus \
@@ -482,18 +537,19 @@ void free (void *); /* INFRINGES ON USER NAME SPACE */
 /* A type that is properly aligned for any stack member.  */
 union yyalloc
 {
-  yytype_int16 yyss_alloc;
+  yy_state_t yyss_alloc;
   YYSTYPE yyvs_alloc;
   YYLTYPE yyls_alloc;
 };
 
 /* The size of the maximum gap between one aligned stack and the next.  */
-# define YYSTACK_GAP_MAXIMUM (sizeof (union yyalloc) - 1)
+# define YYSTACK_GAP_MAXIMUM (YYSIZEOF (union yyalloc) - 1)
 
 /* The size of an array large to enough to hold all stacks, each with
    N elements.  */
 # define YYSTACK_BYTES(N) \
-     ((N) * (sizeof (yytype_int16) + sizeof (YYSTYPE) + sizeof (YYLTYPE)) \
+     ((N) * (YYSIZEOF (yy_state_t) + YYSIZEOF (YYSTYPE) \
+             + YYSIZEOF (YYLTYPE)) \
       + 2 * YYSTACK_GAP_MAXIMUM)
 
 # define YYCOPY_NEEDED 1
@@ -506,11 +562,11 @@ union yyalloc
 # define YYSTACK_RELOCATE(Stack_alloc, Stack)                           \
     do                                                                  \
       {                                                                 \
-        YYSIZE_T yynewbytes;                                            \
+        YYPTRDIFF_T yynewbytes;                                         \
         YYCOPY (&yyptr->Stack_alloc, Stack, yysize);                    \
         Stack = &yyptr->Stack_alloc;                                    \
-        yynewbytes = yystacksize * sizeof (*Stack) + YYSTACK_GAP_MAXIMUM; \
-        yyptr += yynewbytes / sizeof (*yyptr);                          \
+        yynewbytes = yystacksize * YYSIZEOF (*Stack) + YYSTACK_GAP_MAXIMUM; \
+        yyptr += yynewbytes / YYSIZEOF (*yyptr);                        \
       }                                                                 \
     while (0)
 
@@ -522,12 +578,12 @@ union yyalloc
 # ifndef YYCOPY
 #  if defined __GNUC__ && 1 < __GNUC__
 #   define YYCOPY(Dst, Src, Count) \
-      __builtin_memcpy (Dst, Src, (Count) * sizeof (*(Src)))
+      __builtin_memcpy (Dst, Src, YY_CAST (YYSIZE_T, (Count)) * sizeof (*(Src)))
 #  else
 #   define YYCOPY(Dst, Src, Count)              \
       do                                        \
         {                                       \
-          YYSIZE_T yyi;                         \
+          YYPTRDIFF_T yyi;                      \
           for (yyi = 0; yyi < (Count); yyi++)   \
             (Dst)[yyi] = (Src)[yyi];            \
         }                                       \
@@ -539,28 +595,31 @@ union yyalloc
 /* YYFINAL -- State number of the termination state.  */
 #define YYFINAL  94
 /* YYLAST -- Last index in YYTABLE.  */
-#define YYLAST   737
+#define YYLAST   745
 
 /* YYNTOKENS -- Number of terminals.  */
 #define YYNTOKENS  65
 /* YYNNTS -- Number of nonterminals.  */
 #define YYNNTS  43
 /* YYNRULES -- Number of rules.  */
-#define YYNRULES  129
+#define YYNRULES  130
 /* YYNSTATES -- Number of states.  */
-#define YYNSTATES  210
+#define YYNSTATES  212
 
-/* YYTRANSLATE[YYX] -- Symbol number corresponding to YYX as returned
-   by yylex, with out-of-bounds checking.  */
-#define YYUNDEFTOK  2
+/* YYMAXUTOK -- Last valid token kind.  */
 #define YYMAXUTOK   319
 
-#define YYTRANSLATE(YYX)                                                \
-  ((unsigned int) (YYX) <= YYMAXUTOK ? yytranslate[YYX] : YYUNDEFTOK)
+
+/* YYTRANSLATE(TOKEN-NUM) -- Symbol number corresponding to TOKEN-NUM
+   as returned by yylex, with out-of-bounds checking.  */
+#define YYTRANSLATE(YYX)                                \
+  (0 <= (YYX) && (YYX) <= YYMAXUTOK                     \
+   ? YY_CAST (yysymbol_kind_t, yytranslate[YYX])        \
+   : YYSYMBOL_YYUNDEF)
 
 /* YYTRANSLATE[TOKEN-NUM] -- Symbol number corresponding to TOKEN-NUM
-   as returned by yylex, without out-of-bounds checking.  */
-static const yytype_uint8 yytranslate[] =
+   as returned by yylex.  */
+static const yytype_int8 yytranslate[] =
 {
        0,     2,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     2,
@@ -597,198 +656,186 @@ static const yytype_uint8 yytranslate[] =
 };
 
 #if YYDEBUG
-  /* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
-static const yytype_uint16 yyrline[] =
+/* YYRLINE[YYN] -- Source line where rule number YYN was defined.  */
+static const yytype_int16 yyrline[] =
 {
-       0,   197,   197,   201,   202,   203,   207,   208,   209,   210,
-     211,   214,   215,   216,   217,   220,   221,   224,   225,   226,
-     227,   230,   231,   232,   235,   236,   237,   238,   239,   240,
-     241,   242,   245,   248,   249,   250,   251,   252,   253,   254,
-     255,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   269,   270,   271,   272,   275,   276,   277,   278,
-     281,   282,   283,   286,   287,   288,   292,   293,   294,   297,
-     298,   301,   304,   305,   308,   309,   310,   311,   312,   315,
-     318,   321,   324,   325,   328,   331,   332,   335,   336,   337,
-     338,   341,   342,   345,   346,   347,   350,   351,   352,   355,
-     356,   359,   360,   363,   364,   365,   368,   369,   372,   373,
-     376,   377,   378,   381,   382,   385,   386,   389,   390,   393,
-     394,   397,   398,   399,   400,   403,   406,   407,   410,   411
+       0,   199,   199,   203,   204,   205,   209,   210,   211,   212,
+     213,   216,   217,   218,   219,   222,   223,   226,   227,   228,
+     229,   232,   233,   234,   237,   238,   239,   240,   241,   242,
+     243,   244,   247,   250,   251,   252,   253,   254,   255,   256,
+     257,   258,   259,   260,   261,   262,   263,   264,   265,   266,
+     267,   268,   271,   272,   273,   274,   277,   278,   279,   280,
+     283,   284,   285,   288,   289,   290,   294,   295,   296,   299,
+     300,   303,   306,   307,   310,   311,   312,   313,   314,   317,
+     320,   323,   326,   327,   330,   331,   334,   335,   338,   339,
+     340,   341,   344,   345,   348,   349,   350,   353,   354,   355,
+     358,   359,   362,   363,   366,   367,   368,   371,   372,   375,
+     376,   379,   380,   381,   384,   385,   388,   389,   392,   393,
+     396,   397,   400,   401,   402,   403,   406,   409,   410,   413,
+     414
 };
 #endif
 
-#if YYDEBUG || YYERROR_VERBOSE || 1
+/** Accessing symbol of state STATE.  */
+#define YY_ACCESSING_SYMBOL(State) YY_CAST (yysymbol_kind_t, yystos[State])
+
+#if 1
+/* The user-facing name of the symbol whose (internal) number is
+   YYSYMBOL.  No bounds checking.  */
+static const char *yysymbol_name (yysymbol_kind_t yysymbol) YY_ATTRIBUTE_UNUSED;
+
 /* YYTNAME[SYMBOL-NUM] -- String name of the symbol SYMBOL-NUM.
    First, the terminals, then, starting at YYNTOKENS, nonterminals.  */
 static const char *const yytname[] =
 {
-  "\"end of file\"", "error", "$undefined", "ANY_KIND", "SCALAR_KIND",
-  "VOID", "BOOL", "SIGNED_KIND", "INT8", "INT16", "INT32", "INT64",
-  "UNSIGNED_KIND", "UINT8", "UINT16", "UINT32", "UINT64", "FLOAT_KIND",
-  "FLOAT16", "FLOAT32", "FLOAT64", "COMPLEX_KIND", "COMPLEX32",
-  "COMPLEX64", "COMPLEX128", "CATEGORICAL", "NA", "INTPTR", "UINTPTR",
-  "SIZE", "CHAR", "STRING", "FIXED_STRING_KIND", "FIXED_STRING", "BYTES",
-  "FIXED_BYTES_KIND", "FIXED_BYTES", "REF", "FIXED", "VAR", "COMMA",
-  "COLON", "LPAREN", "RPAREN", "LBRACE", "RBRACE", "LBRACK", "RBRACK",
-  "STAR", "ELLIPSIS", "RARROW", "EQUAL", "LESS", "GREATER", "QUESTIONMARK",
-  "BANG", "AMPERSAND", "BAR", "ERRTOKEN", "INTEGER", "FLOATNUMBER",
-  "STRINGLIT", "NAME_LOWER", "NAME_UPPER", "NAME_OTHER", "$accept",
-  "input", "datashape_or_module", "datashape_with_ellipsis", "datashape",
-  "dimensions", "dimensions_nooption", "dimensions_tail", "dtype",
-  "scalar", "signed", "unsigned", "ieee_float", "ieee_complex", "alias",
-  "character", "string", "fixed_string", "endian_opt", "encoding", "bytes",
-  "fixed_bytes", "ref", "categorical", "typed_value_seq", "typed_value",
-  "variadic_flag", "comma_variadic_flag", "tuple_type", "tuple_field_seq",
-  "tuple_field", "record_type", "record_field_seq", "record_field",
-  "record_field_name", "arguments_opt", "attribute_seq", "attribute",
-  "untyped_value_seq", "untyped_value", "function_type",
+  "\"end of file\"", "error", "\"invalid token\"", "ANY_KIND",
+  "SCALAR_KIND", "VOID", "BOOL", "SIGNED_KIND", "INT8", "INT16", "INT32",
+  "INT64", "UNSIGNED_KIND", "UINT8", "UINT16", "UINT32", "UINT64",
+  "FLOAT_KIND", "FLOAT16", "FLOAT32", "FLOAT64", "COMPLEX_KIND",
+  "COMPLEX32", "COMPLEX64", "COMPLEX128", "CATEGORICAL", "NA", "INTPTR",
+  "UINTPTR", "SIZE", "CHAR", "STRING", "FIXED_STRING_KIND", "FIXED_STRING",
+  "BYTES", "FIXED_BYTES_KIND", "FIXED_BYTES", "REF", "FIXED", "VAR",
+  "COMMA", "COLON", "LPAREN", "RPAREN", "LBRACE", "RBRACE", "LBRACK",
+  "RBRACK", "STAR", "ELLIPSIS", "RARROW", "EQUAL", "LESS", "GREATER",
+  "QUESTIONMARK", "BANG", "AMPERSAND", "BAR", "ERRTOKEN", "INTEGER",
+  "FLOATNUMBER", "STRINGLIT", "NAME_LOWER", "NAME_UPPER", "NAME_OTHER",
+  "$accept", "input", "datashape_or_module", "datashape_with_ellipsis",
+  "datashape", "dimensions", "dimensions_nooption", "dimensions_tail",
+  "dtype", "scalar", "signed", "unsigned", "ieee_float", "ieee_complex",
+  "alias", "character", "string", "fixed_string", "endian_opt", "encoding",
+  "bytes", "fixed_bytes", "ref", "categorical", "typed_value_seq",
+  "typed_value", "variadic_flag", "comma_variadic_flag", "tuple_type",
+  "tuple_field_seq", "tuple_field", "record_type", "record_field_seq",
+  "record_field", "record_field_name", "arguments_opt", "attribute_seq",
+  "attribute", "untyped_value_seq", "untyped_value", "function_type",
   "type_seq_or_void", "type_seq", YY_NULLPTR
 };
-#endif
 
-# ifdef YYPRINT
-/* YYTOKNUM[NUM] -- (External) token number corresponding to the
-   (internal) symbol number NUM (which must be that of a token).  */
-static const yytype_uint16 yytoknum[] =
+static const char *
+yysymbol_name (yysymbol_kind_t yysymbol)
 {
-       0,   256,   257,   258,   259,   260,   261,   262,   263,   264,
-     265,   266,   267,   268,   269,   270,   271,   272,   273,   274,
-     275,   276,   277,   278,   279,   280,   281,   282,   283,   284,
-     285,   286,   287,   288,   289,   290,   291,   292,   293,   294,
-     295,   296,   297,   298,   299,   300,   301,   302,   303,   304,
-     305,   306,   307,   308,   309,   310,   311,   312,   313,   314,
-     315,   316,   317,   318,   319
-};
-# endif
+  return yytname[yysymbol];
+}
+#endif
 
-#define YYPACT_NINF -184
+#define YYPACT_NINF (-185)
 
-#define yypact_value_is_default(Yystate) \
-  (!!((Yystate) == (-184)))
+#define yypact_value_is_default(Yyn) \
+  ((Yyn) == YYPACT_NINF)
 
-#define YYTABLE_NINF -95
+#define YYTABLE_NINF (-96)
 
-#define yytable_value_is_error(Yytable_value) \
+#define yytable_value_is_error(Yyn) \
   0
 
-  /* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
-     STATE-NUM.  */
+/* YYPACT[STATE-NUM] -- Index in YYTABLE of the portion describing
+   STATE-NUM.  */
 static const yytype_int16 yypact[] =
 {
-     142,  -184,  -184,  -184,  -184,  -184,  -184,  -184,   -16,    -7,
-    -184,  -184,    17,    33,  -184,    42,    51,    55,    -6,   199,
-     -30,   -32,  -184,  -184,  -184,   588,   -14,   431,  -184,    50,
-    -184,    69,    18,    28,   105,  -184,  -184,  -184,  -184,  -184,
-    -184,  -184,  -184,  -184,  -184,  -184,  -184,  -184,    72,  -184,
-    -184,  -184,  -184,  -184,  -184,  -184,    59,    73,   -22,    54,
-      53,    57,  -184,    57,   431,    57,    77,    87,    33,  -184,
-       2,    63,    96,   101,  -184,  -184,  -184,  -184,    99,   108,
-    -184,   109,   545,  -184,  -184,   -17,   103,  -184,  -184,   545,
-     111,   488,   545,   107,  -184,  -184,  -184,  -184,  -184,  -184,
-    -184,  -184,  -184,  -184,  -184,  -184,  -184,  -184,  -184,  -184,
-    -184,  -184,  -184,  -184,   260,   374,  -184,  -184,  -184,  -184,
-      13,  -184,  -184,   110,    29,   106,    34,  -184,    81,   113,
-      93,   631,   545,    57,  -184,   317,   115,  -184,    40,   116,
-     431,   588,  -184,  -184,  -184,  -184,   374,   106,   117,    94,
-    -184,   545,     6,  -184,  -184,  -184,   -22,  -184,  -184,    54,
-    -184,     1,    57,  -184,  -184,  -184,   114,   674,   122,  -184,
-    -184,   -27,  -184,  -184,   100,  -184,   106,  -184,   -28,  -184,
-     112,  -184,  -184,  -184,  -184,  -184,  -184,   123,    70,  -184,
-    -184,  -184,  -184,  -184,  -184,   545,  -184,  -184,  -184,  -184,
-      57,  -184,   -20,  -184,  -184,   -26,    70,  -184,  -184,  -184
+     126,  -185,  -185,  -185,  -185,  -185,  -185,  -185,   -14,    11,
+    -185,  -185,    21,    33,  -185,    44,    63,    75,     7,   183,
+      -2,   -36,  -185,  -185,  -185,   572,   -13,   415,  -185,   -28,
+    -185,    39,    18,    74,   103,  -185,  -185,  -185,  -185,  -185,
+    -185,  -185,  -185,  -185,  -185,  -185,  -185,  -185,   716,  -185,
+    -185,  -185,  -185,  -185,  -185,  -185,    68,    79,   -17,   -40,
+      62,    58,  -185,    58,   415,    58,    76,    77,    33,  -185,
+       6,    78,    89,    94,  -185,  -185,  -185,  -185,    91,    97,
+    -185,    99,   529,  -185,  -185,    -4,    93,  -185,  -185,   529,
+     104,   472,   529,    96,  -185,  -185,  -185,  -185,  -185,  -185,
+    -185,  -185,  -185,  -185,  -185,  -185,  -185,  -185,  -185,  -185,
+    -185,  -185,  -185,  -185,   244,   358,  -185,  -185,  -185,  -185,
+      53,  -185,  -185,   105,    55,    95,    57,  -185,    59,   106,
+      61,   615,   529,    58,  -185,   301,   107,  -185,    20,   108,
+     415,   572,  -185,  -185,  -185,  -185,   358,    95,   109,    69,
+    -185,   529,   -26,  -185,  -185,  -185,   -22,  -185,  -185,   -40,
+    -185,   -29,    58,  -185,  -185,  -185,   118,   658,   112,  -185,
+    -185,   -30,  -185,  -185,    70,  -185,    95,  -185,    32,  -185,
+      98,  -185,  -185,  -185,  -185,  -185,  -185,    71,   124,    30,
+    -185,  -185,  -185,  -185,  -185,  -185,   529,  -185,  -185,  -185,
+    -185,    58,  -185,  -185,    38,  -185,  -185,   -21,    30,  -185,
+    -185,  -185
 };
 
-  /* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
-     Performed when YYTABLE does not specify something else to do.  Zero
-     means the default is an error.  */
+/* YYDEFACT[STATE-NUM] -- Default reduction number in state STATE-NUM.
+   Performed when YYTABLE does not specify something else to do.  Zero
+   means the default is an error.  */
 static const yytype_uint8 yydefact[] =
 {
-      74,    24,    25,   127,    34,    36,    38,    40,     0,    69,
-      71,    45,     0,   113,    48,     0,     0,     0,   113,    74,
-      91,     0,    75,    76,    77,    74,     0,    74,    78,     0,
-      29,    32,     0,     0,   128,     6,    11,    15,    13,    26,
+      74,    24,    25,   128,    34,    36,    38,    40,     0,    69,
+      71,    45,     0,   114,    48,     0,     0,     0,   114,    74,
+      92,     0,    75,    76,    77,    74,     0,    74,    78,     0,
+      29,    32,     0,     0,   129,     6,    11,    15,    13,    26,
       35,    37,    39,    41,    42,    43,    44,    46,     0,    47,
-      49,    51,    50,    27,    28,     4,     0,   126,     0,     0,
-       0,     0,    80,     0,    74,     0,     0,     0,   113,    92,
-      32,   101,     0,    93,    99,   110,   111,   112,     0,    93,
-     106,     0,    74,    16,    14,     0,     0,    12,    83,    74,
+      49,    51,    50,    27,    28,     4,     0,   127,     0,     0,
+       0,     0,    80,     0,    74,     0,     0,     0,   114,    93,
+      32,   102,     0,    94,   100,   111,   112,   113,     0,    94,
+     107,     0,    74,    16,    14,     0,     0,    12,    83,    74,
        0,    74,    74,     0,     1,     2,    33,    52,    53,    54,
       55,    56,    57,    58,    59,    60,    61,    62,    63,    64,
-      65,    66,    67,    68,    74,    74,    90,    87,    88,    89,
-       0,    85,    79,     0,     0,     0,     0,   115,     0,     0,
-       0,    74,    74,     0,    96,    74,     0,   103,    94,     0,
+      65,    66,    67,    68,    74,    74,    91,    88,    89,    90,
+       0,    86,    79,     0,     0,     0,     0,   116,     0,     0,
+       0,    74,    74,     0,    97,    74,     0,   104,    95,     0,
       74,    74,    23,     7,    21,    17,    74,    29,     0,     0,
-      19,    74,    32,   128,   125,   129,     0,    84,    70,     0,
-      72,     0,     0,   114,    81,    82,     0,    74,    32,     9,
-      20,     0,    95,   100,     0,    97,   110,   107,     0,   104,
-     108,    22,     5,    30,    31,     8,    86,     0,     0,   122,
-     123,   124,   121,   117,   116,    74,    10,   102,    98,   105,
-       0,    73,     0,   119,    18,     0,     0,   118,   109,   120
+      19,    74,    32,   129,   126,   130,     0,    84,    70,     0,
+      72,     0,     0,   115,    81,    82,     0,    74,    32,     9,
+      20,     0,    96,   101,     0,    98,   111,   108,     0,   105,
+     109,    22,     5,    30,    31,     8,    87,     0,     0,     0,
+     123,   124,   125,   122,   118,   117,    74,    10,   103,    99,
+     106,     0,    85,    73,     0,   120,    18,     0,     0,   119,
+     110,   121
 };
 
-  /* YYPGOTO[NTERM-NUM].  */
+/* YYPGOTO[NTERM-NUM].  */
 static const yytype_int16 yypgoto[] =
 {
-    -184,  -184,  -184,  -105,   -12,   -24,   -19,   -81,   -25,  -184,
-    -184,  -184,  -184,  -184,  -184,  -184,  -184,  -184,  -184,     9,
-    -184,  -184,  -184,  -184,  -184,    26,   145,   104,  -184,  -184,
-      52,  -184,  -184,    47,  -184,   175,   -62,    27,  -184,  -183,
-    -184,    76,  -184
+    -185,  -185,  -185,  -101,   -12,   -24,   -19,   -81,   -25,  -185,
+    -185,  -185,  -185,  -185,  -185,  -185,  -185,  -185,  -185,    10,
+    -185,  -185,  -185,  -185,  -185,    17,   154,   113,  -185,  -185,
+      41,  -185,  -185,    46,  -185,   178,   -62,    31,  -185,  -184,
+    -185,    80,  -185
 };
 
-  /* YYDEFGOTO[NTERM-NUM].  */
-static const yytype_int16 yydefgoto[] =
+/* YYDEFGOTO[NTERM-NUM].  */
+static const yytype_uint8 yydefgoto[] =
 {
-      -1,    32,    33,    34,    35,    36,    37,   143,    38,    39,
+       0,    32,    33,    34,    35,    36,    37,   143,    38,    39,
       40,    41,    42,    43,    44,    45,    46,    47,    48,   123,
       49,    50,    51,    52,   120,   121,    72,   136,    53,    73,
-      74,    54,    79,    80,    81,    67,   126,   127,   202,   193,
+      74,    54,    79,    80,    81,    67,   126,   127,   204,   194,
       55,    56,    57
 };
 
-  /* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
-     positive, shift that token.  If negative, reduce the rule whose
-     number is the opposite.  If YYTABLE_NINF, syntax error.  */
+/* YYTABLE[YYPACT[STATE-NUM]] -- What to do in state STATE-NUM.  If
+   positive, shift that token.  If negative, reduce the rule whose
+   number is the opposite.  If YYTABLE_NINF, syntax error.  */
 static const yytype_int16 yytable[] =
 {
-      84,   128,    87,   130,   116,   203,    83,    71,   145,   153,
-     155,   150,   162,   162,   162,    88,    82,   199,    94,    69,
-     206,    17,    68,   209,    17,    68,    58,   207,    95,   149,
-     197,   208,    75,    76,    77,    59,    61,   117,   118,   119,
-      85,   182,    29,    66,    91,    29,    86,   188,    91,    86,
-      92,   170,   129,   156,    92,    93,   157,   144,   142,    60,
-     189,   190,   191,   192,   144,   142,    83,   144,   142,   159,
-     185,   171,   160,   174,   162,    61,   178,   163,    96,   148,
-      97,    98,    99,   100,    63,   101,   102,   103,   104,   172,
-     105,   106,   107,    64,   108,   109,   110,    65,    89,   111,
-     112,   113,   176,    76,    77,    -3,   169,   144,   142,   114,
-      90,    91,   124,   115,   204,   122,   181,    92,    93,   125,
-     133,   162,    83,    71,   164,   131,   144,   142,   180,   189,
-     190,   191,   192,   162,   162,   132,   166,   184,   205,   134,
-     162,   135,   196,   198,   137,     1,     2,     3,   138,     4,
-     140,    92,   146,   158,     5,   151,   165,   161,   175,     6,
-     183,   179,   195,     7,    91,    78,   201,     8,   187,   200,
-     144,   142,     9,    10,    11,    12,    13,    14,    15,    16,
-      17,    18,   186,   139,    19,   177,    20,   173,    62,   194,
-     154,    21,     0,    22,    23,    24,    25,    26,    27,    28,
-       0,    29,     1,     2,    30,    31,     4,     0,     0,     0,
-       0,     5,     0,     0,     0,     0,     6,     0,     0,     0,
-       7,     0,     0,     0,     8,     0,     0,     0,     0,     9,
-      10,    11,    12,    13,    14,    15,    16,    17,    68,     0,
-       0,    19,   -91,    20,     0,     0,     0,     0,    69,     0,
-      22,    23,    24,    25,    26,    27,    28,     0,    29,     0,
-       0,    30,    70,     1,     2,     3,     0,     4,     0,     0,
-       0,     0,     5,     0,     0,     0,     0,     6,     0,     0,
-       0,     7,     0,     0,     0,     8,     0,     0,     0,     0,
-       9,    10,    11,    12,    13,    14,    15,    16,    17,    18,
-       0,     0,    19,     0,    20,     0,     0,     0,     0,    21,
-       0,    22,    23,    24,    25,    26,    27,    28,     0,    29,
-       1,     2,    30,   152,     4,     0,     0,     0,     0,     5,
-       0,     0,     0,     0,     6,     0,     0,     0,     7,     0,
-       0,     0,     8,     0,     0,     0,     0,     9,    10,    11,
-      12,    13,    14,    15,    16,    17,    68,     0,     0,    19,
-     -94,    20,     0,     0,     0,     0,   172,     0,    22,    23,
-      24,    25,    26,    27,    28,     0,    29,     1,     2,   147,
-      70,     4,     0,     0,     0,     0,     5,     0,     0,     0,
+      84,   128,    87,   130,   116,   205,    83,    71,   145,   116,
+     162,   150,    82,   153,   155,    88,    91,   189,    94,   162,
+      89,   122,    92,    93,   211,    17,    68,   198,    58,   149,
+     190,   191,   192,   193,    17,    68,   210,   117,   118,   119,
+     125,    85,   117,   118,   119,   182,    29,    69,    91,    61,
+      86,   170,   129,    59,    92,    29,    66,   144,   142,    86,
+      75,    76,    77,    60,   144,   142,    83,   144,   142,   172,
+     185,   171,   162,   174,    95,    61,   178,   200,   208,   148,
+      90,    91,   176,    76,    77,   209,    63,    92,    93,   190,
+     191,   192,   193,   156,   187,   159,   157,   162,   160,   162,
+     163,   162,   164,    -3,   166,    64,   169,   144,   142,   162,
+     162,   162,   184,   199,   202,   206,   181,    65,   114,   115,
+     125,   124,    83,    71,   131,   132,   144,   142,   180,     1,
+       2,     3,   134,     4,   135,   133,   137,   138,     5,   207,
+     140,    92,   197,     6,   151,   146,   161,     7,   158,   165,
+     175,     8,   183,   179,    91,   201,     9,    10,    11,    12,
+      13,    14,    15,    16,    17,    18,   196,   203,    19,   188,
+      20,   144,   142,   186,    78,    21,   173,    22,    23,    24,
+      25,    26,    27,    28,   177,    29,     1,     2,    30,    31,
+       4,    62,   139,   195,   154,     5,     0,     0,     0,     0,
+       6,     0,     0,     0,     7,     0,     0,     0,     8,     0,
+       0,     0,     0,     9,    10,    11,    12,    13,    14,    15,
+      16,    17,    68,     0,     0,    19,   -92,    20,     0,     0,
+       0,     0,    69,     0,    22,    23,    24,    25,    26,    27,
+      28,     0,    29,     0,     0,    30,    70,     1,     2,     3,
+       0,     4,     0,     0,     0,     0,     5,     0,     0,     0,
        0,     6,     0,     0,     0,     7,     0,     0,     0,     8,
        0,     0,     0,     0,     9,    10,    11,    12,    13,    14,
       15,    16,    17,    18,     0,     0,    19,     0,    20,     0,
@@ -797,76 +844,77 @@ static const yytype_int16 yytable[] =
        0,     0,     0,     5,     0,     0,     0,     0,     6,     0,
        0,     0,     7,     0,     0,     0,     8,     0,     0,     0,
        0,     9,    10,    11,    12,    13,    14,    15,    16,    17,
-      68,     0,     0,    19,     0,    20,     0,     0,     0,     0,
-       0,     0,    22,    23,    24,    25,    26,    27,    28,     0,
-      29,     1,     2,    30,    70,     4,     0,     0,     0,     0,
+      68,     0,     0,    19,   -95,    20,     0,     0,     0,     0,
+     172,     0,    22,    23,    24,    25,    26,    27,    28,     0,
+      29,     1,     2,   147,    70,     4,     0,     0,     0,     0,
        5,     0,     0,     0,     0,     6,     0,     0,     0,     7,
        0,     0,     0,     8,     0,     0,     0,     0,     9,    10,
-      11,    12,    13,    14,    15,    16,    17,    68,     0,     0,
-      19,     0,    20,     0,     0,     0,     0,     0,     0,    22,
+      11,    12,    13,    14,    15,    16,    17,    18,     0,     0,
+      19,     0,    20,     0,     0,     0,     0,    21,     0,    22,
       23,    24,    25,    26,    27,    28,     0,    29,     1,     2,
-     147,    70,     4,     0,     0,     0,     0,     5,     0,     0,
+      30,   152,     4,     0,     0,     0,     0,     5,     0,     0,
        0,     0,     6,     0,     0,     0,     7,     0,     0,     0,
        8,     0,     0,     0,     0,     9,    10,    11,    12,    13,
       14,    15,    16,    17,    68,     0,     0,    19,     0,    20,
-       0,     1,     2,     0,     0,     4,    22,    23,    24,   141,
-       5,    27,    28,     0,    29,     6,     0,    30,    70,     7,
+       0,     0,     0,     0,     0,     0,    22,    23,    24,    25,
+      26,    27,    28,     0,    29,     1,     2,    30,    70,     4,
+       0,     0,     0,     0,     5,     0,     0,     0,     0,     6,
+       0,     0,     0,     7,     0,     0,     0,     8,     0,     0,
+       0,     0,     9,    10,    11,    12,    13,    14,    15,    16,
+      17,    68,     0,     0,    19,     0,    20,     0,     0,     0,
+       0,     0,     0,    22,    23,    24,    25,    26,    27,    28,
+       0,    29,     1,     2,   147,    70,     4,     0,     0,     0,
+       0,     5,     0,     0,     0,     0,     6,     0,     0,     0,
+       7,     0,     0,     0,     8,     0,     0,     0,     0,     9,
+      10,    11,    12,    13,    14,    15,    16,    17,    68,     0,
+       0,    19,     0,    20,     0,     1,     2,     0,     0,     4,
+      22,    23,    24,   141,     5,    27,    28,     0,    29,     6,
+       0,    30,    70,     7,     0,     0,     0,     8,     0,     0,
+       0,     0,     9,    10,    11,    12,    13,    14,    15,    16,
+      17,    68,     0,     0,    19,     0,    20,     0,     1,     2,
+       0,     0,     4,    22,    23,    24,     0,     5,    27,    28,
+       0,    29,     6,     0,    30,    70,     7,     0,     0,     0,
+       8,     0,     0,     0,     0,     9,    10,    11,    12,    13,
+      14,    15,    16,     0,     0,     0,     0,    19,     0,    20,
+       0,     1,     2,     0,     0,     4,    22,    23,    24,   167,
+       5,    27,    28,     0,     0,     6,     0,    30,   168,     7,
        0,     0,     0,     8,     0,     0,     0,     0,     9,    10,
-      11,    12,    13,    14,    15,    16,    17,    68,     0,     0,
-      19,     0,    20,     0,     1,     2,     0,     0,     4,    22,
-      23,    24,     0,     5,    27,    28,     0,    29,     6,     0,
-      30,    70,     7,     0,     0,     0,     8,     0,     0,     0,
-       0,     9,    10,    11,    12,    13,    14,    15,    16,     0,
-       0,     0,     0,    19,     0,    20,     0,     1,     2,     0,
-       0,     4,    22,    23,    24,   167,     5,    27,    28,     0,
-       0,     6,     0,    30,   168,     7,     0,     0,     0,     8,
-       0,     0,     0,     0,     9,    10,    11,    12,    13,    14,
-      15,    16,     0,     0,     0,     0,    19,     0,    20,     0,
-       0,     0,     0,     0,     0,    22,    23,    24,     0,     0,
-      27,    28,     0,     0,     0,     0,    30,   168
+      11,    12,    13,    14,    15,    16,     0,     0,     0,     0,
+      19,     0,    20,     0,     0,     0,     0,     0,     0,    22,
+      23,    24,     0,     0,    27,    28,     0,     0,     0,     0,
+      30,   168,    96,     0,    97,    98,    99,   100,     0,   101,
+     102,   103,   104,     0,   105,   106,   107,     0,   108,   109,
+     110,     0,     0,   111,   112,   113
 };
 
 static const yytype_int16 yycheck[] =
 {
-      25,    63,    26,    65,    26,   188,    25,    19,    89,   114,
-     115,    92,    40,    40,    40,    27,    48,    45,     0,    49,
-      40,    38,    39,   206,    38,    39,    42,    47,     0,    91,
-      57,    57,    62,    63,    64,    42,    42,    59,    60,    61,
-      54,   146,    59,    49,    42,    59,    63,    46,    42,    63,
-      48,   132,    64,    40,    48,    49,    43,    82,    82,    42,
-      59,    60,    61,    62,    89,    89,    85,    92,    92,    40,
-     151,   133,    43,   135,    40,    42,   138,    43,     6,    91,
-       8,     9,    10,    11,    42,    13,    14,    15,    16,    49,
-      18,    19,    20,    42,    22,    23,    24,    42,    48,    27,
-      28,    29,    62,    63,    64,     0,   131,   132,   132,    50,
-      41,    42,    59,    40,   195,    61,   141,    48,    49,    62,
-      57,    40,   141,   135,    43,    48,   151,   151,   140,    59,
-      60,    61,    62,    40,    40,    48,    43,    43,   200,    43,
-      40,    40,   167,    43,    45,     3,     4,     5,    40,     7,
-      41,    48,    41,    43,    12,    48,    43,    51,    43,    17,
-      43,    45,    48,    21,    42,    20,    43,    25,   159,    57,
-     195,   195,    30,    31,    32,    33,    34,    35,    36,    37,
-      38,    39,   156,    79,    42,   138,    44,   135,    13,   162,
-     114,    49,    -1,    51,    52,    53,    54,    55,    56,    57,
-      -1,    59,     3,     4,    62,    63,     7,    -1,    -1,    -1,
-      -1,    12,    -1,    -1,    -1,    -1,    17,    -1,    -1,    -1,
-      21,    -1,    -1,    -1,    25,    -1,    -1,    -1,    -1,    30,
-      31,    32,    33,    34,    35,    36,    37,    38,    39,    -1,
-      -1,    42,    43,    44,    -1,    -1,    -1,    -1,    49,    -1,
-      51,    52,    53,    54,    55,    56,    57,    -1,    59,    -1,
-      -1,    62,    63,     3,     4,     5,    -1,     7,    -1,    -1,
-      -1,    -1,    12,    -1,    -1,    -1,    -1,    17,    -1,    -1,
-      -1,    21,    -1,    -1,    -1,    25,    -1,    -1,    -1,    -1,
-      30,    31,    32,    33,    34,    35,    36,    37,    38,    39,
-      -1,    -1,    42,    -1,    44,    -1,    -1,    -1,    -1,    49,
-      -1,    51,    52,    53,    54,    55,    56,    57,    -1,    59,
-       3,     4,    62,    63,     7,    -1,    -1,    -1,    -1,    12,
-      -1,    -1,    -1,    -1,    17,    -1,    -1,    -1,    21,    -1,
-      -1,    -1,    25,    -1,    -1,    -1,    -1,    30,    31,    32,
-      33,    34,    35,    36,    37,    38,    39,    -1,    -1,    42,
-      43,    44,    -1,    -1,    -1,    -1,    49,    -1,    51,    52,
-      53,    54,    55,    56,    57,    -1,    59,     3,     4,    62,
-      63,     7,    -1,    -1,    -1,    -1,    12,    -1,    -1,    -1,
+      25,    63,    26,    65,    26,   189,    25,    19,    89,    26,
+      40,    92,    48,   114,   115,    27,    42,    46,     0,    40,
+      48,    61,    48,    49,   208,    38,    39,    57,    42,    91,
+      59,    60,    61,    62,    38,    39,    57,    59,    60,    61,
+      62,    54,    59,    60,    61,   146,    59,    49,    42,    42,
+      63,   132,    64,    42,    48,    59,    49,    82,    82,    63,
+      62,    63,    64,    42,    89,    89,    85,    92,    92,    49,
+     151,   133,    40,   135,     0,    42,   138,    45,    40,    91,
+      41,    42,    62,    63,    64,    47,    42,    48,    49,    59,
+      60,    61,    62,    40,   156,    40,    43,    40,    43,    40,
+      43,    40,    43,     0,    43,    42,   131,   132,   132,    40,
+      40,    40,    43,    43,    43,   196,   141,    42,    50,    40,
+      62,    59,   141,   135,    48,    48,   151,   151,   140,     3,
+       4,     5,    43,     7,    40,    57,    45,    40,    12,   201,
+      41,    48,   167,    17,    48,    41,    51,    21,    43,    43,
+      43,    25,    43,    45,    42,    57,    30,    31,    32,    33,
+      34,    35,    36,    37,    38,    39,    48,    43,    42,   159,
+      44,   196,   196,   156,    20,    49,   135,    51,    52,    53,
+      54,    55,    56,    57,   138,    59,     3,     4,    62,    63,
+       7,    13,    79,   162,   114,    12,    -1,    -1,    -1,    -1,
+      17,    -1,    -1,    -1,    21,    -1,    -1,    -1,    25,    -1,
+      -1,    -1,    -1,    30,    31,    32,    33,    34,    35,    36,
+      37,    38,    39,    -1,    -1,    42,    43,    44,    -1,    -1,
+      -1,    -1,    49,    -1,    51,    52,    53,    54,    55,    56,
+      57,    -1,    59,    -1,    -1,    62,    63,     3,     4,     5,
+      -1,     7,    -1,    -1,    -1,    -1,    12,    -1,    -1,    -1,
       -1,    17,    -1,    -1,    -1,    21,    -1,    -1,    -1,    25,
       -1,    -1,    -1,    -1,    30,    31,    32,    33,    34,    35,
       36,    37,    38,    39,    -1,    -1,    42,    -1,    44,    -1,
@@ -875,38 +923,52 @@ static const yytype_int16 yycheck[] =
       -1,    -1,    -1,    12,    -1,    -1,    -1,    -1,    17,    -1,
       -1,    -1,    21,    -1,    -1,    -1,    25,    -1,    -1,    -1,
       -1,    30,    31,    32,    33,    34,    35,    36,    37,    38,
-      39,    -1,    -1,    42,    -1,    44,    -1,    -1,    -1,    -1,
-      -1,    -1,    51,    52,    53,    54,    55,    56,    57,    -1,
+      39,    -1,    -1,    42,    43,    44,    -1,    -1,    -1,    -1,
+      49,    -1,    51,    52,    53,    54,    55,    56,    57,    -1,
       59,     3,     4,    62,    63,     7,    -1,    -1,    -1,    -1,
       12,    -1,    -1,    -1,    -1,    17,    -1,    -1,    -1,    21,
       -1,    -1,    -1,    25,    -1,    -1,    -1,    -1,    30,    31,
       32,    33,    34,    35,    36,    37,    38,    39,    -1,    -1,
-      42,    -1,    44,    -1,    -1,    -1,    -1,    -1,    -1,    51,
+      42,    -1,    44,    -1,    -1,    -1,    -1,    49,    -1,    51,
       52,    53,    54,    55,    56,    57,    -1,    59,     3,     4,
       62,    63,     7,    -1,    -1,    -1,    -1,    12,    -1,    -1,
       -1,    -1,    17,    -1,    -1,    -1,    21,    -1,    -1,    -1,
       25,    -1,    -1,    -1,    -1,    30,    31,    32,    33,    34,
       35,    36,    37,    38,    39,    -1,    -1,    42,    -1,    44,
+      -1,    -1,    -1,    -1,    -1,    -1,    51,    52,    53,    54,
+      55,    56,    57,    -1,    59,     3,     4,    62,    63,     7,
+      -1,    -1,    -1,    -1,    12,    -1,    -1,    -1,    -1,    17,
+      -1,    -1,    -1,    21,    -1,    -1,    -1,    25,    -1,    -1,
+      -1,    -1,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    -1,    -1,    42,    -1,    44,    -1,    -1,    -1,
+      -1,    -1,    -1,    51,    52,    53,    54,    55,    56,    57,
+      -1,    59,     3,     4,    62,    63,     7,    -1,    -1,    -1,
+      -1,    12,    -1,    -1,    -1,    -1,    17,    -1,    -1,    -1,
+      21,    -1,    -1,    -1,    25,    -1,    -1,    -1,    -1,    30,
+      31,    32,    33,    34,    35,    36,    37,    38,    39,    -1,
+      -1,    42,    -1,    44,    -1,     3,     4,    -1,    -1,     7,
+      51,    52,    53,    54,    12,    56,    57,    -1,    59,    17,
+      -1,    62,    63,    21,    -1,    -1,    -1,    25,    -1,    -1,
+      -1,    -1,    30,    31,    32,    33,    34,    35,    36,    37,
+      38,    39,    -1,    -1,    42,    -1,    44,    -1,     3,     4,
+      -1,    -1,     7,    51,    52,    53,    -1,    12,    56,    57,
+      -1,    59,    17,    -1,    62,    63,    21,    -1,    -1,    -1,
+      25,    -1,    -1,    -1,    -1,    30,    31,    32,    33,    34,
+      35,    36,    37,    -1,    -1,    -1,    -1,    42,    -1,    44,
       -1,     3,     4,    -1,    -1,     7,    51,    52,    53,    54,
-      12,    56,    57,    -1,    59,    17,    -1,    62,    63,    21,
+      12,    56,    57,    -1,    -1,    17,    -1,    62,    63,    21,
       -1,    -1,    -1,    25,    -1,    -1,    -1,    -1,    30,    31,
-      32,    33,    34,    35,    36,    37,    38,    39,    -1,    -1,
-      42,    -1,    44,    -1,     3,     4,    -1,    -1,     7,    51,
-      52,    53,    -1,    12,    56,    57,    -1,    59,    17,    -1,
-      62,    63,    21,    -1,    -1,    -1,    25,    -1,    -1,    -1,
-      -1,    30,    31,    32,    33,    34,    35,    36,    37,    -1,
-      -1,    -1,    -1,    42,    -1,    44,    -1,     3,     4,    -1,
-      -1,     7,    51,    52,    53,    54,    12,    56,    57,    -1,
-      -1,    17,    -1,    62,    63,    21,    -1,    -1,    -1,    25,
-      -1,    -1,    -1,    -1,    30,    31,    32,    33,    34,    35,
-      36,    37,    -1,    -1,    -1,    -1,    42,    -1,    44,    -1,
-      -1,    -1,    -1,    -1,    -1,    51,    52,    53,    -1,    -1,
-      56,    57,    -1,    -1,    -1,    -1,    62,    63
+      32,    33,    34,    35,    36,    37,    -1,    -1,    -1,    -1,
+      42,    -1,    44,    -1,    -1,    -1,    -1,    -1,    -1,    51,
+      52,    53,    -1,    -1,    56,    57,    -1,    -1,    -1,    -1,
+      62,    63,     6,    -1,     8,     9,    10,    11,    -1,    13,
+      14,    15,    16,    -1,    18,    19,    20,    -1,    22,    23,
+      24,    -1,    -1,    27,    28,    29
 };
 
-  /* YYSTOS[STATE-NUM] -- The (internal number of the) accessing
-     symbol of state STATE-NUM.  */
-static const yytype_uint8 yystos[] =
+/* YYSTOS[STATE-NUM] -- The symbol kind of the accessing symbol of
+   state STATE-NUM.  */
+static const yytype_int8 yystos[] =
 {
        0,     3,     4,     5,     7,    12,    17,    21,    25,    30,
       31,    32,    33,    34,    35,    36,    37,    38,    39,    42,
@@ -926,13 +988,14 @@ static const yytype_uint8 yystos[] =
       72,    48,    63,    68,   106,    68,    40,    43,    43,    40,
       43,    51,    40,    43,    43,    43,    43,    54,    63,    73,
       72,   101,    49,    95,   101,    43,    62,    98,   101,    45,
-      69,    73,    68,    43,    43,    72,    90,    84,    46,    59,
-      60,    61,    62,   104,   102,    48,    73,    57,    43,    45,
-      57,    43,   103,   104,    72,   101,    40,    47,    57,   104
+      69,    73,    68,    43,    43,    72,    90,   101,    84,    46,
+      59,    60,    61,    62,   104,   102,    48,    73,    57,    43,
+      45,    57,    43,    43,   103,   104,    72,   101,    40,    47,
+      57,   104
 };
 
-  /* YYR1[YYN] -- Symbol number of symbol that rule YYN derives.  */
-static const yytype_uint8 yyr1[] =
+/* YYR1[RULE-NUM] -- Symbol kind of the left-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr1[] =
 {
        0,    65,    66,    67,    67,    67,    68,    68,    68,    68,
       68,    69,    69,    69,    69,    70,    70,    71,    71,    71,
@@ -942,15 +1005,16 @@ static const yytype_uint8 yyr1[] =
       74,    74,    75,    75,    75,    75,    76,    76,    76,    76,
       77,    77,    77,    78,    78,    78,    79,    79,    79,    80,
       80,    81,    82,    82,    83,    83,    83,    83,    83,    84,
-      85,    86,    87,    87,    88,    89,    89,    90,    90,    90,
-      90,    91,    91,    92,    92,    92,    93,    93,    93,    94,
-      94,    95,    95,    96,    96,    96,    97,    97,    98,    98,
-      99,    99,    99,   100,   100,   101,   101,   102,   102,   103,
-     103,   104,   104,   104,   104,   105,   106,   106,   107,   107
+      85,    86,    87,    87,    88,    88,    89,    89,    90,    90,
+      90,    90,    91,    91,    92,    92,    92,    93,    93,    93,
+      94,    94,    95,    95,    96,    96,    96,    97,    97,    98,
+      98,    99,    99,    99,   100,   100,   101,   101,   102,   102,
+     103,   103,   104,   104,   104,   104,   105,   106,   106,   107,
+     107
 };
 
-  /* YYR2[YYN] -- Number of symbols on the right hand side of rule YYN.  */
-static const yytype_uint8 yyr2[] =
+/* YYR2[RULE-NUM] -- Number of symbols on the right-hand side of rule RULE-NUM.  */
+static const yytype_int8 yyr2[] =
 {
        0,     2,     2,     1,     1,     4,     1,     3,     4,     4,
        5,     1,     2,     1,     2,     1,     2,     3,     6,     3,
@@ -960,47 +1024,48 @@ static const yytype_uint8 yyr2[] =
        1,     1,     2,     2,     2,     2,     2,     2,     2,     2,
        2,     2,     2,     2,     2,     2,     2,     2,     2,     1,
        4,     1,     4,     6,     0,     1,     1,     1,     1,     1,
-       2,     4,     4,     2,     4,     1,     3,     1,     1,     1,
-       1,     0,     1,     0,     1,     2,     3,     4,     5,     1,
-       3,     1,     4,     3,     4,     5,     1,     3,     3,     6,
-       1,     1,     1,     0,     3,     1,     3,     3,     5,     1,
-       3,     1,     1,     1,     1,     3,     1,     1,     1,     3
+       2,     4,     4,     2,     4,     6,     1,     3,     1,     1,
+       1,     1,     0,     1,     0,     1,     2,     3,     4,     5,
+       1,     3,     1,     4,     3,     4,     5,     1,     3,     3,
+       6,     1,     1,     1,     0,     3,     1,     3,     3,     5,
+       1,     3,     1,     1,     1,     1,     3,     1,     1,     1,
+       3
 };
 
 
+enum { YYENOMEM = -2 };
+
 #define yyerrok         (yyerrstatus = 0)
 #define yyclearin       (yychar = YYEMPTY)
-#define YYEMPTY         (-2)
-#define YYEOF           0
 
 #define YYACCEPT        goto yyacceptlab
 #define YYABORT         goto yyabortlab
 #define YYERROR         goto yyerrorlab
+#define YYNOMEM         goto yyexhaustedlab
 
 
 #define YYRECOVERING()  (!!yyerrstatus)
 
-#define YYBACKUP(Token, Value)                                  \
-do                                                              \
-  if (yychar == YYEMPTY)                                        \
-    {                                                           \
-      yychar = (Token);                                         \
-      yylval = (Value);                                         \
-      YYPOPSTACK (yylen);                                       \
-      yystate = *yyssp;                                         \
-      goto yybackup;                                            \
-    }                                                           \
-  else                                                          \
-    {                                                           \
-      yyerror (&yylloc, scanner, ast, meta, ctx, YY_("syntax error: cannot back up")); \
-      YYERROR;                                                  \
-    }                                                           \
-while (0)
-
-/* Error token number */
-#define YYTERROR        1
-#define YYERRCODE       256
-
+#define YYBACKUP(Token, Value)                                    \
+  do                                                              \
+    if (yychar == YYEMPTY)                                        \
+      {                                                           \
+        yychar = (Token);                                         \
+        yylval = (Value);                                         \
+        YYPOPSTACK (yylen);                                       \
+        yystate = *yyssp;                                         \
+        goto yybackup;                                            \
+      }                                                           \
+    else                                                          \
+      {                                                           \
+        yyerror (&yylloc, scanner, ast, meta, arena, ctx, YY_("syntax error: cannot back up")); \
+        YYERROR;                                                  \
+      }                                                           \
+  while (0)
+
+/* Backward compatibility with an undocumented macro.
+   Use YYerror or YYUNDEF. */
+#define YYERRCODE YYUNDEF
 
 /* YYLLOC_DEFAULT -- Set CURRENT to span from RHS[1] to RHS[N].
    If N is 0, then set CURRENT to the empty location which ends
@@ -1044,20 +1109,27 @@ do {                                            \
 } while (0)
 
 
-/* YY_LOCATION_PRINT -- Print the location on the stream.
+/* YYLOCATION_PRINT -- Print the location on the stream.
    This macro was not mandated originally: define only if we know
    we won't break user code: when these are the locations we know.  */
 
-#ifndef YY_LOCATION_PRINT
-# if defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
+# ifndef YYLOCATION_PRINT
+
+#  if defined YY_LOCATION_PRINT
+
+   /* Temporary convenience wrapper in case some people defined the
+      undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YYLOCATION_PRINT(File, Loc)  YY_LOCATION_PRINT(File, *(Loc))
+
+#  elif defined YYLTYPE_IS_TRIVIAL && YYLTYPE_IS_TRIVIAL
 
 /* Print *YYLOCP on YYO.  Private, do not rely on its existence. */
 
 YY_ATTRIBUTE_UNUSED
-static unsigned
+static int
 yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
 {
-  unsigned res = 0;
+  int res = 0;
   int end_col = 0 != yylocp->last_column ? yylocp->last_column - 1 : 0;
   if (0 <= yylocp->first_line)
     {
@@ -1077,67 +1149,76 @@ yy_location_print_ (FILE *yyo, YYLTYPE const * const yylocp)
         res += YYFPRINTF (yyo, "-%d", end_col);
     }
   return res;
- }
+}
 
-#  define YY_LOCATION_PRINT(File, Loc)          \
-  yy_location_print_ (File, &(Loc))
+#   define YYLOCATION_PRINT  yy_location_print_
 
-# else
-#  define YY_LOCATION_PRINT(File, Loc) ((void) 0)
-# endif
-#endif
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT(File, Loc)  YYLOCATION_PRINT(File, &(Loc))
+
+#  else
 
+#   define YYLOCATION_PRINT(File, Loc) ((void) 0)
+    /* Temporary convenience wrapper in case some people defined the
+       undocumented and private YY_LOCATION_PRINT macros.  */
+#   define YY_LOCATION_PRINT  YYLOCATION_PRINT
 
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)                    \
+#  endif
+# endif /* !defined YYLOCATION_PRINT */
+
+
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)                    \
 do {                                                                      \
   if (yydebug)                                                            \
     {                                                                     \
       YYFPRINTF (stderr, "%s ", Title);                                   \
       yy_symbol_print (stderr,                                            \
-                  Type, Value, Location, scanner, ast, meta, ctx); \
+                  Kind, Value, Location, scanner, ast, meta, arena, ctx); \
       YYFPRINTF (stderr, "\n");                                           \
     }                                                                     \
 } while (0)
 
 
-/*----------------------------------------.
-| Print this symbol's value on YYOUTPUT.  |
-`----------------------------------------*/
+/*-----------------------------------.
+| Print this symbol's value on YYO.  |
+`-----------------------------------*/
 
 static void
-yy_symbol_value_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx)
+yy_symbol_value_print (FILE *yyo,
+                       yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx)
 {
-  FILE *yyo = yyoutput;
-  YYUSE (yyo);
-  YYUSE (yylocationp);
-  YYUSE (scanner);
-  YYUSE (ast);
-  YYUSE (meta);
-  YYUSE (ctx);
+  FILE *yyoutput = yyo;
+  YY_USE (yyoutput);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (ast);
+  YY_USE (meta);
+  YY_USE (arena);
+  YY_USE (ctx);
   if (!yyvaluep)
     return;
-# ifdef YYPRINT
-  if (yytype < YYNTOKENS)
-    YYPRINT (yyoutput, yytoknum[yytype], *yyvaluep);
-# endif
-  YYUSE (yytype);
+  YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
+  YY_USE (yykind);
+  YY_IGNORE_MAYBE_UNINITIALIZED_END
 }
 
 
-/*--------------------------------.
-| Print this symbol on YYOUTPUT.  |
-`--------------------------------*/
+/*---------------------------.
+| Print this symbol on YYO.  |
+`---------------------------*/
 
 static void
-yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx)
+yy_symbol_print (FILE *yyo,
+                 yysymbol_kind_t yykind, YYSTYPE const * const yyvaluep, YYLTYPE const * const yylocationp, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx)
 {
-  YYFPRINTF (yyoutput, "%s %s (",
-             yytype < YYNTOKENS ? "token" : "nterm", yytname[yytype]);
+  YYFPRINTF (yyo, "%s %s (",
+             yykind < YYNTOKENS ? "token" : "nterm", yysymbol_name (yykind));
 
-  YY_LOCATION_PRINT (yyoutput, *yylocationp);
-  YYFPRINTF (yyoutput, ": ");
-  yy_symbol_value_print (yyoutput, yytype, yyvaluep, yylocationp, scanner, ast, meta, ctx);
-  YYFPRINTF (yyoutput, ")");
+  YYLOCATION_PRINT (yyo, yylocationp);
+  YYFPRINTF (yyo, ": ");
+  yy_symbol_value_print (yyo, yykind, yyvaluep, yylocationp, scanner, ast, meta, arena, ctx);
+  YYFPRINTF (yyo, ")");
 }
 
 /*------------------------------------------------------------------.
@@ -1146,7 +1227,7 @@ yy_symbol_print (FILE *yyoutput, int yytype, YYSTYPE const * const yyvaluep, YYL
 `------------------------------------------------------------------*/
 
 static void
-yy_stack_print (yytype_int16 *yybottom, yytype_int16 *yytop)
+yy_stack_print (yy_state_t *yybottom, yy_state_t *yytop)
 {
   YYFPRINTF (stderr, "Stack now");
   for (; yybottom <= yytop; yybottom++)
@@ -1169,21 +1250,22 @@ do {                                                            \
 `------------------------------------------------*/
 
 static void
-yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx)
+yy_reduce_print (yy_state_t *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp,
+                 int yyrule, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx)
 {
-  unsigned long int yylno = yyrline[yyrule];
+  int yylno = yyrline[yyrule];
   int yynrhs = yyr2[yyrule];
   int yyi;
-  YYFPRINTF (stderr, "Reducing stack by rule %d (line %lu):\n",
+  YYFPRINTF (stderr, "Reducing stack by rule %d (line %d):\n",
              yyrule - 1, yylno);
   /* The symbols being reduced.  */
   for (yyi = 0; yyi < yynrhs; yyi++)
     {
       YYFPRINTF (stderr, "   $%d = ", yyi + 1);
       yy_symbol_print (stderr,
-                       yystos[yyssp[yyi + 1 - yynrhs]],
-                       &(yyvsp[(yyi + 1) - (yynrhs)])
-                       , &(yylsp[(yyi + 1) - (yynrhs)])                       , scanner, ast, meta, ctx);
+                       YY_ACCESSING_SYMBOL (+yyssp[yyi + 1 - yynrhs]),
+                       &yyvsp[(yyi + 1) - (yynrhs)],
+                       &(yylsp[(yyi + 1) - (yynrhs)]), scanner, ast, meta, arena, ctx);
       YYFPRINTF (stderr, "\n");
     }
 }
@@ -1191,15 +1273,15 @@ yy_reduce_print (yytype_int16 *yyssp, YYSTYPE *yyvsp, YYLTYPE *yylsp, int yyrule
 # define YY_REDUCE_PRINT(Rule)          \
 do {                                    \
   if (yydebug)                          \
-    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, scanner, ast, meta, ctx); \
+    yy_reduce_print (yyssp, yyvsp, yylsp, Rule, scanner, ast, meta, arena, ctx); \
 } while (0)
 
 /* Nonzero means print parse trace.  It is left uninitialized so that
    multiple parsers can coexist.  */
 int yydebug;
 #else /* !YYDEBUG */
-# define YYDPRINTF(Args)
-# define YY_SYMBOL_PRINT(Title, Type, Value, Location)
+# define YYDPRINTF(Args) ((void) 0)
+# define YY_SYMBOL_PRINT(Title, Kind, Value, Location)
 # define YY_STACK_PRINT(Bottom, Top)
 # define YY_REDUCE_PRINT(Rule)
 #endif /* !YYDEBUG */
@@ -1222,28 +1304,77 @@ int yydebug;
 #endif
 
 
-#if YYERROR_VERBOSE
+/* Context of a parse error.  */
+typedef struct
+{
+  yy_state_t *yyssp;
+  yysymbol_kind_t yytoken;
+  YYLTYPE *yylloc;
+} yypcontext_t;
+
+/* Put in YYARG at most YYARGN of the expected tokens given the
+   current YYCTX, and return the number of tokens stored in YYARG.  If
+   YYARG is null, return the number of expected tokens (guaranteed to
+   be less than YYNTOKENS).  Return YYENOMEM on memory exhaustion.
+   Return 0 if there are more than YYARGN expected tokens, yet fill
+   YYARG up to YYARGN. */
+static int
+yypcontext_expected_tokens (const yypcontext_t *yyctx,
+                            yysymbol_kind_t yyarg[], int yyargn)
+{
+  /* Actual size of YYARG. */
+  int yycount = 0;
+  int yyn = yypact[+*yyctx->yyssp];
+  if (!yypact_value_is_default (yyn))
+    {
+      /* Start YYX at -YYN if negative to avoid negative indexes in
+         YYCHECK.  In other words, skip the first -YYN actions for
+         this state because they are default actions.  */
+      int yyxbegin = yyn < 0 ? -yyn : 0;
+      /* Stay within bounds of both yycheck and yytname.  */
+      int yychecklim = YYLAST - yyn + 1;
+      int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
+      int yyx;
+      for (yyx = yyxbegin; yyx < yyxend; ++yyx)
+        if (yycheck[yyx + yyn] == yyx && yyx != YYSYMBOL_YYerror
+            && !yytable_value_is_error (yytable[yyx + yyn]))
+          {
+            if (!yyarg)
+              ++yycount;
+            else if (yycount == yyargn)
+              return 0;
+            else
+              yyarg[yycount++] = YY_CAST (yysymbol_kind_t, yyx);
+          }
+    }
+  if (yyarg && yycount == 0 && 0 < yyargn)
+    yyarg[0] = YYSYMBOL_YYEMPTY;
+  return yycount;
+}
+
+
 
-# ifndef yystrlen
-#  if defined __GLIBC__ && defined _STRING_H
-#   define yystrlen strlen
-#  else
+
+#ifndef yystrlen
+# if defined __GLIBC__ && defined _STRING_H
+#  define yystrlen(S) (YY_CAST (YYPTRDIFF_T, strlen (S)))
+# else
 /* Return the length of YYSTR.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yystrlen (const char *yystr)
 {
-  YYSIZE_T yylen;
+  YYPTRDIFF_T yylen;
   for (yylen = 0; yystr[yylen]; yylen++)
     continue;
   return yylen;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yystpcpy
-#  if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
-#   define yystpcpy stpcpy
-#  else
+#ifndef yystpcpy
+# if defined __GLIBC__ && defined _STRING_H && defined _GNU_SOURCE
+#  define yystpcpy stpcpy
+# else
 /* Copy YYSRC to YYDEST, returning the address of the terminating '\0' in
    YYDEST.  */
 static char *
@@ -1257,10 +1388,10 @@ yystpcpy (char *yydest, const char *yysrc)
 
   return yyd - 1;
 }
-#  endif
 # endif
+#endif
 
-# ifndef yytnamerr
+#ifndef yytnamerr
 /* Copy to YYRES the contents of YYSTR after stripping away unnecessary
    quotes and backslashes, so that it's suitable for yyerror.  The
    heuristic is that double-quoting is unnecessary unless the string
@@ -1268,14 +1399,13 @@ yystpcpy (char *yydest, const char *yysrc)
    backslash-backslash).  YYSTR is taken from yytname.  If YYRES is
    null, do not copy; instead, return the length of what the result
    would have been.  */
-static YYSIZE_T
+static YYPTRDIFF_T
 yytnamerr (char *yyres, const char *yystr)
 {
   if (*yystr == '"')
     {
-      YYSIZE_T yyn = 0;
+      YYPTRDIFF_T yyn = 0;
       char const *yyp = yystr;
-
       for (;;)
         switch (*++yyp)
           {
@@ -1286,7 +1416,10 @@ yytnamerr (char *yyres, const char *yystr)
           case '\\':
             if (*++yyp != '\\')
               goto do_not_strip_quotes;
-            /* Fall through.  */
+            else
+              goto append;
+
+          append:
           default:
             if (yyres)
               yyres[yyn] = *yyp;
@@ -1301,36 +1434,20 @@ yytnamerr (char *yyres, const char *yystr)
     do_not_strip_quotes: ;
     }
 
-  if (! yyres)
+  if (yyres)
+    return yystpcpy (yyres, yystr) - yyres;
+  else
     return yystrlen (yystr);
-
-  return yystpcpy (yyres, yystr) - yyres;
 }
-# endif
+#endif
 
-/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
-   about the unexpected token YYTOKEN for the state stack whose top is
-   YYSSP.
 
-   Return 0 if *YYMSG was successfully written.  Return 1 if *YYMSG is
-   not large enough to hold the message.  In that case, also set
-   *YYMSG_ALLOC to the required number of bytes.  Return 2 if the
-   required number of bytes is too large to store.  */
 static int
-yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
-                yytype_int16 *yyssp, int yytoken)
+yy_syntax_error_arguments (const yypcontext_t *yyctx,
+                           yysymbol_kind_t yyarg[], int yyargn)
 {
-  YYSIZE_T yysize0 = yytnamerr (YY_NULLPTR, yytname[yytoken]);
-  YYSIZE_T yysize = yysize0;
-  enum { YYERROR_VERBOSE_ARGS_MAXIMUM = 5 };
-  /* Internationalized format string. */
-  const char *yyformat = YY_NULLPTR;
-  /* Arguments of yyformat. */
-  char const *yyarg[YYERROR_VERBOSE_ARGS_MAXIMUM];
-  /* Number of reported tokens (one for the "unexpected", one per
-     "expected"). */
+  /* Actual size of YYARG. */
   int yycount = 0;
-
   /* There are many possibilities here to consider:
      - If this state is a consistent state with a default action, then
        the only way this function was invoked is if the default action
@@ -1354,63 +1471,78 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
        one exception: it will still contain any token that will not be
        accepted due to an error action in a later state.
   */
-  if (yytoken != YYEMPTY)
+  if (yyctx->yytoken != YYSYMBOL_YYEMPTY)
     {
-      int yyn = yypact[*yyssp];
-      yyarg[yycount++] = yytname[yytoken];
-      if (!yypact_value_is_default (yyn))
-        {
-          /* Start YYX at -YYN if negative to avoid negative indexes in
-             YYCHECK.  In other words, skip the first -YYN actions for
-             this state because they are default actions.  */
-          int yyxbegin = yyn < 0 ? -yyn : 0;
-          /* Stay within bounds of both yycheck and yytname.  */
-          int yychecklim = YYLAST - yyn + 1;
-          int yyxend = yychecklim < YYNTOKENS ? yychecklim : YYNTOKENS;
-          int yyx;
-
-          for (yyx = yyxbegin; yyx < yyxend; ++yyx)
-            if (yycheck[yyx + yyn] == yyx && yyx != YYTERROR
-                && !yytable_value_is_error (yytable[yyx + yyn]))
-              {
-                if (yycount == YYERROR_VERBOSE_ARGS_MAXIMUM)
-                  {
-                    yycount = 1;
-                    yysize = yysize0;
-                    break;
-                  }
-                yyarg[yycount++] = yytname[yyx];
-                {
-                  YYSIZE_T yysize1 = yysize + yytnamerr (YY_NULLPTR, yytname[yyx]);
-                  if (! (yysize <= yysize1
-                         && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-                    return 2;
-                  yysize = yysize1;
-                }
-              }
-        }
+      int yyn;
+      if (yyarg)
+        yyarg[yycount] = yyctx->yytoken;
+      ++yycount;
+      yyn = yypcontext_expected_tokens (yyctx,
+                                        yyarg ? yyarg + 1 : yyarg, yyargn - 1);
+      if (yyn == YYENOMEM)
+        return YYENOMEM;
+      else
+        yycount += yyn;
     }
+  return yycount;
+}
+
+/* Copy into *YYMSG, which is of size *YYMSG_ALLOC, an error message
+   about the unexpected token YYTOKEN for the state stack whose top is
+   YYSSP.
+
+   Return 0 if *YYMSG was successfully written.  Return -1 if *YYMSG is
+   not large enough to hold the message.  In that case, also set
+   *YYMSG_ALLOC to the required number of bytes.  Return YYENOMEM if the
+   required number of bytes is too large to store.  */
+static int
+yysyntax_error (YYPTRDIFF_T *yymsg_alloc, char **yymsg,
+                const yypcontext_t *yyctx)
+{
+  enum { YYARGS_MAX = 5 };
+  /* Internationalized format string. */
+  const char *yyformat = YY_NULLPTR;
+  /* Arguments of yyformat: reported tokens (one for the "unexpected",
+     one per "expected"). */
+  yysymbol_kind_t yyarg[YYARGS_MAX];
+  /* Cumulated lengths of YYARG.  */
+  YYPTRDIFF_T yysize = 0;
+
+  /* Actual size of YYARG. */
+  int yycount = yy_syntax_error_arguments (yyctx, yyarg, YYARGS_MAX);
+  if (yycount == YYENOMEM)
+    return YYENOMEM;
 
   switch (yycount)
     {
-# define YYCASE_(N, S)                      \
+#define YYCASE_(N, S)                       \
       case N:                               \
         yyformat = S;                       \
-      break
+        break
+    default: /* Avoid compiler warnings. */
       YYCASE_(0, YY_("syntax error"));
       YYCASE_(1, YY_("syntax error, unexpected %s"));
       YYCASE_(2, YY_("syntax error, unexpected %s, expecting %s"));
       YYCASE_(3, YY_("syntax error, unexpected %s, expecting %s or %s"));
       YYCASE_(4, YY_("syntax error, unexpected %s, expecting %s or %s or %s"));
       YYCASE_(5, YY_("syntax error, unexpected %s, expecting %s or %s or %s or %s"));
-# undef YYCASE_
+#undef YYCASE_
     }
 
+  /* Compute error message size.  Don't count the "%s"s, but reserve
+     room for the terminator.  */
+  yysize = yystrlen (yyformat) - 2 * yycount + 1;
   {
-    YYSIZE_T yysize1 = yysize + yystrlen (yyformat);
-    if (! (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM))
-      return 2;
-    yysize = yysize1;
+    int yyi;
+    for (yyi = 0; yyi < yycount; ++yyi)
+      {
+        YYPTRDIFF_T yysize1
+          = yysize + yytnamerr (YY_NULLPTR, yytname[yyarg[yyi]]);
+        if (yysize <= yysize1 && yysize1 <= YYSTACK_ALLOC_MAXIMUM)
+          yysize = yysize1;
+        else
+          return YYENOMEM;
+      }
   }
 
   if (*yymsg_alloc < yysize)
@@ -1419,7 +1551,7 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
       if (! (yysize <= *yymsg_alloc
              && *yymsg_alloc <= YYSTACK_ALLOC_MAXIMUM))
         *yymsg_alloc = YYSTACK_ALLOC_MAXIMUM;
-      return 1;
+      return -1;
     }
 
   /* Avoid sprintf, as that infringes on the user's name space.
@@ -1431,304 +1563,305 @@ yysyntax_error (YYSIZE_T *yymsg_alloc, char **yymsg,
     while ((*yyp = *yyformat) != '\0')
       if (*yyp == '%' && yyformat[1] == 's' && yyi < yycount)
         {
-          yyp += yytnamerr (yyp, yyarg[yyi++]);
+          yyp += yytnamerr (yyp, yytname[yyarg[yyi++]]);
           yyformat += 2;
         }
       else
         {
-          yyp++;
-          yyformat++;
+          ++yyp;
+          ++yyformat;
         }
   }
   return 0;
 }
-#endif /* YYERROR_VERBOSE */
+
 
 /*-----------------------------------------------.
 | Release the memory associated to this symbol.  |
 `-----------------------------------------------*/
 
 static void
-yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx)
+yydestruct (const char *yymsg,
+            yysymbol_kind_t yykind, YYSTYPE *yyvaluep, YYLTYPE *yylocationp, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx)
 {
-  YYUSE (yyvaluep);
-  YYUSE (yylocationp);
-  YYUSE (scanner);
-  YYUSE (ast);
-  YYUSE (meta);
-  YYUSE (ctx);
+  YY_USE (yyvaluep);
+  YY_USE (yylocationp);
+  YY_USE (scanner);
+  YY_USE (ast);
+  YY_USE (meta);
+  YY_USE (arena);
+  YY_USE (ctx);
   if (!yymsg)
     yymsg = "Deleting";
-  YY_SYMBOL_PRINT (yymsg, yytype, yyvaluep, yylocationp);
+  YY_SYMBOL_PRINT (yymsg, yykind, yyvaluep, yylocationp);
 
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
-  switch (yytype)
+  switch (yykind)
     {
-          case 59: /* INTEGER  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1471 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_INTEGER: /* INTEGER  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1605 "grammar.c"
         break;
 
-    case 60: /* FLOATNUMBER  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1477 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_FLOATNUMBER: /* FLOATNUMBER  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1611 "grammar.c"
         break;
 
-    case 61: /* STRINGLIT  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1483 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_STRINGLIT: /* STRINGLIT  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1617 "grammar.c"
         break;
 
-    case 62: /* NAME_LOWER  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1489 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_NAME_LOWER: /* NAME_LOWER  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1623 "grammar.c"
         break;
 
-    case 63: /* NAME_UPPER  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1495 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_NAME_UPPER: /* NAME_UPPER  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1629 "grammar.c"
         break;
 
-    case 64: /* NAME_OTHER  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1501 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_NAME_OTHER: /* NAME_OTHER  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1635 "grammar.c"
         break;
 
-    case 66: /* input  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1507 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_input: /* input  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1641 "grammar.c"
         break;
 
-    case 67: /* datashape_or_module  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1513 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_datashape_or_module: /* datashape_or_module  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1647 "grammar.c"
         break;
 
-    case 68: /* datashape_with_ellipsis  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1519 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_datashape_with_ellipsis: /* datashape_with_ellipsis  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1653 "grammar.c"
         break;
 
-    case 69: /* datashape  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1525 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_datashape: /* datashape  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1659 "grammar.c"
         break;
 
-    case 70: /* dimensions  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1531 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_dimensions: /* dimensions  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1665 "grammar.c"
         break;
 
-    case 71: /* dimensions_nooption  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1537 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_dimensions_nooption: /* dimensions_nooption  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1671 "grammar.c"
         break;
 
-    case 72: /* dimensions_tail  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1543 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_dimensions_tail: /* dimensions_tail  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1677 "grammar.c"
         break;
 
-    case 73: /* dtype  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1549 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_dtype: /* dtype  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1683 "grammar.c"
         break;
 
-    case 74: /* scalar  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1555 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_scalar: /* scalar  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1689 "grammar.c"
         break;
 
-    case 75: /* signed  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1561 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_signed: /* signed  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1695 "grammar.c"
         break;
 
-    case 76: /* unsigned  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1567 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_unsigned: /* unsigned  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1701 "grammar.c"
         break;
 
-    case 77: /* ieee_float  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1573 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_ieee_float: /* ieee_float  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1707 "grammar.c"
         break;
 
-    case 78: /* ieee_complex  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1579 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_ieee_complex: /* ieee_complex  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1713 "grammar.c"
         break;
 
-    case 79: /* alias  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1585 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_alias: /* alias  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1719 "grammar.c"
         break;
 
-    case 80: /* character  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1591 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_character: /* character  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1725 "grammar.c"
         break;
 
-    case 81: /* string  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1597 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_string: /* string  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1731 "grammar.c"
         break;
 
-    case 82: /* fixed_string  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1603 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_fixed_string: /* fixed_string  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1737 "grammar.c"
         break;
 
-    case 85: /* bytes  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1609 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_bytes: /* bytes  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1743 "grammar.c"
         break;
 
-    case 86: /* fixed_bytes  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1615 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_fixed_bytes: /* fixed_bytes  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1749 "grammar.c"
         break;
 
-    case 87: /* ref  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1621 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_ref: /* ref  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1755 "grammar.c"
         break;
 
-    case 88: /* categorical  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1627 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_categorical: /* categorical  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1761 "grammar.c"
         break;
 
-    case 89: /* typed_value_seq  */
-#line 187 "grammar.y" /* yacc.c:1257  */
-      { ndt_value_seq_del(((*yyvaluep).typed_value_seq)); }
-#line 1633 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_typed_value_seq: /* typed_value_seq  */
+#line 189 "grammar.y"
+            { ndt_value_seq_del(((*yyvaluep).typed_value_seq)); }
+#line 1767 "grammar.c"
         break;
 
-    case 90: /* typed_value  */
-#line 186 "grammar.y" /* yacc.c:1257  */
-      { ndt_value_del(((*yyvaluep).typed_value)); }
-#line 1639 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_typed_value: /* typed_value  */
+#line 188 "grammar.y"
+            { ndt_value_clear(((*yyvaluep).typed_value)); }
+#line 1773 "grammar.c"
         break;
 
-    case 93: /* tuple_type  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1645 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_tuple_type: /* tuple_type  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1779 "grammar.c"
         break;
 
-    case 94: /* tuple_field_seq  */
-#line 185 "grammar.y" /* yacc.c:1257  */
-      { ndt_field_seq_del(((*yyvaluep).field_seq)); }
-#line 1651 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_tuple_field_seq: /* tuple_field_seq  */
+#line 187 "grammar.y"
+            { ndt_field_seq_del(((*yyvaluep).field_seq)); }
+#line 1785 "grammar.c"
         break;
 
-    case 95: /* tuple_field  */
-#line 184 "grammar.y" /* yacc.c:1257  */
-      { ndt_field_del(((*yyvaluep).field)); }
-#line 1657 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_tuple_field: /* tuple_field  */
+#line 186 "grammar.y"
+            { ndt_field_clear(((*yyvaluep).field)); }
+#line 1791 "grammar.c"
         break;
 
-    case 96: /* record_type  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1663 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_record_type: /* record_type  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1797 "grammar.c"
         break;
 
-    case 97: /* record_field_seq  */
-#line 185 "grammar.y" /* yacc.c:1257  */
-      { ndt_field_seq_del(((*yyvaluep).field_seq)); }
-#line 1669 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_record_field_seq: /* record_field_seq  */
+#line 187 "grammar.y"
+            { ndt_field_seq_del(((*yyvaluep).field_seq)); }
+#line 1803 "grammar.c"
         break;
 
-    case 98: /* record_field  */
-#line 184 "grammar.y" /* yacc.c:1257  */
-      { ndt_field_del(((*yyvaluep).field)); }
-#line 1675 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_record_field: /* record_field  */
+#line 186 "grammar.y"
+            { ndt_field_clear(((*yyvaluep).field)); }
+#line 1809 "grammar.c"
         break;
 
-    case 99: /* record_field_name  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1681 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_record_field_name: /* record_field_name  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1815 "grammar.c"
         break;
 
-    case 100: /* arguments_opt  */
-#line 189 "grammar.y" /* yacc.c:1257  */
-      { ndt_attr_seq_del(((*yyvaluep).attribute_seq)); }
-#line 1687 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_arguments_opt: /* arguments_opt  */
+#line 191 "grammar.y"
+            { ndt_attr_seq_del(((*yyvaluep).attribute_seq)); }
+#line 1821 "grammar.c"
         break;
 
-    case 101: /* attribute_seq  */
-#line 189 "grammar.y" /* yacc.c:1257  */
-      { ndt_attr_seq_del(((*yyvaluep).attribute_seq)); }
-#line 1693 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_attribute_seq: /* attribute_seq  */
+#line 191 "grammar.y"
+            { ndt_attr_seq_del(((*yyvaluep).attribute_seq)); }
+#line 1827 "grammar.c"
         break;
 
-    case 102: /* attribute  */
-#line 188 "grammar.y" /* yacc.c:1257  */
-      { ndt_attr_del(((*yyvaluep).attribute)); }
-#line 1699 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_attribute: /* attribute  */
+#line 190 "grammar.y"
+            { ndt_attr_clear(((*yyvaluep).attribute)); }
+#line 1833 "grammar.c"
         break;
 
-    case 103: /* untyped_value_seq  */
-#line 191 "grammar.y" /* yacc.c:1257  */
-      { ndt_string_seq_del(((*yyvaluep).string_seq)); }
-#line 1705 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_untyped_value_seq: /* untyped_value_seq  */
+#line 193 "grammar.y"
+            { ndt_string_seq_del(((*yyvaluep).string_seq)); }
+#line 1839 "grammar.c"
         break;
 
-    case 104: /* untyped_value  */
-#line 190 "grammar.y" /* yacc.c:1257  */
-      { ndt_free(((*yyvaluep).string)); }
-#line 1711 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_untyped_value: /* untyped_value  */
+#line 192 "grammar.y"
+            { ndt_free(((*yyvaluep).string)); }
+#line 1845 "grammar.c"
         break;
 
-    case 105: /* function_type  */
-#line 183 "grammar.y" /* yacc.c:1257  */
-      { ndt_del(((*yyvaluep).ndt)); }
-#line 1717 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_function_type: /* function_type  */
+#line 185 "grammar.y"
+            { ndt_del(((*yyvaluep).ndt)); }
+#line 1851 "grammar.c"
         break;
 
-    case 106: /* type_seq_or_void  */
-#line 192 "grammar.y" /* yacc.c:1257  */
-      { ndt_type_seq_del(((*yyvaluep).type_seq)); }
-#line 1723 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_type_seq_or_void: /* type_seq_or_void  */
+#line 194 "grammar.y"
+            { ndt_type_seq_del(((*yyvaluep).type_seq)); }
+#line 1857 "grammar.c"
         break;
 
-    case 107: /* type_seq  */
-#line 192 "grammar.y" /* yacc.c:1257  */
-      { ndt_type_seq_del(((*yyvaluep).type_seq)); }
-#line 1729 "grammar.c" /* yacc.c:1257  */
+    case YYSYMBOL_type_seq: /* type_seq  */
+#line 194 "grammar.y"
+            { ndt_type_seq_del(((*yyvaluep).type_seq)); }
+#line 1863 "grammar.c"
         break;
 
-
       default:
         break;
     }
@@ -1738,14 +1871,16 @@ yydestruct (const char *yymsg, int yytype, YYSTYPE *yyvaluep, YYLTYPE *yylocatio
 
 
 
+
+
 /*----------.
 | yyparse.  |
 `----------*/
 
 int
-yyparse (yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx)
+yyparse (yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx)
 {
-/* The lookahead symbol.  */
+/* Lookahead token kind.  */
 int yychar;
 
 
@@ -1764,55 +1899,50 @@ static YYLTYPE yyloc_default
 YYLTYPE yylloc = yyloc_default;
 
     /* Number of syntax errors so far.  */
-    int yynerrs;
+    int yynerrs = 0;
 
-    int yystate;
+    yy_state_fast_t yystate = 0;
     /* Number of tokens to shift before error messages enabled.  */
-    int yyerrstatus;
-
-    /* The stacks and their tools:
-       'yyss': related to states.
-       'yyvs': related to semantic values.
-       'yyls': related to locations.
+    int yyerrstatus = 0;
 
-       Refer to the stacks through separate pointers, to allow yyoverflow
+    /* Refer to the stacks through separate pointers, to allow yyoverflow
        to reallocate them elsewhere.  */
 
-    /* The state stack.  */
-    yytype_int16 yyssa[YYINITDEPTH];
-    yytype_int16 *yyss;
-    yytype_int16 *yyssp;
+    /* Their size.  */
+    YYPTRDIFF_T yystacksize = YYINITDEPTH;
 
-    /* The semantic value stack.  */
+    /* The state stack: array, bottom, top.  */
+    yy_state_t yyssa[YYINITDEPTH];
+    yy_state_t *yyss = yyssa;
+    yy_state_t *yyssp = yyss;
+
+    /* The semantic value stack: array, bottom, top.  */
     YYSTYPE yyvsa[YYINITDEPTH];
-    YYSTYPE *yyvs;
-    YYSTYPE *yyvsp;
+    YYSTYPE *yyvs = yyvsa;
+    YYSTYPE *yyvsp = yyvs;
 
-    /* The location stack.  */
+    /* The location stack: array, bottom, top.  */
     YYLTYPE yylsa[YYINITDEPTH];
-    YYLTYPE *yyls;
-    YYLTYPE *yylsp;
-
-    /* The locations where the error started and ended.  */
-    YYLTYPE yyerror_range[3];
-
-    YYSIZE_T yystacksize;
+    YYLTYPE *yyls = yylsa;
+    YYLTYPE *yylsp = yyls;
 
   int yyn;
+  /* The return value of yyparse.  */
   int yyresult;
-  /* Lookahead token as an internal (translated) token number.  */
-  int yytoken = 0;
+  /* Lookahead symbol kind.  */
+  yysymbol_kind_t yytoken = YYSYMBOL_YYEMPTY;
   /* The variables used to return semantic value and location from the
      action routines.  */
   YYSTYPE yyval;
   YYLTYPE yyloc;
 
-#if YYERROR_VERBOSE
+  /* The locations where the error started and ended.  */
+  YYLTYPE yyerror_range[3];
+
   /* Buffer for error messages, and its allocated size.  */
   char yymsgbuf[128];
   char *yymsg = yymsgbuf;
-  YYSIZE_T yymsg_alloc = sizeof yymsgbuf;
-#endif
+  YYPTRDIFF_T yymsg_alloc = sizeof yymsgbuf;
 
 #define YYPOPSTACK(N)   (yyvsp -= (N), yyssp -= (N), yylsp -= (N))
 
@@ -1820,20 +1950,13 @@ YYLTYPE yylloc = yyloc_default;
      Keep to zero when no symbol should be popped.  */
   int yylen = 0;
 
-  yyssp = yyss = yyssa;
-  yyvsp = yyvs = yyvsa;
-  yylsp = yyls = yylsa;
-  yystacksize = YYINITDEPTH;
-
   YYDPRINTF ((stderr, "Starting parse\n"));
 
-  yystate = 0;
-  yyerrstatus = 0;
-  yynerrs = 0;
   yychar = YYEMPTY; /* Cause a token to be read.  */
 
+
 /* User initialization code.  */
-#line 76 "grammar.y" /* yacc.c:1429  */
+#line 78 "grammar.y"
 {
    yylloc.first_line = 1;
    yylloc.first_column = 1;
@@ -1841,33 +1964,47 @@ YYLTYPE yylloc = yyloc_default;
    yylloc.last_column = 1;
 }
 
-#line 1845 "grammar.c" /* yacc.c:1429  */
+#line 1968 "grammar.c"
+
   yylsp[0] = yylloc;
   goto yysetstate;
 
+
 /*------------------------------------------------------------.
-| yynewstate -- Push a new state, which is found in yystate.  |
+| yynewstate -- push a new state, which is found in yystate.  |
 `------------------------------------------------------------*/
- yynewstate:
+yynewstate:
   /* In all cases, when you get here, the value and location stacks
      have just been pushed.  So pushing a state here evens the stacks.  */
   yyssp++;
 
- yysetstate:
-  *yyssp = yystate;
+
+/*--------------------------------------------------------------------.
+| yysetstate -- set current state (the top of the stack) to yystate.  |
+`--------------------------------------------------------------------*/
+yysetstate:
+  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
+  YY_ASSERT (0 <= yystate && yystate < YYNSTATES);
+  YY_IGNORE_USELESS_CAST_BEGIN
+  *yyssp = YY_CAST (yy_state_t, yystate);
+  YY_IGNORE_USELESS_CAST_END
+  YY_STACK_PRINT (yyss, yyssp);
 
   if (yyss + yystacksize - 1 <= yyssp)
+#if !defined yyoverflow && !defined YYSTACK_RELOCATE
+    YYNOMEM;
+#else
     {
       /* Get the current used size of the three stacks, in elements.  */
-      YYSIZE_T yysize = yyssp - yyss + 1;
+      YYPTRDIFF_T yysize = yyssp - yyss + 1;
 
-#ifdef yyoverflow
+# if defined yyoverflow
       {
         /* Give user a chance to reallocate the stack.  Use copies of
            these so that the &'s don't force the real ones into
            memory.  */
+        yy_state_t *yyss1 = yyss;
         YYSTYPE *yyvs1 = yyvs;
-        yytype_int16 *yyss1 = yyss;
         YYLTYPE *yyls1 = yyls;
 
         /* Each stack pointer address is followed by the size of the
@@ -1875,32 +2012,29 @@ YYLTYPE yylloc = yyloc_default;
            conditional around just the two extra args, but that might
            be undefined if yyoverflow is a macro.  */
         yyoverflow (YY_("memory exhausted"),
-                    &yyss1, yysize * sizeof (*yyssp),
-                    &yyvs1, yysize * sizeof (*yyvsp),
-                    &yyls1, yysize * sizeof (*yylsp),
+                    &yyss1, yysize * YYSIZEOF (*yyssp),
+                    &yyvs1, yysize * YYSIZEOF (*yyvsp),
+                    &yyls1, yysize * YYSIZEOF (*yylsp),
                     &yystacksize);
-
-        yyls = yyls1;
         yyss = yyss1;
         yyvs = yyvs1;
+        yyls = yyls1;
       }
-#else /* no yyoverflow */
-# ifndef YYSTACK_RELOCATE
-      goto yyexhaustedlab;
-# else
+# else /* defined YYSTACK_RELOCATE */
       /* Extend the stack our own way.  */
       if (YYMAXDEPTH <= yystacksize)
-        goto yyexhaustedlab;
+        YYNOMEM;
       yystacksize *= 2;
       if (YYMAXDEPTH < yystacksize)
         yystacksize = YYMAXDEPTH;
 
       {
-        yytype_int16 *yyss1 = yyss;
+        yy_state_t *yyss1 = yyss;
         union yyalloc *yyptr =
-          (union yyalloc *) YYSTACK_ALLOC (YYSTACK_BYTES (yystacksize));
+          YY_CAST (union yyalloc *,
+                   YYSTACK_ALLOC (YY_CAST (YYSIZE_T, YYSTACK_BYTES (yystacksize))));
         if (! yyptr)
-          goto yyexhaustedlab;
+          YYNOMEM;
         YYSTACK_RELOCATE (yyss_alloc, yyss);
         YYSTACK_RELOCATE (yyvs_alloc, yyvs);
         YYSTACK_RELOCATE (yyls_alloc, yyls);
@@ -1909,31 +2043,32 @@ YYLTYPE yylloc = yyloc_default;
           YYSTACK_FREE (yyss1);
       }
 # endif
-#endif /* no yyoverflow */
 
       yyssp = yyss + yysize - 1;
       yyvsp = yyvs + yysize - 1;
       yylsp = yyls + yysize - 1;
 
-      YYDPRINTF ((stderr, "Stack size increased to %lu\n",
-                  (unsigned long int) yystacksize));
+      YY_IGNORE_USELESS_CAST_BEGIN
+      YYDPRINTF ((stderr, "Stack size increased to %ld\n",
+                  YY_CAST (long, yystacksize)));
+      YY_IGNORE_USELESS_CAST_END
 
       if (yyss + yystacksize - 1 <= yyssp)
         YYABORT;
     }
+#endif /* !defined yyoverflow && !defined YYSTACK_RELOCATE */
 
-  YYDPRINTF ((stderr, "Entering state %d\n", yystate));
 
   if (yystate == YYFINAL)
     YYACCEPT;
 
   goto yybackup;
 
+
 /*-----------.
 | yybackup.  |
 `-----------*/
 yybackup:
-
   /* Do appropriate processing given the current state.  Read a
      lookahead token if we need one and don't already have one.  */
 
@@ -1944,18 +2079,30 @@ yybackup:
 
   /* Not known => get a lookahead token if don't already have one.  */
 
-  /* YYCHAR is either YYEMPTY or YYEOF or a valid lookahead symbol.  */
+  /* YYCHAR is either empty, or end-of-input, or a valid lookahead.  */
   if (yychar == YYEMPTY)
     {
-      YYDPRINTF ((stderr, "Reading a token: "));
+      YYDPRINTF ((stderr, "Reading a token\n"));
       yychar = yylex (&yylval, &yylloc, scanner, ctx);
     }
 
-  if (yychar <= YYEOF)
+  if (yychar <= ENDMARKER)
     {
-      yychar = yytoken = YYEOF;
+      yychar = ENDMARKER;
+      yytoken = YYSYMBOL_YYEOF;
       YYDPRINTF ((stderr, "Now at end of input.\n"));
     }
+  else if (yychar == YYerror)
+    {
+      /* The scanner already issued an error message, process directly
+         to error recovery.  But do not keep the error token as
+         lookahead, it is too special and may lead us to an endless
+         loop in error recovery. */
+      yychar = YYUNDEF;
+      yytoken = YYSYMBOL_YYerror;
+      yyerror_range[1] = yylloc;
+      goto yyerrlab1;
+    }
   else
     {
       yytoken = YYTRANSLATE (yychar);
@@ -1983,15 +2130,14 @@ yybackup:
 
   /* Shift the lookahead token.  */
   YY_SYMBOL_PRINT ("Shifting", yytoken, &yylval, &yylloc);
-
-  /* Discard the shifted token.  */
-  yychar = YYEMPTY;
-
   yystate = yyn;
   YY_IGNORE_MAYBE_UNINITIALIZED_BEGIN
   *++yyvsp = yylval;
   YY_IGNORE_MAYBE_UNINITIALIZED_END
   *++yylsp = yylloc;
+
+  /* Discard the shifted token.  */
+  yychar = YYEMPTY;
   goto yynewstate;
 
 
@@ -2006,7 +2152,7 @@ yydefault:
 
 
 /*-----------------------------.
-| yyreduce -- Do a reduction.  |
+| yyreduce -- do a reduction.  |
 `-----------------------------*/
 yyreduce:
   /* yyn is the number of a rule to reduce with.  */
@@ -2022,783 +2168,791 @@ yyreduce:
      GCC warning that YYVAL may be used uninitialized.  */
   yyval = yyvsp[1-yylen];
 
-  /* Default location.  */
+  /* Default location. */
   YYLLOC_DEFAULT (yyloc, (yylsp - yylen), yylen);
+  yyerror_range[1] = yyloc;
   YY_REDUCE_PRINT (yyn);
   switch (yyn)
     {
-        case 2:
-#line 197 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[-1].ndt);  *ast = (yyval.ndt); YYACCEPT; }
-#line 2034 "grammar.c" /* yacc.c:1646  */
+  case 2: /* input: datashape_or_module "end of file"  */
+#line 199 "grammar.y"
+                                { (yyval.ndt) = (yyvsp[-1].ndt);  *ast = (yyval.ndt); YYACCEPT; }
+#line 2181 "grammar.c"
     break;
 
-  case 3:
-#line 201 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2040 "grammar.c" /* yacc.c:1646  */
+  case 3: /* datashape_or_module: datashape_with_ellipsis  */
+#line 203 "grammar.y"
+                                                 { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2187 "grammar.c"
     break;
 
-  case 4:
-#line 202 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2046 "grammar.c" /* yacc.c:1646  */
+  case 4: /* datashape_or_module: function_type  */
+#line 204 "grammar.y"
+                                                 { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2193 "grammar.c"
     break;
 
-  case 5:
-#line 203 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_module((yyvsp[-3].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2052 "grammar.c" /* yacc.c:1646  */
+  case 5: /* datashape_or_module: NAME_UPPER COLON COLON datashape_with_ellipsis  */
+#line 205 "grammar.y"
+                                                 { (yyval.ndt) = ndt_module((yyvsp[-3].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2199 "grammar.c"
     break;
 
-  case 6:
-#line 207 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2058 "grammar.c" /* yacc.c:1646  */
+  case 6: /* datashape_with_ellipsis: datashape  */
+#line 209 "grammar.y"
+                                           { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2205 "grammar.c"
     break;
 
-  case 7:
-#line 208 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_ellipsis_dim(NULL, (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2064 "grammar.c" /* yacc.c:1646  */
+  case 7: /* datashape_with_ellipsis: ELLIPSIS STAR dimensions_tail  */
+#line 210 "grammar.y"
+                                           { (yyval.ndt) = ndt_ellipsis_dim(NULL, (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2211 "grammar.c"
     break;
 
-  case 8:
-#line 209 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_ellipsis_dim((yyvsp[-3].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2070 "grammar.c" /* yacc.c:1646  */
+  case 8: /* datashape_with_ellipsis: NAME_UPPER ELLIPSIS STAR dimensions_tail  */
+#line 211 "grammar.y"
+                                           { (yyval.ndt) = ndt_ellipsis_dim((yyvsp[-3].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2217 "grammar.c"
     break;
 
-  case 9:
-#line 210 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_var_ellipsis((yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2076 "grammar.c" /* yacc.c:1646  */
+  case 9: /* datashape_with_ellipsis: VAR ELLIPSIS STAR dtype  */
+#line 212 "grammar.y"
+                                           { (yyval.ndt) = mk_var_ellipsis((yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2223 "grammar.c"
     break;
 
-  case 10:
-#line 211 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_var_ellipsis(ndt_option((yyvsp[0].ndt)), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2082 "grammar.c" /* yacc.c:1646  */
+  case 10: /* datashape_with_ellipsis: VAR ELLIPSIS STAR QUESTIONMARK dtype  */
+#line 213 "grammar.y"
+                                           { (yyval.ndt) = mk_var_ellipsis(ndt_option((yyvsp[0].ndt)), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2229 "grammar.c"
     break;
 
-  case 11:
-#line 214 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2088 "grammar.c" /* yacc.c:1646  */
+  case 11: /* datashape: dimensions  */
+#line 216 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2235 "grammar.c"
     break;
 
-  case 12:
-#line 215 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_fortran((yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2094 "grammar.c" /* yacc.c:1646  */
+  case 12: /* datashape: BANG dimensions  */
+#line 217 "grammar.y"
+                     { (yyval.ndt) = mk_fortran((yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2241 "grammar.c"
     break;
 
-  case 13:
-#line 216 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2100 "grammar.c" /* yacc.c:1646  */
+  case 13: /* datashape: dtype  */
+#line 218 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2247 "grammar.c"
     break;
 
-  case 14:
-#line 217 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_option((yyvsp[0].ndt)); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2106 "grammar.c" /* yacc.c:1646  */
+  case 14: /* datashape: QUESTIONMARK dtype  */
+#line 219 "grammar.y"
+                     { (yyval.ndt) = ndt_option((yyvsp[0].ndt)); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2253 "grammar.c"
     break;
 
-  case 15:
-#line 220 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2112 "grammar.c" /* yacc.c:1646  */
+  case 15: /* dimensions: dimensions_nooption  */
+#line 222 "grammar.y"
+                                   { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2259 "grammar.c"
     break;
 
-  case 16:
-#line 221 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_option((yyvsp[0].ndt)); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2118 "grammar.c" /* yacc.c:1646  */
+  case 16: /* dimensions: QUESTIONMARK dimensions_nooption  */
+#line 223 "grammar.y"
+                                   { (yyval.ndt) = ndt_option((yyvsp[0].ndt)); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2265 "grammar.c"
     break;
 
-  case 17:
-#line 224 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_fixed_dim_from_shape((yyvsp[-2].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2124 "grammar.c" /* yacc.c:1646  */
+  case 17: /* dimensions_nooption: INTEGER STAR dimensions_tail  */
+#line 226 "grammar.y"
+                                                         { (yyval.ndt) = mk_fixed_dim_from_shape((yyvsp[-2].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2271 "grammar.c"
     break;
 
-  case 18:
-#line 225 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_fixed_dim_from_attrs((yyvsp[-3].attribute_seq), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2130 "grammar.c" /* yacc.c:1646  */
+  case 18: /* dimensions_nooption: FIXED LPAREN attribute_seq RPAREN STAR dimensions_tail  */
+#line 227 "grammar.y"
+                                                         { (yyval.ndt) = mk_fixed_dim_from_attrs((yyvsp[-3].attribute_seq), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2277 "grammar.c"
     break;
 
-  case 19:
-#line 226 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_symbolic_dim((yyvsp[-2].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2136 "grammar.c" /* yacc.c:1646  */
+  case 19: /* dimensions_nooption: NAME_UPPER STAR dimensions_tail  */
+#line 228 "grammar.y"
+                                                         { (yyval.ndt) = ndt_symbolic_dim((yyvsp[-2].string), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2283 "grammar.c"
     break;
 
-  case 20:
-#line 227 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_var_dim(meta, (yyvsp[-2].attribute_seq), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2142 "grammar.c" /* yacc.c:1646  */
+  case 20: /* dimensions_nooption: VAR arguments_opt STAR dimensions_tail  */
+#line 229 "grammar.y"
+                                                         { (yyval.ndt) = mk_var_dim(meta, (yyvsp[-2].attribute_seq), (yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2289 "grammar.c"
     break;
 
-  case 21:
-#line 230 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2148 "grammar.c" /* yacc.c:1646  */
+  case 21: /* dimensions_tail: dtype  */
+#line 232 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2295 "grammar.c"
     break;
 
-  case 22:
-#line 231 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_option((yyvsp[0].ndt)); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2154 "grammar.c" /* yacc.c:1646  */
+  case 22: /* dimensions_tail: QUESTIONMARK dtype  */
+#line 233 "grammar.y"
+                     { (yyval.ndt) = ndt_option((yyvsp[0].ndt)); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2301 "grammar.c"
     break;
 
-  case 23:
-#line 232 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2160 "grammar.c" /* yacc.c:1646  */
+  case 23: /* dimensions_tail: dimensions  */
+#line 234 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2307 "grammar.c"
     break;
 
-  case 24:
-#line 235 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_any_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2166 "grammar.c" /* yacc.c:1646  */
+  case 24: /* dtype: ANY_KIND  */
+#line 237 "grammar.y"
+                                         { (yyval.ndt) = ndt_any_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2313 "grammar.c"
     break;
 
-  case 25:
-#line 236 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_scalar_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2172 "grammar.c" /* yacc.c:1646  */
+  case 25: /* dtype: SCALAR_KIND  */
+#line 238 "grammar.y"
+                                         { (yyval.ndt) = ndt_scalar_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2319 "grammar.c"
     break;
 
-  case 26:
-#line 237 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2178 "grammar.c" /* yacc.c:1646  */
+  case 26: /* dtype: scalar  */
+#line 239 "grammar.y"
+                                         { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2325 "grammar.c"
     break;
 
-  case 27:
-#line 238 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2184 "grammar.c" /* yacc.c:1646  */
+  case 27: /* dtype: tuple_type  */
+#line 240 "grammar.y"
+                                         { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2331 "grammar.c"
     break;
 
-  case 28:
-#line 239 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2190 "grammar.c" /* yacc.c:1646  */
+  case 28: /* dtype: record_type  */
+#line 241 "grammar.y"
+                                         { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2337 "grammar.c"
     break;
 
-  case 29:
-#line 240 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_nominal((yyvsp[0].string), NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2196 "grammar.c" /* yacc.c:1646  */
+  case 29: /* dtype: NAME_LOWER  */
+#line 242 "grammar.y"
+                                         { (yyval.ndt) = ndt_nominal((yyvsp[0].string), NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2343 "grammar.c"
     break;
 
-  case 30:
-#line 241 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_constr((yyvsp[-3].string), (yyvsp[-1].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2202 "grammar.c" /* yacc.c:1646  */
+  case 30: /* dtype: NAME_UPPER LPAREN datashape RPAREN  */
+#line 243 "grammar.y"
+                                         { (yyval.ndt) = ndt_constr((yyvsp[-3].string), (yyvsp[-1].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2349 "grammar.c"
     break;
 
-  case 31:
-#line 242 "grammar.y" /* yacc.c:1646  */
-    { (void)(yyvsp[-3].string); (void)(yyvsp[-1].attribute_seq); ndt_free((yyvsp[-3].string)); ndt_attr_seq_del((yyvsp[-1].attribute_seq)); (yyval.ndt) = NULL;
+  case 31: /* dtype: NAME_UPPER LPAREN attribute_seq RPAREN  */
+#line 244 "grammar.y"
+                                         { (void)(yyvsp[-3].string); (void)(yyvsp[-1].attribute_seq); ndt_free((yyvsp[-3].string)); ndt_attr_seq_del((yyvsp[-1].attribute_seq)); (yyval.ndt) = NULL;
                                             ndt_err_format(ctx, NDT_NotImplementedError, "general attributes are not implemented");
                                             YYABORT; }
-#line 2210 "grammar.c" /* yacc.c:1646  */
+#line 2357 "grammar.c"
     break;
 
-  case 32:
-#line 245 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_typevar((yyvsp[0].string), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2216 "grammar.c" /* yacc.c:1646  */
+  case 32: /* dtype: NAME_UPPER  */
+#line 247 "grammar.y"
+                                         { (yyval.ndt) = ndt_typevar((yyvsp[0].string), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2363 "grammar.c"
     break;
 
-  case 33:
-#line 248 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Bool, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2222 "grammar.c" /* yacc.c:1646  */
+  case 33: /* scalar: endian_opt BOOL  */
+#line 250 "grammar.y"
+                     { (yyval.ndt) = ndt_primitive(Bool, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2369 "grammar.c"
     break;
 
-  case 34:
-#line 249 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_signed_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2228 "grammar.c" /* yacc.c:1646  */
+  case 34: /* scalar: SIGNED_KIND  */
+#line 251 "grammar.y"
+                     { (yyval.ndt) = ndt_signed_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2375 "grammar.c"
     break;
 
-  case 35:
-#line 250 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2234 "grammar.c" /* yacc.c:1646  */
+  case 35: /* scalar: signed  */
+#line 252 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2381 "grammar.c"
     break;
 
-  case 36:
-#line 251 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_unsigned_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2240 "grammar.c" /* yacc.c:1646  */
+  case 36: /* scalar: UNSIGNED_KIND  */
+#line 253 "grammar.y"
+                     { (yyval.ndt) = ndt_unsigned_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2387 "grammar.c"
     break;
 
-  case 37:
-#line 252 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2246 "grammar.c" /* yacc.c:1646  */
+  case 37: /* scalar: unsigned  */
+#line 254 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2393 "grammar.c"
     break;
 
-  case 38:
-#line 253 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_float_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2252 "grammar.c" /* yacc.c:1646  */
+  case 38: /* scalar: FLOAT_KIND  */
+#line 255 "grammar.y"
+                     { (yyval.ndt) = ndt_float_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2399 "grammar.c"
     break;
 
-  case 39:
-#line 254 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2258 "grammar.c" /* yacc.c:1646  */
+  case 39: /* scalar: ieee_float  */
+#line 256 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2405 "grammar.c"
     break;
 
-  case 40:
-#line 255 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_complex_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2264 "grammar.c" /* yacc.c:1646  */
+  case 40: /* scalar: COMPLEX_KIND  */
+#line 257 "grammar.y"
+                     { (yyval.ndt) = ndt_complex_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2411 "grammar.c"
     break;
 
-  case 41:
-#line 256 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2270 "grammar.c" /* yacc.c:1646  */
+  case 41: /* scalar: ieee_complex  */
+#line 258 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2417 "grammar.c"
     break;
 
-  case 42:
-#line 257 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2276 "grammar.c" /* yacc.c:1646  */
+  case 42: /* scalar: alias  */
+#line 259 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2423 "grammar.c"
     break;
 
-  case 43:
-#line 258 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2282 "grammar.c" /* yacc.c:1646  */
+  case 43: /* scalar: character  */
+#line 260 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2429 "grammar.c"
     break;
 
-  case 44:
-#line 259 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2288 "grammar.c" /* yacc.c:1646  */
+  case 44: /* scalar: string  */
+#line 261 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2435 "grammar.c"
     break;
 
-  case 45:
-#line 260 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_fixed_string_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2294 "grammar.c" /* yacc.c:1646  */
+  case 45: /* scalar: FIXED_STRING_KIND  */
+#line 262 "grammar.y"
+                     { (yyval.ndt) = ndt_fixed_string_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2441 "grammar.c"
     break;
 
-  case 46:
-#line 261 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2300 "grammar.c" /* yacc.c:1646  */
+  case 46: /* scalar: fixed_string  */
+#line 263 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2447 "grammar.c"
     break;
 
-  case 47:
-#line 262 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2306 "grammar.c" /* yacc.c:1646  */
+  case 47: /* scalar: bytes  */
+#line 264 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2453 "grammar.c"
     break;
 
-  case 48:
-#line 263 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_fixed_bytes_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2312 "grammar.c" /* yacc.c:1646  */
+  case 48: /* scalar: FIXED_BYTES_KIND  */
+#line 265 "grammar.y"
+                     { (yyval.ndt) = ndt_fixed_bytes_kind(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2459 "grammar.c"
     break;
 
-  case 49:
-#line 264 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2318 "grammar.c" /* yacc.c:1646  */
+  case 49: /* scalar: fixed_bytes  */
+#line 266 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2465 "grammar.c"
     break;
 
-  case 50:
-#line 265 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2324 "grammar.c" /* yacc.c:1646  */
+  case 50: /* scalar: categorical  */
+#line 267 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2471 "grammar.c"
     break;
 
-  case 51:
-#line 266 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = (yyvsp[0].ndt); }
-#line 2330 "grammar.c" /* yacc.c:1646  */
+  case 51: /* scalar: ref  */
+#line 268 "grammar.y"
+                     { (yyval.ndt) = (yyvsp[0].ndt); }
+#line 2477 "grammar.c"
     break;
 
-  case 52:
-#line 269 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Int8, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2336 "grammar.c" /* yacc.c:1646  */
+  case 52: /* signed: endian_opt INT8  */
+#line 271 "grammar.y"
+                   { (yyval.ndt) = ndt_primitive(Int8, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2483 "grammar.c"
     break;
 
-  case 53:
-#line 270 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Int16, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2342 "grammar.c" /* yacc.c:1646  */
+  case 53: /* signed: endian_opt INT16  */
+#line 272 "grammar.y"
+                   { (yyval.ndt) = ndt_primitive(Int16, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2489 "grammar.c"
     break;
 
-  case 54:
-#line 271 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Int32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2348 "grammar.c" /* yacc.c:1646  */
+  case 54: /* signed: endian_opt INT32  */
+#line 273 "grammar.y"
+                   { (yyval.ndt) = ndt_primitive(Int32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2495 "grammar.c"
     break;
 
-  case 55:
-#line 272 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Int64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2354 "grammar.c" /* yacc.c:1646  */
+  case 55: /* signed: endian_opt INT64  */
+#line 274 "grammar.y"
+                   { (yyval.ndt) = ndt_primitive(Int64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2501 "grammar.c"
     break;
 
-  case 56:
-#line 275 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Uint8, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2360 "grammar.c" /* yacc.c:1646  */
+  case 56: /* unsigned: endian_opt UINT8  */
+#line 277 "grammar.y"
+                    { (yyval.ndt) = ndt_primitive(Uint8, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2507 "grammar.c"
     break;
 
-  case 57:
-#line 276 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Uint16, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2366 "grammar.c" /* yacc.c:1646  */
+  case 57: /* unsigned: endian_opt UINT16  */
+#line 278 "grammar.y"
+                    { (yyval.ndt) = ndt_primitive(Uint16, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2513 "grammar.c"
     break;
 
-  case 58:
-#line 277 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Uint32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2372 "grammar.c" /* yacc.c:1646  */
+  case 58: /* unsigned: endian_opt UINT32  */
+#line 279 "grammar.y"
+                    { (yyval.ndt) = ndt_primitive(Uint32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2519 "grammar.c"
     break;
 
-  case 59:
-#line 278 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Uint64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2378 "grammar.c" /* yacc.c:1646  */
+  case 59: /* unsigned: endian_opt UINT64  */
+#line 280 "grammar.y"
+                    { (yyval.ndt) = ndt_primitive(Uint64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2525 "grammar.c"
     break;
 
-  case 60:
-#line 281 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Float16, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2384 "grammar.c" /* yacc.c:1646  */
+  case 60: /* ieee_float: endian_opt FLOAT16  */
+#line 283 "grammar.y"
+                     { (yyval.ndt) = ndt_primitive(Float16, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2531 "grammar.c"
     break;
 
-  case 61:
-#line 282 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Float32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2390 "grammar.c" /* yacc.c:1646  */
+  case 61: /* ieee_float: endian_opt FLOAT32  */
+#line 284 "grammar.y"
+                     { (yyval.ndt) = ndt_primitive(Float32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2537 "grammar.c"
     break;
 
-  case 62:
-#line 283 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Float64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2396 "grammar.c" /* yacc.c:1646  */
+  case 62: /* ieee_float: endian_opt FLOAT64  */
+#line 285 "grammar.y"
+                     { (yyval.ndt) = ndt_primitive(Float64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2543 "grammar.c"
     break;
 
-  case 63:
-#line 286 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Complex32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2402 "grammar.c" /* yacc.c:1646  */
+  case 63: /* ieee_complex: endian_opt COMPLEX32  */
+#line 288 "grammar.y"
+                        { (yyval.ndt) = ndt_primitive(Complex32, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2549 "grammar.c"
     break;
 
-  case 64:
-#line 287 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Complex64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2408 "grammar.c" /* yacc.c:1646  */
+  case 64: /* ieee_complex: endian_opt COMPLEX64  */
+#line 289 "grammar.y"
+                        { (yyval.ndt) = ndt_primitive(Complex64, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2555 "grammar.c"
     break;
 
-  case 65:
-#line 288 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_primitive(Complex128, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2414 "grammar.c" /* yacc.c:1646  */
+  case 65: /* ieee_complex: endian_opt COMPLEX128  */
+#line 290 "grammar.y"
+                        { (yyval.ndt) = ndt_primitive(Complex128, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2561 "grammar.c"
     break;
 
-  case 66:
-#line 292 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_from_alias(Intptr, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2420 "grammar.c" /* yacc.c:1646  */
+  case 66: /* alias: endian_opt INTPTR  */
+#line 294 "grammar.y"
+                     { (yyval.ndt) = ndt_from_alias(Intptr, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2567 "grammar.c"
     break;
 
-  case 67:
-#line 293 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_from_alias(Uintptr, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2426 "grammar.c" /* yacc.c:1646  */
+  case 67: /* alias: endian_opt UINTPTR  */
+#line 295 "grammar.y"
+                     { (yyval.ndt) = ndt_from_alias(Uintptr, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2573 "grammar.c"
     break;
 
-  case 68:
-#line 294 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_from_alias(Size, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2432 "grammar.c" /* yacc.c:1646  */
+  case 68: /* alias: endian_opt SIZE  */
+#line 296 "grammar.y"
+                     { (yyval.ndt) = ndt_from_alias(Size, (yyvsp[-1].uint32), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2579 "grammar.c"
     break;
 
-  case 69:
-#line 297 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_char(Utf32, ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2438 "grammar.c" /* yacc.c:1646  */
+  case 69: /* character: CHAR  */
+#line 299 "grammar.y"
+                              { (yyval.ndt) = ndt_char(Utf32, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2585 "grammar.c"
     break;
 
-  case 70:
-#line 298 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_char((yyvsp[-1].encoding), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2444 "grammar.c" /* yacc.c:1646  */
+  case 70: /* character: CHAR LPAREN encoding RPAREN  */
+#line 300 "grammar.y"
+                              { (yyval.ndt) = ndt_char((yyvsp[-1].encoding), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2591 "grammar.c"
     break;
 
-  case 71:
-#line 301 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_string(ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2450 "grammar.c" /* yacc.c:1646  */
+  case 71: /* string: STRING  */
+#line 303 "grammar.y"
+         { (yyval.ndt) = ndt_string(ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2597 "grammar.c"
     break;
 
-  case 72:
-#line 304 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_fixed_string((yyvsp[-1].string), Utf8, ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2456 "grammar.c" /* yacc.c:1646  */
+  case 72: /* fixed_string: FIXED_STRING LPAREN INTEGER RPAREN  */
+#line 306 "grammar.y"
+                                                    { (yyval.ndt) = mk_fixed_string((yyvsp[-1].string), Utf8, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2603 "grammar.c"
     break;
 
-  case 73:
-#line 305 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_fixed_string((yyvsp[-3].string), (yyvsp[-1].encoding), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2462 "grammar.c" /* yacc.c:1646  */
+  case 73: /* fixed_string: FIXED_STRING LPAREN INTEGER COMMA encoding RPAREN  */
+#line 307 "grammar.y"
+                                                    { (yyval.ndt) = mk_fixed_string((yyvsp[-3].string), (yyvsp[-1].encoding), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2609 "grammar.c"
     break;
 
-  case 74:
-#line 308 "grammar.y" /* yacc.c:1646  */
-    { (yyval.uint32) = 0; }
-#line 2468 "grammar.c" /* yacc.c:1646  */
+  case 74: /* endian_opt: %empty  */
+#line 310 "grammar.y"
+          { (yyval.uint32) = 0; }
+#line 2615 "grammar.c"
     break;
 
-  case 75:
-#line 309 "grammar.y" /* yacc.c:1646  */
-    { (yyval.uint32) = NDT_SYS_BIG_ENDIAN ? NDT_BIG_ENDIAN : NDT_LITTLE_ENDIAN; }
-#line 2474 "grammar.c" /* yacc.c:1646  */
+  case 75: /* endian_opt: EQUAL  */
+#line 311 "grammar.y"
+          { (yyval.uint32) = NDT_SYS_BIG_ENDIAN ? NDT_BIG_ENDIAN : NDT_LITTLE_ENDIAN; }
+#line 2621 "grammar.c"
     break;
 
-  case 76:
-#line 310 "grammar.y" /* yacc.c:1646  */
-    { (yyval.uint32) = NDT_LITTLE_ENDIAN; }
-#line 2480 "grammar.c" /* yacc.c:1646  */
+  case 76: /* endian_opt: LESS  */
+#line 312 "grammar.y"
+          { (yyval.uint32) = NDT_LITTLE_ENDIAN; }
+#line 2627 "grammar.c"
     break;
 
-  case 77:
-#line 311 "grammar.y" /* yacc.c:1646  */
-    { (yyval.uint32) = NDT_BIG_ENDIAN; }
-#line 2486 "grammar.c" /* yacc.c:1646  */
+  case 77: /* endian_opt: GREATER  */
+#line 313 "grammar.y"
+          { (yyval.uint32) = NDT_BIG_ENDIAN; }
+#line 2633 "grammar.c"
     break;
 
-  case 78:
-#line 312 "grammar.y" /* yacc.c:1646  */
-    { (yyval.uint32) = 0; }
-#line 2492 "grammar.c" /* yacc.c:1646  */
+  case 78: /* endian_opt: BAR  */
+#line 314 "grammar.y"
+          { (yyval.uint32) = 0; }
+#line 2639 "grammar.c"
     break;
 
-  case 79:
-#line 315 "grammar.y" /* yacc.c:1646  */
-    { (yyval.encoding) = encoding_from_string((yyvsp[0].string), ctx); if (ndt_err_occurred(ctx)) YYABORT; }
-#line 2498 "grammar.c" /* yacc.c:1646  */
+  case 79: /* encoding: STRINGLIT  */
+#line 317 "grammar.y"
+            { (yyval.encoding) = encoding_from_string((yyvsp[0].string), ctx); if (ndt_err_occurred(ctx)) YYABORT; }
+#line 2645 "grammar.c"
     break;
 
-  case 80:
-#line 318 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_bytes((yyvsp[0].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2504 "grammar.c" /* yacc.c:1646  */
+  case 80: /* bytes: BYTES arguments_opt  */
+#line 320 "grammar.y"
+                      { (yyval.ndt) = mk_bytes((yyvsp[0].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2651 "grammar.c"
     break;
 
-  case 81:
-#line 321 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_fixed_bytes((yyvsp[-1].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2510 "grammar.c" /* yacc.c:1646  */
+  case 81: /* fixed_bytes: FIXED_BYTES LPAREN attribute_seq RPAREN  */
+#line 323 "grammar.y"
+                                          { (yyval.ndt) = mk_fixed_bytes((yyvsp[-1].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2657 "grammar.c"
     break;
 
-  case 82:
-#line 324 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_ref((yyvsp[-1].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2516 "grammar.c" /* yacc.c:1646  */
+  case 82: /* ref: REF LPAREN datashape RPAREN  */
+#line 326 "grammar.y"
+                              { (yyval.ndt) = ndt_ref((yyvsp[-1].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2663 "grammar.c"
     break;
 
-  case 83:
-#line 325 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = ndt_ref((yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2522 "grammar.c" /* yacc.c:1646  */
+  case 83: /* ref: AMPERSAND datashape  */
+#line 327 "grammar.y"
+                              { (yyval.ndt) = ndt_ref((yyvsp[0].ndt), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2669 "grammar.c"
     break;
 
-  case 84:
-#line 328 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_categorical((yyvsp[-1].typed_value_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2528 "grammar.c" /* yacc.c:1646  */
+  case 84: /* categorical: CATEGORICAL LPAREN typed_value_seq RPAREN  */
+#line 330 "grammar.y"
+                                                                { (yyval.ndt) = mk_categorical((yyvsp[-1].typed_value_seq), NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2675 "grammar.c"
     break;
 
-  case 85:
-#line 331 "grammar.y" /* yacc.c:1646  */
-    { (yyval.typed_value_seq) = ndt_value_seq_new((yyvsp[0].typed_value), ctx); if ((yyval.typed_value_seq) == NULL) YYABORT; }
-#line 2534 "grammar.c" /* yacc.c:1646  */
+  case 85: /* categorical: CATEGORICAL LPAREN typed_value_seq COMMA attribute_seq RPAREN  */
+#line 331 "grammar.y"
+                                                                { (yyval.ndt) = mk_categorical((yyvsp[-3].typed_value_seq), (yyvsp[-1].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2681 "grammar.c"
     break;
 
-  case 86:
-#line 332 "grammar.y" /* yacc.c:1646  */
-    { (yyval.typed_value_seq) = ndt_value_seq_append((yyvsp[-2].typed_value_seq), (yyvsp[0].typed_value), ctx); if ((yyval.typed_value_seq) == NULL) YYABORT; }
-#line 2540 "grammar.c" /* yacc.c:1646  */
+  case 86: /* typed_value_seq: typed_value  */
+#line 334 "grammar.y"
+                                    { (yyval.typed_value_seq) = ndt_value_seq_new((yyvsp[0].typed_value), arena, ctx); if ((yyval.typed_value_seq) == NULL) YYABORT; }
+#line 2687 "grammar.c"
     break;
 
-  case 87:
-#line 335 "grammar.y" /* yacc.c:1646  */
-    { (yyval.typed_value) = ndt_value_from_number(ValInt64, (yyvsp[0].string), ctx); if ((yyval.typed_value) == NULL) YYABORT; }
-#line 2546 "grammar.c" /* yacc.c:1646  */
+  case 87: /* typed_value_seq: typed_value_seq COMMA typed_value  */
+#line 335 "grammar.y"
+                                    { (yyval.typed_value_seq) = ndt_value_seq_append((yyvsp[-2].typed_value_seq), (yyvsp[0].typed_value), arena, ctx); if ((yyval.typed_value_seq) == NULL) YYABORT; }
+#line 2693 "grammar.c"
     break;
 
-  case 88:
-#line 336 "grammar.y" /* yacc.c:1646  */
-    { (yyval.typed_value) = ndt_value_from_number(ValFloat64, (yyvsp[0].string), ctx); if ((yyval.typed_value) == NULL) YYABORT; }
-#line 2552 "grammar.c" /* yacc.c:1646  */
+  case 88: /* typed_value: INTEGER  */
+#line 338 "grammar.y"
+              { (yyval.typed_value) = mk_value_from_number(ValInt64, (yyvsp[0].string), arena, ctx); if ((yyval.typed_value) == NULL) YYABORT; }
+#line 2699 "grammar.c"
     break;
 
-  case 89:
-#line 337 "grammar.y" /* yacc.c:1646  */
-    { (yyval.typed_value) = ndt_value_from_string((yyvsp[0].string), ctx); if ((yyval.typed_value) == NULL) YYABORT; }
-#line 2558 "grammar.c" /* yacc.c:1646  */
+  case 89: /* typed_value: FLOATNUMBER  */
+#line 339 "grammar.y"
+              { (yyval.typed_value) = mk_value_from_number(ValFloat64, (yyvsp[0].string), arena, ctx); if ((yyval.typed_value) == NULL) YYABORT; }
+#line 2705 "grammar.c"
     break;
 
-  case 90:
-#line 338 "grammar.y" /* yacc.c:1646  */
-    { (yyval.typed_value) = ndt_value_na(ctx); if ((yyval.typed_value) == NULL) YYABORT; }
-#line 2564 "grammar.c" /* yacc.c:1646  */
+  case 90: /* typed_value: STRINGLIT  */
+#line 340 "grammar.y"
+              { (yyval.typed_value) = mk_value_from_string((yyvsp[0].string), arena, ctx); if ((yyval.typed_value) == NULL) YYABORT; }
+#line 2711 "grammar.c"
     break;
 
-  case 91:
-#line 341 "grammar.y" /* yacc.c:1646  */
-    { (yyval.variadic_flag) = Nonvariadic; }
-#line 2570 "grammar.c" /* yacc.c:1646  */
+  case 91: /* typed_value: NA  */
+#line 341 "grammar.y"
+              { (yyval.typed_value) = mk_value_na(arena, ctx); if ((yyval.typed_value) == NULL) YYABORT; }
+#line 2717 "grammar.c"
     break;
 
-  case 92:
-#line 342 "grammar.y" /* yacc.c:1646  */
-    { (yyval.variadic_flag) = Variadic; }
-#line 2576 "grammar.c" /* yacc.c:1646  */
+  case 92: /* variadic_flag: %empty  */
+#line 344 "grammar.y"
+           { (yyval.variadic_flag) = Nonvariadic; }
+#line 2723 "grammar.c"
     break;
 
-  case 93:
-#line 345 "grammar.y" /* yacc.c:1646  */
-    { (yyval.variadic_flag) = Nonvariadic; }
-#line 2582 "grammar.c" /* yacc.c:1646  */
+  case 93: /* variadic_flag: ELLIPSIS  */
+#line 345 "grammar.y"
+           { (yyval.variadic_flag) = Variadic; }
+#line 2729 "grammar.c"
     break;
 
-  case 94:
-#line 346 "grammar.y" /* yacc.c:1646  */
-    { (yyval.variadic_flag) = Nonvariadic; }
-#line 2588 "grammar.c" /* yacc.c:1646  */
+  case 94: /* comma_variadic_flag: %empty  */
+#line 348 "grammar.y"
+                 { (yyval.variadic_flag) = Nonvariadic; }
+#line 2735 "grammar.c"
     break;
 
-  case 95:
-#line 347 "grammar.y" /* yacc.c:1646  */
-    { (yyval.variadic_flag) = Variadic; }
-#line 2594 "grammar.c" /* yacc.c:1646  */
+  case 95: /* comma_variadic_flag: COMMA  */
+#line 349 "grammar.y"
+                 { (yyval.variadic_flag) = Nonvariadic; }
+#line 2741 "grammar.c"
     break;
 
-  case 96:
-#line 350 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_tuple((yyvsp[-1].variadic_flag), NULL, NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2600 "grammar.c" /* yacc.c:1646  */
+  case 96: /* comma_variadic_flag: COMMA ELLIPSIS  */
+#line 350 "grammar.y"
+                 { (yyval.variadic_flag) = Variadic; }
+#line 2747 "grammar.c"
     break;
 
-  case 97:
-#line 351 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_tuple((yyvsp[-1].variadic_flag), (yyvsp[-2].field_seq), NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2606 "grammar.c" /* yacc.c:1646  */
+  case 97: /* tuple_type: LPAREN variadic_flag RPAREN  */
+#line 353 "grammar.y"
+                                                    { (yyval.ndt) = mk_tuple((yyvsp[-1].variadic_flag), NULL, NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2753 "grammar.c"
     break;
 
-  case 98:
-#line 352 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_tuple(Nonvariadic, (yyvsp[-3].field_seq), (yyvsp[-1].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2612 "grammar.c" /* yacc.c:1646  */
+  case 98: /* tuple_type: LPAREN tuple_field_seq comma_variadic_flag RPAREN  */
+#line 354 "grammar.y"
+                                                    { (yyval.ndt) = mk_tuple((yyvsp[-1].variadic_flag), (yyvsp[-2].field_seq), NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2759 "grammar.c"
     break;
 
-  case 99:
-#line 355 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field_seq) = ndt_field_seq_new((yyvsp[0].field), ctx); if ((yyval.field_seq) == NULL) YYABORT; }
-#line 2618 "grammar.c" /* yacc.c:1646  */
+  case 99: /* tuple_type: LPAREN tuple_field_seq COMMA attribute_seq RPAREN  */
+#line 355 "grammar.y"
+                                                    { (yyval.ndt) = mk_tuple(Nonvariadic, (yyvsp[-3].field_seq), (yyvsp[-1].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2765 "grammar.c"
     break;
 
-  case 100:
-#line 356 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field_seq) = ndt_field_seq_append((yyvsp[-2].field_seq), (yyvsp[0].field), ctx); if ((yyval.field_seq) == NULL) YYABORT; }
-#line 2624 "grammar.c" /* yacc.c:1646  */
+  case 100: /* tuple_field_seq: tuple_field  */
+#line 358 "grammar.y"
+                                    { (yyval.field_seq) = ndt_field_seq_new((yyvsp[0].field), arena, ctx); if ((yyval.field_seq) == NULL) YYABORT; }
+#line 2771 "grammar.c"
     break;
 
-  case 101:
-#line 359 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field) = mk_field(NULL, (yyvsp[0].ndt), NULL, ctx); if ((yyval.field) == NULL) YYABORT; }
-#line 2630 "grammar.c" /* yacc.c:1646  */
+  case 101: /* tuple_field_seq: tuple_field_seq COMMA tuple_field  */
+#line 359 "grammar.y"
+                                    { (yyval.field_seq) = ndt_field_seq_append((yyvsp[-2].field_seq), (yyvsp[0].field), arena, ctx); if ((yyval.field_seq) == NULL) YYABORT; }
+#line 2777 "grammar.c"
     break;
 
-  case 102:
-#line 360 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field) = mk_field(NULL, (yyvsp[-3].ndt), (yyvsp[-1].attribute_seq), ctx); if ((yyval.field) == NULL) YYABORT; }
-#line 2636 "grammar.c" /* yacc.c:1646  */
+  case 102: /* tuple_field: datashape  */
+#line 362 "grammar.y"
+                                  { (yyval.field) = mk_field(NULL, (yyvsp[0].ndt), NULL, arena, ctx); if ((yyval.field) == NULL) YYABORT; }
+#line 2783 "grammar.c"
     break;
 
-  case 103:
-#line 363 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_record((yyvsp[-1].variadic_flag), NULL, NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2642 "grammar.c" /* yacc.c:1646  */
+  case 103: /* tuple_field: datashape BAR attribute_seq BAR  */
+#line 363 "grammar.y"
+                                  { (yyval.field) = mk_field(NULL, (yyvsp[-3].ndt), (yyvsp[-1].attribute_seq), arena, ctx); if ((yyval.field) == NULL) YYABORT; }
+#line 2789 "grammar.c"
     break;
 
-  case 104:
-#line 364 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_record((yyvsp[-1].variadic_flag), (yyvsp[-2].field_seq), NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2648 "grammar.c" /* yacc.c:1646  */
+  case 104: /* record_type: LBRACE variadic_flag RBRACE  */
+#line 366 "grammar.y"
+                                                     { (yyval.ndt) = mk_record((yyvsp[-1].variadic_flag), NULL, NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2795 "grammar.c"
     break;
 
-  case 105:
-#line 365 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_record(Nonvariadic, (yyvsp[-3].field_seq), (yyvsp[-1].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2654 "grammar.c" /* yacc.c:1646  */
+  case 105: /* record_type: LBRACE record_field_seq comma_variadic_flag RBRACE  */
+#line 367 "grammar.y"
+                                                     { (yyval.ndt) = mk_record((yyvsp[-1].variadic_flag), (yyvsp[-2].field_seq), NULL, ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2801 "grammar.c"
     break;
 
-  case 106:
-#line 368 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field_seq) = ndt_field_seq_new((yyvsp[0].field), ctx); if ((yyval.field_seq) == NULL) YYABORT; }
-#line 2660 "grammar.c" /* yacc.c:1646  */
+  case 106: /* record_type: LBRACE record_field_seq COMMA attribute_seq RBRACE  */
+#line 368 "grammar.y"
+                                                     { (yyval.ndt) = mk_record(Nonvariadic, (yyvsp[-3].field_seq), (yyvsp[-1].attribute_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2807 "grammar.c"
     break;
 
-  case 107:
-#line 369 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field_seq) = ndt_field_seq_append((yyvsp[-2].field_seq), (yyvsp[0].field), ctx); if ((yyval.field_seq) == NULL) YYABORT; }
-#line 2666 "grammar.c" /* yacc.c:1646  */
+  case 107: /* record_field_seq: record_field  */
+#line 371 "grammar.y"
+                                       { (yyval.field_seq) = ndt_field_seq_new((yyvsp[0].field), arena, ctx); if ((yyval.field_seq) == NULL) YYABORT; }
+#line 2813 "grammar.c"
     break;
 
-  case 108:
-#line 372 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field) = mk_field((yyvsp[-2].string), (yyvsp[0].ndt), NULL, ctx); if ((yyval.field) == NULL) YYABORT; }
-#line 2672 "grammar.c" /* yacc.c:1646  */
+  case 108: /* record_field_seq: record_field_seq COMMA record_field  */
+#line 372 "grammar.y"
+                                       { (yyval.field_seq) = ndt_field_seq_append((yyvsp[-2].field_seq), (yyvsp[0].field), arena, ctx); if ((yyval.field_seq) == NULL) YYABORT; }
+#line 2819 "grammar.c"
     break;
 
-  case 109:
-#line 373 "grammar.y" /* yacc.c:1646  */
-    { (yyval.field) = mk_field((yyvsp[-5].string), (yyvsp[-3].ndt), (yyvsp[-1].attribute_seq), ctx); if ((yyval.field) == NULL) YYABORT; }
-#line 2678 "grammar.c" /* yacc.c:1646  */
+  case 109: /* record_field: record_field_name COLON datashape  */
+#line 375 "grammar.y"
+                                                          { (yyval.field) = mk_field((yyvsp[-2].string), (yyvsp[0].ndt), NULL, arena, ctx); if ((yyval.field) == NULL) YYABORT; }
+#line 2825 "grammar.c"
     break;
 
-  case 110:
-#line 376 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
-#line 2684 "grammar.c" /* yacc.c:1646  */
+  case 110: /* record_field: record_field_name COLON datashape BAR attribute_seq BAR  */
+#line 376 "grammar.y"
+                                                          { (yyval.field) = mk_field((yyvsp[-5].string), (yyvsp[-3].ndt), (yyvsp[-1].attribute_seq), arena, ctx); if ((yyval.field) == NULL) YYABORT; }
+#line 2831 "grammar.c"
     break;
 
-  case 111:
-#line 377 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
-#line 2690 "grammar.c" /* yacc.c:1646  */
+  case 111: /* record_field_name: NAME_LOWER  */
+#line 379 "grammar.y"
+             { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
+#line 2837 "grammar.c"
     break;
 
-  case 112:
-#line 378 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
-#line 2696 "grammar.c" /* yacc.c:1646  */
+  case 112: /* record_field_name: NAME_UPPER  */
+#line 380 "grammar.y"
+             { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
+#line 2843 "grammar.c"
     break;
 
-  case 113:
-#line 381 "grammar.y" /* yacc.c:1646  */
-    { (yyval.attribute_seq) = NULL; }
-#line 2702 "grammar.c" /* yacc.c:1646  */
+  case 113: /* record_field_name: NAME_OTHER  */
+#line 381 "grammar.y"
+             { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
+#line 2849 "grammar.c"
     break;
 
-  case 114:
-#line 382 "grammar.y" /* yacc.c:1646  */
-    { (yyval.attribute_seq) = (yyvsp[-1].attribute_seq); if ((yyval.attribute_seq) == NULL) YYABORT; }
-#line 2708 "grammar.c" /* yacc.c:1646  */
+  case 114: /* arguments_opt: %empty  */
+#line 384 "grammar.y"
+                              { (yyval.attribute_seq) = NULL; }
+#line 2855 "grammar.c"
     break;
 
-  case 115:
-#line 385 "grammar.y" /* yacc.c:1646  */
-    { (yyval.attribute_seq) = ndt_attr_seq_new((yyvsp[0].attribute), ctx); if ((yyval.attribute_seq) == NULL) YYABORT; }
-#line 2714 "grammar.c" /* yacc.c:1646  */
+  case 115: /* arguments_opt: LPAREN attribute_seq RPAREN  */
+#line 385 "grammar.y"
+                              { (yyval.attribute_seq) = (yyvsp[-1].attribute_seq); if ((yyval.attribute_seq) == NULL) YYABORT; }
+#line 2861 "grammar.c"
     break;
 
-  case 116:
-#line 386 "grammar.y" /* yacc.c:1646  */
-    { (yyval.attribute_seq) = ndt_attr_seq_append((yyvsp[-2].attribute_seq), (yyvsp[0].attribute), ctx); if ((yyval.attribute_seq) == NULL) YYABORT; }
-#line 2720 "grammar.c" /* yacc.c:1646  */
+  case 116: /* attribute_seq: attribute  */
+#line 388 "grammar.y"
+                                { (yyval.attribute_seq) = ndt_attr_seq_new((yyvsp[0].attribute), arena, ctx); if ((yyval.attribute_seq) == NULL) YYABORT; }
+#line 2867 "grammar.c"
     break;
 
-  case 117:
-#line 389 "grammar.y" /* yacc.c:1646  */
-    { (yyval.attribute) = mk_attr((yyvsp[-2].string), (yyvsp[0].string), ctx); if ((yyval.attribute) == NULL) YYABORT; }
-#line 2726 "grammar.c" /* yacc.c:1646  */
+  case 117: /* attribute_seq: attribute_seq COMMA attribute  */
+#line 389 "grammar.y"
+                                { (yyval.attribute_seq) = ndt_attr_seq_append((yyvsp[-2].attribute_seq), (yyvsp[0].attribute), arena, ctx); if ((yyval.attribute_seq) == NULL) YYABORT; }
+#line 2873 "grammar.c"
     break;
 
-  case 118:
-#line 390 "grammar.y" /* yacc.c:1646  */
-    { (yyval.attribute) = mk_attr_from_seq((yyvsp[-4].string), (yyvsp[-1].string_seq), ctx); if ((yyval.attribute) == NULL) YYABORT; }
-#line 2732 "grammar.c" /* yacc.c:1646  */
+  case 118: /* attribute: NAME_LOWER EQUAL untyped_value  */
+#line 392 "grammar.y"
+                                                   { (yyval.attribute) = mk_attr((yyvsp[-2].string), (yyvsp[0].string), arena, ctx); if ((yyval.attribute) == NULL) YYABORT; }
+#line 2879 "grammar.c"
     break;
 
-  case 119:
-#line 393 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string_seq) = ndt_string_seq_new((yyvsp[0].string), ctx); if ((yyval.string_seq) == NULL) YYABORT; }
-#line 2738 "grammar.c" /* yacc.c:1646  */
+  case 119: /* attribute: NAME_LOWER EQUAL LBRACK untyped_value_seq RBRACK  */
+#line 393 "grammar.y"
+                                                   { (yyval.attribute) = mk_attr_from_seq((yyvsp[-4].string), (yyvsp[-1].string_seq), arena, ctx); if ((yyval.attribute) == NULL) YYABORT; }
+#line 2885 "grammar.c"
     break;
 
-  case 120:
-#line 394 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string_seq) = ndt_string_seq_append((yyvsp[-2].string_seq), (yyvsp[0].string), ctx); if ((yyval.string_seq) == NULL) YYABORT; }
-#line 2744 "grammar.c" /* yacc.c:1646  */
+  case 120: /* untyped_value_seq: untyped_value  */
+#line 396 "grammar.y"
+                                        { (yyval.string_seq) = ndt_string_seq_new((yyvsp[0].string), arena, ctx); if ((yyval.string_seq) == NULL) YYABORT; }
+#line 2891 "grammar.c"
     break;
 
-  case 121:
-#line 397 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
-#line 2750 "grammar.c" /* yacc.c:1646  */
+  case 121: /* untyped_value_seq: untyped_value_seq COMMA untyped_value  */
+#line 397 "grammar.y"
+                                        { (yyval.string_seq) = ndt_string_seq_append((yyvsp[-2].string_seq), (yyvsp[0].string), arena, ctx); if ((yyval.string_seq) == NULL) YYABORT; }
+#line 2897 "grammar.c"
     break;
 
-  case 122:
-#line 398 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
-#line 2756 "grammar.c" /* yacc.c:1646  */
+  case 122: /* untyped_value: NAME_LOWER  */
+#line 400 "grammar.y"
+              { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
+#line 2903 "grammar.c"
     break;
 
-  case 123:
-#line 399 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
-#line 2762 "grammar.c" /* yacc.c:1646  */
+  case 123: /* untyped_value: INTEGER  */
+#line 401 "grammar.y"
+              { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
+#line 2909 "grammar.c"
     break;
 
-  case 124:
-#line 400 "grammar.y" /* yacc.c:1646  */
-    { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
-#line 2768 "grammar.c" /* yacc.c:1646  */
+  case 124: /* untyped_value: FLOATNUMBER  */
+#line 402 "grammar.y"
+              { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
+#line 2915 "grammar.c"
     break;
 
-  case 125:
-#line 403 "grammar.y" /* yacc.c:1646  */
-    { (yyval.ndt) = mk_function((yyvsp[-2].type_seq), (yyvsp[0].type_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
-#line 2774 "grammar.c" /* yacc.c:1646  */
+  case 125: /* untyped_value: STRINGLIT  */
+#line 403 "grammar.y"
+              { (yyval.string) = (yyvsp[0].string); if ((yyval.string) == NULL) YYABORT; }
+#line 2921 "grammar.c"
     break;
 
-  case 126:
-#line 406 "grammar.y" /* yacc.c:1646  */
-    { (yyval.type_seq) = (yyvsp[0].type_seq); if ((yyval.type_seq) == NULL) YYABORT; }
-#line 2780 "grammar.c" /* yacc.c:1646  */
+  case 126: /* function_type: type_seq_or_void RARROW type_seq_or_void  */
+#line 406 "grammar.y"
+                                           { (yyval.ndt) = mk_function((yyvsp[-2].type_seq), (yyvsp[0].type_seq), ctx); if ((yyval.ndt) == NULL) YYABORT; }
+#line 2927 "grammar.c"
     break;
 
-  case 127:
-#line 407 "grammar.y" /* yacc.c:1646  */
-    { (yyval.type_seq) = ndt_type_seq_empty(ctx); if ((yyval.type_seq) == NULL) YYABORT; }
-#line 2786 "grammar.c" /* yacc.c:1646  */
+  case 127: /* type_seq_or_void: type_seq  */
+#line 409 "grammar.y"
+           { (yyval.type_seq) = (yyvsp[0].type_seq); if ((yyval.type_seq) == NULL) YYABORT; }
+#line 2933 "grammar.c"
     break;
 
-  case 128:
-#line 410 "grammar.y" /* yacc.c:1646  */
-    { (yyval.type_seq) = ndt_type_seq_new((yyvsp[0].ndt), ctx); if ((yyval.type_seq) == NULL) YYABORT; }
-#line 2792 "grammar.c" /* yacc.c:1646  */
+  case 128: /* type_seq_or_void: VOID  */
+#line 410 "grammar.y"
+           { (yyval.type_seq) = ndt_type_seq_empty(arena, ctx); if ((yyval.type_seq) == NULL) YYABORT; }
+#line 2939 "grammar.c"
     break;
 
-  case 129:
-#line 411 "grammar.y" /* yacc.c:1646  */
-    { (yyval.type_seq) = ndt_type_seq_append((yyvsp[-2].type_seq), (yyvsp[0].ndt), ctx); if ((yyval.type_seq) == NULL) YYABORT; }
-#line 2798 "grammar.c" /* yacc.c:1646  */
+  case 129: /* type_seq: datashape_with_ellipsis  */
+#line 413 "grammar.y"
+                                         { (yyval.type_seq) = ndt_type_seq_new((yyvsp[0].ndt), arena, ctx); if ((yyval.type_seq) == NULL) YYABORT; }
+#line 2945 "grammar.c"
+    break;
+
+  case 130: /* type_seq: type_seq COMMA datashape_with_ellipsis  */
+#line 414 "grammar.y"
+                                         { (yyval.type_seq) = ndt_type_seq_append((yyvsp[-2].type_seq), (yyvsp[0].ndt), arena, ctx); if ((yyval.type_seq) == NULL) YYABORT; }
+#line 2951 "grammar.c"
     break;
 
 
-#line 2802 "grammar.c" /* yacc.c:1646  */
+#line 2955 "grammar.c"
+
       default: break;
     }
   /* User semantic actions sometimes alter yychar, and that requires
@@ -2812,11 +2966,10 @@ yyreduce:
      case of YYERROR or YYBACKUP, subsequent parser actions might lead
      to an incorrect destructor call or verbose syntax error message
      before the lookahead is translated.  */
-  YY_SYMBOL_PRINT ("-> $$ =", yyr1[yyn], &yyval, &yyloc);
+  YY_SYMBOL_PRINT ("-> $$ =", YY_CAST (yysymbol_kind_t, yyr1[yyn]), &yyval, &yyloc);
 
   YYPOPSTACK (yylen);
   yylen = 0;
-  YY_STACK_PRINT (yyss, yyssp);
 
   *++yyvsp = yyval;
   *++yylsp = yyloc;
@@ -2824,14 +2977,13 @@ yyreduce:
   /* Now 'shift' the result of the reduction.  Determine what state
      that goes to, based on the state we popped back to and the rule
      number reduced by.  */
-
-  yyn = yyr1[yyn];
-
-  yystate = yypgoto[yyn - YYNTOKENS] + *yyssp;
-  if (0 <= yystate && yystate <= YYLAST && yycheck[yystate] == *yyssp)
-    yystate = yytable[yystate];
-  else
-    yystate = yydefgoto[yyn - YYNTOKENS];
+  {
+    const int yylhs = yyr1[yyn] - YYNTOKENS;
+    const int yyi = yypgoto[yylhs] + *yyssp;
+    yystate = (0 <= yyi && yyi <= YYLAST && yycheck[yyi] == *yyssp
+               ? yytable[yyi]
+               : yydefgoto[yylhs]);
+  }
 
   goto yynewstate;
 
@@ -2842,65 +2994,60 @@ yyreduce:
 yyerrlab:
   /* Make sure we have latest lookahead translation.  See comments at
      user semantic actions for why this is necessary.  */
-  yytoken = yychar == YYEMPTY ? YYEMPTY : YYTRANSLATE (yychar);
-
+  yytoken = yychar == YYEMPTY ? YYSYMBOL_YYEMPTY : YYTRANSLATE (yychar);
   /* If not already recovering from an error, report this error.  */
   if (!yyerrstatus)
     {
       ++yynerrs;
-#if ! YYERROR_VERBOSE
-      yyerror (&yylloc, scanner, ast, meta, ctx, YY_("syntax error"));
-#else
-# define YYSYNTAX_ERROR yysyntax_error (&yymsg_alloc, &yymsg, \
-                                        yyssp, yytoken)
       {
+        yypcontext_t yyctx
+          = {yyssp, yytoken, &yylloc};
         char const *yymsgp = YY_("syntax error");
         int yysyntax_error_status;
-        yysyntax_error_status = YYSYNTAX_ERROR;
+        yysyntax_error_status = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
         if (yysyntax_error_status == 0)
           yymsgp = yymsg;
-        else if (yysyntax_error_status == 1)
+        else if (yysyntax_error_status == -1)
           {
             if (yymsg != yymsgbuf)
               YYSTACK_FREE (yymsg);
-            yymsg = (char *) YYSTACK_ALLOC (yymsg_alloc);
-            if (!yymsg)
+            yymsg = YY_CAST (char *,
+                             YYSTACK_ALLOC (YY_CAST (YYSIZE_T, yymsg_alloc)));
+            if (yymsg)
               {
-                yymsg = yymsgbuf;
-                yymsg_alloc = sizeof yymsgbuf;
-                yysyntax_error_status = 2;
+                yysyntax_error_status
+                  = yysyntax_error (&yymsg_alloc, &yymsg, &yyctx);
+                yymsgp = yymsg;
               }
             else
               {
-                yysyntax_error_status = YYSYNTAX_ERROR;
-                yymsgp = yymsg;
+                yymsg = yymsgbuf;
+                yymsg_alloc = sizeof yymsgbuf;
+                yysyntax_error_status = YYENOMEM;
               }
           }
-        yyerror (&yylloc, scanner, ast, meta, ctx, yymsgp);
-        if (yysyntax_error_status == 2)
-          goto yyexhaustedlab;
+        yyerror (&yylloc, scanner, ast, meta, arena, ctx, yymsgp);
+        if (yysyntax_error_status == YYENOMEM)
+          YYNOMEM;
       }
-# undef YYSYNTAX_ERROR
-#endif
     }
 
   yyerror_range[1] = yylloc;
-
   if (yyerrstatus == 3)
     {
       /* If just tried and failed to reuse lookahead token after an
          error, discard it.  */
 
-      if (yychar <= YYEOF)
+      if (yychar <= ENDMARKER)
         {
           /* Return failure if at end of input.  */
-          if (yychar == YYEOF)
+          if (yychar == ENDMARKER)
             YYABORT;
         }
       else
         {
           yydestruct ("Error: discarding",
-                      yytoken, &yylval, &yylloc, scanner, ast, meta, ctx);
+                      yytoken, &yylval, &yylloc, scanner, ast, meta, arena, ctx);
           yychar = YYEMPTY;
         }
     }
@@ -2914,14 +3061,12 @@ yyerrlab:
 | yyerrorlab -- error raised explicitly by YYERROR.  |
 `---------------------------------------------------*/
 yyerrorlab:
+  /* Pacify compilers when the user code never invokes YYERROR and the
+     label yyerrorlab therefore never appears in user code.  */
+  if (0)
+    YYERROR;
+  ++yynerrs;
 
-  /* Pacify compilers like GCC when the user code never invokes
-     YYERROR and the label yyerrorlab therefore never appears in user
-     code.  */
-  if (/*CONSTCOND*/ 0)
-     goto yyerrorlab;
-
-  yyerror_range[1] = yylsp[1-yylen];
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYERROR.  */
   YYPOPSTACK (yylen);
@@ -2937,13 +3082,14 @@ yyerrorlab:
 yyerrlab1:
   yyerrstatus = 3;      /* Each real token shifted decrements this.  */
 
+  /* Pop stack until we find a state that shifts the error token.  */
   for (;;)
     {
       yyn = yypact[yystate];
       if (!yypact_value_is_default (yyn))
         {
-          yyn += YYTERROR;
-          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYTERROR)
+          yyn += YYSYMBOL_YYerror;
+          if (0 <= yyn && yyn <= YYLAST && yycheck[yyn] == YYSYMBOL_YYerror)
             {
               yyn = yytable[yyn];
               if (0 < yyn)
@@ -2957,7 +3103,7 @@ yyerrlab1:
 
       yyerror_range[1] = *yylsp;
       yydestruct ("Error: popping",
-                  yystos[yystate], yyvsp, yylsp, scanner, ast, meta, ctx);
+                  YY_ACCESSING_SYMBOL (yystate), yyvsp, yylsp, scanner, ast, meta, arena, ctx);
       YYPOPSTACK (1);
       yystate = *yyssp;
       YY_STACK_PRINT (yyss, yyssp);
@@ -2968,13 +3114,11 @@ yyerrlab1:
   YY_IGNORE_MAYBE_UNINITIALIZED_END
 
   yyerror_range[2] = yylloc;
-  /* Using YYLLOC is tempting, but would change the location of
-     the lookahead.  YYLOC is available though.  */
-  YYLLOC_DEFAULT (yyloc, yyerror_range, 2);
-  *++yylsp = yyloc;
+  ++yylsp;
+  YYLLOC_DEFAULT (*yylsp, yyerror_range, 2);
 
   /* Shift the error token.  */
-  YY_SYMBOL_PRINT ("Shifting", yystos[yyn], yyvsp, yylsp);
+  YY_SYMBOL_PRINT ("Shifting", YY_ACCESSING_SYMBOL (yyn), yyvsp, yylsp);
 
   yystate = yyn;
   goto yynewstate;
@@ -2985,33 +3129,37 @@ yyerrlab1:
 `-------------------------------------*/
 yyacceptlab:
   yyresult = 0;
-  goto yyreturn;
+  goto yyreturnlab;
+
 
 /*-----------------------------------.
 | yyabortlab -- YYABORT comes here.  |
 `-----------------------------------*/
 yyabortlab:
   yyresult = 1;
-  goto yyreturn;
+  goto yyreturnlab;
 
-#if !defined yyoverflow || YYERROR_VERBOSE
-/*-------------------------------------------------.
-| yyexhaustedlab -- memory exhaustion comes here.  |
-`-------------------------------------------------*/
+
+/*-----------------------------------------------------------.
+| yyexhaustedlab -- YYNOMEM (memory exhaustion) comes here.  |
+`-----------------------------------------------------------*/
 yyexhaustedlab:
-  yyerror (&yylloc, scanner, ast, meta, ctx, YY_("memory exhausted"));
+  yyerror (&yylloc, scanner, ast, meta, arena, ctx, YY_("memory exhausted"));
   yyresult = 2;
-  /* Fall through.  */
-#endif
+  goto yyreturnlab;
 
-yyreturn:
+
+/*----------------------------------------------------------.
+| yyreturnlab -- parsing is finished, clean up and return.  |
+`----------------------------------------------------------*/
+yyreturnlab:
   if (yychar != YYEMPTY)
     {
       /* Make sure we have latest lookahead translation.  See comments at
          user semantic actions for why this is necessary.  */
       yytoken = YYTRANSLATE (yychar);
       yydestruct ("Cleanup: discarding lookahead",
-                  yytoken, &yylval, &yylloc, scanner, ast, meta, ctx);
+                  yytoken, &yylval, &yylloc, scanner, ast, meta, arena, ctx);
     }
   /* Do not reclaim the symbols of the rule whose action triggered
      this YYABORT or YYACCEPT.  */
@@ -3020,16 +3168,15 @@ yyreturn:
   while (yyssp != yyss)
     {
       yydestruct ("Cleanup: popping",
-                  yystos[*yyssp], yyvsp, yylsp, scanner, ast, meta, ctx);
+                  YY_ACCESSING_SYMBOL (+*yyssp), yyvsp, yylsp, scanner, ast, meta, arena, ctx);
       YYPOPSTACK (1);
     }
 #ifndef yyoverflow
   if (yyss != yyssa)
     YYSTACK_FREE (yyss);
 #endif
-#if YYERROR_VERBOSE
   if (yymsg != yymsgbuf)
     YYSTACK_FREE (yymsg);
-#endif
   return yyresult;
 }
+
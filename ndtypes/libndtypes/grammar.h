@@ -1,8 +1,9 @@
-/* A Bison parser, made by GNU Bison 3.0.4.  */
+/* A Bison parser, made by GNU Bison 3.8.2.  */
 
 /* Bison interface for Yacc-like parsers in C
 
-   Copyright (C) 1984, 1989-1990, 2000-2015 Free Software Foundation, Inc.
+   Copyright (C) 1984, 1989-1990, 2000-2015, 2018-2021 Free Software Foundation,
+   Inc.
 
    This program is free software: you can redistribute it and/or modify
    it under the terms of the GNU General Public License as published by
@@ -15,7 +16,7 @@
    GNU General Public License for more details.
 
    You should have received a copy of the GNU General Public License
-   along with this program.  If not, see <http://www.gnu.org/licenses/>.  */
+   along with this program.  If not, see <https://www.gnu.org/licenses/>.  */
 
 /* As a special exception, you may create a larger work that contains
    part or all of the Bison parser skeleton and distribute that work
@@ -30,6 +31,10 @@
    This special exception was added by the Free Software Foundation in
    version 2.2 of Bison.  */
 
+/* DO NOT RELY ON FEATURES THAT ARE NOT DOCUMENTED in the manual,
+   especially those whose name start with YY_ or yy_.  They are
+   private implementation details that can be changed or removed.  */
+
 #ifndef YY_NDT_YY_GRAMMAR_H_INCLUDED
 # define YY_NDT_YY_GRAMMAR_H_INCLUDED
 /* Debug traces.  */
@@ -40,94 +45,98 @@
 extern int ndt_yydebug;
 #endif
 /* "%code requires" blocks.  */
-#line 57 "grammar.y" /* yacc.c:1909  */
+#line 58 "grammar.y"
 
   #include "ndtypes.h"
+  #include "arena.h"
   #include "seq.h"
   #include "attr.h"
   #include "parsefuncs.h"
   #define YY_TYPEDEF_YY_SCANNER_T
   typedef void * yyscan_t;
 
-#line 53 "grammar.h" /* yacc.c:1909  */
+#line 59 "grammar.h"
 
-/* Token type.  */
+/* Token kinds.  */
 #ifndef YYTOKENTYPE
 # define YYTOKENTYPE
   enum yytokentype
   {
-    ENDMARKER = 0,
-    ANY_KIND = 258,
-    SCALAR_KIND = 259,
-    VOID = 260,
-    BOOL = 261,
-    SIGNED_KIND = 262,
-    INT8 = 263,
-    INT16 = 264,
-    INT32 = 265,
-    INT64 = 266,
-    UNSIGNED_KIND = 267,
-    UINT8 = 268,
-    UINT16 = 269,
-    UINT32 = 270,
-    UINT64 = 271,
-    FLOAT_KIND = 272,
-    FLOAT16 = 273,
-    FLOAT32 = 274,
-    FLOAT64 = 275,
-    COMPLEX_KIND = 276,
-    COMPLEX32 = 277,
-    COMPLEX64 = 278,
-    COMPLEX128 = 279,
-    CATEGORICAL = 280,
-    NA = 281,
-    INTPTR = 282,
-    UINTPTR = 283,
-    SIZE = 284,
-    CHAR = 285,
-    STRING = 286,
-    FIXED_STRING_KIND = 287,
-    FIXED_STRING = 288,
-    BYTES = 289,
-    FIXED_BYTES_KIND = 290,
-    FIXED_BYTES = 291,
-    REF = 292,
-    FIXED = 293,
-    VAR = 294,
-    COMMA = 295,
-    COLON = 296,
-    LPAREN = 297,
-    RPAREN = 298,
-    LBRACE = 299,
-    RBRACE = 300,
-    LBRACK = 301,
-    RBRACK = 302,
-    STAR = 303,
-    ELLIPSIS = 304,
-    RARROW = 305,
-    EQUAL = 306,
-    LESS = 307,
-    GREATER = 308,
-    QUESTIONMARK = 309,
-    BANG = 310,
-    AMPERSAND = 311,
-    BAR = 312,
-    ERRTOKEN = 313,
-    INTEGER = 314,
-    FLOATNUMBER = 315,
-    STRINGLIT = 316,
-    NAME_LOWER = 317,
-    NAME_UPPER = 318,
-    NAME_OTHER = 319
+    YYEMPTY = -2,
+    ENDMARKER = 0,                 /* "end of file"  */
+    YYerror = 256,                 /* error  */
+    YYUNDEF = 257,                 /* "invalid token"  */
+    ANY_KIND = 258,                /* ANY_KIND  */
+    SCALAR_KIND = 259,             /* SCALAR_KIND  */
+    VOID = 260,                    /* VOID  */
+    BOOL = 261,                    /* BOOL  */
+    SIGNED_KIND = 262,             /* SIGNED_KIND  */
+    INT8 = 263,                    /* INT8  */
+    INT16 = 264,                   /* INT16  */
+    INT32 = 265,                   /* INT32  */
+    INT64 = 266,                   /* INT64  */
+    UNSIGNED_KIND = 267,           /* UNSIGNED_KIND  */
+    UINT8 = 268,                   /* UINT8  */
+    UINT16 = 269,                  /* UINT16  */
+    UINT32 = 270,                  /* UINT32  */
+    UINT64 = 271,                  /* UINT64  */
+    FLOAT_KIND = 272,              /* FLOAT_KIND  */
+    FLOAT16 = 273,                 /* FLOAT16  */
+    FLOAT32 = 274,                 /* FLOAT32  */
+    FLOAT64 = 275,                 /* FLOAT64  */
+    COMPLEX_KIND = 276,            /* COMPLEX_KIND  */
+    COMPLEX32 = 277,               /* COMPLEX32  */
+    COMPLEX64 = 278,               /* COMPLEX64  */
+    COMPLEX128 = 279,              /* COMPLEX128  */
+    CATEGORICAL = 280,             /* CATEGORICAL  */
+    NA = 281,                      /* NA  */
+    INTPTR = 282,                  /* INTPTR  */
+    UINTPTR = 283,                 /* UINTPTR  */
+    SIZE = 284,                    /* SIZE  */
+    CHAR = 285,                    /* CHAR  */
+    STRING = 286,                  /* STRING  */
+    FIXED_STRING_KIND = 287,       /* FIXED_STRING_KIND  */
+    FIXED_STRING = 288,            /* FIXED_STRING  */
+    BYTES = 289,                   /* BYTES  */
+    FIXED_BYTES_KIND = 290,        /* FIXED_BYTES_KIND  */
+    FIXED_BYTES = 291,             /* FIXED_BYTES  */
+    REF = 292,                     /* REF  */
+    FIXED = 293,                   /* FIXED  */
+    VAR = 294,                     /* VAR  */
+    COMMA = 295,                   /* COMMA  */
+    COLON = 296,                   /* COLON  */
+    LPAREN = 297,                  /* LPAREN  */
+    RPAREN = 298,                  /* RPAREN  */
+    LBRACE = 299,                  /* LBRACE  */
+    RBRACE = 300,                  /* RBRACE  */
+    LBRACK = 301,                  /* LBRACK  */
+    RBRACK = 302,                  /* RBRACK  */
+    STAR = 303,                    /* STAR  */
+    ELLIPSIS = 304,                /* ELLIPSIS  */
+    RARROW = 305,                  /* RARROW  */
+    EQUAL = 306,                   /* EQUAL  */
+    LESS = 307,                    /* LESS  */
+    GREATER = 308,                 /* GREATER  */
+    QUESTIONMARK = 309,            /* QUESTIONMARK  */
+    BANG = 310,                    /* BANG  */
+    AMPERSAND = 311,               /* AMPERSAND  */
+    BAR = 312,                     /* BAR  */
+    ERRTOKEN = 313,                /* ERRTOKEN  */
+    INTEGER = 314,                 /* INTEGER  */
+    FLOATNUMBER = 315,             /* FLOATNUMBER  */
+    STRINGLIT = 316,               /* STRINGLIT  */
+    NAME_LOWER = 317,              /* NAME_LOWER  */
+    NAME_UPPER = 318,              /* NAME_UPPER  */
+    NAME_OTHER = 319               /* NAME_OTHER  */
   };
+  typedef enum yytokentype yytoken_kind_t;
 #endif
 
 /* Value type.  */
 #if ! defined YYSTYPE && ! defined YYSTYPE_IS_DECLARED
-
 union YYSTYPE
 {
-#line 86 "grammar.y" /* yacc.c:1909  */
+#line 88 "grammar.y"
 
     ndt_t *ndt;
     ndt_field_t *field;
@@ -143,9 +152,9 @@ union YYSTYPE
     ndt_string_seq_t *string_seq;
     ndt_type_seq_t *type_seq;
 
-#line 147 "grammar.h" /* yacc.c:1909  */
-};
+#line 156 "grammar.h"
 
+};
 typedef union YYSTYPE YYSTYPE;
 # define YYSTYPE_IS_TRIVIAL 1
 # define YYSTYPE_IS_DECLARED 1
@@ -167,14 +176,16 @@ struct YYLTYPE
 
 
 
-int ndt_yyparse (yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx);
+
+int ndt_yyparse (yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx);
+
 /* "%code provides" blocks.  */
-#line 66 "grammar.y" /* yacc.c:1909  */
+#line 68 "grammar.y"
 
   #define YY_DECL extern int ndt_yylexfunc(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner, ndt_context_t *ctx)
   extern int ndt_yylexfunc(YYSTYPE *, YYLTYPE *, yyscan_t, ndt_context_t *);
-  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx, const char *msg);
+  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx, const char *msg);
 
-#line 179 "grammar.h" /* yacc.c:1909  */
+#line 190 "grammar.h"
 
 #endif /* !YY_NDT_YY_GRAMMAR_H_INCLUDED  */
@@ -37,11 +37,12 @@
 
 void
 yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta,
-        ndt_context_t *ctx, const char *msg)
+        ndt_arena_t *arena, ndt_context_t *ctx, const char *msg)
 {
     (void)scanner;
     (void)ast;
     (void)meta;
+    (void)arena;
 
     ndt_err_format(ctx, NDT_ParseError, "%d:%d: %s", loc->first_line,
                    loc->first_column, msg);
@@ -56,6 +57,7 @@ yylex(YYSTYPE *val, YYLTYPE *loc, yyscan_t scanner, ndt_context_t *ctx)
 
 %code requires {
   #include "ndtypes.h"
+  #include "arena.h"
   #include "seq.h"
   #include "attr.h"
   #include "parsefuncs.h"
@@ -66,7 +68,7 @@ yylex(YYSTYPE *val, YYLTYPE *loc, yyscan_t scanner, ndt_context_t *ctx)
 %code provides {
   #define YY_DECL extern int ndt_yylexfunc(YYSTYPE *yylval_param, YYLTYPE *yylloc_param, yyscan_t yyscanner, ndt_context_t *ctx)
   extern int ndt_yylexfunc(YYSTYPE *, YYLTYPE *, yyscan_t, ndt_context_t *);
-  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_context_t *ctx, const char *msg);
+  void yyerror(YYLTYPE *loc, yyscan_t scanner, ndt_t **ast, ndt_meta_t *meta, ndt_arena_t *arena, ndt_context_t *ctx, const char *msg);
 }
 
 %pure-parser
@@ -81,7 +83,7 @@ yylex(YYSTYPE *val, YYLTYPE *loc, yyscan_t scanner, ndt_context_t *ctx)
 }
 
 %lex-param   {yyscan_t scanner} {ndt_context_t *ctx}
-%parse-param {yyscan_t scanner} {ndt_t **ast} {ndt_meta_t *meta} {ndt_context_t *ctx}
+%parse-param {yyscan_t scanner} {ndt_t **ast} {ndt_meta_t *meta} {ndt_arena_t *arena} {ndt_context_t *ctx}
 
 %union {
     ndt_t *ndt;
@@ -181,11 +183,11 @@ ERRTOKEN
 %token ENDMARKER 0 "end of file"
 
 %destructor { ndt_del($$); } <ndt>
-%destructor { ndt_field_del($$); } <field>
+%destructor { ndt_field_clear($$); } <field>
 %destructor { ndt_field_seq_del($$); } <field_seq>
-%destructor { ndt_value_del($$); } <typed_value>
+%destructor { ndt_value_clear($$); } <typed_value>
 %destructor { ndt_value_seq_del($$); } <typed_value_seq>
-%destructor { ndt_attr_del($$); } <attribute>
+%destructor { ndt_attr_clear($$); } <attribute>
 %destructor { ndt_attr_seq_del($$); } <attribute_seq>
 %destructor { ndt_free($$); } <string>
 %destructor { ndt_string_seq_del($$); } <string_seq>
@@ -325,17 +327,18 @@ ref:
 | AMPERSAND datashape         { $$ = ndt_ref($2, ctx); if ($$ == NULL) YYABORT; }
 
 categorical:
-  CATEGORICAL LPAREN typed_value_seq RPAREN { $$ = mk_categorical($3, ctx); if ($$ == NULL) YYABORT; }
+  CATEGORICAL LPAREN typed_value_seq RPAREN                     { $$ = mk_categorical($3, NULL, ctx); if ($$ == NULL) YYABORT; }
+| CATEGORICAL LPAREN typed_value_seq COMMA attribute_seq RPAREN { $$ = mk_categorical($3, $5, ctx); if ($$ == NULL) YYABORT; }
 
 typed_value_seq:
-  typed_value                       { $$ = ndt_value_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| typed_value_seq COMMA typed_value { $$ = ndt_value_seq_append($1, $3, ctx); if ($$ == NULL) YYABORT; }
+  typed_value                       { $$ = ndt_value_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| typed_value_seq COMMA typed_value { $$ = ndt_value_seq_append($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
 
 typed_value:
-  INTEGER     { $$ = ndt_value_from_number(ValInt64, $1, ctx); if ($$ == NULL) YYABORT; }
-| FLOATNUMBER { $$ = ndt_value_from_number(ValFloat64, $1, ctx); if ($$ == NULL) YYABORT; }
-| STRINGLIT   { $$ = ndt_value_from_string($1, ctx); if ($$ == NULL) YYABORT; }
-| NA          { $$ = ndt_value_na(ctx); if ($$ == NULL) YYABORT; }
+  INTEGER     { $$ = mk_value_from_number(ValInt64, $1, arena, ctx); if ($$ == NULL) YYABORT; }
+| FLOATNUMBER { $$ = mk_value_from_number(ValFloat64, $1, arena, ctx); if ($$ == NULL) YYABORT; }
+| STRINGLIT   { $$ = mk_value_from_string($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| NA          { $$ = mk_value_na(arena, ctx); if ($$ == NULL) YYABORT; }
 
 variadic_flag:
   %empty   { $$ = Nonvariadic; }
@@ -352,12 +355,12 @@ tuple_type:
 | LPAREN tuple_field_seq COMMA attribute_seq RPAREN { $$ = mk_tuple(Nonvariadic, $2, $4, ctx); if ($$ == NULL) YYABORT; }
 
 tuple_field_seq:
-  tuple_field                       { $$ = ndt_field_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| tuple_field_seq COMMA tuple_field { $$ = ndt_field_seq_append($1, $3, ctx); if ($$ == NULL) YYABORT; }
+  tuple_field                       { $$ = ndt_field_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| tuple_field_seq COMMA tuple_field { $$ = ndt_field_seq_append($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
 
 tuple_field:
-  datashape                       { $$ = mk_field(NULL, $1, NULL, ctx); if ($$ == NULL) YYABORT; }
-| datashape BAR attribute_seq BAR { $$ = mk_field(NULL, $1, $3, ctx); if ($$ == NULL) YYABORT; }
+  datashape                       { $$ = mk_field(NULL, $1, NULL, arena, ctx); if ($$ == NULL) YYABORT; }
+| datashape BAR attribute_seq BAR { $$ = mk_field(NULL, $1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
 
 record_type:
   LBRACE variadic_flag RBRACE                        { $$ = mk_record($2, NULL, NULL, ctx); if ($$ == NULL) YYABORT; }
@@ -365,12 +368,12 @@ record_type:
 | LBRACE record_field_seq COMMA attribute_seq RBRACE { $$ = mk_record(Nonvariadic, $2, $4, ctx); if ($$ == NULL) YYABORT; }
 
 record_field_seq:
-  record_field                         { $$ = ndt_field_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| record_field_seq COMMA record_field  { $$ = ndt_field_seq_append($1, $3, ctx); if ($$ == NULL) YYABORT; }
+  record_field                         { $$ = ndt_field_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| record_field_seq COMMA record_field  { $$ = ndt_field_seq_append($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
 
 record_field:
-  record_field_name COLON datashape                       { $$ = mk_field($1, $3, NULL, ctx); if ($$ == NULL) YYABORT; }
-| record_field_name COLON datashape BAR attribute_seq BAR { $$ = mk_field($1, $3, $5, ctx); if ($$ == NULL) YYABORT; }
+  record_field_name COLON datashape                       { $$ = mk_field($1, $3, NULL, arena, ctx); if ($$ == NULL) YYABORT; }
+| record_field_name COLON datashape BAR attribute_seq BAR { $$ = mk_field($1, $3, $5, arena, ctx); if ($$ == NULL) YYABORT; }
 
 record_field_name:
   NAME_LOWER { $$ = $1; if ($$ == NULL) YYABORT; }
@@ -382,16 +385,16 @@ arguments_opt:
 | LPAREN attribute_seq RPAREN { $$ = $2; if ($$ == NULL) YYABORT; }
 
 attribute_seq:
-  attribute                     { $$ = ndt_attr_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| attribute_seq COMMA attribute { $$ = ndt_attr_seq_append($1, $3, ctx); if ($$ == NULL) YYABORT; }
+  attribute                     { $$ = ndt_attr_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| attribute_seq COMMA attribute { $$ = ndt_attr_seq_append($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
 
 attribute:
-  NAME_LOWER EQUAL untyped_value                   { $$ = mk_attr($1, $3, ctx); if ($$ == NULL) YYABORT; }
-| NAME_LOWER EQUAL LBRACK untyped_value_seq RBRACK { $$ = mk_attr_from_seq($1, $4, ctx); if ($$ == NULL) YYABORT; }
+  NAME_LOWER EQUAL untyped_value                   { $$ = mk_attr($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
+| NAME_LOWER EQUAL LBRACK untyped_value_seq RBRACK { $$ = mk_attr_from_seq($1, $4, arena, ctx); if ($$ == NULL) YYABORT; }
 
 untyped_value_seq:
-  untyped_value                         { $$ = ndt_string_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| untyped_value_seq COMMA untyped_value { $$ = ndt_string_seq_append($1, $3, ctx); if ($$ == NULL) YYABORT; }
+  untyped_value                         { $$ = ndt_string_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| untyped_value_seq COMMA untyped_value { $$ = ndt_string_seq_append($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
 
 untyped_value:
   NAME_LOWER  { $$ = $1; if ($$ == NULL) YYABORT; }
@@ -404,8 +407,8 @@ function_type:
 
 type_seq_or_void:
   type_seq { $$ = $1; if ($$ == NULL) YYABORT; }
-| VOID     { $$ = ndt_type_seq_empty(ctx); if ($$ == NULL) YYABORT; }
+| VOID     { $$ = ndt_type_seq_empty(arena, ctx); if ($$ == NULL) YYABORT; }
 
 type_seq:
-  datashape_with_ellipsis                { $$ = ndt_type_seq_new($1, ctx); if ($$ == NULL) YYABORT; }
-| type_seq COMMA datashape_with_ellipsis { $$ = ndt_type_seq_append($1, $3, ctx); if ($$ == NULL) YYABORT; }
+  datashape_with_ellipsis                { $$ = ndt_type_seq_new($1, arena, ctx); if ($$ == NULL) YYABORT; }
+| type_seq COMMA datashape_with_ellipsis { $$ = ndt_type_seq_append($1, $3, arena, ctx); if ($$ == NULL) YYABORT; }
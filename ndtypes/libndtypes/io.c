@@ -445,6 +445,17 @@ categorical(buf_t *buf, ndt_value_t *mem, int64_t ntypes, ndt_context_t *ctx)
     return 0;
 }
 
+/*
+ * Codes are wider than the default if half of the width would suffice,
+ * e.g. in types serialized by older versions.  The width is then printed.
+ */
+static bool
+categorical_is_wide(const ndt_t *t)
+{
+    return t->datasize > 1 &&
+           t->Categorical.ntypes <= (int64_t)1 << (4*t->datasize);
+}
+
 static int
 fortran(buf_t *buf, const ndt_t *t, ndt_context_t *ctx)
 {
@@ -617,6 +628,11 @@ datashape(buf_t *buf, const ndt_t *t, int d, ndt_context_t *ctx)
             n = categorical(buf, t->Categorical.types, t->Categorical.ntypes, ctx);
             if (n < 0) return -1;
 
+            if (categorical_is_wide(t)) {
+                n = ndt_snprintf(ctx, buf, ", code_size=%" PRIi64, t->datasize);
+                if (n < 0) return -1;
+            }
+
             return ndt_snprintf(ctx, buf, ")");
         }
 
@@ -1025,7 +1041,7 @@ ast_datashape(buf_t *buf, const ndt_t *t, int d, int cont, ndt_context_t *ctx)
         }
 
         case VarDim: {
-            int i;
+            int64_t i;
 
             n = ndt_snprintf_d(ctx, buf, cont ? 0 : d, "VarDim(\n");
             if (n < 0) return -1;
@@ -1041,8 +1057,8 @@ ast_datashape(buf_t *buf, const ndt_t *t, int d, int cont, ndt_context_t *ctx)
                 if (n < 0) return -1;
 
                 for (i = 0; i < t->Concrete.VarDim.noffsets; i++) {
-                    n = ndt_snprintf(ctx, buf, "%" PRIi32 "%s",
-                                     t->Concrete.VarDim.offsets[i],
+                    n = ndt_snprintf(ctx, buf, "%" PRIi64 "%s",
+                                     ndt_var_offset(t, i),
                                      i==t->Concrete.VarDim.noffsets-1 ? "" : ", ");
                     if (n < 0) return -1;
                 }
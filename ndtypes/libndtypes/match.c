@@ -46,9 +46,10 @@
 
 static int match_datashape(const ndt_t *, const ndt_t *, symtable_t *, ndt_context_t *);
 
+/* 'vshape' must have room for max(vsize, wsize) elements. */
 static int
-_resolve_broadcast(int64_t vshape[NDT_MAX_DIM], int vsize,
-                   const int64_t wshape[NDT_MAX_DIM], int wsize)
+_resolve_broadcast(int64_t *vshape, int vsize,
+                   const int64_t *wshape, int wsize)
 {
     int64_t n, m;
     int i, k;
@@ -91,6 +92,17 @@ resolve_broadcast(symtable_entry_t w, symtable_t *tbl, ndt_context_t *ctx)
         return 1;
     }
 
+    if (w.BroadcastSeq.size > v->BroadcastSeq.size) {
+        int64_t *dims = symtable_realloc(tbl, v->BroadcastSeq.dims,
+                                         v->BroadcastSeq.size,
+                                         w.BroadcastSeq.size,
+                                         sizeof *dims, ctx);
+        if (dims == NULL) {
+            return -1;
+        }
+        v->BroadcastSeq.dims = dims;
+    }
+
     vsize = _resolve_broadcast(v->BroadcastSeq.dims, v->BroadcastSeq.size,
                                w.BroadcastSeq.dims, w.BroadcastSeq.size);
     if (vsize < 0) {
@@ -391,20 +403,40 @@ match_datashape(const ndt_t *p, const ndt_t *c, symtable_t *tbl,
     }
 
     case EllipsisDim: {
+        const int outer_dims = c->ndim - p->EllipsisDim.type->ndim;
         symtable_entry_t outer;
         const ndt_t *inner;
 
+        if (outer_dims < 0) {
+            return 0;
+        }
+
         if (p->EllipsisDim.name == NULL) {
             outer.tag = BroadcastSeq;
             outer.BroadcastSeq.size = 0;
+            outer.BroadcastSeq.dims = symtable_alloc(tbl, outer_dims,
+                                                     sizeof(int64_t), ctx);
+            if (outer.BroadcastSeq.dims == NULL) {
+                return -1;
+            }
         }
         else if (strcmp(p->EllipsisDim.name, "var") == 0) {
             outer.tag = VarSeq;
             outer.VarSeq.size = 0;
+            outer.VarSeq.dims = symtable_alloc(tbl, outer_dims,
+                                               sizeof(ndt_t *), ctx);
+            if (outer.VarSeq.dims == NULL) {
+                return -1;
+            }
         }
         else {
             outer.tag = FixedSeq;
             outer.FixedSeq.size = 0;
+            outer.FixedSeq.dims = symtable_alloc(tbl, outer_dims,
+                                                 sizeof(ndt_t *), ctx);
+            if (outer.FixedSeq.dims == NULL) {
+                return -1;
+            }
         }
 
         inner = outer_inner(&outer, 0, c, p->EllipsisDim.type->ndim);
@@ -523,20 +555,16 @@ match_datashape(const ndt_t *p, const ndt_t *c, symtable_t *tbl,
 int
 ndt_match(const ndt_t *p, const ndt_t *c, ndt_context_t *ctx)
 {
-    symtable_t *tbl;
+    symtable_t tbl;
     int ret;
 
     if (ndt_is_abstract(c)) {
         return 0;
     }
 
-    tbl = symtable_new(ctx);
-    if (tbl == NULL) {
-        return -1;
-    }
-
-    ret = match_datashape(p, c, tbl, ctx);
-    symtable_del(tbl);
+    symtable_init(&tbl);
+    ret = match_datashape(p, c, &tbl, ctx);
+    symtable_clear(&tbl);
     return ret;
 }
 
@@ -558,10 +586,7 @@ broadcast(const ndt_t *t, const int64_t *shape,
     }
 
     dtype = ndt_dtype(t);
-    v = ndt_copy(dtype, ctx);
-    if (v == NULL) {
-        return NULL;
-    }
+    v = ndt_incref(dtype);
 
     for (i=ndim-1; i>=ndim-inner_dims; i--) {
         v = ndt_fixed_dim(v, u.shape[i], u.steps[i], ctx);
@@ -593,6 +618,82 @@ broadcast(const ndt_t *t, const int64_t *shape,
     return v;
 }
 
+static int
+fixed_shape(int64_t *shape, const ndt_t *t)
+{
+    int n = 0;
+
+    for (; t->tag == FixedDim; t = t->FixedDim.type) {
+        shape[n++] = t->FixedDim.shape;
+    }
+
+    return n;
+}
+
+/*
+ * Check if the loop drivers can broadcast the inputs to the shape of the
+ * last output by using zero strides.  All arguments must be ndarrays without
+ * optional values, the outputs must have the same shape and only the outer
+ * 'bdims' dimensions of that shape may be broadcast.
+ *
+ * Return 1 if the inputs need broadcasting, 0 if they already have the shape
+ * of the outputs and -1 if stride broadcasting is not possible.
+ */
+static int
+stride_broadcast(const ndt_apply_spec_t *spec, const ndt_t *in[], int nin,
+                 int bdims)
+{
+    int64_t target[NDT_MAX_DIM];
+    int64_t shape[NDT_MAX_DIM];
+    int tsize, n, i, k;
+    int ret = 0;
+
+    if (spec->nout == 0) {
+        return -1;
+    }
+
+    for (i = 0; i < nin; i++) {
+        if (!ndt_is_ndarray(in[i]) || ndt_subtree_is_optional(in[i])) {
+            return -1;
+        }
+    }
+
+    tsize = fixed_shape(target, spec->out[spec->nout-1]);
+
+    for (i = 0; i < spec->nout; i++) {
+        const ndt_t *t = spec->out[i];
+        if (!ndt_is_ndarray(t) || ndt_subtree_is_optional(t)) {
+            return -1;
+        }
+        if (fixed_shape(shape, t) != tsize ||
+            memcmp(shape, target, tsize * sizeof *shape) != 0) {
+            return -1;
+        }
+    }
+
+    for (i = 0; i < nin; i++) {
+        n = fixed_shape(shape, in[i]);
+        if (n > tsize || tsize-n > bdims) {
+            return -1;
+        }
+        if (n < tsize) {
+            ret = 1;
+        }
+
+        for (k = 0; k < n; k++) {
+            const int j = tsize-n+k;
+            if (shape[k] != target[j]) {
+                if (shape[k] != 1 || j >= bdims) {
+                    return -1;
+                }
+                ret = 1;
+            }
+        }
+    }
+
+    return ret;
+}
+
 int
 ndt_broadcast_all(ndt_apply_spec_t *spec, const ndt_t *sig,
                   const ndt_t *in[], const int nin,
@@ -603,16 +704,6 @@ ndt_broadcast_all(ndt_apply_spec_t *spec, const ndt_t *sig,
     int inner_dims;
     int i;
 
-    for (i = 0; i < nin; i++) {
-        inner_dims = sig->Function.types[i]->ndim-1;
-        spec->broadcast[i] = broadcast(in[i], shape,
-                                       outer_dims, inner_dims, false, ctx);
-        if (spec->broadcast[i] == NULL) {
-            return -1;
-        }
-        spec->nbroadcast++;
-    }
-
     for (i = 0; i < spec->nout; i++) {
         inner_dims = sig->Function.types[nin+i]->ndim-1;
         u = broadcast(spec->out[i], shape,
@@ -626,6 +717,42 @@ ndt_broadcast_all(ndt_apply_spec_t *spec, const ndt_t *sig,
 
     spec->outer_dims = outer_dims;
 
+    if (spec->flags & NDT_STRIDE_BROADCAST) {
+        int ret = spec->nout > 0 ? 0 : -1;
+
+        /* The inner dimensions are not broadcast, so they must agree. */
+        for (i = 0; i < sig->Function.nargs && ret == 0; i++) {
+            const ndt_t *t = sig->Function.types[i];
+            if (t->tag != EllipsisDim || t->EllipsisDim.name != NULL ||
+                t->ndim != sig->Function.types[nin]->ndim) {
+                ret = -1;
+            }
+        }
+
+        if (ret == 0) {
+            ret = stride_broadcast(spec, in, nin, outer_dims);
+        }
+
+        if (ret == 1) {
+            return 0;
+        }
+
+        spec->flags &= ~NDT_STRIDE_BROADCAST;
+        if (ret == 0) {
+            return 0;
+        }
+    }
+
+    for (i = 0; i < nin; i++) {
+        inner_dims = sig->Function.types[i]->ndim-1;
+        spec->broadcast[i] = broadcast(in[i], shape,
+                                       outer_dims, inner_dims, false, ctx);
+        if (spec->broadcast[i] == NULL) {
+            return -1;
+        }
+        spec->nbroadcast++;
+    }
+
     return 0;
 }
 
@@ -688,13 +815,13 @@ ndt_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
               const ndt_constraint_t *c, const void *args,
               ndt_context_t *ctx)
 {
-    symtable_t *tbl;
+    symtable_t tbl;
     ndt_t *t;
     const char *name;
     int ret;
     int64_t i;
 
-    assert(spec->flags == 0);
+    assert((spec->flags & ~NDT_STRIDE_BROADCAST) == 0);
     assert(spec->nout == 0);
     assert(spec->nbroadcast == 0);
     assert(spec->outer_dims == 0);
@@ -719,15 +846,12 @@ ndt_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
         }
     }
 
-    tbl = symtable_new(ctx);
-    if (tbl == NULL) {
-        return -1;
-    }
+    symtable_init(&tbl);
 
     for (i = 0; i < nin; i++) {
-        ret = match_datashape(sig->Function.types[i], in[i], tbl, ctx);
+        ret = match_datashape(sig->Function.types[i], in[i], &tbl, ctx);
         if (ret <= 0) {
-            symtable_del(tbl);
+            symtable_clear(&tbl);
 
             if (ret == 0) {
                 ndt_err_format(ctx, NDT_TypeError,
@@ -738,16 +862,16 @@ ndt_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
         }
     }
 
-    if (c != NULL && resolve_constraint(c, args, tbl, ctx) < 0) {
-        symtable_del(tbl);
+    if (c != NULL && resolve_constraint(c, args, &tbl, ctx) < 0) {
+        symtable_clear(&tbl);
         return -1;
     }
 
     for (i = 0; i < sig->Function.nout; i++) {
-        spec->out[i] = ndt_substitute(sig->Function.types[nin+i], tbl, false, ctx);
+        spec->out[i] = ndt_substitute(sig->Function.types[nin+i], &tbl, false, ctx);
         if (spec->out[i] == NULL) {
             ndt_apply_spec_clear(spec);
-            symtable_del(tbl);
+            symtable_clear(&tbl);
             return -1;
         }
         spec->nout++;
@@ -758,7 +882,7 @@ ndt_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
             ndt_err_format(ctx, NDT_RuntimeError,
                "unexpected configuration of ellipsis flag and function types");
             ndt_apply_spec_clear(spec);
-            symtable_del(tbl);
+            symtable_clear(&tbl);
             return -1;
         }
 
@@ -766,7 +890,8 @@ ndt_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
         name = t->EllipsisDim.name;
 
         if (name != NULL) {
-            symtable_entry_t v = symtable_find(tbl, name);
+            symtable_entry_t v = symtable_find(&tbl, name);
+            spec->flags &= ~NDT_STRIDE_BROADCAST;
             switch (v.tag) {
             case FixedSeq:
                 spec->outer_dims = v.FixedSeq.size;
@@ -778,20 +903,23 @@ ndt_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
                 ndt_err_format(ctx, NDT_RuntimeError,
                     "unexpected missing dimension list entry");
                 ndt_apply_spec_clear(spec);
-                symtable_del(tbl);
+                symtable_clear(&tbl);
                 return -1;
             }
         }
         else {
-            if (broadcast_all(spec, sig, in, nin, tbl, ctx) < 0) {
+            if (broadcast_all(spec, sig, in, nin, &tbl, ctx) < 0) {
                 ndt_apply_spec_clear(spec);
-                symtable_del(tbl);
+                symtable_clear(&tbl);
                 return -1;
             }
         }
     }
+    else {
+        spec->flags &= ~NDT_STRIDE_BROADCAST;
+    }
 
-    symtable_del(tbl);
+    symtable_clear(&tbl);
 
     if (ndt_select_kernel_strategy(spec, sig, in, nin, ctx) < 0) {
         ndt_apply_spec_clear(spec);
@@ -814,10 +942,7 @@ binary_broadcast_1D(const ndt_ndarray_t *t, const ndt_t *dtype,
     int64_t step;
     int i, k;
 
-    v = ndt_copy(dtype, ctx);
-    if (v == NULL) {
-        return NULL;
-    }
+    v = ndt_incref(dtype);
 
     for (i=t->ndim-1, k=size-1; i>=0 && k>=0; i--, k--) {
         step = t->shape[i]<=1 ? 0 : t->steps[i];
@@ -880,6 +1005,7 @@ _ndt_binary_broadcast(ndt_apply_spec_t *spec, const ndt_t *sig,
     int size;
 
     if (shape_equal(x, y)) {
+        spec->flags &= ~NDT_STRIDE_BROADCAST;
         spec->nout = 1;
         spec->nbroadcast = 0;
         spec->outer_dims = x->ndim-inner;
@@ -901,7 +1027,6 @@ _ndt_binary_broadcast(ndt_apply_spec_t *spec, const ndt_t *sig,
         }
 
         spec->nout = 1;
-        spec->nbroadcast = 2;
         spec->outer_dims = size-inner;
 
         spec->out[0] = fixed_dim_from_shape(shape, size, dtype, ctx);
@@ -909,6 +1034,13 @@ _ndt_binary_broadcast(ndt_apply_spec_t *spec, const ndt_t *sig,
             return -1;
         }
 
+        if ((spec->flags & NDT_STRIDE_BROADCAST) &&
+            stride_broadcast(spec, in, nin, size) == 1) {
+            goto strategy;
+        }
+        spec->flags &= ~NDT_STRIDE_BROADCAST;
+        spec->nbroadcast = 2;
+
         spec->broadcast[0] = binary_broadcast_1D(x, ndt_dtype(in[0]), shape, size, ctx);
         if (spec->broadcast[0] == NULL) {
             ndt_del(spec->out[0]);
@@ -923,6 +1055,7 @@ _ndt_binary_broadcast(ndt_apply_spec_t *spec, const ndt_t *sig,
         }
     }
 
+strategy:
     if (ndt_select_kernel_strategy(spec, sig, in, nin, ctx) < 0) {
         ndt_apply_spec_clear(spec);
         return -1;
@@ -982,7 +1115,7 @@ ndt_fast_binary_fixed_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
     ndt_t *p0, *p1, *p2;
     ndt_ndarray_t x, y;
 
-    assert(spec->flags == 0);
+    assert((spec->flags & ~NDT_STRIDE_BROADCAST) == 0);
     assert(spec->nout == 0);
     assert(spec->nbroadcast == 0);
     assert(spec->outer_dims == 0);
@@ -1051,3 +1184,597 @@ ndt_fast_binary_fixed_typecheck(ndt_apply_spec_t *spec, const ndt_t *sig,
         return -1;
     }
 }
+
+
+/*****************************************************************************/
+/*                        Precompiled function signatures                    */
+/*****************************************************************************/
+
+/*
+ * ndt_matcher_new() lowers a function signature into a flat description of
+ * each argument: an optional leading ellipsis, a list of dimensions and a
+ * dtype.  Symbol names are replaced by slot indices, so ndt_matcher_typecheck()
+ * runs without recursion and without string comparisons.  The results are
+ * identical to those of ndt_typecheck().
+ *
+ * Supported signatures contain fixed and symbolic dimensions, an optional
+ * unnamed or named leading ellipsis and a dtype that is a primitive type,
+ * a type kind, a type variable or a concrete type.  For all other signatures
+ * ndt_matcher_new() sets NDT_NotImplementedError and the caller should use
+ * ndt_typecheck().
+ */
+
+enum matcher_ellipsis { NoEllipsis, UnnamedEllipsis, NamedEllipsis };
+enum matcher_dtype { DtypeAny, DtypeTag, DtypeKind, DtypeTypevar, DtypeMatch,
+                     DtypeConcrete };
+
+typedef struct {
+    int slot;           /* shape slot of a symbolic dimension, -1 if fixed */
+    int64_t shape;
+    int64_t step;
+    bool option;
+} matcher_dim_t;
+
+typedef struct {
+    enum matcher_ellipsis ellipsis;
+    int seq;            /* slot of a named ellipsis */
+    bool ellipsis_option;
+    int inner_ndim;     /* ndim of the pattern below the ellipsis */
+
+    int ndim;
+    matcher_dim_t *dims;
+
+    enum matcher_dtype dtype;
+    enum ndt tag;       /* DtypeTag and DtypeKind */
+    int slot;           /* DtypeTypevar */
+    bool option;
+    const ndt_t *type;  /* DtypeMatch pattern or DtypeConcrete template */
+} matcher_arg_t;
+
+struct ndt_matcher {
+    const ndt_t *sig;
+    const ndt_constraint_t *constraint;
+    int constraint_slots[NDT_MAX_SYMBOLS];
+    int nshapes;
+    int ntypes;
+    int nseqs;
+    int nargs;
+    matcher_arg_t *args;
+};
+
+/* Symbol names, only used while compiling. */
+typedef struct {
+    const char *shapes[NDT_MAX_SYMBOLS];
+    const char *types[NDT_MAX_SYMBOLS];
+    const char *seqs[NDT_MAX_SYMBOLS];
+} matcher_names_t;
+
+/* Bindings, only used while matching. */
+typedef struct {
+    uint32_t bound_shapes;
+    int64_t shapes[NDT_MAX_SYMBOLS];
+    const ndt_t *types[NDT_MAX_SYMBOLS];
+    const ndt_t *seqs[NDT_MAX_SYMBOLS];
+    int seq_sizes[NDT_MAX_SYMBOLS];
+    int bsize;
+    int64_t bshape[NDT_MAX_DIM];
+} matcher_state_t;
+
+
+static int
+matcher_unsupported(ndt_context_t *ctx)
+{
+    ndt_err_format(ctx, NDT_NotImplementedError,
+        "signature cannot be precompiled");
+    return -1;
+}
+
+static int
+find_name(const char *names[], int n, const char *name)
+{
+    for (int i = 0; i < n; i++) {
+        if (strcmp(names[i], name) == 0) {
+            return i;
+        }
+    }
+
+    return -1;
+}
+
+/*
+ * Return the slot of 'name' in the namespace 'names'.  If 'add' is true,
+ * a missing name is added.  A name that is used in more than one namespace
+ * is not supported.
+ */
+static int
+name_slot(ndt_matcher_t *m, matcher_names_t *nm, const char *names[], int *n,
+          const char *name, bool add, ndt_context_t *ctx)
+{
+    int slot;
+
+    slot = find_name(names, *n, name);
+    if (slot >= 0) {
+        return slot;
+    }
+
+    if (!add || *n == NDT_MAX_SYMBOLS ||
+        (names != nm->shapes && find_name(nm->shapes, m->nshapes, name) >= 0) ||
+        (names != nm->types && find_name(nm->types, m->ntypes, name) >= 0) ||
+        (names != nm->seqs && find_name(nm->seqs, m->nseqs, name) >= 0)) {
+        return matcher_unsupported(ctx);
+    }
+
+    names[*n] = name;
+    return (*n)++;
+}
+
+static int
+compile_arg(ndt_matcher_t *m, matcher_names_t *nm, matcher_arg_t *a,
+            const ndt_t *p, bool output, ndt_context_t *ctx)
+{
+    const ndt_t *t;
+    int i;
+
+    a->ellipsis = NoEllipsis;
+    if (p->tag == EllipsisDim) {
+        const char *name = p->EllipsisDim.name;
+        if (name == NULL) {
+            a->ellipsis = UnnamedEllipsis;
+        }
+        else {
+            if (strcmp(name, "var") == 0) {
+                return matcher_unsupported(ctx);
+            }
+            a->ellipsis = NamedEllipsis;
+            a->seq = name_slot(m, nm, nm->seqs, &m->nseqs, name, !output, ctx);
+            if (a->seq < 0) {
+                return -1;
+            }
+        }
+        a->ellipsis_option = ndt_is_optional(p);
+        p = p->EllipsisDim.type;
+        a->inner_ndim = p->ndim;
+    }
+
+    for (t = p, a->ndim = 0; t->tag == FixedDim || t->tag == SymbolicDim;
+         t = t->tag == FixedDim ? t->FixedDim.type : t->SymbolicDim.type) {
+        if (output && ndt_is_concrete(t)) {
+            break;
+        }
+        a->ndim++;
+    }
+
+    a->dims = ndt_calloc(a->ndim ? a->ndim : 1, sizeof *a->dims);
+    if (a->dims == NULL) {
+        (void)ndt_memory_error(ctx);
+        return -1;
+    }
+
+    for (t = p, i = 0; i < a->ndim; i++) {
+        matcher_dim_t *d = &a->dims[i];
+        d->option = ndt_is_optional(t);
+        if (t->tag == FixedDim) {
+            d->slot = -1;
+            d->shape = t->FixedDim.shape;
+            d->step = t->Concrete.FixedDim.step;
+            t = t->FixedDim.type;
+        }
+        else {
+            d->slot = name_slot(m, nm, nm->shapes, &m->nshapes,
+                                t->SymbolicDim.name, !output, ctx);
+            if (d->slot < 0) {
+                return -1;
+            }
+            t = t->SymbolicDim.type;
+        }
+    }
+
+    a->option = ndt_is_optional(t);
+
+    if (output) {
+        if (ndt_is_concrete(t)) {
+            a->dtype = DtypeConcrete;
+            a->type = ndt_incref(t);
+            return 0;
+        }
+        if (t->tag == Typevar) {
+            a->dtype = DtypeTypevar;
+            a->slot = name_slot(m, nm, nm->types, &m->ntypes,
+                                t->Typevar.name, false, ctx);
+            return a->slot < 0 ? -1 : 0;
+        }
+        return matcher_unsupported(ctx);
+    }
+
+    switch (t->tag) {
+    case AnyKind:
+        a->dtype = DtypeAny;
+        return 0;
+    case Bool:
+    case Int8: case Int16: case Int32: case Int64:
+    case Uint8: case Uint16: case Uint32: case Uint64:
+    case Float16: case Float32: case Float64:
+    case Complex32: case Complex64: case Complex128:
+    case String:
+        a->dtype = DtypeTag;
+        a->tag = t->tag;
+        return 0;
+    case SignedKind: case UnsignedKind: case FloatKind: case ComplexKind:
+    case FixedStringKind: case FixedBytesKind: case ScalarKind:
+        a->dtype = DtypeKind;
+        a->tag = t->tag;
+        return 0;
+    case Typevar:
+        a->dtype = DtypeTypevar;
+        a->slot = name_slot(m, nm, nm->types, &m->ntypes, t->Typevar.name,
+                            true, ctx);
+        return a->slot < 0 ? -1 : 0;
+    default:
+        if (ndt_is_concrete(t)) {
+            a->dtype = DtypeMatch;
+            a->type = ndt_incref(t);
+            return 0;
+        }
+        return matcher_unsupported(ctx);
+    }
+}
+
+void
+ndt_matcher_del(ndt_matcher_t *m)
+{
+    if (m == NULL) {
+        return;
+    }
+
+    for (int i = 0; i < m->nargs; i++) {
+        ndt_free(m->args[i].dims);
+        ndt_del((ndt_t *)m->args[i].type);
+    }
+
+    ndt_free(m->args);
+    ndt_del((ndt_t *)m->sig);
+    ndt_free(m);
+}
+
+ndt_matcher_t *
+ndt_matcher_new(const ndt_t *sig, const ndt_constraint_t *c, ndt_context_t *ctx)
+{
+    matcher_names_t nm;
+    ndt_matcher_t *m;
+    int nin, i;
+
+    if (sig->tag != Function) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "signature must be a function type");
+        return NULL;
+    }
+
+    nin = (int)sig->Function.nin;
+
+    /* The first input determines the outer dimensions (see ndt_typecheck()). */
+    if ((sig->flags & NDT_ELLIPSIS) &&
+        (nin == 0 || sig->Function.types[0]->tag != EllipsisDim)) {
+        (void)matcher_unsupported(ctx);
+        return NULL;
+    }
+
+    m = ndt_calloc(1, sizeof *m);
+    if (m == NULL) {
+        return ndt_memory_error(ctx);
+    }
+    m->sig = ndt_incref(sig);
+    m->constraint = c;
+
+    m->args = ndt_calloc(sig->Function.nargs ? sig->Function.nargs : 1,
+                         sizeof *m->args);
+    if (m->args == NULL) {
+        ndt_matcher_del(m);
+        return ndt_memory_error(ctx);
+    }
+
+    for (i = 0; i < nin; i++) {
+        m->nargs++;
+        if (compile_arg(m, &nm, &m->args[i], sig->Function.types[i], false,
+                        ctx) < 0) {
+            ndt_matcher_del(m);
+            return NULL;
+        }
+    }
+
+    if (c != NULL) {
+        for (i = 0; i < c->nin+c->nout; i++) {
+            m->constraint_slots[i] = name_slot(m, &nm, nm.shapes, &m->nshapes,
+                                               c->symbols[i], i >= c->nin, ctx);
+            if (m->constraint_slots[i] < 0) {
+                ndt_matcher_del(m);
+                return NULL;
+            }
+        }
+    }
+
+    for (i = nin; i < sig->Function.nargs; i++) {
+        m->nargs++;
+        if (compile_arg(m, &nm, &m->args[i], sig->Function.types[i], true,
+                        ctx) < 0) {
+            ndt_matcher_del(m);
+            return NULL;
+        }
+    }
+
+    return m;
+}
+
+static int
+match_kind(enum ndt tag, const ndt_t *c)
+{
+    switch (tag) {
+    case SignedKind: return ndt_is_signed(c);
+    case UnsignedKind: return ndt_is_unsigned(c);
+    case FloatKind: return ndt_is_float(c);
+    case ComplexKind: return ndt_is_complex(c);
+    case FixedStringKind: return c->tag == FixedString;
+    case FixedBytesKind: return c->tag == FixedBytes;
+    case ScalarKind: return ndt_is_scalar(c);
+    default: /* NOT REACHED */
+        ndt_internal_error("invalid kind");
+    }
+}
+
+static int
+matcher_match_arg(const matcher_arg_t *a, const ndt_t *c, matcher_state_t *s,
+                  ndt_context_t *ctx)
+{
+    const ndt_t *outer = c;
+    int outer_dims = 0;
+    int i;
+
+    if (a->ellipsis != NoEllipsis) {
+        if (ndt_is_optional(c) != a->ellipsis_option) return 0;
+
+        outer_dims = c->ndim - a->inner_ndim;
+        if (outer_dims < 0) {
+            return 0;
+        }
+        for (i = 0; i < outer_dims; i++) {
+            if (c->tag != FixedDim) return 0;
+            c = c->FixedDim.type;
+        }
+    }
+
+    for (i = 0; i < a->ndim; i++) {
+        const matcher_dim_t *d = &a->dims[i];
+        if (ndt_is_optional(c) != d->option || c->tag != FixedDim) return 0;
+        if (d->slot < 0) {
+            if (c->FixedDim.shape != d->shape) return 0;
+        }
+        else if (s->bound_shapes & (1U << d->slot)) {
+            if (c->FixedDim.shape != s->shapes[d->slot]) return 0;
+        }
+        else {
+            s->shapes[d->slot] = c->FixedDim.shape;
+            s->bound_shapes |= 1U << d->slot;
+        }
+        c = c->FixedDim.type;
+    }
+
+    if (ndt_is_optional(c) != a->option) return 0;
+
+    switch (a->dtype) {
+    case DtypeAny:
+        break;
+    case DtypeTag:
+        if (c->tag != a->tag) return 0;
+        break;
+    case DtypeKind:
+        if (!match_kind(a->tag, c)) return 0;
+        break;
+    case DtypeTypevar:
+        if (s->types[a->slot] == NULL) {
+            s->types[a->slot] = c;
+        }
+        else if (!ndt_equal(s->types[a->slot], c)) {
+            return 0;
+        }
+        break;
+    case DtypeMatch: {
+        symtable_t tbl;
+        int n;
+        symtable_init(&tbl);
+        n = match_datashape(a->type, c, &tbl, ctx);
+        symtable_clear(&tbl);
+        if (n <= 0) return n;
+        break;
+    }
+    case DtypeConcrete: default: /* NOT REACHED */
+        ndt_internal_error("invalid dtype");
+    }
+
+    switch (a->ellipsis) {
+    case NoEllipsis:
+        return 1;
+    case UnnamedEllipsis: {
+        int64_t shape[NDT_MAX_DIM];
+        for (i = 0, c = outer; i < outer_dims; i++, c = c->FixedDim.type) {
+            shape[i] = c->FixedDim.shape;
+        }
+        if (s->bsize < 0) {
+            memcpy(s->bshape, shape, outer_dims * sizeof *shape);
+            s->bsize = outer_dims;
+            return 1;
+        }
+        s->bsize = _resolve_broadcast(s->bshape, s->bsize, shape, outer_dims);
+        if (s->bsize < 0) {
+            ndt_err_format(ctx, NDT_TypeError, "broadcast error");
+            return -1;
+        }
+        return 1;
+    }
+    case NamedEllipsis: {
+        const ndt_t *t = s->seqs[a->seq];
+        if (t == NULL) {
+            s->seqs[a->seq] = outer;
+            s->seq_sizes[a->seq] = outer_dims;
+            return 1;
+        }
+        if (outer_dims != s->seq_sizes[a->seq]) {
+            return 0;
+        }
+        for (i = 0, c = outer; i < outer_dims; i++) {
+            if (c->FixedDim.shape != t->FixedDim.shape) return 0;
+            c = c->FixedDim.type;
+            t = t->FixedDim.type;
+        }
+        return 1;
+    }
+    default: /* NOT REACHED */
+        ndt_internal_error("invalid ellipsis");
+    }
+}
+
+static ndt_t *
+matcher_substitute(const matcher_arg_t *a, const matcher_state_t *s,
+                   ndt_context_t *ctx)
+{
+    ndt_t *t;
+    int i;
+
+    t = ndt_incref(a->dtype == DtypeConcrete ? a->type : s->types[a->slot]);
+
+    for (i = a->ndim-1; i >= 0; i--) {
+        const matcher_dim_t *d = &a->dims[i];
+        if (d->slot < 0) {
+            t = ndt_fixed_dim(t, d->shape, d->step, ctx);
+        }
+        else {
+            t = ndt_fixed_dim(t, s->shapes[d->slot], INT64_MAX, ctx);
+        }
+        if (t == NULL) {
+            return NULL;
+        }
+    }
+
+    if (a->ellipsis == NamedEllipsis) {
+        const ndt_t *dims[NDT_MAX_DIM];
+        const ndt_t *u = s->seqs[a->seq];
+        int size = s->seq_sizes[a->seq];
+
+        for (i = 0; i < size; i++, u = u->FixedDim.type) {
+            dims[i] = u;
+        }
+        for (i = size-1; i >= 0; i--) {
+            t = ndt_fixed_dim(t, dims[i]->FixedDim.shape, INT64_MAX, ctx);
+            if (t == NULL) {
+                return NULL;
+            }
+        }
+    }
+
+    return t;
+}
+
+/*
+ * Same as ndt_typecheck(), using the signature and the constraint that
+ * were compiled into 'm'.
+ */
+int
+ndt_matcher_typecheck(ndt_apply_spec_t *spec, const ndt_matcher_t *m,
+                      const ndt_t *in[], const int nin, const void *args,
+                      ndt_context_t *ctx)
+{
+    const ndt_t *sig = m->sig;
+    const ndt_constraint_t *c = m->constraint;
+    matcher_state_t s;
+    int ret;
+    int i;
+
+    assert((spec->flags & ~NDT_STRIDE_BROADCAST) == 0);
+    assert(spec->nout == 0);
+    assert(spec->nbroadcast == 0);
+    assert(spec->outer_dims == 0);
+
+    if (nin != sig->Function.nin) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "expected %" PRIi64 " arguments, got %d", sig->Function.nin, nin);
+        return -1;
+    }
+
+    for (i = 0; i < nin; i++) {
+        if (ndt_is_abstract(in[i])) {
+            ndt_err_format(ctx, NDT_ValueError,
+                "type checking requires concrete argument types");
+            return -1;
+        }
+    }
+
+    s.bound_shapes = 0;
+    s.bsize = -1;
+    for (i = 0; i < m->ntypes; i++) {
+        s.types[i] = NULL;
+    }
+    for (i = 0; i < m->nseqs; i++) {
+        s.seqs[i] = NULL;
+    }
+
+    for (i = 0; i < nin; i++) {
+        ret = matcher_match_arg(&m->args[i], in[i], &s, ctx);
+        if (ret <= 0) {
+            if (ret == 0) {
+                ndt_err_format(ctx, NDT_TypeError,
+                    "argument types do not match");
+            }
+            return -1;
+        }
+    }
+
+    if (c != NULL) {
+        int64_t shapes[NDT_MAX_SYMBOLS];
+
+        for (i = 0; i < c->nin; i++) {
+            shapes[i] = s.shapes[m->constraint_slots[i]];
+        }
+
+        if (c->f(shapes, args, ctx) < 0) {
+            return -1;
+        }
+
+        for (i = c->nin; i < c->nin+c->nout; i++) {
+            const int slot = m->constraint_slots[i];
+            if (!(s.bound_shapes & (1U << slot))) {
+                s.shapes[slot] = shapes[i];
+                s.bound_shapes |= 1U << slot;
+            }
+        }
+    }
+
+    for (i = 0; i < sig->Function.nout; i++) {
+        spec->out[i] = matcher_substitute(&m->args[nin+i], &s, ctx);
+        if (spec->out[i] == NULL) {
+            ndt_apply_spec_clear(spec);
+            return -1;
+        }
+        spec->nout++;
+    }
+
+    if (sig->flags & NDT_ELLIPSIS) {
+        const matcher_arg_t *a = &m->args[0];
+        if (a->ellipsis == NamedEllipsis) {
+            spec->flags &= ~NDT_STRIDE_BROADCAST;
+            spec->outer_dims = s.seq_sizes[a->seq];
+        }
+        else if (ndt_broadcast_all(spec, sig, in, nin, s.bshape, s.bsize,
+                                   ctx) < 0) {
+            ndt_apply_spec_clear(spec);
+            return -1;
+        }
+    }
+    else {
+        spec->flags &= ~NDT_STRIDE_BROADCAST;
+    }
+
+    if (ndt_select_kernel_strategy(spec, sig, in, nin, ctx) < 0) {
+        ndt_apply_spec_clear(spec);
+        return -1;
+    }
+
+    return 0;
+}
@@ -447,32 +447,29 @@ get_align(uint16_opt_t align, uint16_t default_align, ndt_context_t *ctx)
  * given padding is equal to the computed padding.
  *
  * 'name' is NULL for a tuple field.
+ *
+ * Initialize a caller-allocated field.  'name' and 'type' are stolen, also
+ * on error.
  */
-ndt_field_t *
-ndt_field(char *name, ndt_t *type, uint16_opt_t align, uint16_opt_t pack,
-          uint16_opt_t pad, ndt_context_t *ctx)
+int
+ndt_field_init(ndt_field_t *field, char *name, ndt_t *type, uint16_opt_t align,
+               uint16_opt_t pack, uint16_opt_t pad, ndt_context_t *ctx)
 {
-    ndt_field_t *field;
     uint16_t min_align;
 
     if (type == NULL) {
-        return NULL;
+        ndt_free(name);
+        return -1;
     }
 
     min_align = min_field_align(type, align, pack, ctx);
     if (min_align == UINT16_MAX) {
         ndt_free(name);
         ndt_del(type);
-        return NULL;
+        return -1;
     }
 
     /* abstract field */
-    field = ndt_alloc_size(sizeof *field);
-    if (field == NULL) {
-        ndt_free(name);
-        ndt_del(type);
-        return ndt_memory_error(ctx);
-    }
     field->name = name;
     field->type = type;
 
@@ -485,19 +482,51 @@ ndt_field(char *name, ndt_t *type, uint16_opt_t align, uint16_opt_t pack,
         field->Concrete.explicit_pad = (pad.tag==Some);
     }
 
+    return 0;
+}
+
+ndt_field_t *
+ndt_field(char *name, ndt_t *type, uint16_opt_t align, uint16_opt_t pack,
+          uint16_opt_t pad, ndt_context_t *ctx)
+{
+    ndt_field_t *field;
+
+    if (type == NULL) {
+        return NULL;
+    }
+
+    field = ndt_alloc_size(sizeof *field);
+    if (field == NULL) {
+        ndt_free(name);
+        ndt_del(type);
+        return ndt_memory_error(ctx);
+    }
+
+    if (ndt_field_init(field, name, type, align, pack, pad, ctx) < 0) {
+        ndt_free(field);
+        return NULL;
+    }
+
     return field;
 }
 
+/* Release the name and the type of a field, but not the field itself. */
 void
-ndt_field_del(ndt_field_t *field)
+ndt_field_clear(ndt_field_t *field)
 {
     if (field) {
         ndt_free(field->name);
         ndt_del(field->type);
-        ndt_free(field);
     }
 }
 
+void
+ndt_field_del(ndt_field_t *field)
+{
+    ndt_field_clear(field);
+    ndt_free(field);
+}
+
 void
 ndt_field_array_del(ndt_field_t *fields, int64_t shape)
 {
@@ -750,6 +779,278 @@ error:
 /*                         Type allocation/deallocation                       */
 /******************************************************************************/
 
+/*
+ * Reference counting: types are immutable after construction, so a subtree
+ * can be shared between several parents (views, substitution results, type
+ * caches) instead of being deep copied.  The counter is updated atomically,
+ * which makes it safe to share types between threads.
+ */
+#if defined(__GNUC__)
+  #define REFCNT_INC(p) __atomic_add_fetch(p, 1, __ATOMIC_RELAXED)
+  #define REFCNT_DEC(p) __atomic_sub_fetch(p, 1, __ATOMIC_ACQ_REL)
+  #define REFCNT_GET(p) __atomic_load_n(p, __ATOMIC_ACQUIRE)
+#elif defined(_MSC_VER) && defined(_WIN64)
+  #include <intrin.h>
+  #define REFCNT_INC(p) _InterlockedIncrement64(p)
+  #define REFCNT_DEC(p) _InterlockedDecrement64(p)
+  #define REFCNT_GET(p) _InterlockedOr64(p, 0)
+#else
+  #define REFCNT_INC(p) (++(*(p)))
+  #define REFCNT_DEC(p) (--(*(p)))
+  #define REFCNT_GET(p) (*(p))
+#endif
+
+/* Return a new reference to 't'. */
+ndt_t *
+ndt_incref(const ndt_t *t)
+{
+    ndt_t *u = (ndt_t *)t;
+
+    REFCNT_INC(&u->refcnt);
+    return u;
+}
+
+/* Release a reference to 't'. */
+void
+ndt_decref(ndt_t *t)
+{
+    ndt_del(t);
+}
+
+/*
+ * Interned types: structurally equal types share one immutable, reference
+ * counted instance, which makes equality a pointer comparison.  The table
+ * does not own references, a type is removed when its last reference is
+ * deleted.  The table uses open addressing with linear probing.
+ *
+ * The table is protected by a spinlock.  The reference count of an interned
+ * type is only decremented under the lock, so a lookup never returns a type
+ * that is being deleted.  Only types that are not shared with other owners
+ * are flagged as interned, all other types are copied first.
+ */
+static struct {
+    ndt_spinlock_t lock;
+    ndt_t **slots;
+    int64_t size;
+    int64_t used;
+} interned = {0, NULL, 0, 0};
+
+static inline void
+intern_lock(void)
+{
+    ndt_spin_lock(&interned.lock);
+}
+
+static inline void
+intern_unlock(void)
+{
+    ndt_spin_unlock(&interned.lock);
+}
+
+/* Types with external var offsets depend on the lifetime of another object. */
+static bool
+has_external_offsets(const ndt_t *t)
+{
+    int64_t i;
+
+    switch (t->tag) {
+    case VarDim:
+        if (ndt_is_concrete(t) &&
+            t->Concrete.VarDim.flag == ExternalOffsets) {
+            return true;
+        }
+        return has_external_offsets(t->VarDim.type);
+    case FixedDim:
+        return has_external_offsets(t->FixedDim.type);
+    case Tuple:
+        for (i = 0; i < t->Tuple.shape; i++) {
+            if (has_external_offsets(t->Tuple.types[i])) {
+                return true;
+            }
+        }
+        return false;
+    case Record:
+        for (i = 0; i < t->Record.shape; i++) {
+            if (has_external_offsets(t->Record.types[i])) {
+                return true;
+            }
+        }
+        return false;
+    case Function:
+        for (i = 0; i < t->Function.nargs; i++) {
+            if (has_external_offsets(t->Function.types[i])) {
+                return true;
+            }
+        }
+        return false;
+    case Module:
+        return has_external_offsets(t->Module.type);
+    case SymbolicDim:
+        return has_external_offsets(t->SymbolicDim.type);
+    case EllipsisDim:
+        return has_external_offsets(t->EllipsisDim.type);
+    case Ref:
+        return has_external_offsets(t->Ref.type);
+    case Constr:
+        return has_external_offsets(t->Constr.type);
+    case Nominal:
+        return has_external_offsets(t->Nominal.type);
+    default:
+        return false;
+    }
+}
+
+static void
+intern_insert(ndt_t **slots, int64_t size, ndt_t *t)
+{
+    const int64_t mask = size-1;
+    int64_t i;
+
+    for (i = t->hash & mask; slots[i] != NULL; i = (i+1) & mask);
+    slots[i] = t;
+}
+
+static int
+intern_resize(int64_t size, ndt_context_t *ctx)
+{
+    ndt_t **slots;
+    int64_t i;
+
+    slots = ndt_calloc(size, sizeof *slots);
+    if (slots == NULL) {
+        (void)ndt_memory_error(ctx);
+        return -1;
+    }
+
+    for (i = 0; i < interned.size; i++) {
+        if (interned.slots[i] != NULL) {
+            intern_insert(slots, size, interned.slots[i]);
+        }
+    }
+
+    ndt_free(interned.slots);
+    interned.slots = slots;
+    interned.size = size;
+
+    return 0;
+}
+
+static void
+intern_remove(const ndt_t *t)
+{
+    const int64_t mask = interned.size-1;
+    int64_t i, j, k;
+
+    for (i = t->hash & mask; interned.slots[i] != t; i = (i+1) & mask);
+
+    /* Backward shift deletion */
+    interned.slots[i] = NULL;
+    for (j = (i+1) & mask; interned.slots[j] != NULL; j = (j+1) & mask) {
+        k = interned.slots[j]->hash & mask;
+        if ((i <= j) ? (i < k && k <= j) : (i < k || k <= j)) {
+            continue;
+        }
+        interned.slots[i] = interned.slots[j];
+        interned.slots[j] = NULL;
+        i = j;
+    }
+
+    if (--interned.used == 0) {
+        ndt_free(interned.slots);
+        interned.slots = NULL;
+        interned.size = 0;
+    }
+}
+
+/* Return a new reference to an interned type equal to 't' or NULL. */
+static ndt_t *
+intern_lookup(const ndt_t *t, uint64_t hash)
+{
+    const int64_t mask = interned.size-1;
+    ndt_t *u;
+    int64_t i;
+
+    if (interned.size == 0) {
+        return NULL;
+    }
+
+    for (i = hash & mask; interned.slots[i] != NULL; i = (i+1) & mask) {
+        u = interned.slots[i];
+        if (u->hash == hash && ndt_equal(u, t)) {
+            return ndt_incref(u);
+        }
+    }
+
+    return NULL;
+}
+
+/*
+ * Return the interned instance that is structurally equal to 't'.  The
+ * function steals the reference to 't' and returns a new reference.
+ *
+ * Types that refer to external var offsets are returned unchanged if no
+ * equal type has been interned already, since their lifetime depends on
+ * the owner of the offsets.
+ */
+ndt_t *
+ndt_intern(ndt_t *t, ndt_context_t *ctx)
+{
+    uint64_t hash;
+    ndt_t *u;
+
+    if (t->interned) {
+        return t;
+    }
+
+    hash = ndt_structural_hash(t);
+
+    intern_lock();
+    u = intern_lookup(t, hash);
+    intern_unlock();
+    if (u != NULL) {
+        ndt_del(t);
+        return u;
+    }
+
+    if (has_external_offsets(t)) {
+        return t;
+    }
+
+    /* Other owners of 't' may read the interned flag concurrently. */
+    if (REFCNT_GET(&t->refcnt) > 1) {
+        u = ndt_copy(t, ctx);
+        ndt_del(t);
+        if (u == NULL) {
+            return NULL;
+        }
+        t = u;
+    }
+
+    intern_lock();
+    u = intern_lookup(t, hash);
+    if (u != NULL) {
+        intern_unlock();
+        ndt_del(t);
+        return u;
+    }
+
+    if (2 * (interned.used+1) > interned.size) {
+        if (intern_resize(interned.size == 0 ? 64 : 2 * interned.size, ctx) < 0) {
+            intern_unlock();
+            ndt_del(t);
+            return NULL;
+        }
+    }
+
+    t->hash = hash;
+    t->interned = true;
+    intern_insert(interned.slots, interned.size, t);
+    interned.used++;
+    intern_unlock();
+
+    return t;
+}
+
 ndt_t *
 ndt_new(enum ndt tag, ndt_context_t *ctx)
 {
@@ -768,6 +1069,10 @@ ndt_new(enum ndt tag, ndt_context_t *ctx)
     t->datasize = 0;
     t->align = UINT16_MAX;
 
+    t->refcnt = 1;
+    t->interned = false;
+    t->hash = 0;
+
     return t;
 }
 
@@ -797,6 +1102,10 @@ ndt_new_extra(enum ndt tag, int64_t n, ndt_context_t *ctx)
     t->datasize = 0;
     t->align = UINT16_MAX;
 
+    t->refcnt = 1;
+    t->interned = false;
+    t->hash = 0;
+
     return t;
 }
 
@@ -941,6 +1250,19 @@ ndt_del(ndt_t *t)
         return;
     }
 
+    if (t->interned) {
+        intern_lock();
+        if (REFCNT_DEC(&t->refcnt) > 0) {
+            intern_unlock();
+            return;
+        }
+        intern_remove(t);
+        intern_unlock();
+    }
+    else if (REFCNT_DEC(&t->refcnt) > 0) {
+        return;
+    }
+
     switch (t->tag) {
     case Module: {
         ndt_free(t->Module.name);
@@ -965,7 +1287,7 @@ ndt_del(ndt_t *t)
         ndt_del(t->VarDim.type);
         if (ndt_is_concrete(t)) {
             if (t->Concrete.VarDim.flag == InternalOffsets) {
-                ndt_free((int32_t *)t->Concrete.VarDim.offsets);
+                ndt_free((void *)t->Concrete.VarDim.offsets);
             }
             ndt_free(t->Concrete.VarDim.slices);
         }
@@ -1020,6 +1342,7 @@ ndt_del(ndt_t *t)
 
     case Categorical: {
         ndt_value_array_del(t->Categorical.types, t->Categorical.ntypes);
+        ndt_free(t->Categorical.index);
         goto free_type;
     }
 
@@ -1181,7 +1504,7 @@ _ndt_to_fortran(const ndt_t *t, int64_t step, ndt_context_t *ctx)
 
     assert(ndt_is_concrete(t));
     if (t->ndim == 0) {
-        return ndt_copy(t, ctx);
+        return ndt_incref(t);
     }
 
     next_step = MULi64(step, t->FixedDim.shape, &overflow);
@@ -1287,6 +1610,7 @@ ndt_abstract_var_dim(ndt_t *type, ndt_context_t *ctx)
     /* concrete access */
     t->access = Abstract;
     t->Concrete.VarDim.flag = ExternalOffsets;
+    t->Concrete.VarDim.offset_type = Int32Offsets;
     t->Concrete.VarDim.itemsize = 0;
     t->Concrete.VarDim.noffsets = 0;
     t->Concrete.VarDim.offsets = NULL;
@@ -1296,6 +1620,27 @@ ndt_abstract_var_dim(ndt_t *type, ndt_context_t *ctx)
     return t;
 }
 
+static inline int64_t
+var_offset(const ndt_t *t, int64_t index)
+{
+    if (t->Concrete.VarDim.offset_type == Int64Offsets) {
+        return ((const int64_t *)t->Concrete.VarDim.offsets)[index];
+    }
+
+    return ((const int32_t *)t->Concrete.VarDim.offsets)[index];
+}
+
+/* Return the offset at position index of a concrete var dimension. */
+int64_t
+ndt_var_offset(const ndt_t *t, int64_t index)
+{
+    assert(ndt_is_concrete(t));
+    assert(t->tag == VarDim);
+    assert(0 <= index && index < t->Concrete.VarDim.noffsets);
+
+    return var_offset(t, index);
+}
+
 /*
  * Compute the current start index, step and shape of a var dimension.
  * Recomputing the values avoids a potentially very large shape array
@@ -1316,13 +1661,13 @@ ndt_var_indices(int64_t *res_start, int64_t *res_step, const ndt_t *t,
 
     if (index < 0 || index+1 >= t->Concrete.VarDim.noffsets) {
         ndt_err_format(ctx, NDT_ValueError,
-            "var dim index out of range: index=%" PRIi64 ", noffsets=%" PRIi32,
+            "var dim index out of range: index=%" PRIi64 ", noffsets=%" PRIi64,
             index, t->Concrete.VarDim.noffsets);
         return -1;
     }
 
-    list_start = t->Concrete.VarDim.offsets[index];
-    list_stop = t->Concrete.VarDim.offsets[index+1];
+    list_start = var_offset(t, index);
+    list_stop = var_offset(t, index+1);
     list_shape = list_stop - list_start;
 
     *res_start = 0;
@@ -1375,16 +1720,16 @@ ndt_var_add_slice(int32_t *nslices, const ndt_t *t,
     return slices;
 }
 
-ndt_t *
-ndt_var_dim(ndt_t *type,
-            enum ndt_offsets flag,
-            int32_t noffsets, const int32_t *offsets,
-            int32_t nslices, ndt_slice_t *slices,
-            ndt_context_t *ctx)
+static ndt_t *
+mk_var_dim(ndt_t *type,
+           enum ndt_offsets flag, enum ndt_offset_type offset_type,
+           int64_t noffsets, const void *offsets,
+           int32_t nslices, ndt_slice_t *slices,
+           ndt_context_t *ctx)
 {
     bool overflow = 0;
     ndt_t *t;
-    int64_t itemsize, datasize;
+    int64_t itemsize, datasize, last;
 
     assert(offsets != NULL);
     assert(!!nslices == !!slices);
@@ -1400,6 +1745,9 @@ ndt_var_dim(ndt_t *type,
         goto error;
     }
 
+    last = offset_type == Int64Offsets ? ((const int64_t *)offsets)[noffsets-1]
+                                       : ((const int32_t *)offsets)[noffsets-1];
+
     if (!ndt_is_concrete(type)) {
         ndt_err_format(ctx, NDT_InvalidArgumentError,
                        "var_dim: expected concrete type");
@@ -1409,7 +1757,7 @@ ndt_var_dim(ndt_t *type,
 
     switch (type->tag) {
     case VarDim:
-        if (offsets[noffsets-1] != type->Concrete.VarDim.noffsets-1) {
+        if (last != type->Concrete.VarDim.noffsets-1) {
             ndt_err_format(ctx, NDT_ValueError,
                 "var_dim: missing or invalid number of offset arguments");
             ndt_del(type);
@@ -1419,7 +1767,7 @@ ndt_var_dim(ndt_t *type,
         itemsize = type->Concrete.VarDim.itemsize;
         break;
     default:
-        datasize = MULi64(offsets[noffsets-1], type->datasize, &overflow);
+        datasize = MULi64(last, type->datasize, &overflow);
         itemsize = type->datasize;
         break;
     }
@@ -1446,6 +1794,7 @@ ndt_var_dim(ndt_t *type,
     t->datasize = datasize;
     t->align = type->align;
     t->Concrete.VarDim.flag = flag;
+    t->Concrete.VarDim.offset_type = offset_type;
     t->Concrete.VarDim.itemsize = itemsize;
     t->Concrete.VarDim.noffsets = noffsets;
     t->Concrete.VarDim.offsets = offsets;
@@ -1457,12 +1806,86 @@ ndt_var_dim(ndt_t *type,
 
 error:
     if (flag == InternalOffsets) {
-        ndt_free((int32_t *)offsets);
+        ndt_free((void *)offsets);
     }
     ndt_free(slices);
     return NULL;
 }
 
+ndt_t *
+ndt_var_dim(ndt_t *type,
+            enum ndt_offsets flag,
+            int32_t noffsets, const int32_t *offsets,
+            int32_t nslices, ndt_slice_t *slices,
+            ndt_context_t *ctx)
+{
+    return mk_var_dim(type, flag, Int32Offsets, noffsets, offsets,
+                      nslices, slices, ctx);
+}
+
+/* Var dimension with int64_t offsets for more than INT32_MAX elements. */
+ndt_t *
+ndt_var_dim64(ndt_t *type,
+              enum ndt_offsets flag,
+              int64_t noffsets, const int64_t *offsets,
+              int32_t nslices, ndt_slice_t *slices,
+              ndt_context_t *ctx)
+{
+    return mk_var_dim(type, flag, Int64Offsets, noffsets, offsets,
+                      nslices, slices, ctx);
+}
+
+/* Var dimension with offsets of either element type. */
+ndt_t *
+ndt_var_dim_typed(ndt_t *type,
+                  enum ndt_offsets flag, enum ndt_offset_type offset_type,
+                  int64_t noffsets, const void *offsets,
+                  int32_t nslices, ndt_slice_t *slices,
+                  ndt_context_t *ctx)
+{
+    return mk_var_dim(type, flag, offset_type, noffsets, offsets,
+                      nslices, slices, ctx);
+}
+
+/*
+ * Offsets are computed as int64_t and stored as int32_t if all values and the
+ * length fit.  Return the type of the offsets, which may have been replaced
+ * by a compact copy, or -1 on error.  The original offsets are not freed on
+ * error.
+ */
+int
+ndt_compact_offsets(void **offsets, int64_t noffsets, ndt_context_t *ctx)
+{
+    const int64_t *v = *offsets;
+    int32_t *w;
+    int64_t i;
+
+    if (noffsets > INT32_MAX) {
+        return Int64Offsets;
+    }
+
+    for (i = 0; i < noffsets; i++) {
+        if (v[i] > INT32_MAX) {
+            return Int64Offsets;
+        }
+    }
+
+    w = ndt_alloc(noffsets, sizeof *w);
+    if (w == NULL) {
+        (void)ndt_memory_error(ctx);
+        return -1;
+    }
+
+    for (i = 0; i < noffsets; i++) {
+        w[i] = (int32_t)v[i];
+    }
+
+    ndt_free(*offsets);
+    *offsets = w;
+
+    return Int32Offsets;
+}
+
 ndt_t *
 ndt_symbolic_dim(char *name, ndt_t *type, ndt_context_t *ctx)
 {
@@ -1846,11 +2269,7 @@ ndt_nominal(char *name, ndt_t *type, ndt_context_t *ctx)
         }
     }
     else {
-        type = ndt_copy(d->type, ctx);
-        if (type == NULL) {
-            ndt_free(name);
-            return NULL;
-        }
+        type = ndt_incref(d->type);
     }
 
     /* abstract type */
@@ -1884,61 +2303,151 @@ ndt_scalar_kind(ndt_context_t *ctx)
     return ndt_new(ScalarKind, ctx);
 }
 
-/* Define a sort order for the typed values in the categorical set. */
-static int
-cmp(const void *x, const void *y)
+/*
+ * The categories are indexed by an open addressing hash table with linear
+ * probing.  The table holds category numbers, empty slots are -1.  The load
+ * factor is at most 1/2, so lookups of values that are not in the set
+ * terminate quickly.
+ */
+static int64_t *
+categorical_index(const ndt_value_t *types, int64_t ntypes, uint64_t *mask,
+                  ndt_context_t *ctx)
 {
-    const ndt_value_t *p = (const ndt_value_t *)x;
-    const ndt_value_t *q = (const ndt_value_t *)y;
+    int64_t *index;
+    uint64_t nslots = 8;
+    uint64_t h;
+    int64_t i, k;
+
+    while (nslots < 2 * (uint64_t)ntypes) {
+        if (nslots > INT64_MAX / 2) {
+            return ndt_memory_error(ctx);
+        }
+        nslots *= 2;
+    }
+
+    index = ndt_alloc((int64_t)nslots, sizeof *index);
+    if (index == NULL) {
+        return ndt_memory_error(ctx);
+    }
+    memset(index, -1, nslots * sizeof *index);
 
-    return ndt_value_compare(p, q);
+    for (i = 0; i < ntypes; i++) {
+        h = ndt_value_hash(&types[i]) & (nslots-1);
+        while ((k = index[h]) >= 0) {
+            if (ndt_value_mem_equal(&types[k], &types[i])) {
+                ndt_free(index);
+                ndt_err_format(ctx, NDT_ValueError, "duplicate category entries");
+                return NULL;
+            }
+            h = (h+1) & (nslots-1);
+        }
+        index[h] = i;
+    }
+
+    *mask = nslots-1;
+    return index;
+}
+
+/* Smallest unsigned code width that can hold all category numbers. */
+static uint16_t
+categorical_code_size(int64_t ntypes)
+{
+    if (ntypes <= UINT8_MAX+1) {
+        return sizeof(uint8_t);
+    }
+    else if (ntypes <= UINT16_MAX+1) {
+        return sizeof(uint16_t);
+    }
+    else if (ntypes <= (int64_t)UINT32_MAX+1) {
+        return sizeof(uint32_t);
+    }
+    else {
+        return sizeof(ndt_categorical_t);
+    }
 }
 
 ndt_t *
 ndt_categorical(ndt_value_t *types, int64_t ntypes, ndt_context_t *ctx)
 {
-    ndt_value_t *tmp;
+    return ndt_categorical_sized(types, ntypes, 0, ctx);
+}
+
+/*
+ * Create a categorical type with a code width of 'code_size' bytes.  A size
+ * of 0 selects the narrowest width.  Wider codes are used by types that were
+ * serialized by older versions, which always stored 8-byte codes.
+ */
+ndt_t *
+ndt_categorical_sized(ndt_value_t *types, int64_t ntypes, int64_t code_size,
+                      ndt_context_t *ctx)
+{
+    int64_t *index;
+    uint64_t mask = 0;
     ndt_t *t;
-    int64_t size, i;
 
-    tmp = ndt_alloc(ntypes, sizeof(ndt_value_t));
-    if (tmp == NULL) {
+    if (code_size == 0) {
+        code_size = categorical_code_size(ntypes);
+    }
+    else if ((code_size != 1 && code_size != 2 && code_size != 4 &&
+              code_size != (int64_t)sizeof(ndt_categorical_t)) ||
+             code_size < categorical_code_size(ntypes)) {
         ndt_value_array_del(types, ntypes);
-        return ndt_memory_error(ctx);
+        ndt_err_format(ctx, NDT_ValueError, "invalid categorical code size");
+        return NULL;
     }
 
-    /* Successful allocation implies no overflow and size <= SIZE_MAX. */
-    size = ntypes * sizeof(ndt_value_t);
-    memcpy(tmp, types, (size_t)size);
-    qsort(tmp, (size_t)ntypes, sizeof *tmp, cmp);
-
-    for (i = 0; i+1 < ntypes; i++) {
-        if (ndt_value_mem_equal(&tmp[i], &tmp[i+1])) {
-            ndt_free(tmp);
-            ndt_value_array_del(types, ntypes);
-            ndt_err_format(ctx, NDT_ValueError, "duplicate category entries");
-            return NULL;
-        }
+    index = categorical_index(types, ntypes, &mask, ctx);
+    if (index == NULL) {
+        ndt_value_array_del(types, ntypes);
+        return NULL;
     }
-    ndt_free(tmp);
 
     /* abstract type */
     t = ndt_new(Categorical, ctx);
     if (t == NULL) {
+        ndt_free(index);
         ndt_value_array_del(types, ntypes);
         return NULL;
     }
     t->Categorical.ntypes = ntypes;
     t->Categorical.types = types;
+    t->Categorical.index = index;
+    t->Categorical.mask = mask;
 
     /* concrete access */
     t->access = Concrete;
-    t->datasize = sizeof(ndt_categorical_t);
-    t->align = alignof(ndt_categorical_t);
+    t->datasize = code_size;
+    t->align = (uint16_t)code_size;
 
     return t;
 }
 
+/*
+ * Return the category number of 'v' or -1 if 'v' is not in the set.  Values
+ * are matched with ndt_value_mem_equal(), so NA finds the NA category.
+ */
+int64_t
+ndt_categorical_lookup(const ndt_t *t, const ndt_value_t *v)
+{
+    const ndt_value_t *types = t->Categorical.types;
+    const int64_t *index = t->Categorical.index;
+    const uint64_t mask = t->Categorical.mask;
+    uint64_t h;
+    int64_t k;
+
+    assert(t->tag == Categorical);
+
+    h = ndt_value_hash(v) & mask;
+    while ((k = index[h]) >= 0) {
+        if (ndt_value_mem_equal(&types[k], v)) {
+            return k;
+        }
+        h = (h+1) & mask;
+    }
+
+    return -1;
+}
+
 ndt_t *
 ndt_fixed_string_kind(ndt_context_t *ctx)
 {
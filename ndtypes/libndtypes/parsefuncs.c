@@ -83,11 +83,11 @@ encoding_from_string(char *s, ndt_context_t *ctx)
 }
 
 ndt_attr_t *
-mk_attr(char *name, char *value, ndt_context_t *ctx)
+mk_attr(char *name, char *value, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     ndt_attr_t *attr;
 
-    attr = ndt_alloc_size(sizeof *attr);
+    attr = ndt_arena_alloc(arena, 1, sizeof *attr);
     if (attr == NULL) {
         ndt_free(name);
         ndt_free(value);
@@ -102,11 +102,12 @@ mk_attr(char *name, char *value, ndt_context_t *ctx)
 }
 
 ndt_attr_t *
-mk_attr_from_seq(char *name, ndt_string_seq_t *seq, ndt_context_t *ctx)
+mk_attr_from_seq(char *name, ndt_string_seq_t *seq, ndt_arena_t *arena,
+                 ndt_context_t *ctx)
 {
     ndt_attr_t *attr;
 
-    attr = ndt_alloc_size(sizeof *attr);
+    attr = ndt_arena_alloc(arena, 1, sizeof *attr);
     if (attr == NULL) {
         ndt_free(name);
         ndt_string_seq_del(seq);
@@ -118,12 +119,62 @@ mk_attr_from_seq(char *name, ndt_string_seq_t *seq, ndt_context_t *ctx)
     attr->AttrList.len = seq->len;
     attr->AttrList.items = seq->ptr;
 
-    ndt_free(seq);
-
     return attr;
 }
 
 
+ndt_value_t *
+mk_value_from_number(enum ndt_value tag, char *v, ndt_arena_t *arena,
+                     ndt_context_t *ctx)
+{
+    ndt_value_t *mem;
+
+    mem = ndt_arena_alloc(arena, 1, sizeof *mem);
+    if (mem == NULL) {
+        ndt_free(v);
+        return ndt_memory_error(ctx);
+    }
+
+    if (ndt_value_init_number(mem, tag, v, ctx) < 0) {
+        return NULL;
+    }
+
+    return mem;
+}
+
+ndt_value_t *
+mk_value_from_string(char *v, ndt_arena_t *arena, ndt_context_t *ctx)
+{
+    ndt_value_t *mem;
+
+    mem = ndt_arena_alloc(arena, 1, sizeof *mem);
+    if (mem == NULL) {
+        ndt_free(v);
+        return ndt_memory_error(ctx);
+    }
+
+    /* XXX: check utf8 */
+    mem->tag = ValString;
+    mem->ValString = v;
+
+    return mem;
+}
+
+ndt_value_t *
+mk_value_na(ndt_arena_t *arena, ndt_context_t *ctx)
+{
+    ndt_value_t *mem;
+
+    mem = ndt_arena_alloc(arena, 1, sizeof *mem);
+    if (mem == NULL) {
+        return ndt_memory_error(ctx);
+    }
+    mem->tag = ValNA;
+
+    return mem;
+}
+
+
 /*****************************************************************************/
 /*                    Parser functions for creating types                    */
 /*****************************************************************************/
@@ -154,11 +205,6 @@ mk_function(ndt_type_seq_t *in, ndt_type_seq_t *out, ndt_context_t *ctx)
         types[nin+i] = out->ptr[i];
     }
 
-    ndt_free(in->ptr);
-    ndt_free(in);
-    ndt_free(out->ptr);
-    ndt_free(out);
-
     return ndt_function(types, nargs, nin, nout, ctx);
 }
 
@@ -208,12 +254,13 @@ mk_fixed_dim_from_attrs(ndt_attr_seq_t *attrs, ndt_t *type, ndt_context_t *ctx)
 ndt_t *
 mk_var_dim(ndt_meta_t *m, ndt_attr_seq_t *attrs, ndt_t *type, ndt_context_t *ctx)
 {
-    static const attr_spec kwlist = {1, 2, {"offsets", "_noffsets"}, {AttrInt32List, AttrInt64}};
+    static const attr_spec kwlist = {1, 2, {"offsets", "_noffsets"}, {AttrInt64List, AttrInt64}};
 
     if (attrs) {
-        int32_t *offsets = NULL;
+        enum ndt_offsets flag = m == NULL ? InternalOffsets : ExternalOffsets;
+        void *offsets = NULL;
         int64_t noffsets = 0;
-        ndt_t *t;
+        int offset_type;
         int ret;
 
         ret = ndt_parse_attr(&kwlist, ctx, attrs, &offsets, &noffsets);
@@ -223,31 +270,28 @@ mk_var_dim(ndt_meta_t *m, ndt_attr_seq_t *attrs, ndt_t *type, ndt_context_t *ctx
             return NULL;
         }
 
-        if (noffsets > INT32_MAX) {
-            ndt_err_format(ctx, NDT_ValueError, "too many offsets");
+        offset_type = ndt_compact_offsets(&offsets, noffsets, ctx);
+        if (offset_type < 0) {
             ndt_del(type);
             ndt_free(offsets);
             return NULL;
         }
 
-        if (m == NULL) {
-            t = ndt_var_dim(type, InternalOffsets, (int32_t)noffsets, offsets, 0, NULL, ctx);
-        }
-        else {
+        if (m != NULL) {
             if (m->ndims >= NDT_MAX_DIM) {
                 ndt_err_format(ctx, NDT_RuntimeError, "too many dimensions");
                 ndt_del(type);
                 ndt_free(offsets);
                 return NULL;
             }
-            m->noffsets[m->ndims] = (int32_t)noffsets;
+            m->offset_type[m->ndims] = offset_type;
+            m->noffsets[m->ndims] = noffsets;
             m->offsets[m->ndims] = offsets;
             m->ndims++;
-
-            t = ndt_var_dim(type, ExternalOffsets, (int32_t)noffsets, offsets, 0, NULL, ctx);
         }
 
-        return t;
+        return ndt_var_dim_typed(type, flag, offset_type, noffsets, offsets,
+                                 0, NULL, ctx);
     }
     else {
         return ndt_abstract_var_dim(type, ctx);
@@ -267,12 +311,14 @@ mk_var_ellipsis(ndt_t *type, ndt_context_t *ctx)
 }
 
 ndt_field_t *
-mk_field(char *name, ndt_t *type, ndt_attr_seq_t *attrs, ndt_context_t *ctx)
+mk_field(char *name, ndt_t *type, ndt_attr_seq_t *attrs, ndt_arena_t *arena,
+         ndt_context_t *ctx)
 {
     static const attr_spec kwlist = {0, 2, {"align", "pack"}, {AttrUint16Opt, AttrUint16Opt}};
     uint16_opt_t align = {None, 0};
     uint16_opt_t pack = {None, 0};
     uint16_opt_t pad = {None, 0};
+    ndt_field_t *field;
 
     if (attrs) {
         int ret = ndt_parse_attr(&kwlist, ctx, attrs, &align, &pack);
@@ -285,7 +331,18 @@ mk_field(char *name, ndt_t *type, ndt_attr_seq_t *attrs, ndt_context_t *ctx)
         }
     }
 
-    return ndt_field(name, type, align, pack, pad, ctx);
+    field = ndt_arena_alloc(arena, 1, sizeof *field);
+    if (field == NULL) {
+        ndt_free(name);
+        ndt_del(type);
+        return ndt_memory_error(ctx);
+    }
+
+    if (ndt_field_init(field, name, type, align, pack, pad, ctx) < 0) {
+        return NULL;
+    }
+
+    return field;
 }
 
 ndt_t *
@@ -295,9 +352,8 @@ mk_tuple(enum ndt_variadic flag, ndt_field_seq_t *fields,
     static const attr_spec kwlist = {0, 2, {"align", "pack"}, {AttrUint16Opt, AttrUint16Opt}};
     uint16_opt_t align = {None, 0};
     uint16_opt_t pack = {None, 0};
-    ndt_t *t;
-
-    fields = ndt_field_seq_finalize(fields);
+    ndt_field_t *ptr;
+    int64_t len;
 
     if (attrs) {
         int ret = ndt_parse_attr(&kwlist, ctx, attrs, &align, &pack);
@@ -313,9 +369,13 @@ mk_tuple(enum ndt_variadic flag, ndt_field_seq_t *fields,
         return ndt_tuple(flag, NULL, 0, align, pack, ctx);
     }
 
-    t = ndt_tuple(flag, fields->ptr, fields->len, align, pack, ctx);
-    ndt_free(fields);
-    return t;
+    len = fields->len;
+    ptr = ndt_field_seq_finalize(fields, ctx);
+    if (ptr == NULL) {
+        return NULL;
+    }
+
+    return ndt_tuple(flag, ptr, len, align, pack, ctx);
 }
 
 ndt_t *
@@ -325,9 +385,8 @@ mk_record(enum ndt_variadic flag, ndt_field_seq_t *fields,
     static const attr_spec kwlist = {0, 2, {"align", "pack"}, {AttrUint16Opt, AttrUint16Opt}};
     uint16_opt_t align = {None, 0};
     uint16_opt_t pack = {None, 0};
-    ndt_t *t;
-
-    fields = ndt_field_seq_finalize(fields);
+    ndt_field_t *ptr;
+    int64_t len;
 
     if (attrs) {
         int ret = ndt_parse_attr(&kwlist, ctx, attrs, &align, &pack);
@@ -343,21 +402,39 @@ mk_record(enum ndt_variadic flag, ndt_field_seq_t *fields,
         return ndt_record(flag, NULL, 0, align, pack, ctx);
     }
 
-    t = ndt_record(flag, fields->ptr, fields->len, align, pack, ctx);
-    ndt_free(fields);
-    return t;
+    len = fields->len;
+    ptr = ndt_field_seq_finalize(fields, ctx);
+    if (ptr == NULL) {
+        return NULL;
+    }
+
+    return ndt_record(flag, ptr, len, align, pack, ctx);
 }
 
 ndt_t *
-mk_categorical(ndt_value_seq_t *seq, ndt_context_t *ctx)
+mk_categorical(ndt_value_seq_t *seq, ndt_attr_seq_t *attrs, ndt_context_t *ctx)
 {
-    ndt_t *t;
+    static const attr_spec kwlist = {0, 1, {"code_size"}, {AttrInt64}};
+    int64_t code_size = 0;
+    ndt_value_t *ptr;
+    int64_t len;
+
+    if (attrs) {
+        int ret = ndt_parse_attr(&kwlist, ctx, attrs, &code_size);
+        ndt_attr_seq_del(attrs);
+        if (ret < 0) {
+            ndt_value_seq_del(seq);
+            return NULL;
+        }
+    }
 
-    seq = ndt_value_seq_finalize(seq);
-    t = ndt_categorical(seq->ptr, seq->len, ctx);
+    len = seq->len;
+    ptr = ndt_value_seq_finalize(seq, ctx);
+    if (ptr == NULL) {
+        return NULL;
+    }
 
-    ndt_free(seq);
-    return t;
+    return ndt_categorical_sized(ptr, len, code_size, ctx);
 }
 
 ndt_t *
@@ -36,6 +36,7 @@
 
 
 #include "ndtypes.h"
+#include "arena.h"
 #include "seq.h"
 #include "attr.h"
 
@@ -56,8 +57,12 @@ char *mk_stringlit(const char *lexeme, ndt_context_t *ctx);
 /*****************************************************************************/
 
 enum ndt_encoding encoding_from_string(char *s, ndt_context_t *ctx);
-ndt_attr_t *mk_attr(char *name, char *value, ndt_context_t *ctx);
-ndt_attr_t *mk_attr_from_seq(char *name, ndt_string_seq_t *seq, ndt_context_t *ctx);
+ndt_attr_t *mk_attr(char *name, char *value, ndt_arena_t *arena, ndt_context_t *ctx);
+ndt_attr_t *mk_attr_from_seq(char *name, ndt_string_seq_t *seq, ndt_arena_t *arena, ndt_context_t *ctx);
+
+ndt_value_t *mk_value_from_number(enum ndt_value tag, char *v, ndt_arena_t *arena, ndt_context_t *ctx);
+ndt_value_t *mk_value_from_string(char *v, ndt_arena_t *arena, ndt_context_t *ctx);
+ndt_value_t *mk_value_na(ndt_arena_t *arena, ndt_context_t *ctx);
 
 
 /*****************************************************************************/
@@ -73,11 +78,11 @@ ndt_t *mk_fixed_dim_from_attrs(ndt_attr_seq_t *attrs, ndt_t *type, ndt_context_t
 ndt_t *mk_var_dim(ndt_meta_t *m, ndt_attr_seq_t *seq, ndt_t *type, ndt_context_t *ctx);
 ndt_t *mk_var_ellipsis(ndt_t *type, ndt_context_t *ctx);
 
-ndt_field_t *mk_field(char *name, ndt_t *type, ndt_attr_seq_t *seq, ndt_context_t *ctx);
+ndt_field_t *mk_field(char *name, ndt_t *type, ndt_attr_seq_t *seq, ndt_arena_t *arena, ndt_context_t *ctx);
 ndt_t *mk_tuple(enum ndt_variadic flag, ndt_field_seq_t *fields, ndt_attr_seq_t *attrs, ndt_context_t *ctx);
 ndt_t *mk_record(enum ndt_variadic flag, ndt_field_seq_t *fields, ndt_attr_seq_t *attrs, ndt_context_t *ctx);
 
-ndt_t *mk_categorical(ndt_value_seq_t *seq, ndt_context_t *ctx);
+ndt_t *mk_categorical(ndt_value_seq_t *seq, ndt_attr_seq_t *attrs, ndt_context_t *ctx);
 
 ndt_t *mk_fixed_string(char *v, enum ndt_encoding encoding, ndt_context_t *ctx);
 ndt_t *mk_bytes(ndt_attr_seq_t *seq, ndt_context_t *ctx);
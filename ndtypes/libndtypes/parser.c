@@ -35,9 +35,11 @@
 #include <assert.h>
 #include <setjmp.h>
 #include "ndtypes.h"
+#include "arena.h"
 #include "seq.h"
 #include "grammar.h"
 #include "lexer.h"
+#include "typecache.h"
 
 
 #ifdef YYDEBUG
@@ -63,8 +65,13 @@ ndt_fopen(const char *name, const char *mode)
 jmp_buf ndt_lexerror;
 
 
+/*
+ * All parse-time temporaries are allocated from an arena that is released
+ * when the parse is complete.  The arena belongs to the caller of the
+ * functions that use setjmp().
+ */
 static ndt_t *
-_ndt_from_fp(ndt_meta_t *m, FILE *fp, ndt_context_t *ctx)
+parse_fp(ndt_meta_t *m, FILE *fp, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     volatile yyscan_t scanner = NULL;
     ndt_t *ast = NULL;
@@ -80,7 +87,7 @@ _ndt_from_fp(ndt_meta_t *m, FILE *fp, ndt_context_t *ctx)
             ndt_yyset_in(fp, scanner);
         }
 
-        ret = ndt_yyparse(scanner, &ast, m, ctx);
+        ret = ndt_yyparse(scanner, &ast, m, arena, ctx);
         ndt_yylex_destroy(scanner);
 
         if (ret == 2) {
@@ -99,6 +106,19 @@ _ndt_from_fp(ndt_meta_t *m, FILE *fp, ndt_context_t *ctx)
     }
 }
 
+static ndt_t *
+_ndt_from_fp(ndt_meta_t *m, FILE *fp, ndt_context_t *ctx)
+{
+    ndt_arena_t arena;
+    ndt_t *t;
+
+    ndt_arena_init(&arena);
+    t = parse_fp(m, fp, &arena, ctx);
+    ndt_arena_clear(&arena);
+
+    return t;
+}
+
 static ndt_t *
 _ndt_from_file(ndt_meta_t *m, const char *name, ndt_context_t *ctx)
 {
@@ -135,7 +155,8 @@ ndt_from_file_fill_meta(ndt_meta_t *m, const char *name, ndt_context_t *ctx)
 }
 
 static ndt_t *
-_ndt_from_string(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
+parse_string(ndt_meta_t *m, const char *input, ndt_arena_t *arena,
+             ndt_context_t *ctx)
 {
     volatile yyscan_t scanner = NULL;
     volatile YY_BUFFER_STATE state = NULL;
@@ -151,7 +172,7 @@ _ndt_from_string(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
         return NULL;
     }
 
-    buffer = ndt_alloc_size(size+2);
+    buffer = ndt_arena_alloc(arena, 1, size+2);
     if (buffer == NULL) {
         return ndt_memory_error(ctx);
     }
@@ -162,7 +183,6 @@ _ndt_from_string(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
     if (setjmp(ndt_lexerror) == 0) {
         if (ndt_yylex_init_extra(ctx, (yyscan_t *)&scanner) != 0) {
             ndt_err_format(ctx, NDT_LexError, "lexer initialization failed");
-            ndt_free(buffer);
             return NULL;
         }
 
@@ -170,10 +190,9 @@ _ndt_from_string(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
         state->yy_bs_lineno = 1;
         state->yy_bs_column = 1;
 
-        ret = ndt_yyparse(scanner, &ast, m, ctx);
+        ret = ndt_yyparse(scanner, &ast, m, arena, ctx);
         ndt_yy_delete_buffer(state, scanner);
         ndt_yylex_destroy(scanner);
-        ndt_free(buffer);
 
         if (ret == 2) {
             ndt_err_format(ctx, NDT_MemoryError, "out of memory");
@@ -188,22 +207,53 @@ _ndt_from_string(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
         if (scanner) {
             ndt_yylex_destroy(scanner);
         }
-        ndt_free(buffer);
         ndt_err_format(ctx, NDT_MemoryError, "flex: internal lexer error");
         return NULL;
     }
 }
 
+static ndt_t *
+_ndt_from_string(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
+{
+    ndt_arena_t arena;
+    ndt_t *t;
+
+    ndt_arena_init(&arena);
+    t = parse_string(m, input, &arena, ctx);
+    ndt_arena_clear(&arena);
+
+    return t;
+}
+
+/* Types with external offsets that are collected in 'm' are never cached. */
+static ndt_t *
+cached_from_string(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
+{
+    ndt_t *t;
+
+    t = ndt_type_cache_lookup(DatashapeSyntax, input);
+    if (t != NULL) {
+        return t;
+    }
+
+    t = _ndt_from_string(m, input, ctx);
+    if (t != NULL) {
+        ndt_type_cache_insert(DatashapeSyntax, input, t);
+    }
+
+    return t;
+}
+
 ndt_t *
 ndt_from_string(const char *input, ndt_context_t *ctx)
 {
-    return _ndt_from_string(NULL, input, ctx);
+    return cached_from_string(NULL, input, ctx);
 }
 
 ndt_t *
 ndt_from_string_v(const char *input, ndt_context_t *ctx)
 {
-    ndt_t *t = _ndt_from_string(NULL, input, ctx);
+    ndt_t *t = cached_from_string(NULL, input, ctx);
     if (t == NULL) {
         ndt_err_append(ctx, input);
     }
@@ -213,7 +263,7 @@ ndt_from_string_v(const char *input, ndt_context_t *ctx)
 ndt_t *
 ndt_from_string_fill_meta(ndt_meta_t *m, const char *input, ndt_context_t *ctx)
 {
-    return _ndt_from_string(m, input, ctx);
+    return cached_from_string(m, input, ctx);
 }
 
 ndt_t *
@@ -235,8 +285,8 @@ ndt_from_metadata_and_dtype(const ndt_meta_t *m, const char *dtype, ndt_context_
     }
 
     for (i=0, t=type; i < m->ndims; i++, type=t) {
-        t = ndt_var_dim(type, ExternalOffsets, m->noffsets[i], m->offsets[i],
-                        0, NULL, ctx);
+        t = ndt_var_dim_typed(type, ExternalOffsets, m->offset_type[i],
+                              m->noffsets[i], m->offsets[i], 0, NULL, ctx);
         if (t == NULL) {
             return NULL;
         }
@@ -54,20 +54,19 @@ NDT_SEQ_FINALIZE(ndt_field)
 /*****************************************************************************/
 
 ndt_string_seq_t *
-ndt_string_seq_new(char *elt, ndt_context_t *ctx)
+ndt_string_seq_new(char *elt, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     ndt_string_seq_t *seq;
     char **ptr;
 
-    seq = ndt_alloc_size(sizeof *seq);
+    seq = ndt_arena_alloc(arena, 1, sizeof *seq);
     if (seq == NULL) {
         ndt_free(elt);
         return ndt_memory_error(ctx);
     }
 
-    ptr = ndt_alloc_size(2 * (sizeof *ptr));
+    ptr = ndt_arena_alloc(arena, 2, sizeof *ptr);
     if (ptr == NULL) {
-        ndt_free(seq);
         ndt_free(elt);
         return ndt_memory_error(ctx);
     }
@@ -89,17 +88,16 @@ ndt_string_seq_del(ndt_string_seq_t *seq)
         for (i = 0; i < seq->len; i++) {
             ndt_free(seq->ptr[i]);
         }
-        ndt_free(seq->ptr);
-        ndt_free(seq);
     }
 }
 
 static int
-ndt_string_seq_grow(ndt_string_seq_t *seq, ndt_context_t *ctx)
+ndt_string_seq_grow(ndt_string_seq_t *seq, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     char **ptr;
 
-    ptr = ndt_realloc(seq->ptr, seq->reserved, 2 * (sizeof *ptr));
+    ptr = ndt_arena_realloc(arena, seq->ptr, seq->reserved, 2 * seq->reserved,
+                            sizeof *ptr);
     if (ptr == NULL) {
         ndt_err_format(ctx, NDT_MemoryError, "out of memory");
         return -1;
@@ -112,12 +110,13 @@ ndt_string_seq_grow(ndt_string_seq_t *seq, ndt_context_t *ctx)
 }
 
 ndt_string_seq_t *
-ndt_string_seq_append(ndt_string_seq_t *seq, char *elt, ndt_context_t *ctx)
+ndt_string_seq_append(ndt_string_seq_t *seq, char *elt, ndt_arena_t *arena,
+                      ndt_context_t *ctx)
 {
     assert(seq->len <= seq->reserved);
 
     if (seq->len == seq->reserved) {
-        if (ndt_string_seq_grow(seq, ctx) < 0) {
+        if (ndt_string_seq_grow(seq, arena, ctx) < 0) {
             ndt_string_seq_del(seq);
             ndt_free(elt);
             return NULL;
@@ -130,39 +129,17 @@ ndt_string_seq_append(ndt_string_seq_t *seq, char *elt, ndt_context_t *ctx)
     return seq;
 }
 
-ndt_string_seq_t *
-ndt_string_seq_finalize(ndt_string_seq_t *seq)
-{
-    char **ptr;
-
-    if (seq == NULL) {
-        return NULL;
-    }
-
-    assert(seq->len <= seq->reserved);
-
-    ptr = ndt_realloc(seq->ptr, seq->len, sizeof *ptr);
-    if (ptr == NULL) {
-        return seq; /* seq is still valid */
-    }
-
-    seq->ptr = ptr;
-    seq->reserved = seq->len;
-
-    return seq;
-}
-
 
 /*****************************************************************************/
 /*                                Type sequences                             */
 /*****************************************************************************/
 
 ndt_type_seq_t *
-ndt_type_seq_empty(ndt_context_t *ctx)
+ndt_type_seq_empty(ndt_arena_t *arena, ndt_context_t *ctx)
 {
     ndt_type_seq_t *seq;
 
-    seq = ndt_alloc_size(sizeof *seq);
+    seq = ndt_arena_alloc(arena, 1, sizeof *seq);
     if (seq == NULL) {
         return ndt_memory_error(ctx);
     }
@@ -175,20 +152,19 @@ ndt_type_seq_empty(ndt_context_t *ctx)
 }
 
 ndt_type_seq_t *
-ndt_type_seq_new(ndt_t *elt, ndt_context_t *ctx)
+ndt_type_seq_new(ndt_t *elt, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     ndt_type_seq_t *seq;
     ndt_t **ptr;
 
-    seq = ndt_alloc_size(sizeof *seq);
+    seq = ndt_arena_alloc(arena, 1, sizeof *seq);
     if (seq == NULL) {
         ndt_del(elt);
         return ndt_memory_error(ctx);
     }
 
-    ptr = ndt_alloc_size(2 * (sizeof *ptr));
+    ptr = ndt_arena_alloc(arena, 2, sizeof *ptr);
     if (ptr == NULL) {
-        ndt_free(seq);
         ndt_del(elt);
         return ndt_memory_error(ctx);
     }
@@ -205,17 +181,17 @@ void
 ndt_type_seq_del(ndt_type_seq_t *seq)
 {
     if (seq != NULL) {
-        ndt_type_array_del(seq->ptr, seq->len);
-        ndt_free(seq);
+        ndt_type_array_clear(seq->ptr, seq->len);
     }
 }
 
 static int
-ndt_type_seq_grow(ndt_type_seq_t *seq, ndt_context_t *ctx)
+ndt_type_seq_grow(ndt_type_seq_t *seq, ndt_arena_t *arena, ndt_context_t *ctx)
 {
     ndt_t **ptr;
 
-    ptr = ndt_realloc(seq->ptr, seq->reserved, 2 * (sizeof *ptr));
+    ptr = ndt_arena_realloc(arena, seq->ptr, seq->reserved, 2 * seq->reserved,
+                            sizeof *ptr);
     if (ptr == NULL) {
         ndt_err_format(ctx, NDT_MemoryError, "out of memory");
         return -1;
@@ -228,14 +204,15 @@ ndt_type_seq_grow(ndt_type_seq_t *seq, ndt_context_t *ctx)
 }
 
 ndt_type_seq_t *
-ndt_type_seq_append(ndt_type_seq_t *seq, ndt_t *elt, ndt_context_t *ctx)
+ndt_type_seq_append(ndt_type_seq_t *seq, ndt_t *elt, ndt_arena_t *arena,
+                    ndt_context_t *ctx)
 {
     assert(seq->len <= seq->reserved);
 
     if (seq->len == seq->reserved) {
-        if (ndt_type_seq_grow(seq, ctx) < 0) {
+        if (ndt_type_seq_grow(seq, arena, ctx) < 0) {
             ndt_type_seq_del(seq);
-            ndt_free(elt);
+            ndt_del(elt);
             return NULL;
         }
     }
@@ -245,25 +222,3 @@ ndt_type_seq_append(ndt_type_seq_t *seq, ndt_t *elt, ndt_context_t *ctx)
 
     return seq;
 }
-
-ndt_type_seq_t *
-ndt_type_seq_finalize(ndt_type_seq_t *seq)
-{
-    ndt_t **ptr;
-
-    if (seq == NULL) {
-        return NULL;
-    }
-
-    assert(seq->len <= seq->reserved);
-
-    ptr = ndt_realloc(seq->ptr, seq->len, sizeof *ptr);
-    if (ptr == NULL) {
-        return seq; /* seq is still valid */
-    }
-
-    seq->ptr = ptr;
-    seq->reserved = seq->len;
-
-    return seq;
-}
@@ -35,84 +35,96 @@
 #define SEQ_H
 
 
+#include <string.h>
 #include "ndtypes.h"
+#include "arena.h"
 
 
 /*****************************************************************************/
 /*                         Strongly typed sequences                          */
 /*****************************************************************************/
 
+/*
+ * Sequences, their storage and their elements are allocated from the parse
+ * arena.  The elements own heap resources (names, types, strings) that are
+ * released by elem##_clear().
+ */
+
 /* Create a new sequence with one initial element.  Steal the element. */
 #define NDT_SEQ_NEW(elem) \
-elem##_seq_t *                                                 \
-elem##_seq_new(elem##_t *elt, ndt_context_t *ctx)              \
-{                                                              \
-    elem##_seq_t *seq;                                         \
-    elem##_t *ptr;                                             \
-                                                               \
-    seq = ndt_alloc(1, sizeof *seq);                           \
-    if (seq == NULL) {                                         \
-        elem##_del(elt);                                       \
-        return ndt_memory_error(ctx);                          \
-    }                                                          \
-                                                               \
-    ptr = ndt_alloc(2, sizeof *ptr);                           \
-    if (ptr == NULL) {                                         \
-        ndt_free(seq);                                         \
-        elem##_del(elt);                                       \
-        return ndt_memory_error(ctx);                          \
-    }                                                          \
-                                                               \
-    ptr[0] = *elt;                                             \
-    seq->len = 1;                                              \
-    seq->reserved = 2;                                         \
-    seq->ptr = ptr;                                            \
-                                                               \
-    ndt_free(elt);                                             \
-    return seq;                                                \
+elem##_seq_t *                                                        \
+elem##_seq_new(elem##_t *elt, ndt_arena_t *arena, ndt_context_t *ctx) \
+{                                                                     \
+    elem##_seq_t *seq;                                                \
+    elem##_t *ptr;                                                    \
+                                                                      \
+    seq = ndt_arena_alloc(arena, 1, sizeof *seq);                     \
+    if (seq == NULL) {                                                \
+        elem##_clear(elt);                                            \
+        return ndt_memory_error(ctx);                                 \
+    }                                                                 \
+                                                                      \
+    ptr = ndt_arena_alloc(arena, 2, sizeof *ptr);                     \
+    if (ptr == NULL) {                                                \
+        elem##_clear(elt);                                            \
+        return ndt_memory_error(ctx);                                 \
+    }                                                                 \
+                                                                      \
+    ptr[0] = *elt;                                                    \
+    seq->len = 1;                                                     \
+    seq->reserved = 2;                                                \
+    seq->ptr = ptr;                                                   \
+                                                                      \
+    return seq;                                                       \
 }
 
-/* Delete a sequence */
+/* Delete a sequence.  The memory itself belongs to the arena. */
 #define NDT_SEQ_DEL(elem) \
 void                                          \
 elem##_seq_del(elem##_seq_t *seq)             \
 {                                             \
+    int64_t i;                                \
+                                              \
     if (seq != NULL) {                        \
-        elem##_array_del(seq->ptr, seq->len); \
-        ndt_free(seq);                        \
+        for (i = 0; i < seq->len; i++) {      \
+            elem##_clear(&seq->ptr[i]);       \
+        }                                     \
     }                                         \
 }
 
 /* Grow a sequence */
 #define NDT_SEQ_GROW(elem) \
-static int                                                         \
-elem##_seq_grow(elem##_seq_t *seq, ndt_context_t *ctx)             \
-{                                                                  \
-    elem##_t *ptr;                                                 \
-                                                                   \
-    ptr = ndt_realloc(seq->ptr, seq->reserved, 2 * (sizeof *ptr)); \
-    if (ptr == NULL) {                                             \
-        ndt_err_format(ctx, NDT_MemoryError, "out of memory");     \
-        return -1;                                                 \
-    }                                                              \
-                                                                   \
-    seq->ptr = ptr;                                                \
-    seq->reserved = 2 * seq->reserved;                             \
-                                                                   \
-    return 0;                                                      \
+static int                                                           \
+elem##_seq_grow(elem##_seq_t *seq, ndt_arena_t *arena,               \
+                ndt_context_t *ctx)                                  \
+{                                                                    \
+    elem##_t *ptr;                                                   \
+                                                                     \
+    ptr = ndt_arena_realloc(arena, seq->ptr, seq->reserved,          \
+                            2 * seq->reserved, sizeof *ptr);         \
+    if (ptr == NULL) {                                               \
+        ndt_err_format(ctx, NDT_MemoryError, "out of memory");       \
+        return -1;                                                   \
+    }                                                                \
+                                                                     \
+    seq->ptr = ptr;                                                  \
+    seq->reserved = 2 * seq->reserved;                               \
+                                                                     \
+    return 0;                                                        \
 }
 
 /* Append an element to a sequence */
 #define NDT_SEQ_APPEND(elem) \
 elem##_seq_t *                                                          \
-elem##_seq_append(elem##_seq_t *seq, elem##_t *elt, ndt_context_t *ctx) \
+elem##_seq_append(elem##_seq_t *seq, elem##_t *elt, ndt_arena_t *arena, \
+                  ndt_context_t *ctx)                                   \
 {                                                                       \
     assert(seq->len <= seq->reserved);                                  \
                                                                         \
     if (seq->len == seq->reserved) {                                    \
-        if (elem##_seq_grow(seq, ctx) < 0) {                            \
+        if (elem##_seq_grow(seq, arena, ctx) < 0) {                     \
             elem##_seq_del(seq);                                        \
-            elem##_del(elt);                                            \
+            elem##_clear(elt);                                          \
             return NULL;                                                \
         }                                                               \
     }                                                                   \
@@ -120,31 +132,29 @@ elem##_seq_append(elem##_seq_t *seq, elem##_t *elt, ndt_context_t *ctx) \
     seq->ptr[seq->len] = *elt;                                          \
     seq->len++;                                                         \
                                                                         \
-    ndt_free(elt);                                                      \
     return seq;                                                         \
 }
 
+/* Move the elements to an exactly sized heap array that is owned by the
+   caller.  On failure, the elements are deleted. */
 #define NDT_SEQ_FINALIZE(elem) \
-elem##_seq_t *                                          \
-elem##_seq_finalize(elem##_seq_t *seq)                  \
-{                                                       \
-    elem##_t *ptr;                                      \
-                                                        \
-    if (seq == NULL) {                                  \
-        return NULL;                                    \
-    }                                                   \
-                                                        \
-    assert(seq->len <= seq->reserved);                  \
-                                                        \
-    ptr = ndt_realloc(seq->ptr, seq->len, sizeof *ptr); \
-    if (ptr == NULL) {                                  \
-        return seq; /* seq is still valid */            \
-    }                                                   \
-                                                        \
-    seq->ptr = ptr;                                     \
-    seq->reserved = seq->len;                           \
-                                                        \
-    return seq;                                         \
+elem##_t *                                                        \
+elem##_seq_finalize(elem##_seq_t *seq, ndt_context_t *ctx)        \
+{                                                                 \
+    elem##_t *ptr;                                                \
+                                                                  \
+    assert(seq->len <= seq->reserved);                            \
+                                                                  \
+    ptr = ndt_alloc(seq->len, sizeof *ptr);                       \
+    if (ptr == NULL) {                                            \
+        elem##_seq_del(seq);                                      \
+        return ndt_memory_error(ctx);                             \
+    }                                                             \
+                                                                  \
+    memcpy(ptr, seq->ptr, seq->len * (sizeof *ptr));              \
+    seq->len = 0;                                                 \
+                                                                  \
+    return ptr;                                                   \
 }
 
 typedef struct {
@@ -172,26 +182,23 @@ typedef struct {
 } ndt_type_seq_t;
 
 
-ndt_field_seq_t *ndt_field_seq_new(ndt_field_t *, ndt_context_t *ctx);
+ndt_field_seq_t *ndt_field_seq_new(ndt_field_t *, ndt_arena_t *arena, ndt_context_t *ctx);
 void ndt_field_seq_del(ndt_field_seq_t *);
-ndt_field_seq_t *ndt_field_seq_append(ndt_field_seq_t *, ndt_field_t *, ndt_context_t *ctx);
-ndt_field_seq_t *ndt_field_seq_finalize(ndt_field_seq_t *);
+ndt_field_seq_t *ndt_field_seq_append(ndt_field_seq_t *, ndt_field_t *, ndt_arena_t *arena, ndt_context_t *ctx);
+ndt_field_t *ndt_field_seq_finalize(ndt_field_seq_t *, ndt_context_t *ctx);
 
-ndt_value_seq_t *ndt_value_seq_new(ndt_value_t *, ndt_context_t *ctx);
+ndt_value_seq_t *ndt_value_seq_new(ndt_value_t *, ndt_arena_t *arena, ndt_context_t *ctx);
 void ndt_value_seq_del(ndt_value_seq_t *);
-ndt_value_seq_t *ndt_value_seq_append(ndt_value_seq_t *, ndt_value_t *, ndt_context_t *ctx);
-ndt_value_seq_t *ndt_value_seq_finalize(ndt_value_seq_t *);
+ndt_value_seq_t *ndt_value_seq_append(ndt_value_seq_t *, ndt_value_t *, ndt_arena_t *arena, ndt_context_t *ctx);
+ndt_value_t *ndt_value_seq_finalize(ndt_value_seq_t *, ndt_context_t *ctx);
 
-ndt_string_seq_t *ndt_string_seq_new(char *, ndt_context_t *ctx);
+ndt_string_seq_t *ndt_string_seq_new(char *, ndt_arena_t *arena, ndt_context_t *ctx);
 void ndt_string_seq_del(ndt_string_seq_t *);
-ndt_string_seq_t *ndt_string_seq_append(ndt_string_seq_t *, char *, ndt_context_t *ctx);
-ndt_string_seq_t *ndt_string_seq_finalize(ndt_string_seq_t *);
+ndt_string_seq_t *ndt_string_seq_append(ndt_string_seq_t *, char *, ndt_arena_t *arena, ndt_context_t *ctx);
 
-ndt_type_seq_t *ndt_type_seq_empty(ndt_context_t *ctx);
-ndt_type_seq_t *ndt_type_seq_new(ndt_t *, ndt_context_t *ctx);
+ndt_type_seq_t *ndt_type_seq_empty(ndt_arena_t *arena, ndt_context_t *ctx);
+ndt_type_seq_t *ndt_type_seq_new(ndt_t *, ndt_arena_t *arena, ndt_context_t *ctx);
 void ndt_type_seq_del(ndt_type_seq_t *);
-ndt_type_seq_t *ndt_type_seq_append(ndt_type_seq_t *, ndt_t *, ndt_context_t *ctx);
-ndt_type_seq_t *ndt_type_seq_finalize(ndt_type_seq_t *);
-
+ndt_type_seq_t *ndt_type_seq_append(ndt_type_seq_t *, ndt_t *, ndt_arena_t *arena, ndt_context_t *ctx);
 
 #endif /* SEQ_H */
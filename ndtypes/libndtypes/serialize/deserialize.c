@@ -51,6 +51,7 @@ typedef bool bool_t;
 typedef enum ndt ndt_tag;
 typedef enum ndt_access ndt_access;
 typedef enum ndt_variadic ndt_variadic;
+typedef enum ndt_offset_type ndt_offset_type;
 typedef enum ndt_encoding ndt_encoding;
 typedef enum ndt_value ndt_value;
 
@@ -195,6 +196,7 @@ read_##type##_array(type##_t * const v, const int64_t nmemb,        \
 READ_CAST(ndt_tag, uint8)
 READ_CAST(ndt_access, uint8)
 READ_CAST(ndt_variadic, uint8)
+READ_CAST(ndt_offset_type, uint8)
 READ_CAST(ndt_encoding, uint8)
 READ_CAST(ndt_value, uint8)
 READ_CAST(bool, uint8)
@@ -531,8 +533,9 @@ read_var_dim(ndt_meta_t *m, const common_t *fields, const char * const ptr,
              int64_t offset, const int64_t len, ndt_context_t *ctx)
 {
     int64_t itemsize;
-    int32_t noffsets;
-    int32_t *offsets;
+    enum ndt_offset_type offset_type;
+    int64_t noffsets;
+    void *offsets;
     int32_t nslices = 0;
     ndt_slice_t *slices = NULL;
     ndt_t *type;
@@ -541,18 +544,35 @@ read_var_dim(ndt_meta_t *m, const common_t *fields, const char * const ptr,
     offset = read_pos_int64(&itemsize, ptr, offset, len, ctx);
     if (offset < 0) return NULL;
 
-    offset = read_pos_int32(&noffsets, ptr, offset, len, ctx);
+    offset = ndt_offset_type_from_uint8(&offset_type, ptr, offset, len, ctx);
+    if (offset < 0) return NULL;
+
+    if (offset_type != Int32Offsets && offset_type != Int64Offsets) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "invalid offset type in deserialization (corrupt data?)");
+        return NULL;
+    }
+
+    offset = read_pos_int64(&noffsets, ptr, offset, len, ctx);
     if (offset < 0) return NULL;
 
     offset = read_pos_int32(&nslices, ptr, offset, len, ctx);
     if (offset < 0) return NULL;
 
-    offsets = ndt_alloc(noffsets, sizeof *offsets);
-    if (offsets == NULL) {
-        return ndt_memory_error(ctx);
+    if (offset_type == Int64Offsets) {
+        offsets = ndt_alloc(noffsets, sizeof(int64_t));
+        if (offsets == NULL) {
+            return ndt_memory_error(ctx);
+        }
+        offset = read_int64_array(offsets, noffsets, ptr, offset, len, ctx);
+    }
+    else {
+        offsets = ndt_alloc(noffsets, sizeof(int32_t));
+        if (offsets == NULL) {
+            return ndt_memory_error(ctx);
+        }
+        offset = read_int32_array(offsets, noffsets, ptr, offset, len, ctx);
     }
-
-    offset = read_int32_array(offsets, noffsets, ptr, offset, len, ctx);
     if (offset < 0) {
         ndt_free(offsets);
         return NULL;
@@ -592,12 +612,14 @@ read_var_dim(ndt_meta_t *m, const common_t *fields, const char * const ptr,
     }
     t->VarDim.type = type;
     t->Concrete.VarDim.flag = ExternalOffsets;
+    t->Concrete.VarDim.offset_type = offset_type;
     t->Concrete.VarDim.itemsize = itemsize;
     t->Concrete.VarDim.noffsets = noffsets;
     t->Concrete.VarDim.offsets = offsets;
     t->Concrete.VarDim.nslices = nslices;
     t->Concrete.VarDim.slices = slices;
 
+    m->offset_type[m->ndims] = offset_type;
     m->noffsets[m->ndims] = noffsets;
     m->offsets[m->ndims] = offsets;
     m->ndims++;
@@ -815,13 +837,18 @@ read_categorical(const common_t *fields, const char * const ptr, int64_t offset,
         return NULL;
     }
 
-    t = new_copy_common(fields, ctx);
-    if (t == NULL) {
+    if (fields->align != fields->datasize) {
         ndt_value_array_del(types, ntypes);
+        ndt_err_format(ctx, NDT_ValueError, "invalid categorical code size");
         return NULL;
     }
-    t->Categorical.ntypes = ntypes;
-    t->Categorical.types = types;
+
+    /* Older serializations use 8-byte codes, so keep the stored width. */
+    t = ndt_categorical_sized(types, ntypes, fields->datasize, ctx);
+    if (t == NULL) {
+        return NULL;
+    }
+    copy_common(t, fields);
 
     return t;
 }
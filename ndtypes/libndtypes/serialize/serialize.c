@@ -228,13 +228,20 @@ static int64_t
 write_var_dim(char * const ptr, int64_t offset, const ndt_t * const t,
               bool *overflow)
 {
-    const int32_t noffsets = t->Concrete.VarDim.noffsets;
+    const enum ndt_offset_type offset_type = t->Concrete.VarDim.offset_type;
+    const int64_t noffsets = t->Concrete.VarDim.noffsets;
     const int32_t nslices = t->Concrete.VarDim.nslices;
 
     offset = write_int64(ptr, offset, t->Concrete.VarDim.itemsize, overflow);
-    offset = write_int32(ptr, offset, noffsets, overflow);
+    offset = write_uint8(ptr, offset, (uint8_t)offset_type, overflow);
+    offset = write_int64(ptr, offset, noffsets, overflow);
     offset = write_int32(ptr, offset, t->Concrete.VarDim.nslices, overflow);
-    offset = write_int32_array(ptr, offset, t->Concrete.VarDim.offsets, noffsets, overflow);
+    if (offset_type == Int64Offsets) {
+        offset = write_int64_array(ptr, offset, t->Concrete.VarDim.offsets, noffsets, overflow);
+    }
+    else {
+        offset = write_int32_array(ptr, offset, t->Concrete.VarDim.offsets, noffsets, overflow);
+    }
     offset = write_ndt_slice_array(ptr, offset, t->Concrete.VarDim.slices, nslices, overflow);
     return write_type(ptr, offset, t->VarDim.type, overflow);
 }
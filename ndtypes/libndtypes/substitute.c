@@ -99,7 +99,7 @@ ndt_substitute(const ndt_t *t, const symtable_t *tbl, const bool req_concrete,
     ndt_t *u;
 
     if (ndt_is_concrete(t)) {
-        return ndt_copy(t, ctx);
+        return ndt_incref(t);
     }
 
     switch (t->tag) {
@@ -197,11 +197,7 @@ ndt_substitute(const ndt_t *t, const symtable_t *tbl, const bool req_concrete,
             return NULL;
         }
 
-        u = ndt_copy(t->Nominal.type, ctx);
-        if (u == NULL) {
-            ndt_free(name);
-            return NULL;
-        }
+        u = ndt_incref(t->Nominal.type);
 
         return ndt_nominal(name, u, ctx);
     }
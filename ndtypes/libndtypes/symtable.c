@@ -34,6 +34,8 @@
 #include <stdio.h>
 #include <limits.h>
 #include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include "ndtypes.h"
 #include "symtable.h"
 
@@ -213,6 +215,7 @@ ndt_init(ndt_context_t *ctx)
 void
 ndt_finalize(void)
 {
+    ndt_type_cache_clear();
     typedef_trie_del(typedef_map);
     typedef_map = NULL;
 }
@@ -222,76 +225,142 @@ ndt_finalize(void)
 /*                        Symbol tables for matching                         */
 /*****************************************************************************/
 
-symtable_t *
-symtable_new(ndt_context_t *ctx)
+void
+symtable_init(symtable_t *t)
 {
-    symtable_t *t;
     int i;
 
-    t = ndt_alloc_size(offsetof(symtable_t, next) + ALPHABET_LEN * (sizeof t));
-    if (t == NULL) {
+    t->size = SYMTABLE_INLINE_SLOTS;
+    t->used = 0;
+    t->slots = t->initial;
+    ndt_arena_init(&t->arena);
+
+    for (i = 0; i < SYMTABLE_INLINE_SLOTS; i++) {
+        t->initial[i].key = NULL;
+    }
+}
+
+void
+symtable_clear(symtable_t *t)
+{
+    if (t->slots != t->initial) {
+        ndt_free(t->slots);
+    }
+    ndt_arena_clear(&t->arena);
+    symtable_init(t);
+}
+
+/* Allocate a dimension list that lives as long as the table. */
+void *
+symtable_alloc(symtable_t *t, int64_t nmemb, int64_t size, ndt_context_t *ctx)
+{
+    void *ptr;
+
+    ptr = ndt_arena_alloc(&t->arena, nmemb, size);
+    if (ptr == NULL) {
         return ndt_memory_error(ctx);
     }
 
-    t->entry.tag = Unbound;
+    return ptr;
+}
 
-    for (i = 0; i < ALPHABET_LEN; i++) {
-        t->next[i] = NULL;
+void *
+symtable_realloc(symtable_t *t, void *ptr, int64_t old_nmemb,
+                 int64_t new_nmemb, int64_t size, ndt_context_t *ctx)
+{
+    ptr = ndt_arena_realloc(&t->arena, ptr, old_nmemb, new_nmemb, size);
+    if (ptr == NULL) {
+        return ndt_memory_error(ctx);
     }
 
-    return t;
+    return ptr;
 }
 
-void
-symtable_del(symtable_t *t)
+/* FNV-1a */
+static uint64_t
+symtable_hash(const char *key)
 {
-    int i;
+    const unsigned char *cp = (const unsigned char *)key;
+    uint64_t h = 14695981039346656037ULL;
 
-    if (t == NULL) {
-        return;
+    while (*cp != '\0') {
+        h = (h ^ *cp++) * 1099511628211ULL;
     }
 
-    for (i = 0; i < ALPHABET_LEN; i++) {
-        symtable_del(t->next[i]);
+    return h;
+}
+
+static symtable_slot_t *
+symtable_lookup(const symtable_t *t, const char *key)
+{
+    const int64_t mask = t->size-1;
+    int64_t i;
+
+    for (i = symtable_hash(key) & mask; t->slots[i].key != NULL; i = (i+1) & mask) {
+        if (strcmp(t->slots[i].key, key) == 0) {
+            break;
+        }
     }
 
-    ndt_free(t);
+    return &t->slots[i];
 }
 
-int
-symtable_add(symtable_t *t, const char *key, const symtable_entry_t entry,
-             ndt_context_t *ctx)
+static int
+symtable_resize(symtable_t *t, ndt_context_t *ctx)
 {
-    const unsigned char *cp;
-    int i;
+    symtable_slot_t *slots = t->slots;
+    int64_t size = t->size;
+    symtable_slot_t *s;
+    int64_t i;
+
+    t->slots = ndt_calloc(2*size, sizeof *t->slots);
+    if (t->slots == NULL) {
+        t->slots = slots;
+        (void)ndt_memory_error(ctx);
+        return -1;
+    }
+    t->size = 2*size;
 
-    for (cp = (const unsigned char *)key; *cp != '\0'; cp++) {
-        i = code[*cp];
-        if (i == UCHAR_MAX) {
-            ndt_err_format(ctx, NDT_ValueError,
-                           "invalid character in symbol: '%c'", *cp);
-            return -1;
+    for (i = 0; i < size; i++) {
+        if (slots[i].key != NULL) {
+            s = symtable_lookup(t, slots[i].key);
+            *s = slots[i];
         }
+    }
 
-        if (t->next[i] == NULL) {
-            symtable_t *u = symtable_new(ctx);
-            if (u == NULL) {
-                return -1;
-            }
-            t->next[i] = u;
-            t = u;
-        }
-        else {
-            t = t->next[i];
-        }
+    if (slots != t->initial) {
+        ndt_free(slots);
     }
 
-    if (t->entry.tag != Unbound) {
+    return 0;
+}
+
+/*
+ * Bind 'key' to 'entry'.  The key is not copied and must outlive the table.
+ */
+int
+symtable_add(symtable_t *t, const char *key, const symtable_entry_t entry,
+             ndt_context_t *ctx)
+{
+    symtable_slot_t *s;
+
+    s = symtable_lookup(t, key);
+    if (s->key != NULL) {
         ndt_err_format(ctx, NDT_ValueError, "duplicate binding for '%s'", key);
         return -1;
     }
 
-    t->entry = entry;
+    if (2 * (t->used+1) > t->size) {
+        if (symtable_resize(t, ctx) < 0) {
+            return -1;
+        }
+        s = symtable_lookup(t, key);
+    }
+
+    s->key = key;
+    s->entry = entry;
+    t->used++;
+
     return 0;
 }
 
@@ -299,43 +368,27 @@ symtable_entry_t
 symtable_find(const symtable_t *t, const char *key)
 {
     symtable_entry_t unbound = { .tag=Unbound };
-    const unsigned char *cp;
-    int i;
+    const symtable_slot_t *s;
 
-    for (cp = (const unsigned char *)key; *cp != '\0'; cp++) {
-        i = code[*cp];
-        if (i == UCHAR_MAX) {
-            return unbound; /* NOT REACHED */
-        }
-
-        if (t->next[i] == NULL) {
-            return unbound;
-        }
-        t = t->next[i];
+    s = symtable_lookup(t, key);
+    if (s->key == NULL) {
+        return unbound;
     }
 
-    return t->entry;
+    return s->entry;
 }
 
 symtable_entry_t *
 symtable_find_ptr(symtable_t *t, const char *key)
 {
-    const unsigned char *cp;
-    int i;
-
-    for (cp = (const unsigned char *)key; *cp != '\0'; cp++) {
-        i = code[*cp];
-        if (i == UCHAR_MAX) {
-            return NULL; /* NOT REACHED */
-        }
+    symtable_slot_t *s;
 
-        if (t->next[i] == NULL) {
-            return NULL;
-        }
-        t = t->next[i];
+    s = symtable_lookup(t, key);
+    if (s->key == NULL) {
+        return NULL;
     }
 
-    return &t->entry;
+    return &s->entry;
 }
 
 int64_t
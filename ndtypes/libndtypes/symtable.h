@@ -35,6 +35,11 @@
 #define SYMTABLE_H
 
 
+#include <stdint.h>
+#include "ndtypes.h"
+#include "arena.h"
+
+
 /*****************************************************************************/
 /*                     Symbol tables used in type matching                   */
 /*****************************************************************************/
@@ -49,14 +54,15 @@ enum symtable_entry {
   VarSeq
 };
 
+/* The dimension lists are allocated from the arena of the symbol table. */
 typedef struct {
     int size;
-    const ndt_t *dims[NDT_MAX_DIM];
+    const ndt_t **dims;
 } dim_list_t;
 
 typedef struct {
     int size;
-    int64_t dims[NDT_MAX_DIM];
+    int64_t *dims;
 }  broadcast_list_t;
 
 typedef struct {
@@ -71,9 +77,26 @@ typedef struct {
   };
 } symtable_entry_t;
 
-typedef struct symtable {
+typedef struct {
+    const char *key;
     symtable_entry_t entry;
-    struct symtable *next[];
+} symtable_slot_t;
+
+/*
+ * Open addressing hash map from symbol names to entries.  The table is
+ * meant to live on the stack for the duration of a single match: keys are
+ * borrowed from the types being matched, and the initial slots and the
+ * first arena block are embedded in the struct, so the common case of a
+ * few symbols does not allocate.
+ */
+#define SYMTABLE_INLINE_SLOTS 16
+
+typedef struct {
+    int64_t size;               /* number of slots, a power of two */
+    int64_t used;               /* number of bound keys */
+    symtable_slot_t *slots;
+    ndt_arena_t arena;          /* storage for dimension lists */
+    symtable_slot_t initial[SYMTABLE_INLINE_SLOTS];
 } symtable_t;
 
 
@@ -81,9 +104,11 @@ typedef struct symtable {
 NDT_PRAGMA(NDT_HIDE_SYMBOLS_START)
 
 
-symtable_t *symtable_new(ndt_context_t *ctx);
-void symtable_free_entry(symtable_entry_t entry);
-void symtable_del(symtable_t *t);
+void symtable_init(symtable_t *t);
+void symtable_clear(symtable_t *t);
+void *symtable_alloc(symtable_t *t, int64_t nmemb, int64_t size, ndt_context_t *ctx);
+void *symtable_realloc(symtable_t *t, void *ptr, int64_t old_nmemb,
+                       int64_t new_nmemb, int64_t size, ndt_context_t *ctx);
 int symtable_add(symtable_t *t, const char *key, const symtable_entry_t entry,
                  ndt_context_t *ctx);
 symtable_entry_t symtable_find(const symtable_t *t, const char *key);
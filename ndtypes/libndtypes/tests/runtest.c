@@ -235,6 +235,79 @@ test_parse_roundtrip(void)
     return 0;
 }
 
+static int
+test_parse_large(void)
+{
+    const int nfields = 2000;
+    ndt_context_t *ctx;
+    ndt_t *t;
+    char *buf, *s;
+    size_t size, n;
+    int i;
+
+    ctx = ndt_context_new();
+    if (ctx == NULL) {
+        fprintf(stderr, "error: out of memory");
+        return -1;
+    }
+
+    /* Large enough to exhaust several arena chunks during parsing. */
+    size = (size_t)nfields * 32 + 3;
+    buf = ndt_alloc(1, size);
+    if (buf == NULL) {
+        fprintf(stderr, "error: out of memory");
+        ndt_context_del(ctx);
+        return -1;
+    }
+
+    n = 0;
+    buf[n++] = '{';
+    for (i = 0; i < nfields; i++) {
+        n += snprintf(buf+n, size-n, "%sfield_%d : 10 * int64",
+                      i == 0 ? "" : ", ", i);
+    }
+    buf[n++] = '}';
+    buf[n] = '\0';
+
+    t = ndt_from_string(buf, ctx);
+    if (t == NULL) {
+        fprintf(stderr, "test_parse_large: parse: FAIL: got: %s: %s\n\n",
+                ndt_err_as_string(ctx->err),
+                ndt_context_msg(ctx));
+        ndt_free(buf);
+        ndt_context_del(ctx);
+        return -1;
+    }
+
+    if (t->tag != Record || t->Record.shape != nfields ||
+        strcmp(t->Record.names[nfields-1], "field_1999") != 0 ||
+        t->datasize != nfields * 80) {
+        fprintf(stderr, "test_parse_large: parse: FAIL: unexpected type\n");
+        ndt_del(t);
+        ndt_free(buf);
+        ndt_context_del(ctx);
+        return -1;
+    }
+
+    s = ndt_as_string(t, ctx);
+    if (s == NULL || strcmp(s, buf) != 0) {
+        fprintf(stderr, "test_parse_large: convert: FAIL: roundtrip mismatch\n");
+        ndt_free(s);
+        ndt_del(t);
+        ndt_free(buf);
+        ndt_context_del(ctx);
+        return -1;
+    }
+
+    ndt_free(s);
+    ndt_del(t);
+    ndt_free(buf);
+    fprintf(stderr, "test_parse_large (1 test case)\n");
+
+    ndt_context_del(ctx);
+    return 0;
+}
+
 static int
 test_parse_error(void)
 {
@@ -878,6 +951,234 @@ error:
    goto out;
 }
 
+/* P = N * (N-1) / 2 */
+static int
+pairs_constraint(int64_t *shapes, const void *args, ndt_context_t *ctx)
+{
+    (void)args;
+
+    if (shapes[0] < 1) {
+        ndt_err_format(ctx, NDT_ValueError, "need at least one row");
+        return -1;
+    }
+
+    shapes[1] = shapes[0] * (shapes[0]-1) / 2;
+    return 0;
+}
+
+static const ndt_constraint_t pairs = {
+  .f = pairs_constraint,
+  .nin = 1,
+  .nout = 1,
+  .symbols = {"N", "P"}
+};
+
+static int
+test_matcher(void)
+{
+    static const char *pairs_in[] = {"5 * 3 * float64", NULL};
+    NDT_STATIC_CONTEXT(ctx);
+    ndt_apply_spec_t spec = ndt_apply_spec_empty;
+    const typecheck_testcase_t *test;
+    const ndt_t *sig = NULL;
+    ndt_matcher_t *m = NULL;
+    type_array_t in;
+    int count = 0;
+    int ret = -1;
+
+    for (test = typecheck_tests; test->signature != NULL; test++) {
+        sig = ndt_from_string(test->signature, &ctx);
+        if (sig == NULL) {
+            ndt_err_format(&ctx, NDT_RuntimeError,
+                "test_matcher: could not parse \"%s\"\n", test->signature);
+            goto error;
+        }
+
+        for (alloc_fail = 1; alloc_fail < INT_MAX; alloc_fail++) {
+            ndt_err_clear(&ctx);
+
+            ndt_set_alloc_fail();
+            m = ndt_matcher_new(sig, NULL, &ctx);
+            ndt_set_alloc();
+
+            if (ctx.err != NDT_MemoryError) {
+                break;
+            }
+        }
+
+        if (m == NULL) {
+            ndt_del((ndt_t *)sig);
+            if (ctx.err != NDT_NotImplementedError) {
+                goto error;
+            }
+            ndt_err_clear(&ctx);
+            continue;
+        }
+
+        in = types_from_string(test->in, &ctx);
+        if (in.size < 0) {
+            goto error;
+        }
+
+        for (alloc_fail = 1; alloc_fail < INT_MAX; alloc_fail++) {
+            ndt_err_clear(&ctx);
+
+            ndt_set_alloc_fail();
+            ret = ndt_matcher_typecheck(&spec, m, (const ndt_t **)in.types, in.size, NULL, &ctx);
+            ndt_set_alloc();
+
+            if (ctx.err != NDT_MemoryError) {
+                break;
+            }
+
+            ndt_apply_spec_clear(&spec);
+            if (ret != -1) {
+                ndt_err_format(&ctx, NDT_RuntimeError,
+                    "test_matcher: expect nout == -1 after MemoryError\n"
+                    "test_matcher: \"%s\"\n", test->signature);
+                goto error;
+            }
+        }
+
+        ndt_err_clear(&ctx);
+        ret = validate_typecheck_test(test, sig, &spec, ret, &ctx);
+        ndt_type_array_clear(in.types, in.size);
+        ndt_apply_spec_clear(&spec);
+        ndt_matcher_del(m);
+        ndt_del((ndt_t *)sig);
+        m = NULL;
+
+        if (ret < 0) {
+            goto error;
+        }
+
+        count++;
+    }
+
+    /* Constraint */
+    sig = ndt_from_string("N * M * float64 -> P * float64", &ctx);
+    if (sig == NULL) {
+        goto error;
+    }
+
+    m = ndt_matcher_new(sig, &pairs, &ctx);
+    ndt_del((ndt_t *)sig);
+    if (m == NULL) {
+        goto error;
+    }
+
+    in = types_from_string(pairs_in, &ctx);
+    if (in.size < 0) {
+        goto error;
+    }
+
+    ret = ndt_matcher_typecheck(&spec, m, (const ndt_t **)in.types, in.size, NULL, &ctx);
+    ndt_type_array_clear(in.types, in.size);
+    if (ret < 0) {
+        goto error;
+    }
+
+    if (spec.nout != 1 || spec.out[0]->tag != FixedDim ||
+        spec.out[0]->FixedDim.shape != 10) {
+        ndt_err_format(&ctx, NDT_RuntimeError,
+            "test_matcher: unexpected constraint result");
+        ndt_apply_spec_clear(&spec);
+        goto error;
+    }
+    ndt_apply_spec_clear(&spec);
+    count++;
+
+    ret = 0;
+    fprintf(stderr, "test_matcher (%d test cases)\n", count);
+
+
+out:
+    ndt_matcher_del(m);
+    ndt_context_del(&ctx);
+    return ret;
+
+error:
+   ret = -1;
+   ndt_err_fprint(stderr, &ctx);
+   goto out;
+}
+
+static int
+test_stride_broadcast(void)
+{
+    static const struct {
+        const char *sig;
+        const char *in[3];
+        bool lazy;
+        int nbroadcast;
+    } tests[] = {
+      { "... * float64, ... * float64 -> ... * float64",
+        {"float64", "10 * float64", NULL}, true, 0 },
+      { "... * float64, ... * float64 -> ... * float64",
+        {"3 * 1 * float64", "4 * float64", NULL}, true, 0 },
+      { "... * float64, ... * float64 -> ... * float64",
+        {"3 * 4 * float64", "3 * 4 * float64", NULL}, false, 0 },
+      { "... * N * float64, ... * N * float64 -> ... * N * float64",
+        {"4 * float64", "3 * 4 * float64", NULL}, true, 0 },
+      { "... * N * float64, ... * N * float64 -> ... * N * float64",
+        {"1 * 4 * float64", "3 * 4 * float64", NULL}, true, 0 },
+      { "... * N * int64, ... * int64 -> ... * int64",
+        {"2 * 3 * int64", "10 * 2 * int64", NULL}, false, 2 },
+      { "... * N * int64, ... * int64 -> ... * N * int64",
+        {"2 * 3 * int64", "20 * 10 * 2 * int64", NULL}, false, 2 },
+      { NULL, {NULL}, false, 0 }
+    };
+    NDT_STATIC_CONTEXT(ctx);
+    ndt_apply_spec_t spec = ndt_apply_spec_empty;
+    const ndt_t *sig;
+    type_array_t in;
+    bool lazy;
+    int count = 0;
+    int i, ret;
+
+    for (i = 0; tests[i].sig != NULL; i++) {
+        sig = ndt_from_string(tests[i].sig, &ctx);
+        if (sig == NULL) {
+            goto error;
+        }
+
+        in = types_from_string(tests[i].in, &ctx);
+        if (in.size < 0) {
+            ndt_del((ndt_t *)sig);
+            goto error;
+        }
+
+        spec.flags = NDT_STRIDE_BROADCAST;
+        ret = ndt_typecheck(&spec, sig, (const ndt_t **)in.types, in.size,
+                            NULL, NULL, &ctx);
+        ndt_type_array_clear(in.types, in.size);
+        ndt_del((ndt_t *)sig);
+        if (ret < 0) {
+            goto error;
+        }
+
+        lazy = (spec.flags & NDT_STRIDE_BROADCAST) != 0;
+        if (lazy != tests[i].lazy || spec.nbroadcast != tests[i].nbroadcast ||
+            (lazy && spec.flags != (NDT_STRIDED|NDT_STRIDE_BROADCAST))) {
+            ndt_err_format(&ctx, NDT_RuntimeError,
+                "test_stride_broadcast: unexpected result for case %d", i);
+            ndt_apply_spec_clear(&spec);
+            goto error;
+        }
+
+        ndt_apply_spec_clear(&spec);
+        count++;
+    }
+
+    fprintf(stderr, "test_stride_broadcast (%d test cases)\n", count);
+    return 0;
+
+error:
+    ndt_err_fprint(stderr, &ctx);
+    ndt_context_del(&ctx);
+    return -1;
+}
+
 static int
 test_numba(void)
 {
@@ -1071,6 +1372,7 @@ test_hash(void)
     const char **c;
     ndt_t *t;
     hash_testcase_t x;
+    ndt_t *u;
     int i;
 
     for (c = parse_roundtrip_tests; *c != NULL; c++) {
@@ -1093,7 +1395,26 @@ test_hash(void)
 
         x.hash = ndt_hash(t, &ctx);
         x.str = *c;
+
+        u = ndt_from_string(*c, &ctx);
+        if (u == NULL) {
+            fprintf(stderr, "test_hash: FAIL: expected success: \"%s\"\n", *c);
+            ndt_del(t);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        if (ndt_structural_hash(t) != ndt_structural_hash(u)) {
+            fprintf(stderr,
+                "test_hash: FAIL: structural hash differs for equal types: \"%s\"\n\n", *c);
+            ndt_del(t);
+            ndt_del(u);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
         ndt_del(t);
+        ndt_del(u);
 
         if (x.hash == -1) {
             fprintf(stderr, "test_hash: FAIL: hash==-1\n\n");
@@ -1120,25 +1441,319 @@ test_hash(void)
         return -1;
     }
 
+    /* The structural hash does not allocate. */
     alloc_fail = 1;
     ndt_set_alloc_fail();
     x.hash = ndt_hash(t, &ctx);
     ndt_set_alloc();
 
+    if (x.hash == -1 || x.hash != ndt_hash(t, &ctx) || ndt_err_occurred(&ctx)) {
+        fprintf(stderr, "test_hash: FAIL: unexpected failure, got %" PRI_ndt_ssize "\n\n", x.hash);
+        ndt_del(t);
+        ndt_context_del(&ctx);
+        return -1;
+    }
+
     ndt_del(t);
 
-    if (x.hash != -1 || ctx.err != NDT_MemoryError) {
-        fprintf(stderr, "test_hash: FAIL: expected failure, got %" PRI_ndt_ssize "\n\n", x.hash);
+    ndt_context_del(&ctx);
+    fprintf(stderr, "test_hash (%d test cases)\n", (int)n);
+
+    return 0;
+}
+
+static int
+test_intern(void)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    const char **c;
+    ndt_t *t, *u, *v;
+    int count = 0;
+    const int64_t cache_size = ndt_get_type_cache_size();
+
+    /* Every parse must create a new type. */
+    (void)ndt_set_type_cache_size(0, &ctx);
+
+    for (c = parse_roundtrip_tests; *c != NULL; c++) {
+        t = ndt_from_string(*c, &ctx);
+        if (t == NULL) {
+            fprintf(stderr, "test_intern: FAIL: from_string: \"%s\"\n", *c);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        t = ndt_intern(t, &ctx);
+        if (t == NULL) {
+            fprintf(stderr, "test_intern: FAIL: intern: \"%s\"\n", *c);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        u = ndt_from_string(*c, &ctx);
+        if (u == NULL) {
+            fprintf(stderr, "test_intern: FAIL: from_string: \"%s\"\n", *c);
+            ndt_del(t);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        /* Before interning u, the comparison is structural. */
+        if (!ndt_equal(t, u) ||
+            ndt_structural_hash(t) != ndt_structural_hash(u)) {
+            fprintf(stderr, "test_intern: FAIL: not equal: \"%s\"\n", *c);
+            ndt_del(t);
+            ndt_del(u);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        u = ndt_intern(u, &ctx);
+        if (u != t) {
+            fprintf(stderr, "test_intern: FAIL: not shared: \"%s\"\n", *c);
+            ndt_del(t);
+            ndt_del(u);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        v = ndt_copy(t, &ctx);
+        if (v != t || t->refcnt != 3) {
+            fprintf(stderr, "test_intern: FAIL: copy: \"%s\"\n", *c);
+            ndt_del(v);
+            ndt_del(u);
+            ndt_del(t);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        ndt_del(v);
+        ndt_del(u);
+        ndt_del(t);
+        count++;
+    }
+
+    t = ndt_from_string("10 * int64", &ctx);
+    u = ndt_from_string("10 * int32", &ctx);
+    if (t == NULL || u == NULL) {
+        fprintf(stderr, "test_intern: FAIL: from_string\n\n");
+        ndt_del(t);
+        ndt_del(u);
         ndt_context_del(&ctx);
         return -1;
     }
 
+    t = ndt_intern(t, &ctx);
+    u = ndt_intern(u, &ctx);
+    if (t == NULL || u == NULL || ndt_equal(t, u)) {
+        fprintf(stderr, "test_intern: FAIL: distinct types\n\n");
+        ndt_del(t);
+        ndt_del(u);
+        ndt_context_del(&ctx);
+        return -1;
+    }
+
+    ndt_del(t);
+    ndt_del(u);
+
+    (void)ndt_set_type_cache_size(cache_size, &ctx);
     ndt_context_del(&ctx);
-    fprintf(stderr, "test_hash (%d test cases)\n", (int)n);
+    fprintf(stderr, "test_intern (%d test cases)\n", count);
 
     return 0;
 }
 
+static int
+test_refcount(void)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    const char **c;
+    ndt_t *t, *u, *v;
+    int count = 0;
+    const int64_t cache_size = ndt_get_type_cache_size();
+
+    /* Every parse must create a new type. */
+    (void)ndt_set_type_cache_size(0, &ctx);
+
+    for (c = parse_roundtrip_tests; *c != NULL; c++) {
+        t = ndt_from_string(*c, &ctx);
+        if (t == NULL) {
+            fprintf(stderr, "test_refcount: FAIL: from_string: \"%s\"\n", *c);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        if (t->tag != FixedDim) {
+            ndt_del(t);
+            continue;
+        }
+
+        u = ndt_from_string(*c, &ctx);
+        if (u == NULL) {
+            fprintf(stderr, "test_refcount: FAIL: from_string: \"%s\"\n", *c);
+            ndt_del(t);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        /* The copy shares the subtree of the original. */
+        v = ndt_copy(t, &ctx);
+        if (v == NULL || v == t || v->FixedDim.type != t->FixedDim.type ||
+            t->FixedDim.type->refcnt != 2) {
+            fprintf(stderr, "test_refcount: FAIL: copy: \"%s\"\n", *c);
+            ndt_del(v);
+            ndt_del(u);
+            ndt_del(t);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        /* The shared subtree survives the deallocation of the original. */
+        ndt_del(t);
+        if (v->FixedDim.type->refcnt != 1 || !ndt_equal(u, v)) {
+            fprintf(stderr, "test_refcount: FAIL: shared subtree: \"%s\"\n", *c);
+            ndt_del(v);
+            ndt_del(u);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        t = ndt_incref(v);
+        if (t != v || v->refcnt != 2) {
+            fprintf(stderr, "test_refcount: FAIL: incref: \"%s\"\n", *c);
+            ndt_del(v);
+            ndt_del(u);
+            ndt_context_del(&ctx);
+            return -1;
+        }
+
+        ndt_decref(t);
+        ndt_decref(v);
+        ndt_del(u);
+        count++;
+    }
+
+    (void)ndt_set_type_cache_size(cache_size, &ctx);
+    ndt_context_del(&ctx);
+    fprintf(stderr, "test_refcount (%d test cases)\n", count);
+
+    return 0;
+}
+
+static int
+test_type_cache(void)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    const int64_t cache_size = ndt_get_type_cache_size();
+    const int64_t max_offsets = ndt_get_type_cache_max_offsets();
+    const char *uncached[] = {
+      "N * int64",                              /* abstract */
+      "var(offsets=[0,3]) * var(offsets=[0,1,3,5]) * int64", /* 6 offsets */
+      NULL
+    };
+    const char **c;
+    ndt_t *t, *u, *v;
+
+    if (ndt_set_type_cache_size(-1, &ctx) == 0 || ctx.err != NDT_ValueError ||
+        ndt_set_type_cache_max_offsets(-1, &ctx) == 0) {
+        fprintf(stderr, "test_type_cache: FAIL: invalid size accepted\n");
+        ndt_context_del(&ctx);
+        return -1;
+    }
+    ndt_err_clear(&ctx);
+
+    if (ndt_set_type_cache_size(2, &ctx) < 0 ||
+        ndt_set_type_cache_max_offsets(4, &ctx) < 0) {
+        fprintf(stderr, "test_type_cache: FAIL: set parameters\n");
+        ndt_context_del(&ctx);
+        return -1;
+    }
+
+    /* Repeated parses share one type. */
+    t = ndt_from_string("10 * {a: int64, b: float64}", &ctx);
+    u = ndt_from_string("10 * {a: int64, b: float64}", &ctx);
+    if (t == NULL || u != t || t->refcnt != 3) {
+        fprintf(stderr, "test_type_cache: FAIL: not shared\n");
+        goto error;
+    }
+    ndt_del(u);
+
+    /* Datashape and buffer protocol inputs do not collide. */
+    u = ndt_from_bpformat("d", &ctx);
+    v = ndt_from_bpformat("d", &ctx);
+    if (u == NULL || v != u || u->tag != Float64) {
+        fprintf(stderr, "test_type_cache: FAIL: bpformat not shared\n");
+        ndt_del(v);
+        ndt_del(u);
+        goto error;
+    }
+    ndt_del(v);
+    ndt_del(u);
+
+    /* The least recently used entry ("10 * {...}") is evicted. */
+    u = ndt_from_string("2 * int8", &ctx);
+    if (u == NULL) {
+        fprintf(stderr, "test_type_cache: FAIL: from_string\n");
+        goto error;
+    }
+    ndt_del(u);
+
+    u = ndt_from_string("10 * {a: int64, b: float64}", &ctx);
+    if (u == NULL || u == t || t->refcnt != 1 || !ndt_equal(t, u)) {
+        fprintf(stderr, "test_type_cache: FAIL: not evicted\n");
+        ndt_del(u);
+        goto error;
+    }
+    ndt_del(u);
+    ndt_del(t);
+
+    for (c = uncached; *c != NULL; c++) {
+        t = ndt_from_string(*c, &ctx);
+        u = ndt_from_string(*c, &ctx);
+        if (t == NULL || u == NULL || t == u || t->refcnt != 1) {
+            fprintf(stderr, "test_type_cache: FAIL: cached: \"%s\"\n", *c);
+            ndt_del(t);
+            ndt_del(u);
+            goto error;
+        }
+        ndt_del(t);
+        ndt_del(u);
+    }
+
+    /* Errors are not cached. */
+    t = ndt_from_string("10 * undefined_t", &ctx);
+    if (t != NULL || ctx.err != NDT_ValueError) {
+        fprintf(stderr, "test_type_cache: FAIL: expected error\n");
+        ndt_del(t);
+        goto error;
+    }
+    ndt_err_clear(&ctx);
+
+    t = ndt_from_string("3 * int32", &ctx);
+    ndt_type_cache_clear();
+    u = ndt_from_string("3 * int32", &ctx);
+    if (t == NULL || u == NULL || u == t || t->refcnt != 1) {
+        fprintf(stderr, "test_type_cache: FAIL: clear\n");
+        ndt_del(t);
+        ndt_del(u);
+        goto error;
+    }
+    ndt_del(t);
+    ndt_del(u);
+
+    (void)ndt_set_type_cache_size(cache_size, &ctx);
+    (void)ndt_set_type_cache_max_offsets(max_offsets, &ctx);
+    ndt_context_del(&ctx);
+    fprintf(stderr, "test_type_cache (1 test case)\n");
+
+    return 0;
+
+error:
+    (void)ndt_set_type_cache_size(cache_size, &ctx);
+    (void)ndt_set_type_cache_max_offsets(max_offsets, &ctx);
+    ndt_context_del(&ctx);
+    return -1;
+}
+
 static int
 test_copy(void)
 {
@@ -1601,6 +2216,7 @@ test_serialize_fuzz(void)
 static int (*tests[])(void) = {
   test_parse,
   test_parse_roundtrip,
+  test_parse_large,
   test_parse_error,
   test_indent,
   test_typedef,
@@ -1609,9 +2225,14 @@ static int (*tests[])(void) = {
   test_equal,
   test_match,
   test_typecheck,
+  test_matcher,
+  test_stride_broadcast,
   test_numba,
   test_static_context,
   test_hash,
+  test_intern,
+  test_refcount,
+  test_type_cache,
   test_copy,
   test_buffer,
   test_buffer_roundtrip,
@@ -325,6 +325,8 @@ const char *parse_tests[] = {
 
   "var(offsets=[0,10]) * var(offsets=[0,1,3,6,10,15,21,28,36,45,55]) * float64",
   "var(offsets=[0,2]) * var(offsets=[0,3,7]) * var(offsets=[0,5,11,18,26,35,45,56]) * float64",
+  "var(offsets=[0,3000000000]) * uint8",
+  "var(offsets=[0,2]) * var(offsets=[0,2147483648,4294967296]) * uint8",
 
   /* Short ref notation */
   "&float64",
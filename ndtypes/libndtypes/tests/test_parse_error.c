@@ -27815,6 +27815,8 @@ const char *parse_error_tests[] = {
   "var(offsets=[-1]) * Some(int64)",
   "var(offsets=[-1, -1]) * Some(int64)",
   "var(offsets=[0, -1]) * Some(int64)",
+  "var(offsets=[0, 9223372036854775808]) * int8",
+  "var(offsets=[0, 9223372036854775807]) * int64",
 
   /* Negative dimensions */
   "-2 * 4 * uint8",
@@ -65,6 +65,20 @@ const typecheck_testcase_t typecheck_tests[] = {
     .outer_dims=0,
     .success=true },
 
+  { .signature="A*B*C*D*E*F*G*H*I*J*K*T, K*L*T -> A*K*L*T",
+    .in={"1 * 2 * 1 * 2 * 1 * 2 * 1 * 2 * 1 * 2 * 3 * int64", "3 * 4 * int64"},
+    .out={"1 * 3 * 4 * int64"},
+    .broadcast={NULL},
+    .outer_dims=0,
+    .success=true },
+
+  { .signature="A*B*C*D*E*F*G*H*I*J*K*T, K*L*T -> A*K*L*T",
+    .in={"1 * 2 * 1 * 2 * 1 * 2 * 1 * 2 * 1 * 2 * 3 * int64", "2 * 4 * int64"},
+    .out={NULL},
+    .broadcast={NULL},
+    .outer_dims=0,
+    .success=false },
+
   { .signature="Dims... *M*N*T, Dims... *N*P*T -> Dims... *M*P*T",
     .in={"2 * 3 * int64", "3 * 10 * int64"},
     .out={"2 * 10 * int64"},
@@ -0,0 +1,438 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <stdbool.h>
+#include <string.h>
+#include "ndtypes.h"
+#include "typecache.h"
+
+
+/*
+ * Bounded LRU cache that maps input strings to parsed types.  Types are
+ * immutable and reference counted, so a lookup returns a new reference to
+ * the shared instance.  Only concrete types are cached; types whose var
+ * dimensions carry more than 'max_offsets' offsets are not cached in order
+ * to avoid pinning large offset arrays, and types with external offsets
+ * depend on the lifetime of another object and are never cached.
+ *
+ * The cache is protected by a spinlock; all operations under the lock are
+ * short and do not allocate or free types.  Sharing types between threads
+ * requires atomic reference counts, so the cache is only enabled on
+ * platforms where ndt_incref() is atomic.
+ */
+
+#define NDT_TYPE_CACHE_SIZE 256
+#define NDT_TYPE_CACHE_MAX_OFFSETS 1024
+
+#if NDT_THREAD_SAFE
+  #define HAVE_TYPE_CACHE
+#endif
+
+
+typedef struct cache_entry {
+    struct cache_entry *chain;  /* next entry in the same bucket */
+    struct cache_entry *prev;   /* LRU list, most recently used first */
+    struct cache_entry *next;
+    enum ndt_cache_syntax syntax;
+    uint64_t hash;
+    ndt_t *type;
+    char key[];
+} cache_entry_t;
+
+static struct {
+    ndt_spinlock_t lock;
+    cache_entry_t **buckets;
+    int64_t nbuckets;
+    int64_t used;
+    cache_entry_t *first;
+    cache_entry_t *last;
+    int64_t max_size;
+    int64_t max_offsets;
+} cache = {
+    0,
+    NULL,
+    0,
+    0,
+    NULL,
+    NULL,
+#ifdef HAVE_TYPE_CACHE
+    NDT_TYPE_CACHE_SIZE,
+#else
+    0,
+#endif
+    NDT_TYPE_CACHE_MAX_OFFSETS
+};
+
+
+static inline void
+cache_lock(void)
+{
+    ndt_spin_lock(&cache.lock);
+}
+
+static inline void
+cache_unlock(void)
+{
+    ndt_spin_unlock(&cache.lock);
+}
+
+/* FNV-1a */
+static uint64_t
+cache_hash(enum ndt_cache_syntax syntax, const char *input)
+{
+    const unsigned char *cp = (const unsigned char *)input;
+    uint64_t h = 14695981039346656037ULL;
+
+    h = (h ^ (uint64_t)syntax) * 1099511628211ULL;
+    while (*cp != '\0') {
+        h = (h ^ *cp++) * 1099511628211ULL;
+    }
+
+    return h;
+}
+
+/*
+ * Return the total number of var dimension offsets in 't' or -1 if 't'
+ * has external offsets.
+ */
+static int64_t
+offsets_size(const ndt_t *t)
+{
+    int64_t n = 0, k, i;
+
+    switch (t->tag) {
+    case FixedDim:
+        return offsets_size(t->FixedDim.type);
+    case VarDim:
+        if (t->Concrete.VarDim.flag == ExternalOffsets) {
+            return -1;
+        }
+        k = offsets_size(t->VarDim.type);
+        return k < 0 ? -1 : k + t->Concrete.VarDim.noffsets;
+    case Tuple:
+        for (i = 0; i < t->Tuple.shape; i++) {
+            k = offsets_size(t->Tuple.types[i]);
+            if (k < 0) return -1;
+            n += k;
+        }
+        return n;
+    case Record:
+        for (i = 0; i < t->Record.shape; i++) {
+            k = offsets_size(t->Record.types[i]);
+            if (k < 0) return -1;
+            n += k;
+        }
+        return n;
+    case Ref:
+        return offsets_size(t->Ref.type);
+    case Constr:
+        return offsets_size(t->Constr.type);
+    case Nominal:
+        return offsets_size(t->Nominal.type);
+    default:
+        return 0;
+    }
+}
+
+/* Unlink 'e' from its bucket and from the LRU list.  Called with the lock held. */
+static void
+cache_unlink(cache_entry_t *e)
+{
+    cache_entry_t **p;
+
+    for (p = &cache.buckets[e->hash & (cache.nbuckets-1)]; *p != e; p = &(*p)->chain);
+    *p = e->chain;
+
+    if (e->prev) e->prev->next = e->next;
+    else cache.first = e->next;
+    if (e->next) e->next->prev = e->prev;
+    else cache.last = e->prev;
+
+    cache.used--;
+}
+
+/* Insert 'e' at the front of the LRU list.  Called with the lock held. */
+static void
+cache_push_front(cache_entry_t *e)
+{
+    e->prev = NULL;
+    e->next = cache.first;
+    if (cache.first) cache.first->prev = e;
+    else cache.last = e;
+    cache.first = e;
+}
+
+/* Free a list of detached entries that is linked through 'next'. */
+static void
+cache_entries_del(cache_entry_t *e)
+{
+    cache_entry_t *next;
+
+    for (; e != NULL; e = next) {
+        next = e->next;
+        ndt_del(e->type);
+        ndt_free(e);
+    }
+}
+
+ndt_t *
+ndt_type_cache_lookup(enum ndt_cache_syntax syntax, const char *input)
+{
+    const uint64_t hash = cache_hash(syntax, input);
+    cache_entry_t *e;
+    ndt_t *t = NULL;
+
+    cache_lock();
+    if (cache.used > 0) {
+        for (e = cache.buckets[hash & (cache.nbuckets-1)]; e != NULL; e = e->chain) {
+            if (e->hash == hash && e->syntax == syntax && strcmp(e->key, input) == 0) {
+                if (e != cache.first) {
+                    e->prev->next = e->next;
+                    if (e->next) e->next->prev = e->prev;
+                    else cache.last = e->prev;
+                    cache_push_front(e);
+                }
+                t = ndt_incref(e->type);
+                break;
+            }
+        }
+    }
+    cache_unlock();
+
+    return t;
+}
+
+/* Detach all entries and the bucket array.  Called with the lock held. */
+static cache_entry_t *
+cache_detach(cache_entry_t ***buckets)
+{
+    cache_entry_t *entries = cache.first;
+
+    *buckets = cache.buckets;
+    cache.first = cache.last = NULL;
+    cache.buckets = NULL;
+    cache.nbuckets = 0;
+    cache.used = 0;
+
+    return entries;
+}
+
+/*
+ * Add a new reference to 't' to the cache.  The cache is best effort:
+ * types that do not qualify and allocation failures are silently ignored.
+ */
+void
+ndt_type_cache_insert(enum ndt_cache_syntax syntax, const char *input,
+                      const ndt_t *t)
+{
+    cache_entry_t *e, *u, *evicted;
+    cache_entry_t **buckets = NULL;
+    int64_t nbuckets, noffsets, n;
+    size_t len;
+
+    if (!ndt_is_concrete(t)) {
+        return;
+    }
+
+    cache_lock();
+    n = cache.max_size;
+    cache_unlock();
+    if (n == 0) {
+        return;
+    }
+
+    noffsets = offsets_size(t);
+    if (noffsets < 0) {
+        return;
+    }
+
+    len = strlen(input);
+    e = ndt_alloc_size(offsetof(cache_entry_t, key) + len + 1);
+    if (e == NULL) {
+        return;
+    }
+    e->chain = e->prev = e->next = NULL;
+    e->syntax = syntax;
+    e->hash = cache_hash(syntax, input);
+    e->type = ndt_incref(t);
+    memcpy(e->key, input, len+1);
+    evicted = e;
+
+    cache_lock();
+    if (cache.buckets == NULL && cache.max_size > 0) {
+        for (nbuckets = 8; nbuckets < cache.max_size; nbuckets *= 2);
+        cache_unlock();
+        buckets = ndt_calloc(nbuckets, sizeof *buckets);
+        if (buckets == NULL) {
+            cache_entries_del(e);
+            return;
+        }
+        cache_lock();
+        if (cache.buckets == NULL) {
+            cache.buckets = buckets;
+            cache.nbuckets = nbuckets;
+            buckets = NULL;
+        }
+    }
+
+    if (cache.max_size == 0 || cache.buckets == NULL ||
+        noffsets > cache.max_offsets) {
+        goto unlock;
+    }
+
+    /* Another thread may have added the same key in the meantime. */
+    for (u = cache.buckets[e->hash & (cache.nbuckets-1)]; u != NULL; u = u->chain) {
+        if (u->hash == e->hash && u->syntax == syntax && strcmp(u->key, input) == 0) {
+            goto unlock;
+        }
+    }
+
+    e->chain = cache.buckets[e->hash & (cache.nbuckets-1)];
+    cache.buckets[e->hash & (cache.nbuckets-1)] = e;
+    cache_push_front(e);
+    cache.used++;
+    evicted = NULL;
+
+    while (cache.used > cache.max_size) {
+        u = cache.last;
+        cache_unlink(u);
+        u->next = evicted;
+        evicted = u;
+    }
+
+unlock:
+    cache_unlock();
+    ndt_free(buckets);
+    cache_entries_del(evicted);
+}
+
+
+/*****************************************************************************/
+/*                               Public API                                  */
+/*****************************************************************************/
+
+/* Remove all cached types. */
+void
+ndt_type_cache_clear(void)
+{
+    cache_entry_t **buckets;
+    cache_entry_t *entries;
+
+    cache_lock();
+    entries = cache_detach(&buckets);
+    cache_unlock();
+
+    ndt_free(buckets);
+    cache_entries_del(entries);
+}
+
+/* Set the maximum number of cached types.  0 disables the cache. */
+int
+ndt_set_type_cache_size(int64_t n, ndt_context_t *ctx)
+{
+    cache_entry_t **buckets;
+    cache_entry_t *entries;
+
+    if (n < 0 || n > INT32_MAX) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "type cache size must be in [0, %" PRIi32 "]", INT32_MAX);
+        return -1;
+    }
+
+#ifndef HAVE_TYPE_CACHE
+    if (n > 0) {
+        ndt_err_format(ctx, NDT_NotImplementedError,
+            "the type cache is not supported on this platform");
+        return -1;
+    }
+#endif
+
+    /* The bucket array is sized for the new maximum on the next insert. */
+    cache_lock();
+    cache.max_size = n;
+    entries = cache_detach(&buckets);
+    cache_unlock();
+
+    ndt_free(buckets);
+    cache_entries_del(entries);
+
+    return 0;
+}
+
+int64_t
+ndt_get_type_cache_size(void)
+{
+    int64_t n;
+
+    cache_lock();
+    n = cache.max_size;
+    cache_unlock();
+
+    return n;
+}
+
+/*
+ * Set the maximum total number of var dimension offsets in a cached type.
+ * Types with more offsets are not added to the cache.
+ */
+int
+ndt_set_type_cache_max_offsets(int64_t n, ndt_context_t *ctx)
+{
+    if (n < 0) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "maximum number of offsets must be non-negative");
+        return -1;
+    }
+
+    cache_lock();
+    cache.max_offsets = n;
+    cache_unlock();
+
+    return 0;
+}
+
+int64_t
+ndt_get_type_cache_max_offsets(void)
+{
+    int64_t n;
+
+    cache_lock();
+    n = cache.max_offsets;
+    cache_unlock();
+
+    return n;
+}
@@ -36,6 +36,10 @@
 #include <assert.h>
 #include "ndtypes.h"
 
+#if defined(_MSC_VER) && defined(_WIN64)
+  #include <intrin.h>
+#endif
+
 
 /*****************************************************************************/
 /*                     String  and formatting utilities                      */
@@ -91,6 +95,41 @@ ndt_asprintf(ndt_context_t *ctx, const char *fmt, ...)
 }
 
 
+/*****************************************************************************/
+/*                                Spinlocks                                  */
+/*****************************************************************************/
+
+/*
+ * Test-and-set spinlock for short critical sections that are not contended
+ * for long, such as cache lookups.  A zero initialized lock is unlocked.
+ */
+void
+ndt_spin_lock(ndt_spinlock_t *lock)
+{
+#if defined(__GNUC__)
+    while (__atomic_test_and_set(lock, __ATOMIC_ACQUIRE)) {
+        while (__atomic_load_n(lock, __ATOMIC_RELAXED));
+    }
+#elif defined(_MSC_VER) && defined(_WIN64)
+    while (_InterlockedExchange(lock, 1) != 0);
+#else
+    (void)lock;
+#endif
+}
+
+void
+ndt_spin_unlock(ndt_spinlock_t *lock)
+{
+#if defined(__GNUC__)
+    __atomic_clear(lock, __ATOMIC_RELEASE);
+#elif defined(_MSC_VER) && defined(_WIN64)
+    (void)_InterlockedExchange(lock, 0);
+#else
+    (void)lock;
+#endif
+}
+
+
 /*****************************************************************************/
 /*                       Type functions (unstable API)                       */
 /*****************************************************************************/
@@ -205,33 +244,17 @@ ndt_as_ndarray(ndt_ndarray_t *a, const ndt_t *t, ndt_context_t *ctx)
     return n;
 }
 
-/* Unoptimized hash function for experimenting. */
+/* Structural hash, cached for interned types. */
 ndt_ssize_t
-ndt_hash(ndt_t *t, ndt_context_t *ctx)
+ndt_hash(const ndt_t *t, ndt_context_t *ctx)
 {
-    unsigned char *s, *cp;
-    size_t len;
-    ndt_ssize_t x;
-
-    cp = s = (unsigned char *)ndt_as_string(t, ctx);
-    if (s == NULL) {
-        return -1;
-    }
-
-    len = strlen((char *)s);
-
-    x = *cp << 7;
-    while (*cp != '\0') {
-        x = (1000003 * x) ^ *cp++;
-    }
-    x ^= len;
+    ndt_ssize_t x = (ndt_ssize_t)ndt_structural_hash(t);
+    (void)ctx;
 
     if (x == -1) {
         x = -2;
     }
 
-    ndt_free(s);
-
     return x;
 }
 
@@ -303,7 +326,7 @@ ndt_apply_spec_del(ndt_apply_spec_t *spec)
 const char *
 ndt_apply_flags_as_string(const ndt_apply_spec_t *spec)
 {
-    switch (spec->flags) {
+    switch (spec->flags & ~NDT_STRIDE_BROADCAST) {
     case 0: return "None";
     case NDT_C: return "C";
     case NDT_FORTRAN: return "Fortran";
@@ -412,7 +435,13 @@ ndt_select_kernel_strategy(ndt_apply_spec_t *spec, const ndt_t *sig,
     int i;
 
     assert(sig->tag == Function);
-    assert(spec->flags == 0);
+    assert((spec->flags & ~NDT_STRIDE_BROADCAST) == 0);
+
+    /* The inputs are broadcast with zero strides, see ndt_broadcast_all(). */
+    if (spec->flags & NDT_STRIDE_BROADCAST) {
+        spec->flags = NDT_STRIDED|NDT_STRIDE_BROADCAST;
+        return 0;
+    }
 
     if (spec->nbroadcast > 0) {
         in = (const ndt_t **)spec->broadcast;
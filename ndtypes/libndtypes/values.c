@@ -41,17 +41,19 @@
 /*                    Values for the categorical type                        */
 /*****************************************************************************/
 
+/* Release the string of a value, but not the value itself. */
 void
-ndt_value_del(ndt_value_t *mem)
+ndt_value_clear(ndt_value_t *mem)
 {
-    if (mem == NULL) {
-        return;
-    }
-
-    if (mem->tag == ValString) {
+    if (mem != NULL && mem->tag == ValString) {
         ndt_free(mem->ValString);
     }
+}
 
+void
+ndt_value_del(ndt_value_t *mem)
+{
+    ndt_value_clear(mem);
     ndt_free(mem);
 }
 
@@ -65,9 +67,7 @@ ndt_value_array_del(ndt_value_t *mem, int64_t ntypes)
     }
 
     for (i = 0; i < ntypes; i++) {
-        if (mem[i].tag == ValString) {
-            ndt_free(mem[i].ValString);
-        }
+        ndt_value_clear(&mem[i]);
     }
 
     ndt_free(mem);
@@ -81,17 +81,12 @@ NDT_SEQ_APPEND(ndt_value)
 NDT_SEQ_FINALIZE(ndt_value)
 
 
-/* Return a new ndt memory buffer. Input types are restricted. */
-ndt_value_t *
-ndt_value_from_number(enum ndt_value tag, char *v, ndt_context_t *ctx)
+/* Initialize a caller-allocated value. Input types are restricted. 'v' is
+   stolen. */
+int
+ndt_value_init_number(ndt_value_t *mem, enum ndt_value tag, char *v,
+                      ndt_context_t *ctx)
 {
-    ndt_value_t *mem;
-
-    mem = ndt_alloc_size(sizeof *mem);
-    if (mem == NULL) {
-        ndt_free(v);
-        return ndt_memory_error(ctx);
-    }
     mem->tag = tag;
 
     switch (tag) {
@@ -111,6 +106,26 @@ ndt_value_from_number(enum ndt_value tag, char *v, ndt_context_t *ctx)
 
     ndt_free(v);
     if (ndt_err_occurred(ctx)) {
+        mem->tag = ValNA;
+        return -1;
+    }
+
+    return 0;
+}
+
+/* Return a new ndt memory buffer. Input types are restricted. */
+ndt_value_t *
+ndt_value_from_number(enum ndt_value tag, char *v, ndt_context_t *ctx)
+{
+    ndt_value_t *mem;
+
+    mem = ndt_alloc_size(sizeof *mem);
+    if (mem == NULL) {
+        ndt_free(v);
+        return ndt_memory_error(ctx);
+    }
+
+    if (ndt_value_init_number(mem, tag, v, ctx) < 0) {
         ndt_free(mem);
         return NULL;
     }
@@ -226,3 +241,50 @@ ndt_value_compare(const ndt_value_t *x, const ndt_value_t *y)
     /* NOT REACHED: tags should be exhaustive. */
     ndt_internal_error("invalid value");
 }
+
+static inline uint64_t
+mix64(uint64_t h)
+{
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ULL;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebULL;
+    h ^= h >> 31;
+    return h;
+}
+
+/* Hash function that is consistent with ndt_value_mem_equal(). */
+uint64_t
+ndt_value_hash(const ndt_value_t *x)
+{
+    uint64_t h = (uint64_t)x->tag;
+
+    switch(x->tag) {
+    case ValBool:
+        h ^= (uint64_t)x->ValBool << 8;
+        break;
+    case ValInt64:
+        h ^= (uint64_t)x->ValInt64;
+        break;
+    case ValFloat64: {
+        double d = x->ValFloat64 == 0 ? 0.0 : x->ValFloat64; /* -0.0 == 0.0 */
+        uint64_t u;
+        memcpy(&u, &d, sizeof u);
+        h ^= u;
+        break;
+    }
+    case ValString: {
+        const unsigned char *s = (const unsigned char *)x->ValString;
+        h ^= 0xcbf29ce484222325ULL;
+        for (; *s != '\0'; s++) {
+            h ^= *s;
+            h *= 0x100000001b3ULL;
+        }
+        break;
+    }
+    case ValNA:
+        break;
+    }
+
+    return mix64(h + 0x9e3779b97f4a7c15ULL);
+}
@@ -112,6 +112,7 @@ rbuf_dealloc(ResourceBufferObject *self)
 static int
 rbuf_init_from_offset_list(ResourceBufferObject *rbuf, PyObject *list)
 {
+    NDT_STATIC_CONTEXT(ctx);
     ndt_meta_t * const m = rbuf->m;
     PyObject *lst;
 
@@ -137,37 +138,47 @@ rbuf_init_from_offset_list(ResourceBufferObject *rbuf, PyObject *list)
         }
 
         const int64_t noffsets = PyList_GET_SIZE(lst);
-        if (noffsets < 2 || noffsets > INT32_MAX) {
+        if (noffsets < 2) {
             PyErr_SetString(PyExc_ValueError,
-                "length of a single offset list must be in [2, INT32_MAX]");
+                "length of a single offset list must be at least 2");
             return -1;
         }
 
-        int32_t * const offsets = ndt_alloc(noffsets, sizeof(int32_t));
+        int64_t * const offsets = ndt_alloc(noffsets, sizeof(int64_t));
         if (offsets == NULL) {
             PyErr_NoMemory();
             return -1;
         }
 
-        for (int32_t k = 0; k < noffsets; k++) {
+        for (int64_t k = 0; k < noffsets; k++) {
             long long x = PyLong_AsLongLong(PyList_GET_ITEM(lst, k));
             if (x == -1 && PyErr_Occurred()) {
                 ndt_free(offsets);
                 return -1;
             }
 
-            if (x < 0 || x > INT32_MAX) {
+            if (x < 0) {
                 ndt_free(offsets);
                 PyErr_SetString(PyExc_ValueError,
-                    "offset must be in [0, INT32_MAX]");
+                    "offset must be in [0, INT64_MAX]");
                 return -1;
             }
 
-            offsets[k] = (int32_t)x;
+            offsets[k] = (int64_t)x;
+        }
+
+        /* Offsets are stored as int32_t unless they require 64 bits. */
+        void *v = offsets;
+        const int offset_type = ndt_compact_offsets(&v, noffsets, &ctx);
+        if (offset_type < 0) {
+            ndt_free(offsets);
+            (void)seterr(&ctx);
+            return -1;
         }
 
-        m->noffsets[m->ndims] = (int32_t)noffsets;
-        m->offsets[m->ndims] = offsets;
+        m->offset_type[m->ndims] = offset_type;
+        m->offsets[m->ndims] = v;
+        m->noffsets[m->ndims] = noffsets;
         m->ndims++;
     }
 
@@ -857,17 +868,13 @@ ndtype_strides(PyObject *self, PyObject *args UNUSED)
 static PyObject *
 ndtype_hidden_dtype(PyObject *self, PyObject *args UNUSED)
 {
-    NDT_STATIC_CONTEXT(ctx);
     const ndt_t *t = NDT(self);
     const ndt_t *dtype;
     ndt_t *u;
 
     dtype = ndt_hidden_dtype(t);
 
-    u = ndt_copy(dtype, &ctx); 
-    if (u == NULL) {
-        return seterr(&ctx);
-    }
+    u = ndt_incref(dtype);
 
     return Ndt_FromType(u);
 }
@@ -1050,7 +1057,6 @@ Ndt_SetError(ndt_context_t *ctx)
 static PyObject *
 Ndt_CopySubtree(const PyObject *src, const ndt_t *t)
 {
-    NDT_STATIC_CONTEXT(ctx);
     PyObject *dest;
 
     if (!Ndt_Check(src)) {
@@ -1063,10 +1069,7 @@ Ndt_CopySubtree(const PyObject *src, const ndt_t *t)
         return NULL;
     }
 
-    NDT(dest) = ndt_copy(t, &ctx);
-    if (NDT(dest) == NULL) {
-        return seterr(&ctx);
-    }
+    NDT(dest) = ndt_incref(t);
 
     RBUF(dest) = RBUF(src);
     Py_XINCREF(RBUF(dest));
@@ -1202,11 +1205,7 @@ ndtype_instantiate(PyObject *mod UNUSED, PyObject *args, PyObject *kwds)
         return seterr(&ctx);
     }
 
-    tp = ndt_copy(NDT(type), &ctx);
-    if (tp == NULL) {
-        ndt_free(cp);
-        return seterr(&ctx);
-    }
+    tp = ndt_incref(NDT(type));
 
     t = ndt_nominal(cp, tp, &ctx);
     if (t == NULL) {
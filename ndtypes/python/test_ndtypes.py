@@ -465,7 +465,7 @@ class TestVarDim(unittest.TestCase):
         self.assertRaises(ValueError, ndt, "int8", [[0], [0]])
 
         self.assertRaises(ValueError, ndt, "int8", [[-1, 2]])
-        self.assertRaises(ValueError, ndt, "int8", [[0, 2147483648]])
+        self.assertRaises(OverflowError, ndt, "int8", [[0, 2**63]])
 
         # Invalid combinations.
         self.assertRaises(ValueError, ndt, "int8", [[0, 2], [0, 10]])
@@ -481,6 +481,27 @@ class TestVarDim(unittest.TestCase):
         # Mixing external and internal offsets.
         self.assertRaises(TypeError, ndt, "var(offsets=[0,2,10]) * int8", [[0, 1], [0, 2]])
 
+    def test_var_dim_int64_offsets(self):
+        # Offsets that do not fit in int32_t.
+        t = ndt("var(offsets=[0,2]) * var(offsets=[0,2147483648,4294967296]) * uint8")
+        check_serialize(self, t)
+        self.assertEqual(t.datasize, 4294967296)
+
+        u = ndt("uint8", [[0, 2], [0, 2147483648, 4294967296]])
+        check_serialize(self, u)
+        self.assertEqual(u, t)
+
+        t = ndt("var(offsets=[0,3000000000]) * int64")
+        self.assertEqual(t.datasize, 24000000000)
+
+        # Compact and wide offsets with the same values are equal.
+        t = ndt("var(offsets=[0,2]) * var(offsets=[0,3,10]) * int8")
+        u = ndt("int8", [[0, 2], [0, 3, 10]])
+        self.assertEqual(t, u)
+
+        # Overflow in the datasize.
+        self.assertRaises(ValueError, ndt, "var(offsets=[0,9223372036854775807]) * int64")
+
 
 class TestSymbolicDim(unittest.TestCase):
 
@@ -838,13 +859,37 @@ class TestCategorical(unittest.TestCase):
         check_serialize(self, t)
 
         self.assertEqual(t.ndim, 0)
-        if not HAVE_32_BIT_LINUX:
-            self.assertEqual(t.itemsize, 8)
-            self.assertEqual(t.align, 8)
+        self.assertEqual(t.itemsize, 1)
+        self.assertEqual(t.align, 1)
 
         self.assertRaises(TypeError, t, 'shape')
         self.assertRaises(TypeError, t, 'strides')
 
+        # The code width depends on the number of categories.
+        for n, size in [(256, 1), (257, 2), (65536, 2), (65537, 4)]:
+            t = ndt("categorical(%s)" % ", ".join(map(str, range(n))))
+            check_serialize(self, t)
+            self.assertEqual(t.itemsize, size)
+            self.assertEqual(t.align, size)
+
+        # Older versions used 8-byte codes.
+        t = ndt("categorical(NA, 'a', code_size=8)")
+        check_serialize(self, t)
+        self.assertEqual(t.itemsize, 8)
+        self.assertEqual(t.align, 8)
+        self.assertEqual(str(t), "categorical(NA, 'a', code_size=8)")
+        self.assertNotEqual(t, ndt("categorical(NA, 'a')"))
+        self.assertEqual(ndt("categorical(NA, 'a', code_size=1)"),
+                         ndt("categorical(NA, 'a')"))
+
+        self.assertRaises(ValueError, ndt, "categorical(1, 2, code_size=3)")
+        self.assertRaises(ValueError, ndt, "categorical(%s, code_size=1)" %
+                                           ", ".join(map(str, range(257))))
+        self.assertRaises(ValueError, ndt, "categorical(1, 2, size=8)")
+        self.assertRaises(ValueError, ndt, "categorical(1, 2, 1)")
+        self.assertRaises(ValueError, ndt, "categorical(NA, 'a', NA)")
+        self.assertRaises(ValueError, ndt, "categorical(0.0, -0.0)")
+
 
 class TestFixedStringKind(unittest.TestCase):
 
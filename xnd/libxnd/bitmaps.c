@@ -33,12 +33,19 @@
 
 #include <stdlib.h>
 #include <stdint.h>
+#include <string.h>
 #include <inttypes.h>
 #include <assert.h>
 #include "ndtypes.h"
 #include "xnd.h"
 
 
+#if defined(__GNUC__) && defined(__x86_64__)
+  #define XND_HAVE_SIMD
+  #include <immintrin.h>
+#endif
+
+
 const xnd_bitmap_t xnd_bitmap_empty = { .data = NULL, .size = 0, .next = NULL};
 
 
@@ -108,8 +115,7 @@ bitmap_init(xnd_bitmap_t *b, const ndt_t *t, int64_t nitems, ndt_context_t *ctx)
         n = nitems;
 
         if (t->ndim == 1) {
-            int32_t noffsets = t->Concrete.VarDim.noffsets;
-            n = t->Concrete.VarDim.offsets[noffsets-1];
+            n = ndt_var_offset(t, t->Concrete.VarDim.noffsets-1);
         }
 
         return bitmap_init(b, t->VarDim.type, n, ctx);
@@ -288,6 +294,7 @@ xnd_bitmap_next(const xnd_t *x, int64_t i, ndt_context_t *ctx)
     return x->bitmap.next[x->index * shape + i];
 }
 
+/* The index is non-negative, so shifts and masks replace division and modulo. */
 void
 xnd_set_valid(xnd_t *x)
 {
@@ -297,7 +304,7 @@ xnd_set_valid(xnd_t *x)
     assert(ndt_is_optional(t));
     assert(0 <= n);
 
-    x->bitmap.data[n / 8] |= ((uint8_t)1 << (n % 8));
+    x->bitmap.data[n >> 3] |= ((uint8_t)1 << (n & 7));
 }
 
 void
@@ -309,7 +316,7 @@ xnd_set_na(xnd_t *x)
     assert(ndt_is_optional(t));
     assert(0 <= n);
 
-    x->bitmap.data[n / 8] &= ~((uint8_t)1 << (n % 8));
+    x->bitmap.data[n >> 3] &= ~((uint8_t)1 << (n & 7));
 }
 
 static int
@@ -321,7 +328,7 @@ _xnd_is_valid(const xnd_t *x)
     assert(ndt_is_optional(t));
     assert(0 <= n);
 
-    return x->bitmap.data[n / 8] & ((uint8_t)1 << (n % 8));
+    return x->bitmap.data[n >> 3] & ((uint8_t)1 << (n & 7));
 }
 
 int
@@ -343,3 +350,447 @@ xnd_is_na(const xnd_t *x)
 
     return !_xnd_is_valid(x);
 }
+
+
+/*****************************************************************************/
+/*                           Bulk bitmap operations                          */
+/*****************************************************************************/
+
+/*
+ * The operations work on the bits [pos, pos+n) of a bitmap, where 'pos' is
+ * usually the linear index of the first element of a view.  Bit i is stored
+ * in byte i/8 at position i%8, so eight bytes assembled in little-endian order
+ * form a 64-bit word whose bit k is bit pos+k of the bitmap.  Word sized
+ * chunks of the ranges are extracted from and inserted at arbitrary bit
+ * offsets.  A NULL input bitmap belongs to a type without optional values
+ * and is all valid.
+ */
+
+static inline uint64_t
+load_le64(const uint8_t *p)
+{
+    return (uint64_t)p[0]       | (uint64_t)p[1] << 8  |
+           (uint64_t)p[2] << 16 | (uint64_t)p[3] << 24 |
+           (uint64_t)p[4] << 32 | (uint64_t)p[5] << 40 |
+           (uint64_t)p[6] << 48 | (uint64_t)p[7] << 56;
+}
+
+static inline void
+store_le64(uint8_t *p, uint64_t w)
+{
+    for (int i = 0; i < 8; i++) {
+        p[i] = (uint8_t)(w >> (8*i));
+    }
+}
+
+/* Return the n bits (1 <= n <= 64) starting at bit 'pos'. */
+static inline uint64_t
+load_bits(const uint8_t *data, int64_t pos, int n)
+{
+    const uint8_t *p = data + (pos >> 3);
+    const int shift = (int)(pos & 7);
+    const int nbytes = (shift + n + 7) >> 3;
+    uint64_t w;
+
+    if (nbytes >= 8) {
+        w = load_le64(p) >> shift;
+        if (nbytes > 8) {
+            w |= (uint64_t)p[8] << (64-shift);
+        }
+    }
+    else {
+        w = 0;
+        for (int i = 0; i < nbytes; i++) {
+            w |= (uint64_t)p[i] << (8*i);
+        }
+        w >>= shift;
+    }
+
+    return n < 64 ? w & (((uint64_t)1 << n) - 1) : w;
+}
+
+/* Store the low n bits (1 <= n <= 64) of 'w' at bit 'pos'. */
+static inline void
+store_bits(uint8_t *data, int64_t pos, int n, uint64_t w)
+{
+    uint8_t *p = data + (pos >> 3);
+    const int shift = (int)(pos & 7);
+    uint8_t mask;
+
+    if (shift == 0 && n == 64) {
+        store_le64(p, w);
+        return;
+    }
+
+    if (shift) {
+        const int m = n < 8-shift ? n : 8-shift;
+        mask = (uint8_t)(((1U << m) - 1) << shift);
+        *p = (uint8_t)((*p & ~mask) | ((w << shift) & mask));
+        w >>= m;
+        n -= m;
+        p++;
+    }
+
+    for (; n >= 8; n -= 8) {
+        *p++ = (uint8_t)w;
+        w >>= 8;
+    }
+
+    if (n > 0) {
+        mask = (uint8_t)((1U << n) - 1);
+        *p = (uint8_t)((*p & ~mask) | (w & mask));
+    }
+}
+
+static void
+set_range(uint8_t *data, int64_t pos, int64_t n, int valid)
+{
+    const uint64_t w = valid ? UINT64_MAX : 0;
+    const int shift = (int)(pos & 7);
+    int64_t nbytes;
+
+    if (n <= 0) {
+        return;
+    }
+
+    if (shift) {
+        const int m = n < 8-shift ? (int)n : 8-shift;
+        store_bits(data, pos, m, w);
+        pos += m;
+        n -= m;
+    }
+
+    nbytes = n >> 3;
+    memset(data + (pos >> 3), valid ? 0xff : 0, (size_t)nbytes);
+    pos += nbytes * 8;
+    n -= nbytes * 8;
+
+    if (n > 0) {
+        store_bits(data, pos, (int)n, w);
+    }
+}
+
+/* Mark the elements [pos, pos+n) as valid. */
+void
+xnd_bitmap_set_valid(uint8_t *data, int64_t pos, int64_t n)
+{
+    set_range(data, pos, n, 1);
+}
+
+/* Mark the elements [pos, pos+n) as missing. */
+void
+xnd_bitmap_set_na(uint8_t *data, int64_t pos, int64_t n)
+{
+    set_range(data, pos, n, 0);
+}
+
+
+/*****************************************************************************/
+/*                                 Popcount                                  */
+/*****************************************************************************/
+
+static inline int
+popcount64(uint64_t w)
+{
+#if defined(__GNUC__)
+    return __builtin_popcountll(w);
+#else
+    w = w - ((w >> 1) & 0x5555555555555555ULL);
+    w = (w & 0x3333333333333333ULL) + ((w >> 2) & 0x3333333333333333ULL);
+    w = (w + (w >> 4)) & 0x0f0f0f0f0f0f0f0fULL;
+    return (int)((w * 0x0101010101010101ULL) >> 56);
+#endif
+}
+
+static int64_t
+count_words(const uint8_t *p, int64_t nwords)
+{
+    int64_t count = 0;
+
+    for (int64_t i = 0; i < nwords; i++) {
+        count += popcount64(load_le64(p + 8*i));
+    }
+
+    return count;
+}
+
+#ifdef XND_HAVE_SIMD
+/* Without -mpopcnt gcc calls a library function for __builtin_popcountll. */
+#if defined(__clang__)
+  #pragma clang attribute push (__attribute__((target("popcnt"))), apply_to = function)
+#else
+  #pragma GCC push_options
+  #pragma GCC target("popcnt")
+#endif
+static int64_t
+count_words_popcnt(const uint8_t *p, int64_t nwords)
+{
+    int64_t c0 = 0, c1 = 0, c2 = 0, c3 = 0;
+    int64_t i;
+
+    for (i = 0; i+4 <= nwords; i += 4) {
+        c0 += __builtin_popcountll(load_le64(p + 8*i));
+        c1 += __builtin_popcountll(load_le64(p + 8*i + 8));
+        c2 += __builtin_popcountll(load_le64(p + 8*i + 16));
+        c3 += __builtin_popcountll(load_le64(p + 8*i + 24));
+    }
+    for (; i < nwords; i++) {
+        c0 += __builtin_popcountll(load_le64(p + 8*i));
+    }
+
+    return c0 + c1 + c2 + c3;
+}
+#if defined(__clang__)
+  #pragma clang attribute pop
+#else
+  #pragma GCC pop_options
+#endif
+#endif
+
+/*
+ * The CPU features are detected on first use.  Concurrent first calls store
+ * the same result, so relaxed atomic accesses are sufficient.
+ */
+#ifdef XND_HAVE_SIMD
+static int64_t (*count_words_func)(const uint8_t *, int64_t) = NULL;
+
+static int64_t
+count_words_dispatch(const uint8_t *p, int64_t nwords)
+{
+    int64_t (*f)(const uint8_t *, int64_t);
+
+    f = __atomic_load_n(&count_words_func, __ATOMIC_RELAXED);
+    if (f == NULL) {
+        __builtin_cpu_init();
+        f = __builtin_cpu_supports("popcnt") ? count_words_popcnt : count_words;
+        __atomic_store_n(&count_words_func, f, __ATOMIC_RELAXED);
+    }
+
+    return f(p, nwords);
+}
+#else
+static inline int64_t
+count_words_dispatch(const uint8_t *p, int64_t nwords)
+{
+    return count_words(p, nwords);
+}
+#endif
+
+/* Return the number of valid elements in [pos, pos+n). */
+int64_t
+xnd_bitmap_count_valid(const uint8_t *data, int64_t pos, int64_t n)
+{
+    const int shift = (int)(pos & 7);
+    int64_t count = 0;
+    int64_t nwords;
+
+    if (n <= 0) {
+        return 0;
+    }
+    if (data == NULL) {
+        return n;
+    }
+
+    if (shift) {
+        const int m = n < 8-shift ? (int)n : 8-shift;
+        count += popcount64(load_bits(data, pos, m));
+        pos += m;
+        n -= m;
+    }
+
+    nwords = n >> 6;
+    count += count_words_dispatch(data + (pos >> 3), nwords);
+    pos += nwords * 64;
+    n -= nwords * 64;
+
+    if (n > 0) {
+        count += popcount64(load_bits(data, pos, (int)n));
+    }
+
+    return count;
+}
+
+
+/*****************************************************************************/
+/*                            Logical operations                             */
+/*****************************************************************************/
+
+#define AND(a, b) ((a) & (b))
+#define OR(a, b) ((a) | (b))
+#define ANDNOT(a, b) ((a) & ~(b))
+
+#ifdef XND_HAVE_SIMD
+/* SSE2 is part of the x86-64 baseline. */
+#define BITMAP_BYTES_SSE2(name, OP, VOP) \
+static int64_t                                                                \
+name##_bytes_sse2(uint8_t *out, const uint8_t *a, const uint8_t *b,           \
+                  int64_t nbytes)                                             \
+{                                                                             \
+    int64_t i;                                                                \
+                                                                              \
+    for (i = 0; i+16 <= nbytes; i += 16) {                                    \
+        const __m128i x = _mm_loadu_si128((const __m128i *)(a+i));            \
+        const __m128i y = _mm_loadu_si128((const __m128i *)(b+i));            \
+        _mm_storeu_si128((__m128i *)(out+i), VOP);                            \
+    }                                                                         \
+    for (; i < nbytes; i++) {                                                 \
+        out[i] = (uint8_t)OP(a[i], b[i]);                                     \
+    }                                                                         \
+                                                                              \
+    return nbytes;                                                            \
+}
+
+BITMAP_BYTES_SSE2(and, AND, _mm_and_si128(x, y))
+BITMAP_BYTES_SSE2(or, OR, _mm_or_si128(x, y))
+BITMAP_BYTES_SSE2(andnot, ANDNOT, _mm_andnot_si128(y, x))
+
+#if defined(__clang__)
+  #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+  #pragma GCC push_options
+  #pragma GCC target("avx2")
+#endif
+#define BITMAP_BYTES_AVX2(name, OP, VOP) \
+static int64_t                                                                \
+name##_bytes_avx2(uint8_t *out, const uint8_t *a, const uint8_t *b,           \
+                  int64_t nbytes)                                             \
+{                                                                             \
+    int64_t i;                                                                \
+                                                                              \
+    for (i = 0; i+32 <= nbytes; i += 32) {                                    \
+        const __m256i x = _mm256_loadu_si256((const __m256i *)(a+i));         \
+        const __m256i y = _mm256_loadu_si256((const __m256i *)(b+i));         \
+        _mm256_storeu_si256((__m256i *)(out+i), VOP);                         \
+    }                                                                         \
+    for (; i < nbytes; i++) {                                                 \
+        out[i] = (uint8_t)OP(a[i], b[i]);                                     \
+    }                                                                         \
+                                                                              \
+    return nbytes;                                                            \
+}
+
+BITMAP_BYTES_AVX2(and, AND, _mm256_and_si256(x, y))
+BITMAP_BYTES_AVX2(or, OR, _mm256_or_si256(x, y))
+BITMAP_BYTES_AVX2(andnot, ANDNOT, _mm256_andnot_si256(y, x))
+#if defined(__clang__)
+  #pragma clang attribute pop
+#else
+  #pragma GCC pop_options
+#endif
+
+static int have_avx2 = -1;
+
+static inline int
+use_avx2(void)
+{
+    int avx2 = __atomic_load_n(&have_avx2, __ATOMIC_RELAXED);
+
+    if (avx2 < 0) {
+        __builtin_cpu_init();
+        avx2 = __builtin_cpu_supports("avx2") ? 1 : 0;
+        __atomic_store_n(&have_avx2, avx2, __ATOMIC_RELAXED);
+    }
+
+    return avx2;
+}
+
+#define BITMAP_BYTES(name, OP) \
+static inline int64_t                                                         \
+name##_bytes(uint8_t *out, const uint8_t *a, const uint8_t *b, int64_t nbytes)\
+{                                                                             \
+    if (use_avx2()) {                                                         \
+        return name##_bytes_avx2(out, a, b, nbytes);                          \
+    }                                                                         \
+    return name##_bytes_sse2(out, a, b, nbytes);                              \
+}
+#else
+#define BITMAP_BYTES(name, OP) \
+static inline int64_t                                                         \
+name##_bytes(uint8_t *out, const uint8_t *a, const uint8_t *b, int64_t nbytes)\
+{                                                                             \
+    for (int64_t i = 0; i < nbytes; i++) {                                    \
+        out[i] = (uint8_t)OP(a[i], b[i]);                                     \
+    }                                                                         \
+                                                                              \
+    return nbytes;                                                            \
+}
+#endif /* XND_HAVE_SIMD */
+
+/*
+ * out[opos:opos+n] = OP(a[apos:apos+n], b[bpos:bpos+n]).  If all ranges
+ * start on a byte boundary, the full bytes are combined directly.  'out' may
+ * be the same range as one of the inputs, but must not overlap them otherwise.
+ */
+#define BITMAP_BINARY(name, OP) \
+BITMAP_BYTES(name, OP)                                                        \
+                                                                              \
+void                                                                          \
+xnd_bitmap_##name(uint8_t *out, int64_t opos,                                 \
+                  const uint8_t *a, int64_t apos,                             \
+                  const uint8_t *b, int64_t bpos,                             \
+                  int64_t n)                                                  \
+{                                                                             \
+    int64_t k = 0;                                                            \
+                                                                              \
+    if (a != NULL && b != NULL &&                                             \
+        (opos & 7) == 0 && (apos & 7) == 0 && (bpos & 7) == 0) {              \
+        k = 8 * name##_bytes(out+(opos>>3), a+(apos>>3), b+(bpos>>3), n>>3);  \
+    }                                                                         \
+                                                                              \
+    for (; k < n; k += 64) {                                                  \
+        const int m = n-k < 64 ? (int)(n-k) : 64;                             \
+        const uint64_t x = a ? load_bits(a, apos+k, m) : UINT64_MAX;          \
+        const uint64_t y = b ? load_bits(b, bpos+k, m) : UINT64_MAX;          \
+        store_bits(out, opos+k, m, OP(x, y));                                 \
+    }                                                                         \
+}
+
+BITMAP_BINARY(and, AND)
+BITMAP_BINARY(or, OR)
+BITMAP_BINARY(andnot, ANDNOT)
+
+
+/*****************************************************************************/
+/*                                Iteration                                  */
+/*****************************************************************************/
+
+static inline int
+ctz64(uint64_t w)
+{
+#if defined(__GNUC__)
+    return __builtin_ctzll(w);
+#else
+    int n = 0;
+    while ((w & 1) == 0) {
+        w >>= 1;
+        n++;
+    }
+    return n;
+#endif
+}
+
+/*
+ * Return the position of the first valid element in [pos, end) or 'end'.
+ * The valid elements are visited by:
+ *
+ *   for (i = xnd_bitmap_next_valid(data, pos, end); i < end;
+ *        i = xnd_bitmap_next_valid(data, i+1, end))
+ */
+int64_t
+xnd_bitmap_next_valid(const uint8_t *data, int64_t pos, int64_t end)
+{
+    if (data == NULL) {
+        return pos < end ? pos : end;
+    }
+
+    while (pos < end) {
+        const int m = end-pos < 64 ? (int)(end-pos) : 64;
+        const uint64_t w = load_bits(data, pos, m);
+        if (w != 0) {
+            return pos + ctz64(w);
+        }
+        pos += m;
+    }
+
+    return end;
+}
@@ -0,0 +1,137 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+#include <assert.h>
+#include "ndtypes.h"
+#include "xnd.h"
+
+
+/*****************************************************************************/
+/*                        Categorical codes and values                       */
+/*****************************************************************************/
+
+/*
+ * Categorical values are stored as the number of the category.  The width of
+ * the code is the datasize of the type: types created by ndt_categorical()
+ * use the smallest unsigned integer that can hold all category numbers.
+ */
+
+int64_t
+xnd_categorical_code(const xnd_t *x)
+{
+    const ndt_t * const t = x->type;
+    int64_t code;
+
+    assert(t->tag == Categorical);
+
+    switch (t->datasize) {
+    case 1: UNPACK_SINGLE(code, x->ptr, uint8_t, t->flags); break;
+    case 2: UNPACK_SINGLE(code, x->ptr, uint16_t, t->flags); break;
+    case 4: UNPACK_SINGLE(code, x->ptr, uint32_t, t->flags); break;
+    default: UNPACK_SINGLE(code, x->ptr, int64_t, t->flags); break;
+    }
+
+    return code;
+}
+
+void
+xnd_categorical_set_code(xnd_t *x, int64_t code)
+{
+    const ndt_t * const t = x->type;
+
+    assert(t->tag == Categorical);
+    assert(0 <= code && code < t->Categorical.ntypes);
+
+    switch (t->datasize) {
+    case 1: PACK_SINGLE(x->ptr, code, uint8_t, t->flags); break;
+    case 2: PACK_SINGLE(x->ptr, code, uint16_t, t->flags); break;
+    case 4: PACK_SINGLE(x->ptr, code, uint32_t, t->flags); break;
+    default: PACK_SINGLE(x->ptr, code, int64_t, t->flags); break;
+    }
+}
+
+/*
+ * Store the code of 'v'.  If 'v' is not a category, the NA category is used
+ * if the type has one.  Return the code or -1 on error.
+ */
+int64_t
+xnd_categorical_encode(xnd_t *x, const ndt_value_t *v, ndt_context_t *ctx)
+{
+    const ndt_t * const t = x->type;
+    const ndt_value_t na = { .tag = ValNA };
+    int64_t code;
+
+    if (t->tag != Categorical) {
+        ndt_err_format(ctx, NDT_TypeError, "expected categorical type");
+        return -1;
+    }
+
+    code = ndt_categorical_lookup(t, v);
+    if (code < 0) {
+        code = ndt_categorical_lookup(t, &na);
+        if (code < 0) {
+            ndt_err_format(ctx, NDT_ValueError, "category not found");
+            return -1;
+        }
+    }
+
+    xnd_categorical_set_code(x, code);
+    return code;
+}
+
+/* Return the category of the stored code or NULL on error. */
+const ndt_value_t *
+xnd_categorical_decode(const xnd_t *x, ndt_context_t *ctx)
+{
+    const ndt_t * const t = x->type;
+    int64_t code;
+
+    if (t->tag != Categorical) {
+        ndt_err_format(ctx, NDT_TypeError, "expected categorical type");
+        return NULL;
+    }
+
+    code = xnd_categorical_code(x);
+    if (code < 0 || code >= t->Categorical.ntypes) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "categorical code out of range: %" PRIi64, code);
+        return NULL;
+    }
+
+    return &t->Categorical.types[code];
+}
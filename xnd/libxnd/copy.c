@@ -61,6 +61,15 @@ value_error(ndt_context_t *ctx)
     return -1;
 }
 
+/* Payloads of master buffers with a string heap must be allocated in the heap. */
+static int
+heap_error(ndt_context_t *ctx)
+{
+    ndt_err_format(ctx, NDT_NotImplementedError,
+        "cannot copy string or bytes values to a master buffer with a string heap");
+    return -1;
+}
+
 /* Skip all ref chains. */
 static int
 copy_ref(xnd_t *y, const xnd_t *x, const uint32_t flags, ndt_context_t *ctx)
@@ -565,24 +574,167 @@ copy_complex128(xnd_t * const x, const double real, const double imag,
     }
 }
 
-int
-xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
+/*****************************************************************************/
+/*                              Block copies                                 */
+/*****************************************************************************/
+
+/* Return true if the dtypes have the same memory layout and no pointers. */
+static bool
+same_plain_dtype(const ndt_t *t, const ndt_t *u)
 {
-    const ndt_t * const t = x->type;
-    const ndt_t * const u = y->type;
-    int n;
+    if (t->tag != u->tag || t->datasize != u->datasize) {
+        return false;
+    }
 
-    if (xnd_is_na(x)) {
-        if (!ndt_is_optional(u)) {
-            ndt_err_format(ctx, NDT_TypeError,
-                "cannot copy NA to destination with non-optional type");
-            return -1;
+    switch (t->tag) {
+    case Bool:
+    case Int8: case Uint8:
+    case Int16: case Int32: case Int64:
+    case Uint16: case Uint32: case Uint64:
+    case Float16: case Float32: case Float64:
+    case Complex32: case Complex64: case Complex128:
+        return t->datasize == 1 || le(t->flags) == le(u->flags);
+    case FixedString:
+        return t->FixedString.encoding == u->FixedString.encoding &&
+               (t->datasize == t->FixedString.size ||
+                le(t->flags) == le(u->flags));
+    case FixedBytes:
+        return true;
+    default:
+        return false;
+    }
+}
+
+/* Copy n elements of a plain dtype, including the validity bits. */
+static inline void
+copy_block(xnd_t *y, int64_t yindex, const xnd_t *x, int64_t xindex,
+           int64_t n, int64_t itemsize)
+{
+    memcpy(y->ptr + yindex * itemsize, x->ptr + xindex * itemsize,
+           (size_t)(n * itemsize));
+
+    if (y->bitmap.data != NULL) {
+        xnd_bitmap_and(y->bitmap.data, yindex, x->bitmap.data, xindex,
+                       NULL, 0, n);
+    }
+}
+
+/*
+ * Return true if the elements of 'x' and 'y' that start at the linear indices
+ * 'xindex' and 'yindex' and have the given shape and steps share memory.
+ */
+static bool
+blocks_overlap(const xnd_t *y, int64_t yindex, const int64_t ysteps[],
+               const xnd_t *x, int64_t xindex, const int64_t xsteps[],
+               const int64_t shape[], int ndim, int64_t itemsize)
+{
+    int64_t xlo = xindex, xhi = xindex;
+    int64_t ylo = yindex, yhi = yindex;
+    int d;
+
+    for (d = 0; d < ndim; d++) {
+        const int64_t xext = (shape[d]-1) * xsteps[d];
+        const int64_t yext = (shape[d]-1) * ysteps[d];
+        if (xext < 0) xlo += xext; else xhi += xext;
+        if (yext < 0) ylo += yext; else yhi += yext;
+    }
+
+    return x->ptr + xlo * itemsize < y->ptr + (yhi+1) * itemsize &&
+           y->ptr + ylo * itemsize < x->ptr + (xhi+1) * itemsize;
+}
+
+/*
+ * Copy fixed arrays with the same shape and the same plain dtype in blocks.
+ * The innermost dimensions that are contiguous in both arrays are copied with
+ * memcpy(), the remaining outer dimensions are traversed.  Missing values are
+ * only handled if the destination has an optional dtype, otherwise the
+ * regular path reports the error.  Overlapping arrays are copied element by
+ * element.  Return 1 if the copy has been done and 0 if the fast path does
+ * not apply.
+ */
+static int
+copy_fixed_blocks(xnd_t *y, const xnd_t *x)
+{
+    const ndt_t *t = x->type;
+    const ndt_t *u = y->type;
+    int64_t shape[NDT_MAX_DIM], xsteps[NDT_MAX_DIM], ysteps[NDT_MAX_DIM];
+    int64_t idx[NDT_MAX_DIM];
+    int64_t block, itemsize, xindex, yindex;
+    int ndim, outer, d;
+
+    for (ndim = 0; t->tag == FixedDim; ndim++) {
+        if (u->tag != FixedDim || u->FixedDim.shape != t->FixedDim.shape ||
+            ndt_is_optional(t) || ndt_is_optional(u)) {
+            return 0;
+        }
+        if (t->FixedDim.shape == 0) {
+            return 0;
         }
+        shape[ndim] = t->FixedDim.shape;
+        xsteps[ndim] = t->Concrete.FixedDim.step;
+        ysteps[ndim] = u->Concrete.FixedDim.step;
+        t = t->FixedDim.type;
+        u = u->FixedDim.type;
+    }
 
-        xnd_set_na(y);
+    if (u->ndim != 0 || !same_plain_dtype(t, u) ||
+        (ndt_is_optional(t) && !ndt_is_optional(u))) {
+        return 0;
+    }
+    itemsize = t->datasize;
+
+    if (blocks_overlap(y, y->index, ysteps, x, x->index, xsteps, shape, ndim,
+                       itemsize)) {
         return 0;
     }
 
+    block = 1;
+    for (outer = ndim; outer > 0; outer--) {
+        if (xsteps[outer-1] != block || ysteps[outer-1] != block) {
+            break;
+        }
+        block *= shape[outer-1];
+    }
+
+    xindex = x->index;
+    yindex = y->index;
+    for (d = 0; d < outer; d++) {
+        idx[d] = 0;
+    }
+
+    for (;;) {
+        copy_block(y, yindex, x, xindex, block, itemsize);
+
+        for (d = outer-1; d >= 0; d--) {
+            xindex += xsteps[d];
+            yindex += ysteps[d];
+            if (++idx[d] < shape[d]) {
+                break;
+            }
+            xindex -= shape[d] * xsteps[d];
+            yindex -= shape[d] * ysteps[d];
+            idx[d] = 0;
+        }
+
+        if (d < 0) {
+            return 1;
+        }
+    }
+}
+
+
+/*****************************************************************************/
+/*                                   Copy                                    */
+/*****************************************************************************/
+
+/* Copy a valid value, the validity bit of 'y' is set by the caller. */
+static int
+copy_value(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
+{
+    const ndt_t * const t = x->type;
+    const ndt_t * const u = y->type;
+    int n;
+
     if (t->tag == Ref || u->tag == Ref) {
         return copy_ref(y, x, flags, ctx);
     }
@@ -595,6 +747,10 @@ xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
             return 0;
         }
 
+        if (copy_fixed_blocks(y, x)) {
+            return 0;
+        }
+
         for (i = 0; i < t->FixedDim.shape; i++) {
             const xnd_t xnext = xnd_fixed_dim_next(x, i);
             xnd_t ynext = xnd_fixed_dim_next(y, i);
@@ -628,6 +784,16 @@ xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
             return type_error(ctx);
         }
 
+        /* The innermost dimension of unsliced var arrays is contiguous. */
+        if (t->ndim == 1 && u->ndim == 1 && xstep == 1 && ystep == 1 &&
+            same_plain_dtype(t->VarDim.type, u->VarDim.type) &&
+            (!ndt_is_optional(t->VarDim.type) || ndt_is_optional(u->VarDim.type)) &&
+            !blocks_overlap(y, ystart, &ystep, x, xstart, &xstep, &xshape, 1,
+                            t->VarDim.type->datasize)) {
+            copy_block(y, ystart, x, xstart, xshape, t->VarDim.type->datasize);
+            return 0;
+        }
+
         for (i = 0; i < xshape; i++) {
             const xnd_t xnext = xnd_var_dim_next(x, xstart, xstep, i);
             xnd_t ynext = xnd_var_dim_next(y, ystart, ystep, i);
@@ -729,14 +895,19 @@ xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
     }
 
     case Categorical: {
-        int64_t i64;
+        int64_t code;
 
-        if (!ndt_equal(t, u)) {
+        if (!ndt_categories_equal(t, u)) {
             return type_error(ctx);
         }
 
-        UNPACK_SINGLE(i64, x->ptr, int64_t, t->flags);
-        PACK_SINGLE(y->ptr, i64, int64_t, u->flags);
+        /* The code widths differ if one of the types has legacy codes. */
+        code = xnd_categorical_code(x);
+        if (code < 0 || code >= u->Categorical.ntypes) {
+            return value_error(ctx);
+        }
+
+        xnd_categorical_set_code(y, code);
         return 0;
     }
 
@@ -875,6 +1046,10 @@ xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
             return type_error(ctx);
         }
 
+        if (flags & XND_STRING_HEAP) {
+            return heap_error(ctx);
+        }
+
         s = ndt_strdup(XND_POINTER_DATA(x->ptr), ctx);
         if (s == NULL) {
             return -1;
@@ -902,6 +1077,10 @@ xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
             return type_error(ctx);
         }
 
+        if (flags & XND_STRING_HEAP) {
+            return heap_error(ctx);
+        }
+
         size = XND_BYTES_SIZE(x->ptr);
 
         s = ndt_aligned_calloc(u->Bytes.target_align, size);
@@ -942,3 +1121,31 @@ xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
     ndt_err_format(ctx, NDT_RuntimeError, "invalid type tag");
     return -1;
 }
+
+int
+xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx)
+{
+    const ndt_t * const u = y->type;
+
+    if (xnd_is_na(x)) {
+        if (!ndt_is_optional(u)) {
+            ndt_err_format(ctx, NDT_TypeError,
+                "cannot copy NA to destination with non-optional type");
+            return -1;
+        }
+
+        xnd_set_na(y);
+        return 0;
+    }
+
+    /* A failed copy leaves the validity bit unchanged. */
+    if (copy_value(y, x, flags, ctx) < 0) {
+        return -1;
+    }
+
+    if (u->ndim == 0 && ndt_is_optional(u)) {
+        xnd_set_valid(y);
+    }
+
+    return 0;
+}
@@ -41,6 +41,285 @@
 #include "contrib.h"
 
 
+#if defined(__GNUC__) && defined(__x86_64__)
+  #define XND_HAVE_SIMD
+  #include <emmintrin.h>
+#endif
+
+
+/*****************************************************************************/
+/*                             Block comparisons                             */
+/*****************************************************************************/
+
+/* Number of elements that are compared before checking for a mismatch. */
+#define CMP_CHUNK 1024
+
+enum cmp_kind { CMP_NONE, CMP_BYTES, CMP_FLOAT32, CMP_FLOAT64 };
+
+static inline bool
+native(uint32_t flags)
+{
+    return !(flags & XND_REV_COND);
+}
+
+/*
+ * Determine how blocks of elements of the plain dtypes t and u can be
+ * compared.  Integers and fixed strings/bytes are equal iff their memory is
+ * equal.  Floating point values must be compared as numbers (NaN != NaN,
+ * -0.0 == 0.0), which is only done for IEEE floats in native byte order.
+ * Complex numbers are compared as pairs of floats.  Both equality functions
+ * compare operands with identical dtypes in the same way, so the result is
+ * valid for both.
+ */
+static enum cmp_kind
+cmp_kind(const ndt_t *t, const ndt_t *u)
+{
+    if (t->tag != u->tag || t->datasize != u->datasize) {
+        return CMP_NONE;
+    }
+
+    switch (t->tag) {
+    case Int8: case Uint8:
+        return CMP_BYTES;
+    case Int16: case Int32: case Int64:
+    case Uint16: case Uint32: case Uint64:
+        return le(t->flags) == le(u->flags) ? CMP_BYTES : CMP_NONE;
+    case Float32: case Complex64:
+        if (native(t->flags) && native(u->flags) &&
+            (xnd_float_is_little_endian() || xnd_float_is_big_endian())) {
+            return CMP_FLOAT32;
+        }
+        return CMP_NONE;
+    case Float64: case Complex128:
+        if (native(t->flags) && native(u->flags) &&
+            (xnd_double_is_little_endian() || xnd_double_is_big_endian())) {
+            return CMP_FLOAT64;
+        }
+        return CMP_NONE;
+    case FixedString:
+        if (t->FixedString.size != u->FixedString.size ||
+            t->FixedString.encoding != u->FixedString.encoding) {
+            return CMP_NONE;
+        }
+        return CMP_BYTES;
+    case FixedBytes:
+        if (t->FixedBytes.size != u->FixedBytes.size) {
+            return CMP_NONE;
+        }
+        return CMP_BYTES;
+    default:
+        return CMP_NONE;
+    }
+}
+
+static bool
+float32_equal(const char *a, const char *b, int64_t n)
+{
+    int64_t i = 0;
+    float p, q;
+
+#ifdef XND_HAVE_SIMD
+    for (; i+8 <= n; i += 8) {
+        __m128 e0 = _mm_cmpeq_ps(_mm_loadu_ps((const float *)a + i),
+                                 _mm_loadu_ps((const float *)b + i));
+        __m128 e1 = _mm_cmpeq_ps(_mm_loadu_ps((const float *)a + i + 4),
+                                 _mm_loadu_ps((const float *)b + i + 4));
+        if (_mm_movemask_ps(_mm_and_ps(e0, e1)) != 0xf) {
+            return false;
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        memcpy(&p, a + i * (int64_t)sizeof p, sizeof p);
+        memcpy(&q, b + i * (int64_t)sizeof q, sizeof q);
+        if (!(p == q)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool
+float64_equal(const char *a, const char *b, int64_t n)
+{
+    int64_t i = 0;
+    double p, q;
+
+#ifdef XND_HAVE_SIMD
+    for (; i+4 <= n; i += 4) {
+        __m128d e0 = _mm_cmpeq_pd(_mm_loadu_pd((const double *)a + i),
+                                  _mm_loadu_pd((const double *)b + i));
+        __m128d e1 = _mm_cmpeq_pd(_mm_loadu_pd((const double *)a + i + 2),
+                                  _mm_loadu_pd((const double *)b + i + 2));
+        if (_mm_movemask_pd(_mm_and_pd(e0, e1)) != 0x3) {
+            return false;
+        }
+    }
+#endif
+
+    for (; i < n; i++) {
+        memcpy(&p, a + i * (int64_t)sizeof p, sizeof p);
+        memcpy(&q, b + i * (int64_t)sizeof q, sizeof q);
+        if (!(p == q)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+/*
+ * Compare n contiguous elements starting at xindex and yindex.  Missing
+ * values compare unequal, like in the element-wise functions.
+ */
+static bool
+block_equal(const xnd_t *x, int64_t xindex, const xnd_t *y, int64_t yindex,
+            int64_t n, enum cmp_kind kind, int64_t itemsize)
+{
+    const char *a = x->ptr + xindex * itemsize;
+    const char *b = y->ptr + yindex * itemsize;
+    int64_t i, m;
+
+    if (xnd_bitmap_count_valid(x->bitmap.data, xindex, n) != n ||
+        xnd_bitmap_count_valid(y->bitmap.data, yindex, n) != n) {
+        return false;
+    }
+
+    for (i = 0; i < n; i += m) {
+        m = n-i < CMP_CHUNK ? n-i : CMP_CHUNK;
+
+        switch (kind) {
+        case CMP_BYTES:
+            if (memcmp(a, b, (size_t)(m * itemsize)) != 0) {
+                return false;
+            }
+            break;
+        case CMP_FLOAT32:
+            if (!float32_equal(a, b, m * itemsize / 4)) {
+                return false;
+            }
+            break;
+        case CMP_FLOAT64:
+            if (!float64_equal(a, b, m * itemsize / 8)) {
+                return false;
+            }
+            break;
+        case CMP_NONE:
+            abort(); /* NOT REACHED */
+        }
+
+        a += m * itemsize;
+        b += m * itemsize;
+    }
+
+    return true;
+}
+
+/*
+ * Compare fixed arrays with the same shape and the same plain dtype in
+ * blocks.  The innermost dimensions that are contiguous in both arrays are
+ * compared in one pass, the remaining outer dimensions are traversed.  Return
+ * false if the fast path does not apply, otherwise store the result in *eq.
+ */
+static bool
+fixed_blocks_equal(int *eq, const xnd_t *x, const xnd_t *y)
+{
+    const ndt_t *t = x->type;
+    const ndt_t *u = y->type;
+    int64_t shape[NDT_MAX_DIM], xsteps[NDT_MAX_DIM], ysteps[NDT_MAX_DIM];
+    int64_t idx[NDT_MAX_DIM];
+    int64_t block, xindex, yindex;
+    enum cmp_kind kind;
+    int ndim, outer, d;
+
+    for (ndim = 0; t->tag == FixedDim; ndim++) {
+        if (u->tag != FixedDim || u->FixedDim.shape != t->FixedDim.shape ||
+            ndt_is_optional(t) || ndt_is_optional(u)) {
+            return false;
+        }
+        if (t->FixedDim.shape == 0) {
+            return false;
+        }
+        shape[ndim] = t->FixedDim.shape;
+        xsteps[ndim] = t->Concrete.FixedDim.step;
+        ysteps[ndim] = u->Concrete.FixedDim.step;
+        t = t->FixedDim.type;
+        u = u->FixedDim.type;
+    }
+
+    if (u->ndim != 0) {
+        return false;
+    }
+
+    kind = cmp_kind(t, u);
+    if (kind == CMP_NONE) {
+        return false;
+    }
+
+    block = 1;
+    for (outer = ndim; outer > 0; outer--) {
+        if (xsteps[outer-1] != block || ysteps[outer-1] != block) {
+            break;
+        }
+        block *= shape[outer-1];
+    }
+
+    xindex = x->index;
+    yindex = y->index;
+    for (d = 0; d < outer; d++) {
+        idx[d] = 0;
+    }
+
+    for (;;) {
+        if (!block_equal(x, xindex, y, yindex, block, kind, t->datasize)) {
+            *eq = 0;
+            return true;
+        }
+
+        for (d = outer-1; d >= 0; d--) {
+            xindex += xsteps[d];
+            yindex += ysteps[d];
+            if (++idx[d] < shape[d]) {
+                break;
+            }
+            xindex -= shape[d] * xsteps[d];
+            yindex -= shape[d] * ysteps[d];
+            idx[d] = 0;
+        }
+
+        if (d < 0) {
+            *eq = 1;
+            return true;
+        }
+    }
+}
+
+/* The innermost dimension of unsliced var arrays is contiguous. */
+static bool
+var_block_equal(int *eq, const xnd_t *x, int64_t xstart, int64_t xstep,
+                const xnd_t *y, int64_t ystart, int64_t ystep, int64_t shape)
+{
+    const ndt_t *t = x->type;
+    const ndt_t *u = y->type;
+    enum cmp_kind kind;
+
+    if (t->ndim != 1 || u->ndim != 1 || xstep != 1 || ystep != 1) {
+        return false;
+    }
+
+    kind = cmp_kind(t->VarDim.type, u->VarDim.type);
+    if (kind == CMP_NONE) {
+        return false;
+    }
+
+    *eq = block_equal(x, xstart, y, ystart, shape, kind,
+                      t->VarDim.type->datasize);
+    return true;
+}
+
+
 /*****************************************************************************/
 /*                      Equality with strict type checking                   */
 /*****************************************************************************/
@@ -72,6 +351,10 @@ xnd_strict_equal(const xnd_t *x, const xnd_t *y, ndt_context_t *ctx)
             return 0;
         }
 
+        if (fixed_blocks_equal(&n, x, y)) {
+            return n;
+        }
+
         for (i = 0; i < t->FixedDim.shape; i++) {
             const xnd_t xnext = xnd_fixed_dim_next(x, i);
             const xnd_t ynext = xnd_fixed_dim_next(y, i);
@@ -101,6 +384,10 @@ xnd_strict_equal(const xnd_t *x, const xnd_t *y, ndt_context_t *ctx)
             return 0;
         }
 
+        if (var_block_equal(&n, x, xstart, xstep, y, ystart, ystep, xshape)) {
+            return n;
+        }
+
         for (i = 0; i < xshape; i++) {
             const xnd_t xnext = xnd_var_dim_next(x, xstart, xstep, i);
             const xnd_t ynext = xnd_var_dim_next(y, ystart, ystep, i);
@@ -214,14 +501,15 @@ xnd_strict_equal(const xnd_t *x, const xnd_t *y, ndt_context_t *ctx)
     case Categorical: {
         int64_t i, k;
 
-        if (!ndt_equal(t, u)) {
+        if (!ndt_categories_equal(t, u)) {
             return 0;
         }
 
-        UNPACK_SINGLE(i, x->ptr, int64_t, t->flags);
-        UNPACK_SINGLE(k, y->ptr, int64_t, u->flags);
+        i = xnd_categorical_code(x);
+        k = xnd_categorical_code(y);
 
-        if (t->Categorical.types[i].tag == ValNA) {
+        if (i < 0 || i >= t->Categorical.ntypes ||
+            t->Categorical.types[i].tag == ValNA) {
             return 0;
         }
 
@@ -879,6 +1167,10 @@ xnd_equal(const xnd_t *x, const xnd_t *y, ndt_context_t *ctx)
             return 0;
         }
 
+        if (fixed_blocks_equal(&n, x, y)) {
+            return n;
+        }
+
         for (i = 0; i < t->FixedDim.shape; i++) {
             const xnd_t xnext = xnd_fixed_dim_next(x, i);
             const xnd_t ynext = xnd_fixed_dim_next(y, i);
@@ -912,6 +1204,10 @@ xnd_equal(const xnd_t *x, const xnd_t *y, ndt_context_t *ctx)
             return 0;
         }
 
+        if (var_block_equal(&n, x, xstart, xstep, y, ystart, ystep, xshape)) {
+            return n;
+        }
+
         for (i = 0; i < xshape; i++) {
             const xnd_t xnext = xnd_var_dim_next(x, xstart, xstep, i);
             const xnd_t ynext = xnd_var_dim_next(y, ystart, ystep, i);
@@ -1015,14 +1311,15 @@ xnd_equal(const xnd_t *x, const xnd_t *y, ndt_context_t *ctx)
     case Categorical: {
         int64_t i, k;
 
-        if (!ndt_equal(t, u)) {
+        if (!ndt_categories_equal(t, u)) {
             return 0;
         }
 
-        UNPACK_SINGLE(i, x->ptr, int64_t, t->flags);
-        UNPACK_SINGLE(k, y->ptr, int64_t, u->flags);
+        i = xnd_categorical_code(x);
+        k = xnd_categorical_code(y);
 
-        if (t->Categorical.types[i].tag == ValNA) {
+        if (i < 0 || i >= t->Categorical.ntypes ||
+            t->Categorical.types[i].tag == ValNA) {
             return 0;
         }
 
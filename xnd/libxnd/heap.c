@@ -0,0 +1,223 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "ndtypes.h"
+#include "xnd.h"
+#include "heap.h"
+
+
+/*****************************************************************************/
+/*                                 Chunks                                    */
+/*****************************************************************************/
+
+#define HEAP_MIN_CHUNK 4096
+#define HEAP_MAX_CHUNK 16777216
+
+struct xnd_heap_chunk {
+    xnd_heap_chunk_t *next;
+    alignas(MAX_ALIGN) char data[];
+};
+
+static void
+heap_init(xnd_heap_t *heap)
+{
+    heap->ptr = NULL;
+    heap->end = NULL;
+    heap->chunk_size = HEAP_MIN_CHUNK;
+    heap->chunks = NULL;
+}
+
+static void
+heap_clear(xnd_heap_t *heap)
+{
+    xnd_heap_chunk_t *chunk, *next;
+
+    for (chunk = heap->chunks; chunk != NULL; chunk = next) {
+        next = chunk->next;
+        ndt_free(chunk);
+    }
+
+    heap_init(heap);
+}
+
+/* Return 'n' bytes aligned to 'align' (a power of two). */
+static char *
+heap_alloc(xnd_heap_t *heap, int64_t n, int64_t align, ndt_context_t *ctx)
+{
+    xnd_heap_chunk_t *chunk;
+    int64_t size;
+    uintptr_t p;
+
+    assert(n >= 0 && align >= 1 && (align & (align-1)) == 0);
+
+    if (heap->ptr != NULL) {
+        p = ((uintptr_t)heap->ptr + (uintptr_t)align - 1) & ~((uintptr_t)align - 1);
+        if (n <= heap->end - (char *)p) {
+            heap->ptr = (char *)p + n;
+            return (char *)p;
+        }
+    }
+
+    if (n > INT64_MAX - align) {
+        ndt_err_format(ctx, NDT_ValueError, "string heap: size too large");
+        return NULL;
+    }
+
+    size = n + align - 1;
+    if (size < heap->chunk_size) {
+        size = heap->chunk_size;
+    }
+    if ((uint64_t)size > SIZE_MAX - sizeof *chunk) {
+        ndt_err_format(ctx, NDT_ValueError, "string heap: size too large");
+        return NULL;
+    }
+
+    chunk = ndt_alloc_size(sizeof *chunk + (size_t)size);
+    if (chunk == NULL) {
+        (void)ndt_memory_error(ctx);
+        return NULL;
+    }
+
+    chunk->next = heap->chunks;
+    heap->chunks = chunk;
+    heap->end = chunk->data + size;
+
+    if (heap->chunk_size < HEAP_MAX_CHUNK) {
+        heap->chunk_size *= 2;
+    }
+
+    p = ((uintptr_t)chunk->data + (uintptr_t)align - 1) & ~((uintptr_t)align - 1);
+    heap->ptr = (char *)p + n;
+    return (char *)p;
+}
+
+
+/*****************************************************************************/
+/*                              Heap masters                                 */
+/*****************************************************************************/
+
+xnd_master_t *
+xnd_heap_master_new(ndt_context_t *ctx)
+{
+    xnd_heap_master_t *m;
+
+    m = ndt_alloc(1, sizeof *m);
+    if (m == NULL) {
+        return ndt_memory_error(ctx);
+    }
+    heap_init(&m->heap);
+
+    return &m->x;
+}
+
+/* The payloads are not freed individually. */
+void
+xnd_heap_del(xnd_master_t *x)
+{
+    xnd_heap_master_t *m = (xnd_heap_master_t *)x;
+    const uint32_t flags = x->flags & ~(XND_OWN_STRINGS|XND_OWN_BYTES);
+
+    assert(x->flags & XND_STRING_HEAP);
+
+    xnd_del_buffer(&x->master, flags);
+    heap_clear(&m->heap);
+    ndt_free(m);
+}
+
+/* Return the heap of 'x' or NULL if 'x' does not have the XND_STRING_HEAP flag. */
+xnd_heap_t *
+xnd_heap(const xnd_master_t *x)
+{
+    if (!(x->flags & XND_STRING_HEAP)) {
+        return NULL;
+    }
+
+    return &((xnd_heap_master_t *)x)->heap;
+}
+
+/*
+ * Copy 'size' bytes of UTF-8 data to the heap.  Like all strings, the result
+ * ends at the first NUL byte.  It is preceded by its size, see
+ * XND_HEAP_STRING_SIZE().
+ */
+char *
+xnd_heap_string(xnd_heap_t *heap, const char *s, int64_t size,
+                ndt_context_t *ctx)
+{
+    const char *nul;
+    char *p;
+
+    nul = memchr(s, '\0', (size_t)size);
+    if (nul != NULL) {
+        size = nul - s;
+    }
+
+    if (size > INT64_MAX - (int64_t)sizeof size - 1) {
+        ndt_err_format(ctx, NDT_ValueError, "string heap: size too large");
+        return NULL;
+    }
+
+    p = heap_alloc(heap, (int64_t)sizeof size + size + 1,
+                   (int64_t)alignof(int64_t), ctx);
+    if (p == NULL) {
+        return NULL;
+    }
+
+    memcpy(p, &size, sizeof size);
+    p += sizeof size;
+    memcpy(p, s, (size_t)size);
+    p[size] = '\0';
+
+    return p;
+}
+
+/* Copy 'size' bytes to the heap, the result is aligned to 'align'. */
+uint8_t *
+xnd_heap_bytes(xnd_heap_t *heap, const void *data, int64_t size,
+               uint16_t align, ndt_context_t *ctx)
+{
+    char *p;
+
+    p = heap_alloc(heap, size, align, ctx);
+    if (p == NULL) {
+        return NULL;
+    }
+
+    memcpy(p, data, (size_t)size);
+    return (uint8_t *)p;
+}
@@ -0,0 +1,73 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+
+#ifndef HEAP_H
+#define HEAP_H
+
+
+#include <stdint.h>
+#include "ndtypes.h"
+#include "xnd.h"
+
+
+/*
+ * Bump allocator for the string and bytes payloads of a master buffer.
+ * Payloads are never freed individually, xnd_del() releases all chunks at
+ * once.  Chunks are not moved, so payload pointers remain valid for the
+ * lifetime of the master buffer.
+ */
+typedef struct xnd_heap_chunk xnd_heap_chunk_t;
+
+struct xnd_heap {
+    char *ptr;                 /* next free byte in the current chunk */
+    char *end;                 /* end of the current chunk */
+    int64_t chunk_size;        /* size of the next chunk */
+    xnd_heap_chunk_t *chunks;  /* chunks, most recent first */
+};
+
+/*
+ * A master buffer with a string heap.  The xnd_master_t must be the first
+ * member: xnd_del() recognizes heap masters by the XND_STRING_HEAP flag and
+ * passes them on to xnd_heap_del().
+ */
+typedef struct {
+    xnd_master_t x;   /* master buffer */
+    xnd_heap_t heap;  /* string and bytes payloads */
+} xnd_heap_master_t;
+
+xnd_master_t *xnd_heap_master_new(ndt_context_t *ctx);
+void xnd_heap_del(xnd_master_t *x);
+
+
+#endif /* HEAP_H */
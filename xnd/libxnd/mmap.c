@@ -0,0 +1,1196 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/* ftruncate() is not in the C11 namespace. */
+#ifndef _WIN32
+  #define _POSIX_C_SOURCE 200809L
+#endif
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <inttypes.h>
+#include <string.h>
+#include <errno.h>
+#include <assert.h>
+#ifndef _WIN32
+  #include <sys/types.h>
+  #include <sys/stat.h>
+  #include <sys/mman.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+#endif
+#include "ndtypes.h"
+#include "xnd.h"
+#include "inline.h"
+#include "mmap.h"
+
+
+/*****************************************************************************/
+/*                                File layout                                */
+/*****************************************************************************/
+
+/*
+ * A container file consists of a fixed size header, the serialized type
+ * (see ndt_serialize(), this includes the var dimension offsets), the data,
+ * the validity bitmaps and the heap for string and bytes payloads:
+ *
+ *   [header][type][padding][data][bitmaps][padding][heap]
+ *
+ * The data offset is a multiple of the alignment of the type, so the data
+ * pointer is properly aligned in every process that maps the file.  Header
+ * fields are in native byte order.
+ *
+ * Bitmaps are stored in the pre-order of the bitmap tree that is built by
+ * xnd_bitmap_init().  The data pointers of a mapped bitmap tree point into
+ * the file, only the arrays of subtree bitmaps are allocated.
+ *
+ * In the data section, string and bytes pointers are replaced by heap
+ * offsets plus one, so that NULL pointers remain zero.  Heap offsets are
+ * relocated to pointers when a file is opened.
+ */
+
+#define MMAP_MAGIC "xndmmap"
+#define MMAP_VERSION 1
+#define MMAP_BYTEORDER 0x01020304U
+#define MMAP_MIN_ALIGN 64
+
+typedef struct {
+    char magic[8];
+    uint32_t version;
+    uint32_t byteorder;
+    int64_t typelen;
+    int64_t dataoffset;
+    int64_t datasize;
+    int64_t bitmapoffset;
+    int64_t bitmapsize;
+    int64_t heapoffset;
+    int64_t heapsize;
+} header_t;
+
+#define HEADER_SIZE ((int64_t)sizeof(header_t))
+
+
+static int64_t
+round_up(int64_t n, int64_t align)
+{
+    return (n + align - 1) / align * align;
+}
+
+static int
+check_mappable(const ndt_t *t, ndt_context_t *ctx)
+{
+    int64_t i;
+
+    switch (t->tag) {
+    case FixedDim:
+        return check_mappable(t->FixedDim.type, ctx);
+
+    case VarDim:
+        return check_mappable(t->VarDim.type, ctx);
+
+    case Tuple:
+        for (i = 0; i < t->Tuple.shape; i++) {
+            if (check_mappable(t->Tuple.types[i], ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+
+    case Record:
+        for (i = 0; i < t->Record.shape; i++) {
+            if (check_mappable(t->Record.types[i], ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+
+    case Constr:
+        return check_mappable(t->Constr.type, ctx);
+
+    case Nominal:
+        return check_mappable(t->Nominal.type, ctx);
+
+    case Ref:
+        ndt_err_format(ctx, NDT_NotImplementedError,
+            "xnd_mmap: ref types cannot be mapped");
+        return -1;
+
+    default:
+        return 0;
+    }
+}
+
+/* Return true if the data of 't' contains string or bytes pointers. */
+static bool
+has_pointers(const ndt_t *t)
+{
+    int64_t i;
+
+    switch (t->tag) {
+    case FixedDim:
+        return has_pointers(t->FixedDim.type);
+
+    case VarDim:
+        return has_pointers(t->VarDim.type);
+
+    case Tuple:
+        for (i = 0; i < t->Tuple.shape; i++) {
+            if (has_pointers(t->Tuple.types[i])) {
+                return true;
+            }
+        }
+        return false;
+
+    case Record:
+        for (i = 0; i < t->Record.shape; i++) {
+            if (has_pointers(t->Record.types[i])) {
+                return true;
+            }
+        }
+        return false;
+
+    case Constr:
+        return has_pointers(t->Constr.type);
+
+    case Nominal:
+        return has_pointers(t->Nominal.type);
+
+    case String: case Bytes:
+        return true;
+
+    default:
+        return false;
+    }
+}
+
+
+/*****************************************************************************/
+/*                                 Bitmaps                                   */
+/*****************************************************************************/
+
+/* The following functions follow the recursion of bitmap_init(). */
+
+static int64_t
+var_nitems(const ndt_t *t, int64_t nitems)
+{
+    if (t->ndim == 1) {
+        return ndt_var_offset(t, t->Concrete.VarDim.noffsets-1);
+    }
+
+    return nitems;
+}
+
+/* Size of all bitmaps in the tree for 'nitems' elements of type 't'. */
+static int64_t
+bitmap_nbytes(const ndt_t *t, int64_t nitems)
+{
+    int64_t n = 0;
+    int64_t i;
+
+    if (t->ndim == 0 && ndt_is_optional(t)) {
+        n = (nitems + 7) / 8;
+    }
+
+    if (!ndt_subtree_is_optional(t)) {
+        return n;
+    }
+
+    switch (t->tag) {
+    case FixedDim:
+        return n + bitmap_nbytes(t->FixedDim.type, nitems * t->FixedDim.shape);
+
+    case VarDim:
+        return n + bitmap_nbytes(t->VarDim.type, var_nitems(t, nitems));
+
+    case Tuple:
+        for (i = 0; i < t->Tuple.shape; i++) {
+            n += nitems * bitmap_nbytes(t->Tuple.types[i], 1);
+        }
+        return n;
+
+    case Record:
+        for (i = 0; i < t->Record.shape; i++) {
+            n += nitems * bitmap_nbytes(t->Record.types[i], 1);
+        }
+        return n;
+
+    case Constr:
+        return n + nitems * bitmap_nbytes(t->Constr.type, 1);
+
+    case Nominal:
+        return n + nitems * bitmap_nbytes(t->Nominal.type, 1);
+
+    default:
+        return n;
+    }
+}
+
+/* Number of subtree bitmaps and the type of subtree 'k' of a node. */
+static int64_t
+bitmap_nchildren(const ndt_t *t, int64_t nitems)
+{
+    switch (t->tag) {
+    case Tuple: return nitems * t->Tuple.shape;
+    case Record: return nitems * t->Record.shape;
+    case Constr: case Nominal: return nitems;
+    default: return 0;
+    }
+}
+
+static const ndt_t *
+bitmap_child_type(const ndt_t *t, int64_t k)
+{
+    switch (t->tag) {
+    case Tuple: return t->Tuple.types[k % t->Tuple.shape];
+    case Record: return t->Record.types[k % t->Record.shape];
+    case Constr: return t->Constr.type;
+    case Nominal: return t->Nominal.type;
+    default: return NULL; /* NOT REACHED */
+    }
+}
+
+/* Build a bitmap tree whose data pointers point into the mapping. */
+static int
+bitmap_map(xnd_bitmap_t *b, const ndt_t *t, int64_t nitems, char **ptr,
+           ndt_context_t *ctx)
+{
+    int64_t n, k;
+
+    if (t->ndim == 0 && ndt_is_optional(t)) {
+        b->data = (uint8_t *)*ptr;
+        *ptr += (nitems + 7) / 8;
+    }
+
+    if (!ndt_subtree_is_optional(t)) {
+        return 0;
+    }
+
+    switch (t->tag) {
+    case FixedDim:
+        return bitmap_map(b, t->FixedDim.type, nitems * t->FixedDim.shape,
+                          ptr, ctx);
+
+    case VarDim:
+        return bitmap_map(b, t->VarDim.type, var_nitems(t, nitems), ptr, ctx);
+
+    case Tuple: case Record: case Constr: case Nominal:
+        n = bitmap_nchildren(t, nitems);
+        b->next = ndt_calloc(n, sizeof *b->next);
+        if (b->next == NULL) {
+            (void)ndt_memory_error(ctx);
+            return -1;
+        }
+        b->size = n;
+
+        for (k = 0; k < n; k++) {
+            if (bitmap_map(b->next+k, bitmap_child_type(t, k), 1, ptr, ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+
+    default:
+        return 0;
+    }
+}
+
+/* Free the subtree arrays of a mapped bitmap tree, the data is in the file. */
+static void
+bitmap_unmap(xnd_bitmap_t *b)
+{
+    int64_t k;
+
+    if (b->next != NULL) {
+        for (k = 0; k < b->size; k++) {
+            bitmap_unmap(b->next+k);
+        }
+        ndt_free(b->next);
+        b->next = NULL;
+        b->size = 0;
+    }
+}
+
+
+/*****************************************************************************/
+/*                        String and bytes pointers                          */
+/*****************************************************************************/
+
+typedef int (*slot_func_t)(char *slot, const ndt_t *t, void *arg,
+                           ndt_context_t *ctx);
+
+/* Call 'f' for all string and bytes values in index order. */
+static int
+walk_pointers(const xnd_t *x, slot_func_t f, void *arg, ndt_context_t *ctx)
+{
+    const ndt_t *t = x->type;
+    int64_t i;
+
+    switch (t->tag) {
+    case FixedDim:
+        for (i = 0; i < t->FixedDim.shape; i++) {
+            const xnd_t next = _fixed_dim_next(x, i);
+            if (walk_pointers(&next, f, arg, ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+
+    case VarDim: {
+        int64_t start, step, shape;
+
+        shape = ndt_var_indices(&start, &step, t, x->index, ctx);
+        if (shape < 0) {
+            return -1;
+        }
+
+        for (i = 0; i < shape; i++) {
+            const xnd_t next = _var_dim_next(x, start, step, i);
+            if (walk_pointers(&next, f, arg, ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+    }
+
+    case Tuple:
+        for (i = 0; i < t->Tuple.shape; i++) {
+            const xnd_t next = _tuple_next(x, i);
+            if (walk_pointers(&next, f, arg, ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+
+    case Record:
+        for (i = 0; i < t->Record.shape; i++) {
+            const xnd_t next = _record_next(x, i);
+            if (walk_pointers(&next, f, arg, ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+
+    case Constr: {
+        const xnd_t next = _constr_next(x);
+        return walk_pointers(&next, f, arg, ctx);
+    }
+
+    case Nominal: {
+        const xnd_t next = _nominal_next(x);
+        return walk_pointers(&next, f, arg, ctx);
+    }
+
+    case String: case Bytes:
+        return f(x->ptr, t, arg, ctx);
+
+    default:
+        return 0;
+    }
+}
+
+/*
+ * Assign the heap location of the payload of a string or bytes value.
+ * Return -1 for NULL pointers.
+ */
+static int64_t
+heap_alloc(int64_t *heapsize, int64_t *heapalign, int64_t *len,
+           const char *slot, const ndt_t *t)
+{
+    int64_t offset;
+
+    if (t->tag == String) {
+        const char *s = XND_POINTER_DATA(slot);
+        if (s == NULL) {
+            return -1;
+        }
+        *len = (int64_t)strlen(s) + 1;
+        offset = *heapsize;
+    }
+    else {
+        const int64_t align = t->Bytes.target_align;
+        if (XND_BYTES_DATA(slot) == NULL) {
+            return -1;
+        }
+        *len = XND_BYTES_SIZE(slot);
+        offset = round_up(*heapsize, align);
+        if (align > *heapalign) {
+            *heapalign = align;
+        }
+    }
+
+    *heapsize = offset + *len;
+    return offset;
+}
+
+
+/*****************************************************************************/
+/*                                  Writer                                   */
+/*****************************************************************************/
+
+typedef struct {
+    FILE *fp;
+    const char *data; /* start of the data of the container */
+    int64_t pos;      /* data bytes written */
+    int64_t heapsize; /* heap bytes assigned */
+    int64_t heapalign;
+} writer_t;
+
+static int
+write_bytes(writer_t *w, const void *ptr, int64_t n, ndt_context_t *ctx)
+{
+    if (n > 0 && fwrite(ptr, 1, (size_t)n, w->fp) != (size_t)n) {
+        ndt_err_format(ctx, NDT_OSError, "xnd_mmap_save: write failed: %s",
+                       strerror(errno));
+        return -1;
+    }
+
+    return 0;
+}
+
+static int
+write_zeros(writer_t *w, int64_t n, ndt_context_t *ctx)
+{
+    static const char zeros[MMAP_MIN_ALIGN] = {0};
+
+    while (n > 0) {
+        const int64_t k = n < MMAP_MIN_ALIGN ? n : MMAP_MIN_ALIGN;
+        if (write_bytes(w, zeros, k, ctx) < 0) {
+            return -1;
+        }
+        n -= k;
+    }
+
+    return 0;
+}
+
+static int
+count_heap(char *slot, const ndt_t *t, void *arg, ndt_context_t *ctx)
+{
+    writer_t *w = (writer_t *)arg;
+    int64_t len;
+    (void)ctx;
+
+    (void)heap_alloc(&w->heapsize, &w->heapalign, &len, slot, t);
+    return 0;
+}
+
+/* Write the data up to and including 'slot', replace the pointer by the heap offset. */
+static int
+write_slot(char *slot, const ndt_t *t, void *arg, ndt_context_t *ctx)
+{
+    writer_t *w = (writer_t *)arg;
+    const int64_t pos = slot - w->data;
+    int64_t offset, len;
+    uintptr_t v;
+
+    if (pos < w->pos) {
+        ndt_err_format(ctx, NDT_NotImplementedError,
+            "xnd_mmap_save: data with pointers must be in index order");
+        return -1;
+    }
+
+    if (write_bytes(w, w->data+w->pos, pos-w->pos, ctx) < 0) {
+        return -1;
+    }
+
+    offset = heap_alloc(&w->heapsize, &w->heapalign, &len, slot, t);
+    v = offset < 0 ? 0 : (uintptr_t)offset + 1;
+
+    if (t->tag == String) {
+        char *s = (char *)v;
+        if (write_bytes(w, &s, sizeof s, ctx) < 0) {
+            return -1;
+        }
+    }
+    else {
+        ndt_bytes_t b;
+        memset(&b, 0, sizeof b);
+        b.size = offset < 0 ? 0 : len;
+        b.data = (uint8_t *)v;
+        if (write_bytes(w, &b, sizeof b, ctx) < 0) {
+            return -1;
+        }
+    }
+
+    w->pos = pos + t->datasize;
+    return 0;
+}
+
+static int
+write_payload(char *slot, const ndt_t *t, void *arg, ndt_context_t *ctx)
+{
+    writer_t *w = (writer_t *)arg;
+    const int64_t start = w->heapsize;
+    int64_t offset, len;
+
+    offset = heap_alloc(&w->heapsize, &w->heapalign, &len, slot, t);
+    if (offset < 0) {
+        return 0;
+    }
+
+    if (write_zeros(w, offset-start, ctx) < 0) {
+        return -1;
+    }
+
+    if (t->tag == String) {
+        return write_bytes(w, XND_POINTER_DATA(slot), len, ctx);
+    }
+
+    return write_bytes(w, XND_BYTES_DATA(slot), len, ctx);
+}
+
+static int
+write_bitmaps(writer_t *w, const xnd_bitmap_t *b, const ndt_t *t,
+              int64_t nitems, ndt_context_t *ctx)
+{
+    int64_t n, k;
+
+    if (t->ndim == 0 && ndt_is_optional(t)) {
+        n = (nitems + 7) / 8;
+        if (b->data != NULL) {
+            if (write_bytes(w, b->data, n, ctx) < 0) {
+                return -1;
+            }
+        }
+        else {
+            /* A missing bitmap means that all values are valid. */
+            for (k = 0; k < n; k++) {
+                const uint8_t valid = 0xff;
+                if (write_bytes(w, &valid, 1, ctx) < 0) {
+                    return -1;
+                }
+            }
+        }
+    }
+
+    if (!ndt_subtree_is_optional(t)) {
+        return 0;
+    }
+
+    switch (t->tag) {
+    case FixedDim:
+        return write_bitmaps(w, b, t->FixedDim.type,
+                             nitems * t->FixedDim.shape, ctx);
+
+    case VarDim:
+        return write_bitmaps(w, b, t->VarDim.type, var_nitems(t, nitems), ctx);
+
+    case Tuple: case Record: case Constr: case Nominal:
+        n = bitmap_nchildren(t, nitems);
+        for (k = 0; k < n; k++) {
+            const xnd_bitmap_t *next = b->next != NULL && k < b->size
+                                       ? b->next+k : &xnd_bitmap_empty;
+            if (write_bitmaps(w, next, bitmap_child_type(t, k), 1, ctx) < 0) {
+                return -1;
+            }
+        }
+        return 0;
+
+    default:
+        return 0;
+    }
+}
+
+static int
+save(writer_t *w, const xnd_t *x, const header_t *h, const char *type,
+     ndt_context_t *ctx)
+{
+    const bool pointers = has_pointers(x->type);
+
+    if (write_bytes(w, h, sizeof *h, ctx) < 0 ||
+        write_bytes(w, type, h->typelen, ctx) < 0 ||
+        write_zeros(w, h->dataoffset - HEADER_SIZE - h->typelen, ctx) < 0) {
+        return -1;
+    }
+
+    w->pos = 0;
+    w->heapsize = 0;
+    if (pointers && walk_pointers(x, write_slot, w, ctx) < 0) {
+        return -1;
+    }
+    if (write_bytes(w, w->data+w->pos, h->datasize-w->pos, ctx) < 0) {
+        return -1;
+    }
+
+    if (write_bitmaps(w, &x->bitmap, x->type, 1, ctx) < 0 ||
+        write_zeros(w, h->heapoffset - h->bitmapoffset - h->bitmapsize, ctx) < 0) {
+        return -1;
+    }
+
+    w->heapsize = 0;
+    if (pointers && walk_pointers(x, write_payload, w, ctx) < 0) {
+        return -1;
+    }
+
+    return 0;
+}
+
+/*
+ * Write the complete container 'x' (usually x = &master->master) to a new
+ * file at 'path'.  The file is written sequentially and can be mapped with
+ * xnd_mmap_open().
+ */
+int
+xnd_mmap_save(const char *path, const xnd_t *x, ndt_context_t *ctx)
+{
+    const ndt_t *t = x->type;
+    char *bytes = NULL;
+    writer_t w;
+    header_t h;
+    int64_t align;
+    int ret;
+
+    if (x->index != 0) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "xnd_mmap_save: expected a complete container");
+        return -1;
+    }
+
+    if (!ndt_is_concrete(t)) {
+        ndt_err_format(ctx, NDT_ValueError, "type must be concrete");
+        return -1;
+    }
+
+    if (check_mappable(t, ctx) < 0) {
+        return -1;
+    }
+
+    w.fp = NULL;
+    w.data = x->ptr;
+    w.pos = 0;
+    w.heapsize = 0;
+    w.heapalign = MMAP_MIN_ALIGN;
+
+    if (has_pointers(t) && walk_pointers(x, count_heap, &w, ctx) < 0) {
+        return -1;
+    }
+
+    memset(&h, 0, sizeof h);
+    memcpy(h.magic, MMAP_MAGIC, sizeof h.magic);
+    h.version = MMAP_VERSION;
+    h.byteorder = MMAP_BYTEORDER;
+
+    h.typelen = ndt_serialize(&bytes, t, ctx);
+    if (h.typelen < 0) {
+        return -1;
+    }
+
+    align = t->align > MMAP_MIN_ALIGN ? t->align : MMAP_MIN_ALIGN;
+    h.dataoffset = round_up(HEADER_SIZE + h.typelen, align);
+    h.datasize = t->datasize;
+    h.bitmapoffset = h.dataoffset + h.datasize;
+    h.bitmapsize = bitmap_nbytes(t, 1);
+    h.heapoffset = round_up(h.bitmapoffset + h.bitmapsize, w.heapalign);
+    h.heapsize = w.heapsize;
+
+    w.fp = fopen(path, "wb");
+    if (w.fp == NULL) {
+        ndt_err_format(ctx, NDT_OSError, "could not create %s: %s", path,
+                       strerror(errno));
+        ndt_free(bytes);
+        return -1;
+    }
+
+    ret = save(&w, x, &h, bytes, ctx);
+    ndt_free(bytes);
+
+    if (fclose(w.fp) != 0 && ret == 0) {
+        ndt_err_format(ctx, NDT_OSError, "could not write %s: %s", path,
+                       strerror(errno));
+        ret = -1;
+    }
+
+    if (ret < 0) {
+        (void)remove(path);
+    }
+
+    return ret;
+}
+
+
+/*****************************************************************************/
+/*                              Mapped masters                               */
+/*****************************************************************************/
+
+#ifndef _WIN32
+typedef struct {
+    char *heap;
+    int64_t heapsize;
+    const char *path;
+} reloc_t;
+
+static void
+corrupt_file(ndt_context_t *ctx, const char *path)
+{
+    ndt_err_format(ctx, NDT_ValueError,
+        "%s: not an xnd container file or corrupt header", path);
+}
+
+/* Replace a heap offset by a pointer into the mapped heap. */
+static int
+relocate(char *slot, const ndt_t *t, void *arg, ndt_context_t *ctx)
+{
+    const reloc_t *r = (const reloc_t *)arg;
+    const int64_t heapsize = r->heapsize;
+    uintptr_t v;
+    int64_t offset;
+
+    if (t->tag == String) {
+        v = (uintptr_t)XND_POINTER_DATA(slot);
+        if (v == 0) {
+            XND_POINTER_DATA(slot) = NULL;
+            return 0;
+        }
+
+        offset = (int64_t)(v - 1);
+        if (v - 1 >= (uintptr_t)heapsize ||
+            memchr(r->heap+offset, '\0', (size_t)(heapsize-offset)) == NULL) {
+            goto corrupt;
+        }
+
+        XND_POINTER_DATA(slot) = r->heap + offset;
+        return 0;
+    }
+    else {
+        const int64_t size = XND_BYTES_SIZE(slot);
+        const int64_t align = t->Bytes.target_align;
+
+        v = (uintptr_t)XND_BYTES_DATA(slot);
+        if (v == 0) {
+            if (size != 0) {
+                goto corrupt;
+            }
+            XND_BYTES_DATA(slot) = NULL;
+            return 0;
+        }
+
+        offset = (int64_t)(v - 1);
+        if (v - 1 > (uintptr_t)heapsize || size < 0 ||
+            size > heapsize - offset ||
+            (align > 1 && (uintptr_t)(r->heap+offset) % (uintptr_t)align != 0)) {
+            goto corrupt;
+        }
+
+        XND_BYTES_DATA(slot) = (uint8_t *)r->heap + offset;
+        return 0;
+    }
+
+corrupt:
+    ndt_err_format(ctx, NDT_ValueError, "%s: invalid heap offset", r->path);
+    return -1;
+}
+
+/*
+ * Validate the header and the type of a mapped file and create the master
+ * buffer.  The mapping is released on failure.  Files with string or bytes
+ * values can only be opened read-only: Their data is remapped privately and
+ * the pointers are relocated before the mapping is made read-only, so only
+ * the pages that contain pointers are copied.
+ */
+static xnd_master_t *
+mapping_new(void *addr, size_t length, enum xnd_mmap_mode mode, int fd,
+            const char *path, ndt_context_t *ctx)
+{
+    const int64_t size = (int64_t)length;
+    char *base = (char *)addr;
+    xnd_mapping_t *m = NULL;
+    ndt_meta_t *meta = NULL;
+    ndt_t *t = NULL;
+    header_t h;
+    char *ptr;
+
+    if (size < HEADER_SIZE) {
+        corrupt_file(ctx, path);
+        goto error;
+    }
+
+    memcpy(&h, base, sizeof h);
+
+    if (memcmp(h.magic, MMAP_MAGIC, sizeof h.magic) != 0 ||
+        h.byteorder != MMAP_BYTEORDER) {
+        corrupt_file(ctx, path);
+        goto error;
+    }
+
+    if (h.version != MMAP_VERSION) {
+        ndt_err_format(ctx, NDT_NotImplementedError,
+            "%s: unsupported container file version %" PRIu32, path, h.version);
+        goto error;
+    }
+
+    if (h.typelen <= 0 || h.typelen > size - HEADER_SIZE ||
+        h.dataoffset < HEADER_SIZE + h.typelen || h.dataoffset > size ||
+        h.datasize < 0 || h.datasize > size - h.dataoffset ||
+        h.bitmapoffset < h.dataoffset + h.datasize || h.bitmapoffset > size ||
+        h.bitmapsize < 0 || h.bitmapsize > size - h.bitmapoffset ||
+        h.heapoffset < h.bitmapoffset + h.bitmapsize || h.heapoffset > size ||
+        h.heapsize < 0 || h.heapsize > size - h.heapoffset) {
+        corrupt_file(ctx, path);
+        goto error;
+    }
+
+    meta = ndt_meta_new(ctx);
+    if (meta == NULL) {
+        goto error;
+    }
+
+    t = ndt_deserialize(meta, base+HEADER_SIZE, h.typelen, ctx);
+    if (t == NULL) {
+        goto error;
+    }
+
+    if (!ndt_is_concrete(t)) {
+        corrupt_file(ctx, path);
+        goto error;
+    }
+
+    if (check_mappable(t, ctx) < 0) {
+        goto error;
+    }
+
+    if (h.dataoffset % t->align != 0 || h.datasize != t->datasize ||
+        h.bitmapsize != bitmap_nbytes(t, 1)) {
+        corrupt_file(ctx, path);
+        goto error;
+    }
+
+    if (has_pointers(t)) {
+        if (mode != MmapReadOnly) {
+            ndt_err_format(ctx, NDT_NotImplementedError,
+                "%s: containers with string or bytes values can only be "
+                "mapped read-only", path);
+            goto error;
+        }
+
+        (void)munmap(addr, length);
+        addr = mmap(NULL, length, PROT_READ|PROT_WRITE, MAP_PRIVATE, fd, 0);
+        if (addr == MAP_FAILED) {
+            ndt_err_format(ctx, NDT_OSError, "could not map %s: %s", path,
+                           strerror(errno));
+            ndt_del(t);
+            ndt_meta_del(meta);
+            return NULL;
+        }
+        base = (char *)addr;
+    }
+
+    m = ndt_calloc(1, sizeof *m);
+    if (m == NULL) {
+        (void)ndt_memory_error(ctx);
+        goto error;
+    }
+
+    m->x.flags = XND_MAPPED;
+    if (mode == MmapReadOnly) {
+        m->x.flags |= XND_READONLY;
+    }
+
+    m->x.master.bitmap = xnd_bitmap_empty;
+    m->x.master.index = 0;
+    m->x.master.type = t;
+    m->x.master.ptr = base + h.dataoffset;
+
+    ptr = base + h.bitmapoffset;
+    if (bitmap_map(&m->x.master.bitmap, t, 1, &ptr, ctx) < 0) {
+        goto error;
+    }
+    assert(ptr == base + h.bitmapoffset + h.bitmapsize);
+
+    if (has_pointers(t)) {
+        reloc_t r = {base + h.heapoffset, h.heapsize, path};
+
+        if (walk_pointers(&m->x.master, relocate, &r, ctx) < 0) {
+            goto error;
+        }
+
+        if (mprotect(addr, length, PROT_READ) < 0) {
+            ndt_err_format(ctx, NDT_OSError, "mprotect failed: %s",
+                           strerror(errno));
+            goto error;
+        }
+    }
+
+    m->type = t;
+    m->meta = meta;
+    m->addr = addr;
+    m->length = length;
+
+    return &m->x;
+
+error:
+    if (m != NULL) {
+        bitmap_unmap(&m->x.master.bitmap);
+        ndt_free(m);
+    }
+    ndt_del(t);
+    ndt_meta_del(meta);
+    (void)munmap(addr, length);
+    return NULL;
+}
+#endif
+
+/*
+ * Create a new container file at 'path' for values of type 't' and map it
+ * shared-writable.  The data is zero-initialized, all optional values are
+ * missing. The type is serialized into the file, the master buffer owns its
+ * own copy of the type.
+ *
+ * String and bytes values cannot be added to a mapping, containers with such
+ * values are written with xnd_mmap_save().
+ */
+xnd_master_t *
+xnd_mmap_create(const char *path, const ndt_t *t, ndt_context_t *ctx)
+{
+#ifdef _WIN32
+    (void)path;
+    (void)t;
+    ndt_err_format(ctx, NDT_NotImplementedError,
+        "xnd_mmap_create: not implemented on this platform");
+    return NULL;
+#else
+    xnd_master_t *x;
+    char *bytes = NULL;
+    int64_t align, size;
+    void *addr;
+    header_t h;
+    int fd;
+
+    if (!ndt_is_concrete(t)) {
+        ndt_err_format(ctx, NDT_ValueError, "type must be concrete");
+        return NULL;
+    }
+
+    if (check_mappable(t, ctx) < 0) {
+        return NULL;
+    }
+
+    if (has_pointers(t)) {
+        ndt_err_format(ctx, NDT_NotImplementedError,
+            "xnd_mmap_create: cannot create a mapping for string or bytes "
+            "values, use xnd_mmap_save()");
+        return NULL;
+    }
+
+    memset(&h, 0, sizeof h);
+    memcpy(h.magic, MMAP_MAGIC, sizeof h.magic);
+    h.version = MMAP_VERSION;
+    h.byteorder = MMAP_BYTEORDER;
+
+    h.typelen = ndt_serialize(&bytes, t, ctx);
+    if (h.typelen < 0) {
+        return NULL;
+    }
+
+    align = t->align > MMAP_MIN_ALIGN ? t->align : MMAP_MIN_ALIGN;
+    h.dataoffset = round_up(HEADER_SIZE + h.typelen, align);
+    h.datasize = t->datasize;
+    h.bitmapsize = bitmap_nbytes(t, 1);
+
+    if (h.datasize > INT64_MAX - h.dataoffset - h.bitmapsize ||
+        (uint64_t)(h.dataoffset + h.datasize + h.bitmapsize) > SIZE_MAX) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "xnd_mmap_create: file size exceeds the address space");
+        ndt_free(bytes);
+        return NULL;
+    }
+
+    h.bitmapoffset = h.dataoffset + h.datasize;
+    h.heapoffset = h.bitmapoffset + h.bitmapsize;
+    h.heapsize = 0;
+    size = h.heapoffset;
+
+    fd = open(path, O_RDWR|O_CREAT|O_TRUNC, 0666);
+    if (fd < 0) {
+        ndt_err_format(ctx, NDT_OSError, "could not create %s: %s", path,
+                       strerror(errno));
+        ndt_free(bytes);
+        return NULL;
+    }
+
+    if (ftruncate(fd, (off_t)size) < 0) {
+        ndt_err_format(ctx, NDT_OSError, "could not resize %s: %s", path,
+                       strerror(errno));
+        (void)close(fd);
+        (void)unlink(path);
+        ndt_free(bytes);
+        return NULL;
+    }
+
+    addr = mmap(NULL, (size_t)size, PROT_READ|PROT_WRITE, MAP_SHARED, fd, 0);
+    if (addr == MAP_FAILED) {
+        ndt_err_format(ctx, NDT_OSError, "could not map %s: %s", path,
+                       strerror(errno));
+        (void)close(fd);
+        (void)unlink(path);
+        ndt_free(bytes);
+        return NULL;
+    }
+
+    memcpy(addr, &h, sizeof h);
+    memcpy((char *)addr + HEADER_SIZE, bytes, (size_t)h.typelen);
+    ndt_free(bytes);
+
+    x = mapping_new(addr, (size_t)size, MmapShared, fd, path, ctx);
+    (void)close(fd);
+    if (x == NULL) {
+        (void)unlink(path);
+    }
+
+    return x;
+#endif
+}
+
+/*
+ * Map an existing container file.  MmapReadOnly and MmapShared share the
+ * pages with all other processes that map the file, writes to a MmapShared
+ * mapping are visible to them and are carried through to the file.  Writes
+ * to a MmapCopyOnWrite mapping are private to the process.
+ */
+xnd_master_t *
+xnd_mmap_open(const char *path, enum xnd_mmap_mode mode, ndt_context_t *ctx)
+{
+#ifdef _WIN32
+    (void)path;
+    (void)mode;
+    ndt_err_format(ctx, NDT_NotImplementedError,
+        "xnd_mmap_open: not implemented on this platform");
+    return NULL;
+#else
+    xnd_master_t *x;
+    struct stat st;
+    int oflag, prot, flags;
+    void *addr;
+    int fd;
+
+    switch (mode) {
+    case MmapReadOnly:
+        oflag = O_RDONLY; prot = PROT_READ; flags = MAP_SHARED;
+        break;
+    case MmapCopyOnWrite:
+        oflag = O_RDONLY; prot = PROT_READ|PROT_WRITE; flags = MAP_PRIVATE;
+        break;
+    case MmapShared:
+        oflag = O_RDWR; prot = PROT_READ|PROT_WRITE; flags = MAP_SHARED;
+        break;
+    default:
+        ndt_err_format(ctx, NDT_InvalidArgumentError,
+            "xnd_mmap_open: invalid mode");
+        return NULL;
+    }
+
+    fd = open(path, oflag);
+    if (fd < 0) {
+        ndt_err_format(ctx, NDT_OSError, "could not open %s: %s", path,
+                       strerror(errno));
+        return NULL;
+    }
+
+    if (fstat(fd, &st) < 0) {
+        ndt_err_format(ctx, NDT_OSError, "could not stat %s: %s", path,
+                       strerror(errno));
+        (void)close(fd);
+        return NULL;
+    }
+
+    if (st.st_size < HEADER_SIZE) {
+        corrupt_file(ctx, path);
+        (void)close(fd);
+        return NULL;
+    }
+
+    if ((uint64_t)st.st_size > SIZE_MAX) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "%s: file size exceeds the address space", path);
+        (void)close(fd);
+        return NULL;
+    }
+
+    addr = mmap(NULL, (size_t)st.st_size, prot, flags, fd, 0);
+    if (addr == MAP_FAILED) {
+        ndt_err_format(ctx, NDT_OSError, "could not map %s: %s", path,
+                       strerror(errno));
+        (void)close(fd);
+        return NULL;
+    }
+
+    x = mapping_new(addr, (size_t)st.st_size, mode, fd, path, ctx);
+    (void)close(fd);
+
+    return x;
+#endif
+}
+
+/* Flush a shared-writable mapping to disk. */
+int
+xnd_mmap_sync(const xnd_master_t *x, ndt_context_t *ctx)
+{
+    const xnd_mapping_t *m = (const xnd_mapping_t *)x;
+
+    if (!(x->flags & XND_MAPPED)) {
+        ndt_err_format(ctx, NDT_ValueError,
+            "xnd_mmap_sync: not a mapped master buffer");
+        return -1;
+    }
+
+#ifdef _WIN32
+    (void)m;
+    ndt_err_format(ctx, NDT_NotImplementedError,
+        "xnd_mmap_sync: not implemented on this platform");
+    return -1;
+#else
+    if (msync(m->addr, m->length, MS_SYNC) < 0) {
+        ndt_err_format(ctx, NDT_OSError, "msync failed: %s", strerror(errno));
+        return -1;
+    }
+
+    return 0;
+#endif
+}
+
+/* Called by xnd_del() for masters with the XND_MAPPED flag. */
+void
+xnd_mmap_del(xnd_master_t *x)
+{
+    xnd_mapping_t *m = (xnd_mapping_t *)x;
+
+    assert(x->flags & XND_MAPPED);
+
+    bitmap_unmap(&m->x.master.bitmap);
+#ifndef _WIN32
+    (void)munmap(m->addr, m->length);
+#endif
+    ndt_del(m->type);
+    ndt_meta_del(m->meta);
+    ndt_free(m);
+}
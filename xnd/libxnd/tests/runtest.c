@@ -68,6 +68,8 @@ init_tests(void)
 
 static int (*tests[])(void) = {
   test_fixed,
+  test_bitmaps,
+  test_mmap,
   NULL
 };
 
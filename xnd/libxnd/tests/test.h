@@ -43,6 +43,8 @@
 
 
 int test_fixed(void);
+int test_bitmaps(void);
+int test_mmap(void);
 
 
 #endif /* TEST_H */
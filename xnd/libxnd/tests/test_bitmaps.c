@@ -0,0 +1,213 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include <inttypes.h>
+#include "ndtypes.h"
+#include "test.h"
+
+
+#define NBITS 1000
+#define NBYTES ((NBITS+7)/8)
+
+static int
+get_bit(const uint8_t *data, int64_t i)
+{
+    return data == NULL || (data[i/8] >> (i%8)) & 1;
+}
+
+static void
+put_bit(uint8_t *data, int64_t i, int v)
+{
+    if (v) {
+        data[i/8] |= (uint8_t)(1 << (i%8));
+    }
+    else {
+        data[i/8] &= (uint8_t)~(1 << (i%8));
+    }
+}
+
+static void
+random_bits(uint8_t *data, unsigned int *seed)
+{
+    for (int i = 0; i < NBYTES; i++) {
+        *seed = *seed * 1103515245 + 12345;
+        data[i] = (uint8_t)(*seed >> 16);
+    }
+}
+
+static int
+check_equal(const uint8_t *x, const uint8_t *y, const char *name,
+            int64_t pos, int64_t n)
+{
+    if (memcmp(x, y, NBYTES) != 0) {
+        fprintf(stderr, "test_bitmaps: %s(pos=%" PRIi64 ", n=%" PRIi64 ") failed\n",
+                name, pos, n);
+        return -1;
+    }
+
+    return 0;
+}
+
+int
+test_bitmaps(void)
+{
+    static const int64_t pos[] = {0, 1, 7, 8, 9, 63, 64, 65, 200, 333};
+    static const int64_t len[] = {0, 1, 5, 8, 17, 64, 65, 128, 500, 600};
+    uint8_t a[NBYTES], b[NBYTES], out[NBYTES], expected[NBYTES];
+    unsigned int seed = 1;
+    int64_t i, k, count;
+    int u, v, w;
+    int ncases = 0;
+
+    for (u = 0; u < ARRAY_SIZE(pos); u++)
+    for (v = 0; v < ARRAY_SIZE(pos); v++)
+    for (w = 0; w < ARRAY_SIZE(len); w++) {
+        const int64_t p = pos[u];
+        const int64_t q = pos[v];
+        const int64_t n = len[w];
+
+        if (p + n > NBITS || q + n > NBITS) {
+            continue;
+        }
+
+        random_bits(a, &seed);
+        random_bits(b, &seed);
+        random_bits(out, &seed);
+
+        /* set_valid, set_na */
+        memcpy(expected, out, NBYTES);
+        for (i = 0; i < n; i++) {
+            put_bit(expected, p+i, 1);
+        }
+        xnd_bitmap_set_valid(out, p, n);
+        if (check_equal(out, expected, "xnd_bitmap_set_valid", p, n) < 0) {
+            return -1;
+        }
+
+        for (i = 0; i < n; i++) {
+            put_bit(expected, q+i, 0);
+        }
+        xnd_bitmap_set_na(out, q, n);
+        if (check_equal(out, expected, "xnd_bitmap_set_na", q, n) < 0) {
+            return -1;
+        }
+
+        /* count_valid */
+        count = 0;
+        for (i = 0; i < n; i++) {
+            count += get_bit(a, p+i);
+        }
+        if (xnd_bitmap_count_valid(a, p, n) != count ||
+            xnd_bitmap_count_valid(NULL, p, n) != n) {
+            fprintf(stderr, "test_bitmaps: xnd_bitmap_count_valid failed\n");
+            return -1;
+        }
+
+        /* and, or, andnot with all combinations of offsets */
+        memcpy(expected, out, NBYTES);
+        for (i = 0; i < n; i++) {
+            put_bit(expected, q+i, get_bit(a, p+i) & get_bit(b, q+i));
+        }
+        xnd_bitmap_and(out, q, a, p, b, q, n);
+        if (check_equal(out, expected, "xnd_bitmap_and", p, n) < 0) {
+            return -1;
+        }
+
+        for (i = 0; i < n; i++) {
+            put_bit(expected, p+i, get_bit(a, p+i) | get_bit(b, q+i));
+        }
+        xnd_bitmap_or(out, p, a, p, b, q, n);
+        if (check_equal(out, expected, "xnd_bitmap_or", p, n) < 0) {
+            return -1;
+        }
+
+        for (i = 0; i < n; i++) {
+            put_bit(expected, q+i, get_bit(a, q+i) & !get_bit(b, p+i));
+        }
+        xnd_bitmap_andnot(out, q, a, q, b, p, n);
+        if (check_equal(out, expected, "xnd_bitmap_andnot", q, n) < 0) {
+            return -1;
+        }
+
+        /* NULL inputs are all valid */
+        for (i = 0; i < n; i++) {
+            put_bit(expected, p+i, get_bit(b, q+i));
+        }
+        xnd_bitmap_and(out, p, NULL, 0, b, q, n);
+        if (check_equal(out, expected, "xnd_bitmap_and", p, n) < 0) {
+            return -1;
+        }
+
+        /* in-place operation */
+        memcpy(expected, a, NBYTES);
+        for (i = 0; i < n; i++) {
+            put_bit(expected, p+i, get_bit(a, p+i) & get_bit(b, p+i));
+        }
+        xnd_bitmap_and(a, p, a, p, b, p, n);
+        if (check_equal(a, expected, "xnd_bitmap_and", p, n) < 0) {
+            return -1;
+        }
+
+        /* next_valid */
+        k = p;
+        for (i = xnd_bitmap_next_valid(b, p, p+n); i < p+n;
+             i = xnd_bitmap_next_valid(b, i+1, p+n)) {
+            for (; k < i; k++) {
+                if (get_bit(b, k)) {
+                    break;
+                }
+            }
+            if (k != i || !get_bit(b, i)) {
+                fprintf(stderr, "test_bitmaps: xnd_bitmap_next_valid failed\n");
+                return -1;
+            }
+            k = i+1;
+        }
+        for (; k < p+n; k++) {
+            if (get_bit(b, k)) {
+                fprintf(stderr, "test_bitmaps: xnd_bitmap_next_valid failed\n");
+                return -1;
+            }
+        }
+
+        ncases++;
+    }
+
+    fprintf(stderr, "test_bitmaps (%d test cases)\n", ncases);
+
+    return 0;
+}
@@ -0,0 +1,336 @@
+/*
+ * BSD 3-Clause License
+ *
+ * Copyright (c) 2017-2018, plures
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are met:
+ *
+ * 1. Redistributions of source code must retain the above copyright notice,
+ *    this list of conditions and the following disclaimer.
+ *
+ * 2. Redistributions in binary form must reproduce the above copyright notice,
+ *    this list of conditions and the following disclaimer in the documentation
+ *    and/or other materials provided with the distribution.
+ *
+ * 3. Neither the name of the copyright holder nor the names of its
+ *    contributors may be used to endorse or promote products derived from
+ *    this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ * AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ * IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ * DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+ * FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+ * DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+ * SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+ * CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+ * OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+ * OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdint.h>
+#include <string.h>
+#include "ndtypes.h"
+#include "test.h"
+
+
+#define FILENAME "test_mmap.tmp"
+
+static xnd_master_t *
+create(const char *s, ndt_context_t *ctx)
+{
+    xnd_master_t *x;
+    ndt_t *t;
+
+    t = ndt_from_string(s, ctx);
+    if (t == NULL) {
+        return NULL;
+    }
+
+    x = xnd_mmap_create(FILENAME, t, ctx);
+    ndt_del(t);
+    return x;
+}
+
+static int
+check_values(const xnd_master_t *x, const double *values, const char *name,
+             ndt_context_t *ctx)
+{
+    const double *ptr = (const double *)x->master.ptr;
+    int i;
+
+    for (i = 0; i < 12; i++) {
+        if ((values[i] >= 0) !=
+            xnd_bitmap_count_valid(x->master.bitmap.data, i, 1)) {
+            ndt_err_format(ctx, NDT_RuntimeError, "%s: unexpected bitmap", name);
+            return -1;
+        }
+        if (values[i] >= 0 && ptr[i] != values[i]) {
+            ndt_err_format(ctx, NDT_RuntimeError, "%s: unexpected value", name);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+static int
+expect_error(xnd_master_t *x, enum ndt_error err, const char *name,
+             ndt_context_t *ctx)
+{
+    if (x != NULL) {
+        xnd_del(x);
+        ndt_err_format(ctx, NDT_RuntimeError, "%s: expected failure", name);
+        return -1;
+    }
+
+    if (ctx->err != err) {
+        return -1;
+    }
+
+    ndt_err_clear(ctx);
+    return 0;
+}
+
+int
+test_mmap(void)
+{
+    ndt_context_t *ctx;
+    xnd_master_t *x = NULL;
+    double values[12];
+    const char *strings[3] = {"", "abc", "xnd container"};
+    double *ptr;
+    int32_t *iptr;
+    xnd_t view;
+    FILE *fp;
+    int ret = 0;
+    int i;
+
+#ifdef _WIN32
+    fprintf(stderr, "test_mmap (skipped: not supported on this platform)\n");
+    return 0;
+#endif
+
+    ctx = ndt_context_new();
+    if (ctx == NULL) {
+        fprintf(stderr, "out of memory\n");
+        return -1;
+    }
+
+
+    /***** Create, write, read back *****/
+    x = create("3 * 4 * ?float64", ctx);
+    if (x == NULL) {
+        goto error;
+    }
+
+    if (((uintptr_t)x->master.ptr) % 8 != 0 ||
+        x->master.bitmap.data == NULL || !(x->flags & XND_MAPPED)) {
+        ndt_err_format(ctx, NDT_RuntimeError, "unexpected master buffer");
+        goto error;
+    }
+
+    ptr = (double *)x->master.ptr;
+    for (i = 0; i < 12; i++) {
+        values[i] = i % 3 == 0 ? -1 : i;
+        if (i % 3 != 0) {
+            ptr[i] = i;
+            xnd_bitmap_set_valid(x->master.bitmap.data, i, 1);
+        }
+    }
+
+    if (xnd_mmap_sync(x, ctx) < 0) {
+        goto error;
+    }
+    xnd_del(x);
+
+    x = xnd_mmap_open(FILENAME, MmapReadOnly, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    if (!(x->flags & XND_READONLY) ||
+        check_values(x, values, "MmapReadOnly", ctx) < 0) {
+        goto error;
+    }
+    xnd_del(x);
+
+
+    /***** Copy-on-write mappings do not change the file *****/
+    x = xnd_mmap_open(FILENAME, MmapCopyOnWrite, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    ((double *)x->master.ptr)[1] = 100;
+    xnd_del(x);
+
+    x = xnd_mmap_open(FILENAME, MmapReadOnly, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    if (check_values(x, values, "MmapCopyOnWrite", ctx) < 0) {
+        goto error;
+    }
+    xnd_del(x);
+
+
+    /***** Shared mappings do *****/
+    x = xnd_mmap_open(FILENAME, MmapShared, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    ((double *)x->master.ptr)[1] = 100;
+    xnd_bitmap_set_na(x->master.bitmap.data, 2, 1);
+    xnd_del(x);
+    values[1] = 100;
+    values[2] = -1;
+
+    x = xnd_mmap_open(FILENAME, MmapReadOnly, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    if (check_values(x, values, "MmapShared", ctx) < 0) {
+        goto error;
+    }
+    xnd_del(x);
+
+
+    /***** Var dimensions *****/
+    x = create("var(offsets=[0,2]) * var(offsets=[0,3,5]) * int32", ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    iptr = (int32_t *)x->master.ptr;
+    for (i = 0; i < 5; i++) {
+        iptr[i] = i * 10;
+    }
+    xnd_del(x);
+
+    x = xnd_mmap_open(FILENAME, MmapReadOnly, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    iptr = (int32_t *)x->master.ptr;
+    if (x->master.type->tag != VarDim ||
+        ndt_var_offset(x->master.type->VarDim.type, 2) != 5 ||
+        iptr[4] != 40) {
+        ndt_err_format(ctx, NDT_RuntimeError, "var dimensions: unexpected value");
+        goto error;
+    }
+    xnd_del(x);
+    x = NULL;
+
+
+    /***** Saved containers with strings and optional fields *****/
+    x = xnd_empty_from_string("3 * {a: ?int64, b: string}", XND_OWN_ALL, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    for (i = 0; i < 3; i++) {
+        int64_t indices[2] = {i, 0};
+
+        view = xnd_subtree_index(&x->master, indices, 2, ctx);
+        if (view.ptr == NULL) {
+            goto error;
+        }
+        if (i != 1) {
+            *(int64_t *)view.ptr = i * 10;
+            xnd_set_valid(&view);
+        }
+
+        indices[1] = 1;
+        view = xnd_subtree_index(&x->master, indices, 2, ctx);
+        if (view.ptr == NULL) {
+            goto error;
+        }
+        XND_POINTER_DATA(view.ptr) = ndt_strdup(strings[i], ctx);
+        if (XND_POINTER_DATA(view.ptr) == NULL) {
+            goto error;
+        }
+    }
+
+    if (xnd_mmap_save(FILENAME, &x->master, ctx) < 0) {
+        goto error;
+    }
+    xnd_del(x);
+
+    x = xnd_mmap_open(FILENAME, MmapReadOnly, ctx);
+    if (x == NULL) {
+        goto error;
+    }
+    for (i = 0; i < 3; i++) {
+        int64_t indices[2] = {i, 0};
+
+        view = xnd_subtree_index(&x->master, indices, 2, ctx);
+        if (view.ptr == NULL) {
+            goto error;
+        }
+        if (xnd_is_valid(&view) != (i != 1) ||
+            (i != 1 && *(int64_t *)view.ptr != i * 10)) {
+            ndt_err_format(ctx, NDT_RuntimeError, "optional field: unexpected value");
+            goto error;
+        }
+
+        indices[1] = 1;
+        view = xnd_subtree_index(&x->master, indices, 2, ctx);
+        if (view.ptr == NULL) {
+            goto error;
+        }
+        if (strcmp(XND_POINTER_DATA(view.ptr), strings[i]) != 0) {
+            ndt_err_format(ctx, NDT_RuntimeError, "string: unexpected value");
+            goto error;
+        }
+    }
+    xnd_del(x);
+    x = NULL;
+
+    if (expect_error(xnd_mmap_open(FILENAME, MmapShared, ctx),
+                     NDT_NotImplementedError, "shared strings", ctx) < 0) {
+        goto error;
+    }
+
+
+    /***** Errors *****/
+    if (expect_error(create("10 * string", ctx), NDT_NotImplementedError,
+                     "string", ctx) < 0 ||
+        expect_error(create("10 * ref(int64)", ctx), NDT_NotImplementedError,
+                     "ref", ctx) < 0 ||
+        expect_error(xnd_mmap_open("test_mmap.nonexistent", MmapReadOnly, ctx),
+                     NDT_OSError, "nonexistent", ctx) < 0) {
+        goto error;
+    }
+
+    fp = fopen(FILENAME, "wb");
+    if (fp == NULL) {
+        ndt_err_format(ctx, NDT_OSError, "could not open " FILENAME);
+        goto error;
+    }
+    for (i = 0; i < 100; i++) {
+        fputc('x', fp);
+    }
+    fclose(fp);
+
+    if (expect_error(xnd_mmap_open(FILENAME, MmapReadOnly, ctx),
+                     NDT_ValueError, "corrupt file", ctx) < 0) {
+        goto error;
+    }
+
+
+    fprintf(stderr, "test_mmap (10 test cases)\n");
+
+
+out:
+    xnd_del(x);
+    (void)remove(FILENAME);
+    ndt_context_del(ctx);
+    return ret;
+
+error:
+    ret = -1;
+    ndt_err_fprint(stderr, ctx);
+    goto out;
+}
@@ -40,6 +40,8 @@
 #include "xnd.h"
 #include "inline.h"
 #include "contrib.h"
+#include "mmap.h"
+#include "heap.h"
 
 
 static int xnd_init(xnd_t * const x, const uint32_t flags, ndt_context_t *ctx);
@@ -279,6 +281,30 @@ xnd_init(xnd_t * const x, const uint32_t flags, ndt_context_t *ctx)
     return -1;
 }
 
+/* Master buffers with XND_STRING_HEAP are allocated as xnd_heap_master_t. */
+static xnd_master_t *
+master_alloc(uint32_t flags, ndt_context_t *ctx)
+{
+    xnd_master_t *x;
+
+    if (flags & XND_STRING_HEAP) {
+        if ((flags & (XND_OWN_STRINGS|XND_OWN_BYTES)) !=
+            (XND_OWN_STRINGS|XND_OWN_BYTES)) {
+            ndt_err_format(ctx, NDT_InvalidArgumentError,
+                "XND_STRING_HEAP requires XND_OWN_STRINGS and XND_OWN_BYTES");
+            return NULL;
+        }
+        return xnd_heap_master_new(ctx);
+    }
+
+    x = ndt_alloc(1, sizeof *x);
+    if (x == NULL) {
+        return ndt_memory_error(ctx);
+    }
+
+    return x;
+}
+
 /*
  * Create a type from a string and return a new master buffer for that type.
  * Any combination of flags that include XND_OWN_TYPE can be passed.
@@ -297,9 +323,9 @@ xnd_empty_from_string(const char *s, uint32_t flags, ndt_context_t *ctx)
         return NULL;
     }
 
-    x = ndt_alloc(1, sizeof *x);
+    x = master_alloc(flags, ctx);
     if (x == NULL) {
-        return ndt_memory_error(ctx);
+        return NULL;
     }
 
     t = ndt_from_string(s, ctx);
@@ -360,9 +386,9 @@ xnd_empty_from_type(const ndt_t *t, uint32_t flags, ndt_context_t *ctx)
         return NULL;
     }
 
-    x = ndt_alloc(1, sizeof *x);
+    x = master_alloc(flags, ctx);
     if (x == NULL) {
-        return ndt_memory_error(ctx);
+        return NULL;
     }
 
     if (xnd_bitmap_init(&b, t, ctx) < 0) {
@@ -401,13 +427,24 @@ xnd_from_xnd(xnd_t *src, uint32_t flags, ndt_context_t *ctx)
 {
     xnd_master_t *x;
 
-    x = ndt_alloc(1, sizeof *x);
+    if (flags & XND_STRING_HEAP) {
+        ndt_err_format(ctx, NDT_InvalidArgumentError,
+            "xnd_from_xnd: XND_STRING_HEAP is not supported");
+        x = NULL;
+    }
+    else {
+        x = ndt_alloc(1, sizeof *x);
+        if (x == NULL) {
+            (void)ndt_memory_error(ctx);
+        }
+    }
+
     if (x == NULL) {
         xnd_clear(src, XND_OWN_ALL);
         ndt_del((ndt_t *)src->type);
         ndt_aligned_free(src->ptr);
         xnd_bitmap_clear(&src->bitmap);
-        return ndt_memory_error(ctx);
+        return NULL;
     }
 
     x->flags = flags;
@@ -422,11 +459,15 @@ xnd_from_xnd(xnd_t *src, uint32_t flags, ndt_context_t *ctx)
 /*****************************************************************************/
 
 static bool
-requires_clear(const ndt_t * const t)
+requires_clear(const ndt_t * const t, const uint32_t flags)
 {
     const ndt_t *dtype = ndt_dtype(t);
 
     switch (dtype->tag) {
+    case String:
+        return flags & XND_OWN_STRINGS;
+    case Bytes:
+        return flags & XND_OWN_BYTES;
     case Categorical:
     case Bool:
     case Int8: case Int16: case Int32: case Int64:
@@ -602,7 +643,7 @@ xnd_del_buffer(xnd_t *x, uint32_t flags)
 {
     if (x != NULL) {
         if (x->ptr != NULL && x->type != NULL) {
-            if ((flags&XND_OWN_DATA) && requires_clear(x->type)) {
+            if ((flags&XND_OWN_DATA) && requires_clear(x->type, flags)) {
                 xnd_clear(x, flags);
             }
 
@@ -629,6 +670,14 @@ void
 xnd_del(xnd_master_t *x)
 {
     if (x != NULL) {
+        if (x->flags & XND_MAPPED) {
+            xnd_mmap_del(x);
+            return;
+        }
+        if (x->flags & XND_STRING_HEAP) {
+            xnd_heap_del(x);
+            return;
+        }
         xnd_del_buffer(&x->master, x->flags);
         ndt_free(x);
     }
@@ -968,10 +1017,7 @@ xnd_multikey(const xnd_t *x, const xnd_index_t indices[], int len, ndt_context_t
 
     if (len == 0) {
         xnd_t next = *x;
-        next.type = ndt_copy(t, ctx);
-        if (next.type == NULL) {
-            return xnd_error;
-        }
+        next.type = ndt_incref(t);
 
         return next;
     }
@@ -1101,11 +1147,11 @@ xnd_slice(const xnd_t *x, const xnd_index_t indices[], int len, ndt_context_t *c
         }
 
         xnd_t ret = *x;
-        ret.type = ndt_var_dim((ndt_t *)next.type,
-                                ExternalOffsets,
-                                t->Concrete.VarDim.noffsets, t->Concrete.VarDim.offsets,
-                                nslices, slices,
-                                ctx);
+        ret.type = ndt_var_dim_typed((ndt_t *)next.type,
+                                     ExternalOffsets, t->Concrete.VarDim.offset_type,
+                                     t->Concrete.VarDim.noffsets, t->Concrete.VarDim.offsets,
+                                     nslices, slices,
+                                     ctx);
         if (ret.type == NULL) {
             return xnd_error;
         }
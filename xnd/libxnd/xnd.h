@@ -86,12 +86,26 @@
                           XND_OWN_BYTES |   \
                           XND_OWN_POINTERS)
 
+/* Master buffers whose memory is a file mapping (see xnd_mmap_open()). */
+#define XND_MAPPED       0x00000100U /* data and bitmap are in a file mapping */
+#define XND_READONLY     0x00000200U /* the mapping is read-only */
+
+/*
+ * Master buffers whose string and bytes payloads are in one heap (see
+ * xnd_heap()).  XND_OWN_STRINGS and XND_OWN_BYTES must be set, they mean
+ * that the master buffer owns the heap.
+ */
+#define XND_STRING_HEAP  0x00000400U
+
 
 /* Convenience macros to extract embedded values. */
 #define XND_POINTER_DATA(ptr) (*((char **)ptr))
 #define XND_BYTES_SIZE(ptr) (((ndt_bytes_t *)ptr)->size)
 #define XND_BYTES_DATA(ptr) (((ndt_bytes_t *)ptr)->data)
 
+/* Strings in a heap are preceded by their size. */
+#define XND_HEAP_STRING_SIZE(s) (((const int64_t *)(s))[-1])
+
 
 /* Bitmap tree. */
 typedef struct xnd_bitmap xnd_bitmap_t;
@@ -116,6 +130,9 @@ typedef struct xnd_master {
     xnd_t master;   /* typed memory */
 } xnd_master_t;
 
+/* String heap, opaque. */
+typedef struct xnd_heap xnd_heap_t;
+
 /* Used in indexing and slicing. */
 enum xnd_key { Index, FieldName, Slice };
 typedef struct {
@@ -140,6 +157,18 @@ XND_API void xnd_del(xnd_master_t *x);
 XND_API xnd_master_t *xnd_from_xnd(xnd_t *src, uint32_t flags, ndt_context_t *ctx);
 XND_API void xnd_del_buffer(xnd_t *x, uint32_t flags);
 
+/* Master buffers backed by files, deleted with xnd_del(). */
+enum xnd_mmap_mode { MmapReadOnly, MmapCopyOnWrite, MmapShared };
+XND_API xnd_master_t *xnd_mmap_create(const char *path, const ndt_t *t, ndt_context_t *ctx);
+XND_API xnd_master_t *xnd_mmap_open(const char *path, enum xnd_mmap_mode mode, ndt_context_t *ctx);
+XND_API int xnd_mmap_sync(const xnd_master_t *x, ndt_context_t *ctx);
+XND_API int xnd_mmap_save(const char *path, const xnd_t *x, ndt_context_t *ctx);
+
+/* String and bytes payloads of master buffers with XND_STRING_HEAP. */
+XND_API xnd_heap_t *xnd_heap(const xnd_master_t *x);
+XND_API char *xnd_heap_string(xnd_heap_t *heap, const char *s, int64_t size, ndt_context_t *ctx);
+XND_API uint8_t *xnd_heap_bytes(xnd_heap_t *heap, const void *data, int64_t size, uint16_t align, ndt_context_t *ctx);
+
 
 /*****************************************************************************/
 /*                         Traverse xnd memory blocks                        */
@@ -159,6 +188,12 @@ XND_API int xnd_strict_equal(const xnd_t *x, const xnd_t *y, ndt_context_t *ctx)
 
 XND_API int xnd_copy(xnd_t *y, const xnd_t *x, uint32_t flags, ndt_context_t *ctx);
 
+/* Categorical codes and values. */
+XND_API int64_t xnd_categorical_code(const xnd_t *x);
+XND_API void xnd_categorical_set_code(xnd_t *x, int64_t code);
+XND_API int64_t xnd_categorical_encode(xnd_t *x, const ndt_value_t *v, ndt_context_t *ctx);
+XND_API const ndt_value_t *xnd_categorical_decode(const xnd_t *x, ndt_context_t *ctx);
+
 
 /*****************************************************************************/
 /*                                  Bitmaps                                  */
@@ -172,6 +207,21 @@ XND_API void xnd_set_na(xnd_t *x);
 XND_API int xnd_is_valid(const xnd_t *x);
 XND_API int xnd_is_na(const xnd_t *x);
 
+/* Bulk operations on the bits [pos, pos+n) of bitmap data. */
+XND_API void xnd_bitmap_set_valid(uint8_t *data, int64_t pos, int64_t n);
+XND_API void xnd_bitmap_set_na(uint8_t *data, int64_t pos, int64_t n);
+XND_API int64_t xnd_bitmap_count_valid(const uint8_t *data, int64_t pos, int64_t n);
+XND_API void xnd_bitmap_and(uint8_t *out, int64_t opos,
+                            const uint8_t *a, int64_t apos,
+                            const uint8_t *b, int64_t bpos, int64_t n);
+XND_API void xnd_bitmap_or(uint8_t *out, int64_t opos,
+                           const uint8_t *a, int64_t apos,
+                           const uint8_t *b, int64_t bpos, int64_t n);
+XND_API void xnd_bitmap_andnot(uint8_t *out, int64_t opos,
+                               const uint8_t *a, int64_t apos,
+                               const uint8_t *b, int64_t bpos, int64_t n);
+XND_API int64_t xnd_bitmap_next_valid(const uint8_t *data, int64_t pos, int64_t end);
+
 
 /*****************************************************************************/
 /*                               Error handling                              */
@@ -205,6 +255,19 @@ xnd_ndim(const xnd_t *x)
     return x->type->ndim;
 }
 
+/* Size of a string in a master buffer with 'flags', without the NUL byte. */
+static inline int64_t
+xnd_string_size(const char *s, uint32_t flags)
+{
+    if (s == NULL) {
+        return 0;
+    }
+    if (flags & XND_STRING_HEAP) {
+        return XND_HEAP_STRING_SIZE(s);
+    }
+    return (int64_t)strlen(s);
+}
+
 static inline xnd_t
 xnd_fixed_dim_next(const xnd_t *x, const int64_t i)
 {
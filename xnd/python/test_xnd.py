@@ -30,7 +30,7 @@
 # OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #
 
-import sys, unittest, argparse
+import sys, os, unittest, argparse, tempfile
 from math import isinf, isnan
 from ndtypes import ndt, typedef
 from xnd import xnd, XndEllipsis
@@ -237,6 +237,61 @@ class TestFixedDim(XndTestCase):
                 x[i, j] = v[i][j] = -8.33e1 * i + j
         self.assertEqual(x.value, v)
 
+
+        ### Xnd values ###
+        v = [[float(4 * i + j) for j in range(4)] for i in range(6)]
+        x = xnd.empty("6 * 4 * float64")
+
+        # Contiguous source and destination
+        x[:] = xnd(v)
+        self.assertEqual(x.value, v)
+
+        # Strided source and destination
+        x = xnd.empty("6 * 4 * float64")
+        x[::2, 1:] = xnd(v)[1::2, :3]
+        self.assertEqual(x.value, [[0.0] + v[i+1][:3] if i % 2 == 0 else 4 * [0.0]
+                                   for i in range(6)])
+
+        # Fortran order
+        x = xnd.empty("!6 * 4 * float64")
+        x[:] = xnd(v)
+        self.assertEqual(x.value, v)
+
+        # Optional values
+        v = [[10.0, None, 2.0, 100.12], [None, None, 6.0, 7.0]]
+        x = xnd([[None, None, None, None], [None, None, None, None]],
+                type="2 * 4 * ?float64")
+        x[:] = xnd(v)
+        self.assertEqual(x.value, v)
+
+        x = xnd([[1.0, 1.0, 1.0, 1.0], [1.0, 1.0, 1.0, 1.0]],
+                type="2 * 4 * ?float64")
+        x[:, 1:3] = xnd(v)[:, ::2]
+        self.assertEqual(x.value, [[1.0, 10.0, 2.0, 1.0], [1.0, None, 6.0, 1.0]])
+
+        # Non-optional into optional
+        x = xnd([[None, None, None, None], [None, None, None, None]],
+                type="2 * 4 * ?float64")
+        x[1] = xnd([1.0, 2.0, 3.0, 4.0])
+        self.assertEqual(x.value, [[None, None, None, None], [1.0, 2.0, 3.0, 4.0]])
+
+        x[0, 2] = xnd(5.0)
+        self.assertEqual(x.value, [[None, None, 5.0, None], [1.0, 2.0, 3.0, 4.0]])
+
+        # A failed copy leaves missing values missing
+        x = xnd([None], type="1 * ?int8")
+        self.assertRaises(ValueError, x.__setitem__, 0, xnd(1000, type="int64"))
+        self.assertEqual(x.value, [None])
+
+        # Overlapping source and destination are copied element by element
+        x = xnd(list(range(10)))
+        x[1:] = x[:-1]
+        self.assertEqual(x.value, 10 * [0])
+
+        x = xnd(list(range(10)))
+        x[:-1] = x[1:]
+        self.assertEqual(x.value, list(range(1, 10)) + [9])
+
     @unittest.skipIf(sys.platform == "darwin",
                      "mach_vm_map message defeats the purpose of this test")
     def test_fixed_dim_overflow(self):
@@ -253,6 +308,63 @@ class TestFixedDim(XndTestCase):
             s = "32768 * 32768 * 2 * uint8"
             self.assertRaises(MemoryError, xnd.empty, s)
 
+    def test_fixed_dim_bulk(self):
+        # Innermost dimensions with primitive dtypes are converted in bulk.
+        test_cases = [
+          ("bool", [True, False, True, True, False]),
+          ("int8", [-128, 0, 1, 127, -3]),
+          ("int16", [-2**15, 0, 1, 2**15-1, -3]),
+          ("int32", [-2**31, 0, 1, 2**31-1, -3]),
+          ("int64", [-2**63, 0, 1, 2**63-1, -3]),
+          ("uint8", [0, 1, 2, 255, 3]),
+          ("uint16", [0, 1, 2, 2**16-1, 3]),
+          ("uint32", [0, 1, 2, 2**32-1, 3]),
+          ("uint64", [0, 1, 2, 2**64-1, 3]),
+          ("float32", [0.5, -1.25, float("inf"), 1e10, -0.0]),
+          ("float64", [0.5, -1.25, float("inf"), 1e300, -0.0]),
+        ]
+
+        for dtype, v in test_cases:
+            for endian in ["", "<", ">"]:
+                t = "%s%s" % (endian, dtype)
+                x = xnd(v, dtype=t)
+                self.assertEqual(x.value, v)
+                self.assertEqual([x[i] for i in range(5)], v)
+
+                w = [v[:], v[::-1], v[:]]
+                x = xnd(w, dtype=t)
+                self.assertEqual(x.value, w)
+                self.assertEqual(x[1].value, v[::-1])
+                self.assertEqual(x[:, ::-2].value, [u[::-2] for u in w])
+
+                x[::2, 1::2] = [[v[0], v[0]], [v[1], v[1]]]
+                w[0][1] = w[0][3] = v[0]
+                w[2][1] = w[2][3] = v[1]
+                self.assertEqual(x.value, w)
+
+                w = [[None, v[0]], [v[1], None], [None, None]]
+                x = xnd(w, dtype="?" + t)
+                self.assertEqual(x.value, w)
+                self.assertEqual(x[:, ::-1].value, [u[::-1] for u in w])
+
+                x[1] = w[1] = [None, v[2]]
+                self.assertEqual(x.value, w)
+
+            if dtype != "bool":
+                self.assertRaises(TypeError, xnd, [[v[0], "a"]], dtype=dtype)
+            self.assertRaises((TypeError, ValueError), xnd, [v[0], None], dtype=dtype)
+
+        # The errors are the same as for scalars.
+        for v, dtype in [(2**63, "int64"), (-1, "uint8"), (256, "uint8"),
+                         (1e300, "float32"), ("a", "float64")]:
+            with self.assertRaises(Exception) as cm:
+                xnd(v, type=dtype)
+            self.assertRaises(type(cm.exception), xnd, [0, v], dtype=dtype)
+
+        # Values that are not exact ints or floats.
+        x = xnd([True, 2, 3.5], dtype="float64")
+        self.assertEqual(x.value, [1.0, 2.0, 3.5])
+
     def test_fixed_dim_richcompare(self):
 
         x = xnd([1,2,3,4])
@@ -367,6 +479,60 @@ class TestFixedDim(XndTestCase):
                     y[indices] = w
                     self.assertNotStrictEqual(x, y)
 
+    def test_fixed_dim_richcompare_blocks(self):
+
+        for dtype, v, w in [("int8", 7, 8), ("uint16", 300, 301),
+                            ("int64", -2**40, 2**40), ("float32", 1.5, 1.75),
+                            ("float64", -3.25, 3.25), ("complex64", 1.5-2j, 1.5+2j),
+                            ("complex128", 3+4j, 4+3j), ("fixed_string(3)", "abc", "abd"),
+                            ("fixed_bytes(size=2)", b"xy", b"yx")]:
+
+            vv = [[v] * 37 for _ in range(5)]
+            x = xnd(vv, dtype=dtype)
+            y = xnd(vv, type="!5 * 37 * %s" % dtype)
+            self.assertStrictEqual(x, y)
+            self.assertStrictEqual(x[::2, 1::3], y[::2, 1::3])
+            self.assertStrictEqual(x[1:3], y[1:3])
+
+            for i, j in [(0, 0), (4, 36), (2, 17)]:
+                y = xnd(vv, dtype=dtype)
+                y[i, j] = w
+                self.assertNotStrictEqual(x, y)
+                y[i, j] = v
+                self.assertStrictEqual(x, y)
+
+                y = xnd(vv, dtype="?%s" % dtype)
+                y[i, j] = None
+                self.assertNotStrictEqual(x, y)
+
+        # NaN is never equal, signed zeros are equal.
+        for dtype in ["float32", "float64", "complex64", "complex128"]:
+            x = xnd(1000 * [0.0], dtype=dtype)
+            y = xnd(1000 * [-0.0], dtype=dtype)
+            self.assertStrictEqual(x, y)
+
+            y[961] = float("nan")
+            self.assertNotStrictEqual(x, y)
+            self.assertNotStrictEqual(y, y)
+
+        x = xnd([complex(1.0, 0.0), complex(2.0, -0.0)], dtype="complex128")
+        y = xnd([complex(1.0, -0.0), complex(2.0, float("nan"))], dtype="complex128")
+        self.assertNotStrictEqual(x, y)
+        self.assertStrictEqual(x[0:1], y[0:1])
+
+        # Non-native byte order.
+        x = xnd(100 * [1.0], dtype=">float64")
+        y = xnd(100 * [1.0], dtype="<float64")
+        self.assertStrictEqual(x, x)
+        self.assertStrictEqual(y, y)
+
+        # Var dimensions.
+        x = xnd([[1.0, float("nan")], [2.0, 3.0, 4.0]])
+        y = xnd([[1.0, float("nan")], [2.0, -0.0, 4.0]])
+        self.assertStrictEqual(x[1:, ::2], y[1:, ::2])
+        self.assertNotStrictEqual(x[0], y[0])
+        self.assertNotStrictEqual(x[1], y[1])
+
 
 class TestFortran(XndTestCase):
 
@@ -701,8 +867,39 @@ class TestVarDim(XndTestCase):
             x[1, i] = v[1][i] = -3e22 * i
         self.assertEqual(x.value, v)
 
+        # Xnd values
+        y = xnd([[None, -1.5], [2.0, None, 4.0]], dtype="?float64")
+        x[0] = y[0]
+        x[1] = y[1]
+        v = [[None, -1.5], [2.0, None, 4.0]]
+        self.assertEqual(x.value, v)
+
+        y = xnd([[7.0, 8.0, 9.0], [10.0, 11.0]])
+        x[1] = y[0]
+        v[1] = [7.0, 8.0, 9.0]
+        self.assertEqual(x.value, v)
+
+    def test_var_dim_bulk(self):
+        # Innermost var dimensions with primitive dtypes are converted in bulk.
+        for dtype in ["int8", "uint16", "int64", "float32", "?float64", "?bool"]:
+            v = [[1, 0], [0, 1, 1], [], [1]]
+            if dtype.startswith("?"):
+                v[1][1] = None
+
+            x = xnd(v, dtype=dtype)
+            self.assertEqual(x.value, v)
+            self.assertEqual(x[::-1, ::-1].value, [u[::-1] for u in v[::-1]])
+            self.assertEqual(x[1:, 1:].value, [u[1:] for u in v[1:]])
+
+            y = x[::-1]
+            y[2] = [0, 0, 0]
+            v[1] = [0, 0, 0]
+            self.assertEqual(x.value, v)
+
+            self.assertRaises(ValueError, y.__setitem__, 2, [0, 0])
+
     def test_var_dim_overflow(self):
-        s = "var(offsets=[0, 2]) * var(offsets=[0, 1073741824, 2147483648]) * uint8"
+        s = "var(offsets=[0, 2]) * var(offsets=[0, 2, 4611686018427387904]) * uint16"
         self.assertRaises(ValueError, xnd.empty, s)
 
     def test_var_dim_match(self):
@@ -1742,6 +1939,55 @@ class TestCategorical(XndTestCase):
         y = xnd(['August', None, 'August'], type=t)
         self.assertNotStrictEqual(x, y)
 
+    def test_categorical_code_width(self):
+        # Codes use the narrowest unsigned width for the number of categories.
+        for n, size in [(3, 1), (300, 2), (70000, 4)]:
+            cats = ["c%d" % i for i in range(n)]
+            s = "categorical(NA, %s)" % ", ".join("'%s'" % c for c in cats)
+            t = ndt("%d * %s" % (n, s))
+            self.assertEqual(t.itemsize, size)
+
+            v = list(reversed(cats))
+            x = xnd(v, type=t)
+            self.assertEqual(x.value, v)
+            self.assertEqual(x[n-1], cats[0])
+
+            x[0] = "unknown"
+            self.assertEqual(x[0], None)
+            x[0] = cats[n-1]
+            self.assertEqual(x[0], cats[n-1])
+
+            y = xnd.empty(t)
+            y[:] = x
+            self.assertStrictEqual(x, y)
+
+        t = "2 * categorical(1, 2.5, -0.0, 'a')"
+        x = xnd([1, 'a'], type=t)
+        self.assertEqual(x.value, [1, 'a'])
+        x[0] = 2.5
+        x[1] = 0.0
+        self.assertEqual(x.value, [2.5, -0.0])
+        self.assertRaises(ValueError, x.__setitem__, 0, 'b')
+        self.assertRaises(ValueError, x.__setitem__, 0, None)
+
+        # Values can be copied and compared across code widths.
+        old = "2 * categorical(NA, 'a', 'b', code_size=8)"
+        x = xnd(['b', None], type=old)
+        y = xnd.empty("2 * categorical(NA, 'a', 'b')")
+        y[:] = x
+        self.assertEqual(y.value, ['b', None])
+        self.assertEqual(x[0], y[0])
+        x[:] = xnd(['a', 'b'], type="2 * categorical(NA, 'a', 'b')")
+        self.assertEqual(x.value, ['a', 'b'])
+        y[0] = x[0]
+        self.assertStrictEqual(x[0], y[0])
+
+        z = xnd.empty("2 * ?categorical(NA, 'a', 'b')")
+        z[0] = x[1]
+        self.assertEqual(z.value, ['b', None])
+        self.assertRaises(TypeError, z.__setitem__, 0,
+                          xnd('a', type="categorical('a', 'b')"))
+
 
 class TestFixedStringKind(XndTestCase):
 
@@ -1959,6 +2205,40 @@ class TestString(XndTestCase):
 
         self.assertNotStrictEqual(x, xnd("acb"))
 
+    def test_string_heap(self):
+        test_cases = [
+          ([], '0 * string'),
+          (["", "a", "bc", 1000 * "x"], '4 * string'),
+          ([["ä", "€", "𝄞"], [], ["z"]], None),
+          ([R['a': 1, 'b': "x"], R['a': 2, 'b': "yz"]], '2 * {a: int64, b: string}'),
+          (["abc\0\0"], '1 * string')
+        ]
+
+        for v, s in test_cases:
+            x = xnd(v, type=s, string_heap=True)
+            y = xnd(v, type=s)
+            self.assertEqual(x.type, y.type)
+            self.assertStrictEqual(x, y)
+            self.assertEqual(x.value, y.value)
+
+        # Values that are larger than the initial heap chunk.
+        v = ["%d" % i * (i % 50) for i in range(10000)]
+        x = xnd(v, string_heap=True)
+        self.assertEqual(x.value, v)
+
+        # Assignment allocates new values in the heap.
+        x = xnd(["a", "b", "c"], string_heap=True)
+        x[1] = "xyz"
+        x[2] = xnd("uvw")
+        self.assertEqual(x.value, ["a", "xyz", "uvw"])
+
+        x = xnd([["a"], ["b", "c"]], string_heap=True)
+        x[1] = xnd(["d", "e"])
+        self.assertEqual(x.value, [["a"], ["d", "e"]])
+
+        self.assertRaises(TypeError, xnd, ["a", 1], type="2 * string",
+                          string_heap=True)
+
 
 class TestBytes(XndTestCase):
 
@@ -1993,6 +2273,21 @@ class TestBytes(XndTestCase):
 
         self.assertEqual(x.value, v)
 
+    def test_bytes_heap(self):
+        test_cases = [
+          ([b'', b'a', b'bc\0d'], '3 * bytes'),
+          ([(b'xyz', b'a'), (b'', b'b')], '2 * (bytes(align=16), bytes)'),
+          ([[b'abc'], [b'd', b'efgh']], None)
+        ]
+
+        for v, s in test_cases:
+            x = xnd(v, type=s, string_heap=True)
+            self.assertEqual(x.value, v)
+
+        x = xnd(v, type=s, string_heap=True)
+        x[1, 0] = b'uvw'
+        self.assertEqual(x.value, [[b'abc'], [b'uvw', b'efgh']])
+
 
 class TestChar(XndTestCase):
 
@@ -2818,6 +3113,135 @@ class TestBuffer(XndTestCase):
         self.assertEqual(x.tolist(), [1000, 2000, 3000])
 
 
+@unittest.skipIf(sys.platform == "win32", "mmap is not supported on Windows")
+class TestMmap(XndTestCase):
+
+    def setUp(self):
+        self.tmpdir = tempfile.TemporaryDirectory()
+        self.path = os.path.join(self.tmpdir.name, "x.xnd")
+
+    def tearDown(self):
+        self.tmpdir.cleanup()
+
+    def test_mmap_modes(self):
+        x = xnd.mmap(self.path, "w+", type="2 * 3 * ?float64")
+        self.assertEqual(x.value, [[None, None, None], [None, None, None]])
+        x[0] = [1.5, None, 2.5]
+        x[1, 2] = -1.0
+        del x
+
+        v = [[1.5, None, 2.5], [None, None, -1.0]]
+        x = xnd.mmap(self.path)
+        self.assertEqual(x.type, ndt("2 * 3 * ?float64"))
+        self.assertEqual(x.value, v)
+        self.assertRaises(TypeError, x.__setitem__, (0, 0), 10.0)
+        del x
+
+        x = xnd.mmap(self.path, "c")
+        x[0, 0] = 10.0
+        self.assertEqual(x[0, 0], 10.0)
+        del x
+        self.assertEqual(xnd.mmap(self.path).value, v)
+
+        x = xnd.mmap(self.path, "r+")
+        y = xnd.mmap(self.path, "r")
+        x[0, 0] = 10.0
+        x[1, 1] = 7.0
+        v[0][0] = 10.0
+        v[1][1] = 7.0
+        self.assertEqual(y.value, v)
+        del x, y
+        self.assertEqual(xnd.mmap(self.path).value, v)
+
+    def test_mmap_types(self):
+        for t, v in [
+          ("10 * int8", list(range(10))),
+          ("3 * 2 * complex128", [[1+2j, 3j], [0j, -1j], [2+0j, 1j]]),
+          ("2 * {a: int64, b: (float32, fixed_bytes(size=2))}",
+           [{'a': 1, 'b': (1.5, b'ab')}, {'a': -1, 'b': (0.5, b'cd')}]),
+          ("var(offsets=[0,2]) * var(offsets=[0,3,4]) * ?uint16",
+           [[1, None, 3], [None]])]:
+
+            x = xnd.mmap(self.path, "w+", type=t)
+            x[:] = v
+            del x
+
+            x = xnd.mmap(self.path)
+            self.assertEqual(x.type, ndt(t))
+            self.assertEqual(x.value, v)
+
+    def test_mmap_save(self):
+        for v, kwargs in [
+          ([1, None, 3], {}),
+          (["", "abc", None, "\U0001F600" * 10], {}),
+          ([b"", b"123", None, b"\x00" * 100], {}),
+          ([[{'a': "x", 'b': None}], [], [{'a': None, 'b': 2.5}] * 3],
+           {'dtype': "{a: ?string, b: ?float64}"}),
+          ([(b"ab", "cd", (None, 1))] * 5,
+           {'type': "5 * (bytes(align=16), string, (?int8, ?int64))"}),
+          ([{'a': None, 'b': [1, None]}, {'a': 3, 'b': [None, 4]}],
+           {'type': "2 * {a: ?int32, b: 2 * ?uint8}"})]:
+
+            x = xnd(v, **kwargs)
+            x.save(self.path)
+
+            y = xnd.mmap(self.path)
+            self.assertEqual(y.type, x.type)
+            self.assertEqual(y.value, x.value)
+
+            # Mapped containers can be saved again.
+            path = self.path + ".copy"
+            y.save(path)
+            self.assertEqual(xnd.mmap(path).value, x.value)
+
+        x = xnd(["abc", "xyz"])
+        x.save(self.path)
+        y = xnd.mmap(self.path)
+        self.assertRaises(TypeError, y.__setitem__, 0, "x")
+        self.assertRaises(NotImplementedError, xnd.mmap, self.path, "c")
+        self.assertRaises(NotImplementedError, xnd.mmap, self.path, "r+")
+        self.assertRaises(ValueError, x[1:].save, self.path)
+
+        x = xnd(list(range(1000)), type="1000 * float64")
+        x.save(self.path)
+        y = xnd.mmap(self.path, "r+")
+        y[0] = -1.0
+        del y
+        self.assertEqual(xnd.mmap(self.path)[:3].value, [-1.0, 1.0, 2.0])
+
+    def test_mmap_buffer(self):
+        x = xnd.mmap(self.path, "w+", type="2 * 3 * int32")
+        x[1] = [4, 5, 6]
+        b = bytes(memoryview(xnd([[0, 0, 0], [4, 5, 6]], type="2 * 3 * int32")))
+        m = memoryview(x)
+        self.assertFalse(m.readonly)
+        self.assertEqual(m.tobytes(), b)
+        m.release()
+        del x
+
+        x = xnd.mmap(self.path)
+        m = memoryview(x)
+        self.assertTrue(m.readonly)
+        self.assertEqual(m.tobytes(), b)
+
+    def test_mmap_errors(self):
+        self.assertRaises(NotImplementedError, xnd.mmap, self.path, "w+",
+                          type="10 * string")
+        self.assertRaises(NotImplementedError, xnd.mmap, self.path, "w+",
+                          type="10 * ref(int64)")
+        self.assertRaises(ValueError, xnd.mmap, self.path, "w+",
+                          type="N * int64")
+        self.assertRaises(TypeError, xnd.mmap, self.path, "w+")
+        self.assertRaises(ValueError, xnd.mmap, self.path, "x")
+        self.assertRaises(OSError, xnd.mmap, self.path + ".nonexistent")
+
+        with open(self.path, "wb") as f:
+            f.write(b"x" * 100)
+        self.assertRaises(ValueError, xnd.mmap, self.path)
+
+        self.assertRaises(ValueError, xnd.mmap, self.path, "r", type="10 * int64")
+
+
 class TestSpec(XndTestCase):
 
     def __init__(self, *, constr,
@@ -3069,6 +3493,7 @@ ALL_TESTS = [
   TestAPI,
   TestRepr,
   TestBuffer,
+  TestMmap,
   LongIndexSliceTest,
 ]
 
@@ -92,6 +92,12 @@ class xnd(Xnd):
            >>> xnd.empty("100000 * uint8")
            xnd([0, 0, 0, 0, 0, 0, 0, 0, 0, ...], type="100000 * uint8")
 
+       Store all string and bytes values in one heap instead of allocating
+       each value separately:
+
+           >>> xnd(["a", "bc", "def"], string_heap=True)
+           xnd(['a', 'bc', 'def'], type="3 * string")
+
        Import a memory block from a buffer exporter:
 
            >>> xnd.from_buffer(b"123")
@@ -99,7 +105,7 @@ class xnd(Xnd):
     """
 
     def __new__(cls, value, *, type=None, dtype=None, levels=None,
-                typedef=None, dtypedef=None):
+                typedef=None, dtypedef=None, string_heap=False):
         if (type, dtype, levels, typedef, dtypedef).count(None) < 2:
             raise TypeError(
                 "the 'type', 'dtype', 'levels' and 'typedef' arguments are "
@@ -124,7 +130,8 @@ class xnd(Xnd):
             type = typeof(value, dtype=dtype)
         else:
             type = typeof(value)
-        return super().__new__(cls, type=type, value=value)
+        return super().__new__(cls, type=type, value=value,
+                               string_heap=string_heap)
 
     def __repr__(self):
         value = self.short_value(maxshape=10)
@@ -145,6 +152,19 @@ class xnd(Xnd):
             type = ndt(type)
         return cls._unsafe_from_data(obj, type)
 
+    @classmethod
+    def mmap(cls, path, mode="r", type=None):
+        """Return an xnd object whose memory is a mapping of the container
+           file 'path'.  Modes are 'r' (read-only), 'c' (copy-on-write),
+           'r+' (shared, writes go to the file) and 'w+' (create a new file
+           for values of 'type' and map it shared).  Files that are written
+           by the save() method and contain string or bytes values can only
+           be opened with mode 'r'.  Ref types cannot be mapped.
+        """
+        if isinstance(type, str):
+            type = ndt(type)
+        return cls._mmap(path, mode, type)
+
 
 # ======================================================================
 #                            Type inference
@@ -114,7 +114,7 @@ static PyTypeObject XndEllipsis_Type = {
 /*                           MemoryBlock Object                             */
 /****************************************************************************/
 
-static int mblock_init(xnd_t * const x, PyObject *v);
+static int mblock_init(xnd_t * const x, PyObject *v, xnd_heap_t *heap);
 static PyTypeObject MemoryBlock_Type;
 
 
@@ -131,6 +131,8 @@ mblock_alloc(void)
     self->type = NULL;
     self->xnd = NULL;
     self->view = NULL;
+    self->readers = 0;
+    self->writers = 0;
 
     PyObject_GC_Track(self);
     return self;
@@ -162,7 +164,7 @@ mblock_dealloc(MemoryBlockObject *self)
 }
 
 static MemoryBlockObject *
-mblock_empty(PyObject *type)
+mblock_empty(PyObject *type, uint32_t flags)
 {
     NDT_STATIC_CONTEXT(ctx);
     MemoryBlockObject *self;
@@ -177,7 +179,7 @@ mblock_empty(PyObject *type)
         return NULL;
     }
 
-    self->xnd = xnd_empty_from_type(CONST_NDT(type), XND_OWN_EMBEDDED, &ctx);
+    self->xnd = xnd_empty_from_type(CONST_NDT(type), flags, &ctx);
     if (self->xnd == NULL) {
         Py_DECREF(self);
         return (MemoryBlockObject *)seterr(&ctx);
@@ -189,16 +191,16 @@ mblock_empty(PyObject *type)
 }
 
 static MemoryBlockObject *
-mblock_from_typed_value(PyObject *type, PyObject *value)
+mblock_from_typed_value(PyObject *type, PyObject *value, uint32_t flags)
 {
     MemoryBlockObject *self;
 
-    self = mblock_empty(type);
+    self = mblock_empty(type, flags);
     if (self == NULL) {
         return NULL;
     }
 
-    if (mblock_init(&self->xnd->master, value) < 0) {
+    if (mblock_init(&self->xnd->master, value, xnd_heap(self->xnd)) < 0) {
         Py_DECREF(self);
         return NULL;
     }
@@ -393,6 +395,115 @@ mblock_from_buffer_and_type(PyObject *obj, PyObject *type)
     return self;
 }
 
+/* The mapping owns its type, the Python type needs its own copy. */
+static PyObject *
+type_from_mapping(const ndt_t *t)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    PyObject *ndtypes, *ndt, *bytes, *type;
+    char *s;
+    int64_t len;
+
+    len = ndt_serialize(&s, t, &ctx);
+    if (len < 0) {
+        return seterr(&ctx);
+    }
+
+    bytes = PyBytes_FromStringAndSize(s, (Py_ssize_t)len);
+    ndt_free(s);
+    if (bytes == NULL) {
+        return NULL;
+    }
+
+    ndtypes = PyImport_ImportModule("ndtypes");
+    if (ndtypes == NULL) {
+        Py_DECREF(bytes);
+        return NULL;
+    }
+
+    ndt = PyObject_GetAttrString(ndtypes, "ndt");
+    Py_DECREF(ndtypes);
+    if (ndt == NULL) {
+        Py_DECREF(bytes);
+        return NULL;
+    }
+
+    type = PyObject_CallMethod(ndt, "deserialize", "O", bytes);
+    Py_DECREF(ndt);
+    Py_DECREF(bytes);
+
+    return type;
+}
+
+static MemoryBlockObject *
+mblock_from_mmap(const char *path, const char *mode, PyObject *type)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    MemoryBlockObject *self;
+    xnd_master_t *x;
+
+    if (strcmp(mode, "w+") == 0) {
+        if (type == NULL || !Ndt_Check(type)) {
+            PyErr_SetString(PyExc_TypeError, "mode 'w+' requires an ndt object");
+            return NULL;
+        }
+        x = xnd_mmap_create(path, CONST_NDT(type), &ctx);
+    }
+    else {
+        enum xnd_mmap_mode m;
+
+        if (strcmp(mode, "r") == 0) {
+            m = MmapReadOnly;
+        }
+        else if (strcmp(mode, "c") == 0) {
+            m = MmapCopyOnWrite;
+        }
+        else if (strcmp(mode, "r+") == 0) {
+            m = MmapShared;
+        }
+        else {
+            PyErr_SetString(PyExc_ValueError,
+                "mode must be 'r', 'c', 'r+' or 'w+'");
+            return NULL;
+        }
+
+        if (type != NULL) {
+            PyErr_SetString(PyExc_ValueError,
+                "the type argument requires mode 'w+'");
+            return NULL;
+        }
+
+        x = xnd_mmap_open(path, m, &ctx);
+    }
+
+    if (x == NULL) {
+        return (MemoryBlockObject *)seterr(&ctx);
+    }
+
+    self = mblock_alloc();
+    if (self == NULL) {
+        xnd_del(x);
+        return NULL;
+    }
+    self->xnd = x;
+
+    if (type != NULL) {
+        Py_INCREF(type);
+    }
+    else {
+        type = type_from_mapping(x->master.type);
+        if (type == NULL) {
+            Py_DECREF(self);
+            return NULL;
+        }
+    }
+
+    self->type = type;
+    self->xnd->master.type = CONST_NDT(self->type);
+
+    return self;
+}
+
 
 static PyTypeObject MemoryBlock_Type = {
     PyVarObject_HEAD_INIT(NULL, 0)
@@ -508,8 +619,126 @@ get_uint(PyObject *v, uint64_t max)
     return x;
 }
 
+/*
+ * Bulk conversion of the innermost dimension of arrays with a primitive
+ * numeric dtype.  The dtype is dispatched once per dimension, the elements
+ * are converted in a tight loop without constructing an xnd_t per value.
+ */
+static inline bool
+bulk_dtype(const ndt_t *t)
+{
+    switch (t->tag) {
+    case Bool:
+    case Int8: case Int16: case Int32: case Int64:
+    case Uint8: case Uint16: case Uint32: case Uint64:
+    case Float32: case Float64:
+        return true;
+    default:
+        return false;
+    }
+}
+
+#define BULK_INIT_LOOP(convert) \
+    for (i = 0, k = index; i < shape; i++, k += step) {   \
+        PyObject *item = PyList_GET_ITEM(v, i);           \
+        char *ptr = x->ptr + k * u->datasize;             \
+        if (optional) {                                   \
+            if (item == Py_None) {                        \
+                bitmap[k>>3] &= ~((uint8_t)1 << (k&7));   \
+                continue;                                 \
+            }                                             \
+            bitmap[k>>3] |= ((uint8_t)1 << (k&7));        \
+        }                                                 \
+        convert                                           \
+    }                                                     \
+    return 0
+
+#define BULK_INIT_INT(type, min, max) \
+    BULK_INIT_LOOP(                                       \
+        type tmp = (type)get_int(item, min, max);         \
+        if (tmp == -1 && PyErr_Occurred()) {              \
+            return -1;                                    \
+        }                                                 \
+        PACK_SINGLE(ptr, tmp, type, u->flags);            \
+    )
+
+#define BULK_INIT_UINT(type, max) \
+    BULK_INIT_LOOP(                                       \
+        type tmp = (type)get_uint(item, max);             \
+        if (tmp == max && PyErr_Occurred()) {             \
+            return -1;                                    \
+        }                                                 \
+        PACK_SINGLE(ptr, tmp, type, u->flags);            \
+    )
+
+#define BULK_INIT_FLOAT(pack) \
+    BULK_INIT_LOOP(                                                     \
+        double tmp = PyFloat_CheckExact(item) ? PyFloat_AS_DOUBLE(item) \
+                                              : PyFloat_AsDouble(item); \
+        if (tmp == -1 && PyErr_Occurred()) {                            \
+            return -1;                                                  \
+        }                                                               \
+        if (pack(tmp, (unsigned char *)ptr, le(u->flags)) < 0) {        \
+            return -1;                                                  \
+        }                                                               \
+    )
+
+/*
+ * Initialize the elements of the dimension 'x' from the list 'v'.  'index'
+ * is the linear index of the first element and 'step' the distance between
+ * elements.  The size of 'v' has been checked by the caller.
+ */
 static int
-mblock_init(xnd_t * const x, PyObject *v)
+bulk_init(const xnd_t *x, PyObject *v, const int64_t index, const int64_t step)
+{
+    const ndt_t * const u = x->type->tag == FixedDim ? x->type->FixedDim.type
+                                                      : x->type->VarDim.type;
+    const int64_t shape = PyList_GET_SIZE(v);
+    const bool optional = ndt_is_optional(u);
+    uint8_t * const bitmap = x->bitmap.data;
+    int64_t i, k;
+
+    assert(u->ndim == 0 && bulk_dtype(u));
+    assert(!optional || bitmap != NULL);
+
+    switch (u->tag) {
+    case Bool:
+        BULK_INIT_LOOP(
+            int tmp;
+            if (item == Py_None) {
+                PyErr_SetString(PyExc_ValueError,
+                    "assigning None to memory block with non-optional type");
+                return -1;
+            }
+            tmp = PyObject_IsTrue(item);
+            if (tmp < 0) {
+                return -1;
+            }
+            PACK_SINGLE(ptr, (bool)tmp, bool, u->flags);
+        );
+    case Int8: BULK_INIT_INT(int8_t, INT8_MIN, INT8_MAX);
+    case Int16: BULK_INIT_INT(int16_t, INT16_MIN, INT16_MAX);
+    case Int32: BULK_INIT_INT(int32_t, INT32_MIN, INT32_MAX);
+    case Int64: BULK_INIT_INT(int64_t, INT64_MIN, INT64_MAX);
+    case Uint8: BULK_INIT_UINT(uint8_t, UINT8_MAX);
+    case Uint16: BULK_INIT_UINT(uint16_t, UINT16_MAX);
+    case Uint32: BULK_INIT_UINT(uint32_t, UINT32_MAX);
+    case Uint64: BULK_INIT_UINT(uint64_t, UINT64_MAX);
+    case Float32: BULK_INIT_FLOAT(_PyFloat_Pack4);
+    case Float64: BULK_INIT_FLOAT(_PyFloat_Pack8);
+    default:
+        PyErr_SetString(PyExc_RuntimeError, "unexpected dtype in bulk conversion");
+        return -1;
+    }
+}
+
+#undef BULK_INIT_FLOAT
+#undef BULK_INIT_UINT
+#undef BULK_INIT_INT
+#undef BULK_INIT_LOOP
+
+static int
+mblock_init(xnd_t * const x, PyObject *v, xnd_heap_t *heap)
 {
     NDT_STATIC_CONTEXT(ctx);
     const ndt_t * const t = x->type;
@@ -556,9 +785,13 @@ mblock_init(xnd_t * const x, PyObject *v)
             return -1;
         }
 
+        if (t->FixedDim.type->ndim == 0 && bulk_dtype(t->FixedDim.type)) {
+            return bulk_init(x, v, x->index, t->Concrete.FixedDim.step);
+        }
+
         for (i = 0; i < shape; i++) {
             xnd_t next = xnd_fixed_dim_next(x, i);
-            if (mblock_init(&next, PyList_GET_ITEM(v, i)) < 0) {
+            if (mblock_init(&next, PyList_GET_ITEM(v, i), heap) < 0) {
                 return -1;
             }
         }
@@ -587,9 +820,13 @@ mblock_init(xnd_t * const x, PyObject *v)
             return -1;
         }
 
+        if (t->VarDim.type->ndim == 0 && bulk_dtype(t->VarDim.type)) {
+            return bulk_init(x, v, start, step);
+        }
+
         for (i = 0; i < shape; i++) {
             xnd_t next = xnd_var_dim_next(x, start, step, i);
-            if (mblock_init(&next, PyList_GET_ITEM(v, i)) < 0) {
+            if (mblock_init(&next, PyList_GET_ITEM(v, i), heap) < 0) {
                 return -1;
             }
         }
@@ -619,7 +856,7 @@ mblock_init(xnd_t * const x, PyObject *v)
                 return seterr_int(&ctx);
             }
 
-            if (mblock_init(&next, PyTuple_GET_ITEM(v, i)) < 0) {
+            if (mblock_init(&next, PyTuple_GET_ITEM(v, i), heap) < 0) {
                 return -1;
             }
         }
@@ -660,7 +897,7 @@ mblock_init(xnd_t * const x, PyObject *v)
                 return -1;
             }
 
-            ret = mblock_init(&next, tmp);
+            ret = mblock_init(&next, tmp, heap);
             Py_DECREF(tmp);
             if (ret < 0) {
                 return -1;
@@ -676,7 +913,7 @@ mblock_init(xnd_t * const x, PyObject *v)
             return seterr_int(&ctx);
         }
 
-        return mblock_init(&next, v);
+        return mblock_init(&next, v, heap);
     }
 
     case Constr: {
@@ -685,7 +922,7 @@ mblock_init(xnd_t * const x, PyObject *v)
             return seterr_int(&ctx);
         }
 
-        return mblock_init(&next, v);
+        return mblock_init(&next, v, heap);
     }
 
     case Nominal: {
@@ -701,7 +938,7 @@ mblock_init(xnd_t * const x, PyObject *v)
             return 0;
         }
 
-        int ret = mblock_init(&next, v);
+        int ret = mblock_init(&next, v, heap);
         if (ret < 0) {
             return ret;
         }
@@ -1015,6 +1252,16 @@ mblock_init(xnd_t * const x, PyObject *v)
             return -1;
         }
 
+        /* Heap strings are never freed individually. */
+        if (heap != NULL) {
+            s = xnd_heap_string(heap, cp, size, &ctx);
+            if (s == NULL) {
+                return seterr_int(&ctx);
+            }
+            XND_POINTER_DATA(x->ptr) = s;
+            return 0;
+        }
+
         s = ndt_strdup(cp, &ctx);
         if (s == NULL) {
             return seterr_int(&ctx);
@@ -1037,6 +1284,17 @@ mblock_init(xnd_t * const x, PyObject *v)
             return -1;
         }
 
+        if (heap != NULL) {
+            s = (char *)xnd_heap_bytes(heap, cp, size, t->Bytes.target_align,
+                                       &ctx);
+            if (s == NULL) {
+                return seterr_int(&ctx);
+            }
+            XND_BYTES_SIZE(x->ptr) = size;
+            XND_BYTES_DATA(x->ptr) = (uint8_t *)s;
+            return 0;
+        }
+
         s = ndt_aligned_calloc(t->Bytes.target_align, size);
         if (s == NULL) {
             PyErr_NoMemory();
@@ -1055,22 +1313,18 @@ mblock_init(xnd_t * const x, PyObject *v)
     }
 
     case Categorical: {
-        int64_t k;
+        ndt_value_t value;
+
+        /* Values of other Python types are looked up as NA. */
+        value.tag = ValNA;
 
         if (PyBool_Check(v)) {
             int tmp = PyObject_IsTrue(v);
             if (tmp < 0) {
                 return -1;
             }
-
-            for (k = 0; k < t->Categorical.ntypes; k++) {
-                if (t->Categorical.types[k].tag == ValBool &&
-                    tmp == t->Categorical.types[k].ValBool) {
-                    PACK_SINGLE(x->ptr, k, int64_t, t->flags);
-                    return 0;
-                }
-            }
-            goto not_found;
+            value.tag = ValBool;
+            value.ValBool = tmp;
         }
 
         else if (PyLong_Check(v)) {
@@ -1078,15 +1332,8 @@ mblock_init(xnd_t * const x, PyObject *v)
             if (tmp == -1 && PyErr_Occurred()) {
                 return -1;
             }
-
-            for (k = 0; k < t->Categorical.ntypes; k++) {
-                if (t->Categorical.types[k].tag == ValInt64 &&
-                    tmp == t->Categorical.types[k].ValInt64) {
-                    PACK_SINGLE(x->ptr, k, int64_t, t->flags);
-                    return 0;
-                }
-            }
-            goto not_found;
+            value.tag = ValInt64;
+            value.ValInt64 = tmp;
         }
 
         else if (PyFloat_Check(v)) {
@@ -1094,16 +1341,8 @@ mblock_init(xnd_t * const x, PyObject *v)
             if (tmp == -1 && PyErr_Occurred()) {
                 return -1;
             }
-
-            for (k = 0; k < t->Categorical.ntypes; k++) {
-                /* XXX: DBL_EPSILON? */
-                if (t->Categorical.types[k].tag == ValFloat64 &&
-                    tmp == t->Categorical.types[k].ValFloat64) {
-                    PACK_SINGLE(x->ptr, k, int64_t, t->flags);
-                    return 0;
-                }
-            }
-            goto not_found;
+            value.tag = ValFloat64;
+            value.ValFloat64 = tmp;
         }
 
         else if (PyUnicode_Check(v)) {
@@ -1111,27 +1350,17 @@ mblock_init(xnd_t * const x, PyObject *v)
             if (tmp == NULL) {
                 return -1;
             }
-
-            for (k = 0; k < t->Categorical.ntypes; k++) {
-                if (t->Categorical.types[k].tag == ValString &&
-                    strcmp(tmp, t->Categorical.types[k].ValString) == 0) {
-                    PACK_SINGLE(x->ptr, k, int64_t, t->flags);
-                    return 0;
-                }
-            }
-            goto not_found;
+            value.tag = ValString;
+            value.ValString = (char *)tmp;
         }
 
-    not_found:
-        for (k = 0; k < t->Categorical.ntypes; k++) {
-            if (t->Categorical.types[k].tag == ValNA) {
-                PACK_SINGLE(x->ptr, k, int64_t, t->flags);
-                return 0;
-            }
+        if (xnd_categorical_encode(x, &value, &ctx) < 0) {
+            ndt_err_clear(&ctx);
+            PyErr_Format(PyExc_ValueError, "category not found for: %.200R", v);
+            return -1;
         }
 
-        PyErr_Format(PyExc_ValueError, "category not found for: %.200R", v);
-        return -1;
+        return 0;
     }
 
     case Char:
@@ -1168,7 +1397,8 @@ static PyTypeObject Xnd_Type;
 static inline bool
 is_readonly(XndObject *self)
 {
-    return self->mblock->view != NULL && self->mblock->view->readonly;
+    return (self->mblock->view != NULL && self->mblock->view->readonly) ||
+           (self->mblock->xnd->flags & XND_READONLY);
 }
 
 
@@ -1233,17 +1463,23 @@ pyxnd_from_mblock(PyTypeObject *tp, MemoryBlockObject *mblock)
 static PyObject *
 pyxnd_new(PyTypeObject *tp, PyObject *args, PyObject *kwds)
 {
-    static char *kwlist[] = {"type", "value", NULL};
+    static char *kwlist[] = {"type", "value", "string_heap", NULL};
     PyObject *type = NULL;
     PyObject *value = NULL;
+    int string_heap = 0;
+    uint32_t flags = XND_OWN_EMBEDDED;
     MemoryBlockObject *mblock;
 
-    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO", kwlist, &type,
-        &value)) {
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "OO|p", kwlist, &type,
+        &value, &string_heap)) {
         return NULL;
     }
 
-    mblock = mblock_from_typed_value(type, value);
+    if (string_heap) {
+        flags |= XND_STRING_HEAP;
+    }
+
+    mblock = mblock_from_typed_value(type, value, flags);
     if (mblock == NULL) {
         return NULL;
     }
@@ -1261,7 +1497,7 @@ pyxnd_empty(PyTypeObject *tp, PyObject *type)
         return NULL;
     }
 
-    mblock = mblock_empty(type);
+    mblock = mblock_empty(type, XND_OWN_EMBEDDED);
     Py_DECREF(type);
     if (mblock == NULL) {
         return NULL;
@@ -1303,6 +1539,30 @@ pyxnd_from_buffer_and_type(PyTypeObject *tp, PyObject *args, PyObject *kwds)
     return pyxnd_from_mblock(tp, mblock);
 }
 
+static PyObject *
+pyxnd_mmap(PyTypeObject *tp, PyObject *args, PyObject *kwds)
+{
+    static char *kwlist[] = {"path", "mode", "type", NULL};
+    PyObject *path = NULL;
+    const char *mode = "r";
+    PyObject *type = Py_None;
+    MemoryBlockObject *mblock;
+
+    if (!PyArg_ParseTupleAndKeywords(args, kwds, "O&|sO", kwlist,
+            PyUnicode_FSConverter, &path, &mode, &type)) {
+        return NULL;
+    }
+
+    mblock = mblock_from_mmap(PyBytes_AS_STRING(path), mode,
+                              type == Py_None ? NULL : type);
+    Py_DECREF(path);
+    if (mblock == NULL) {
+        return NULL;
+    }
+
+    return pyxnd_from_mblock(tp, mblock);
+}
+
 
 /******************************************************************************/
 /*                                 xnd methods                                */
@@ -1325,8 +1585,87 @@ dict_set_item(PyObject *dict, const char *k, PyObject *value)
     return ret;
 }
 
+#define BULK_VALUE_LOOP(convert) \
+    for (i = 0, k = index; i < shape; i++, k += step) {   \
+        const char *ptr = x->ptr + k * u->datasize;       \
+        PyObject *v;                                      \
+        if (optional && !(bitmap[k>>3] & ((uint8_t)1 << (k&7)))) { \
+            Py_INCREF(Py_None);                           \
+            PyList_SET_ITEM(lst, i, Py_None);             \
+            continue;                                     \
+        }                                                 \
+        convert                                           \
+        if (v == NULL) {                                  \
+            Py_DECREF(lst);                               \
+            return NULL;                                  \
+        }                                                 \
+        PyList_SET_ITEM(lst, i, v);                       \
+    }                                                     \
+    return lst
+
+#define BULK_VALUE(type, from) \
+    BULK_VALUE_LOOP(                                      \
+        type tmp;                                         \
+        UNPACK_SINGLE(tmp, ptr, type, u->flags);          \
+        v = from(tmp);                                    \
+    )
+
+#define BULK_VALUE_FLOAT(unpack) \
+    BULK_VALUE_LOOP(                                                    \
+        double tmp = unpack((unsigned char *)ptr, le(u->flags));        \
+        v = tmp == -1.0 && PyErr_Occurred() ? NULL : PyFloat_FromDouble(tmp); \
+    )
+
+/*
+ * Return the elements of the dimension 'x' as a list.  'shape' is the number
+ * of elements, 'index' the linear index of the first element and 'step' the
+ * distance between elements.
+ */
 static PyObject *
-_pyxnd_value(const xnd_t * const x, const int64_t maxshape)
+bulk_value(const xnd_t *x, const int64_t shape, const int64_t index,
+           const int64_t step)
+{
+    const ndt_t * const u = x->type->tag == FixedDim ? x->type->FixedDim.type
+                                                      : x->type->VarDim.type;
+    const bool optional = ndt_is_optional(u);
+    const uint8_t * const bitmap = x->bitmap.data;
+    PyObject *lst;
+    int64_t i, k;
+
+    assert(u->ndim == 0 && bulk_dtype(u));
+    assert(!optional || bitmap != NULL);
+
+    lst = list_new(shape);
+    if (lst == NULL) {
+        return NULL;
+    }
+
+    switch (u->tag) {
+    case Bool: BULK_VALUE(bool, PyBool_FromLong);
+    case Int8: BULK_VALUE(int8_t, PyLong_FromLong);
+    case Int16: BULK_VALUE(int16_t, PyLong_FromLong);
+    case Int32: BULK_VALUE(int32_t, PyLong_FromLong);
+    case Int64: BULK_VALUE(int64_t, PyLong_FromLongLong);
+    case Uint8: BULK_VALUE(uint8_t, PyLong_FromUnsignedLong);
+    case Uint16: BULK_VALUE(uint16_t, PyLong_FromUnsignedLong);
+    case Uint32: BULK_VALUE(uint32_t, PyLong_FromUnsignedLong);
+    case Uint64: BULK_VALUE(uint64_t, PyLong_FromUnsignedLongLong);
+    case Float32: BULK_VALUE_FLOAT(_PyFloat_Unpack4);
+    case Float64: BULK_VALUE_FLOAT(_PyFloat_Unpack8);
+    default:
+        Py_DECREF(lst);
+        PyErr_SetString(PyExc_RuntimeError, "unexpected dtype in bulk conversion");
+        return NULL;
+    }
+}
+
+#undef BULK_VALUE_FLOAT
+#undef BULK_VALUE
+#undef BULK_VALUE_LOOP
+
+static PyObject *
+_pyxnd_value(const xnd_t * const x, const int64_t maxshape,
+             const uint32_t flags)
 {
     NDT_STATIC_CONTEXT(ctx);
     const ndt_t * const t = x->type;
@@ -1344,6 +1683,10 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
         int64_t shape, i;
 
         shape = t->FixedDim.shape;
+        if (shape < maxshape &&
+            t->FixedDim.type->ndim == 0 && bulk_dtype(t->FixedDim.type)) {
+            return bulk_value(x, shape, x->index, t->Concrete.FixedDim.step);
+        }
         if (shape > maxshape) {
             shape = maxshape;
         }
@@ -1360,7 +1703,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
             }
 
             const xnd_t next = xnd_fixed_dim_next(x, i);
-            v = _pyxnd_value(&next, maxshape);
+            v = _pyxnd_value(&next, maxshape, flags);
             if (v == NULL) {
                 Py_DECREF(lst);
                 return NULL;
@@ -1380,6 +1723,10 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
         if (shape < 0) {
             return seterr(&ctx);
         }
+        if (shape < maxshape &&
+            t->VarDim.type->ndim == 0 && bulk_dtype(t->VarDim.type)) {
+            return bulk_value(x, shape, start, step);
+        }
         if (shape > maxshape) {
             shape = maxshape;
         }
@@ -1396,7 +1743,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
             }
 
             const xnd_t next = xnd_var_dim_next(x, start, step, i);
-            v = _pyxnd_value(&next, maxshape);
+            v = _pyxnd_value(&next, maxshape, flags);
             if (v == NULL) {
                 Py_DECREF(lst);
                 return NULL;
@@ -1432,7 +1779,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
                 return seterr(&ctx);
             }
 
-            v = _pyxnd_value(&next, maxshape);
+            v = _pyxnd_value(&next, maxshape, flags);
             if (v == NULL) {
                 Py_DECREF(tuple);
                 return NULL;
@@ -1473,7 +1820,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
                 return seterr(&ctx);
             }
 
-            v = _pyxnd_value(&next, maxshape);
+            v = _pyxnd_value(&next, maxshape, flags);
             if (v == NULL) {
                 Py_DECREF(dict);
                 return NULL;
@@ -1496,7 +1843,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
             return seterr(&ctx);
         }
 
-        return _pyxnd_value(&next, maxshape);
+        return _pyxnd_value(&next, maxshape, flags);
     }
 
     case Constr: {
@@ -1505,7 +1852,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
             return seterr(&ctx);
         }
 
-        return _pyxnd_value(&next, maxshape);
+        return _pyxnd_value(&next, maxshape, flags);
     }
 
     case Nominal: {
@@ -1518,7 +1865,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
             return t->Nominal.meth->repr(&next, &ctx);
         }
 
-        return _pyxnd_value(&next, maxshape);
+        return _pyxnd_value(&next, maxshape, flags);
     }
 
     case Bool: {
@@ -1687,7 +2034,7 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
 
     case String: {
         const char *s = XND_POINTER_DATA(x->ptr);
-        Py_ssize_t size = s ? strlen(s) : 0;
+        Py_ssize_t size = (Py_ssize_t)xnd_string_size(s, flags);
 
         return PyUnicode_FromStringAndSize(s, size);
     }
@@ -1700,28 +2047,29 @@ _pyxnd_value(const xnd_t * const x, const int64_t maxshape)
     }
 
     case Categorical: {
-        int64_t k;
-
-        UNPACK_SINGLE(k, x->ptr, int64_t, t->flags);
+        const ndt_value_t *value = xnd_categorical_decode(x, &ctx);
+        if (value == NULL) {
+            return seterr(&ctx);
+        }
 
-        switch (t->Categorical.types[k].tag) {
+        switch (value->tag) {
         case ValBool: {
-            bool tmp = t->Categorical.types[k].ValBool;
+            bool tmp = value->ValBool;
             return PyBool_FromLong(tmp);
         }
 
         case ValInt64: {
-            int64_t tmp = t->Categorical.types[k].ValInt64;
+            int64_t tmp = value->ValInt64;
             return PyLong_FromLongLong(tmp);
         }
 
         case ValFloat64: {
-            double tmp = t->Categorical.types[k].ValFloat64;
+            double tmp = value->ValFloat64;
             return PyFloat_FromDouble(tmp);
         }
 
         case ValString: {
-            const char *tmp = t->Categorical.types[k].ValString;
+            const char *tmp = value->ValString;
             return PyUnicode_FromString(tmp);
         }
 
@@ -2010,6 +2358,7 @@ pyxnd_assign(XndObject *self, PyObject *key, PyObject *value)
 {
     NDT_STATIC_CONTEXT(ctx);
     xnd_index_t indices[NDT_MAX_DIM];
+    xnd_heap_t *heap;
     xnd_t x;
     int free_type = 0;
     int ret, len;
@@ -2025,6 +2374,12 @@ pyxnd_assign(XndObject *self, PyObject *key, PyObject *value)
         return -1;
     }
 
+    if (self->mblock->readers > 0 || self->mblock->writers > 0) {
+        PyErr_SetString(PyExc_BufferError,
+            "memory block is in use by a running computation");
+        return -1;
+    }
+
     flags = convert_key(indices, &len, key);
     if (flags & KEY_ERROR) {
         return -1;
@@ -2048,14 +2403,27 @@ pyxnd_assign(XndObject *self, PyObject *key, PyObject *value)
         return seterr_int(&ctx);
     }
 
-    if (Xnd_Check(value)) {
+    heap = xnd_heap(self->mblock->xnd);
+
+    if (Xnd_Check(value) && heap == NULL) {
         ret = xnd_copy(&x, XND(value), self->mblock->xnd->flags, &ctx);
         if (ret < 0) {
             (void)seterr_int(&ctx);
         }
     }
+    else if (Xnd_Check(value)) {
+        /* Payloads of a string heap are allocated by mblock_init(). */
+        PyObject *v = _pyxnd_value(XND(value), INT64_MAX, XND_FLAGS(value));
+        if (v == NULL) {
+            ret = -1;
+        }
+        else {
+            ret = mblock_init(&x, v, heap);
+            Py_DECREF(v);
+        }
+    }
     else {
-        ret = mblock_init(&x, value);
+        ret = mblock_init(&x, value, heap);
     }
 
     if (free_type) {
@@ -2092,7 +2460,7 @@ pyxnd_short_value(PyObject *self, PyObject *args, PyObject *kwds)
     }
 
     if (maxshape == Py_None) {
-        return _pyxnd_value(XND(self), INT64_MAX);
+        return _pyxnd_value(XND(self), INT64_MAX, XND_FLAGS(self));
     }
     else {
         Py_ssize_t max = PyLong_AsSsize_t(maxshape);
@@ -2104,7 +2472,7 @@ pyxnd_short_value(PyObject *self, PyObject *args, PyObject *kwds)
             return NULL;
         }
 
-        return _pyxnd_value(XND(self), max);
+        return _pyxnd_value(XND(self), max, XND_FLAGS(self));
     }
 }
 
@@ -2131,6 +2499,34 @@ pyxnd_strict_equal(PyObject *self, PyObject *other)
     return res;
 }
 
+static PyObject *
+pyxnd_save(PyObject *self, PyObject *path)
+{
+    NDT_STATIC_CONTEXT(ctx);
+    const xnd_t *master = &((XndObject *)self)->mblock->xnd->master;
+    PyObject *bytes;
+    int ret;
+
+    if (XND(self)->ptr != master->ptr || XND(self)->index != master->index ||
+        XND(self)->type != master->type) {
+        PyErr_SetString(PyExc_ValueError,
+            "only complete containers can be saved, copy views first");
+        return NULL;
+    }
+
+    if (!PyUnicode_FSConverter(path, &bytes)) {
+        return NULL;
+    }
+
+    ret = xnd_mmap_save(PyBytes_AS_STRING(bytes), XND(self), &ctx);
+    Py_DECREF(bytes);
+    if (ret < 0) {
+        return seterr(&ctx);
+    }
+
+    Py_RETURN_NONE;
+}
+
 static PyObject *
 pyxnd_type(PyObject *self, PyObject *args UNUSED)
 {
@@ -2148,7 +2544,7 @@ pyxnd_ndim(PyObject *self, PyObject *args UNUSED)
 static PyObject *
 pyxnd_value(PyObject *self, PyObject *args UNUSED)
 {
-    return _pyxnd_value(XND(self), INT64_MAX);
+    return _pyxnd_value(XND(self), INT64_MAX, XND_FLAGS(self));
 }
 
 static PyObject *
@@ -2187,11 +2583,13 @@ static PyMethodDef pyxnd_methods [] =
   /* Methods */
   { "short_value", (PyCFunction)pyxnd_short_value, METH_VARARGS|METH_KEYWORDS, doc_short_value },
   { "strict_equal", (PyCFunction)pyxnd_strict_equal, METH_O, NULL },
+  { "save", (PyCFunction)pyxnd_save, METH_O, doc_save },
 
   /* Class methods */
   { "empty", (PyCFunction)pyxnd_empty, METH_O|METH_CLASS, doc_empty },
   { "from_buffer", (PyCFunction)pyxnd_from_buffer, METH_O|METH_CLASS, doc_from_buffer },
   { "_unsafe_from_data", (PyCFunction)pyxnd_from_buffer_and_type, METH_VARARGS|METH_KEYWORDS|METH_CLASS, NULL },
+  { "_mmap", (PyCFunction)pyxnd_mmap, METH_VARARGS|METH_KEYWORDS|METH_CLASS, NULL },
 
   { NULL, NULL, 1 }
 };
@@ -2313,10 +2711,16 @@ pyxnd_getbuf(XndObject *self, Py_buffer *view, int flags)
         return -1;
     }
 
+    if (flags == PyBUF_FULL && is_readonly(self)) {
+        PyErr_SetString(PyExc_BufferError, "memory block is read-only");
+        return -1;
+    }
+
     proxy = buffer_alloc(self);
     if (proxy == NULL) {
         return -1;
     }
+    proxy->view.readonly = is_readonly(self);
 
     if (fill_buffer(&proxy->view, XND(self), &ctx) < 0) {
         Py_DECREF(proxy);
@@ -2364,7 +2768,7 @@ convert_cmp(PyObject *v, PyObject *w, int op)
 
     assert(!Xnd_Check(w));
 
-    vcmp = _pyxnd_value(XND(v), INT64_MAX);
+    vcmp = _pyxnd_value(XND(v), INT64_MAX, XND_FLAGS(v));
     if (vcmp == NULL) {
         return NULL;
     }
@@ -2462,7 +2866,7 @@ Xnd_EmptyFromType(PyTypeObject *tp, ndt_t *t)
         return NULL;
     }
 
-    mblock = mblock_empty(type);
+    mblock = mblock_empty(type, XND_OWN_EMBEDDED);
     Py_DECREF(type);
     if (mblock == NULL) {
         return NULL;
@@ -2517,6 +2921,62 @@ Xnd_FromXnd(PyTypeObject *tp, xnd_t *x)
     return pyxnd_from_mblock(tp, mblock);
 }
 
+static int
+Xnd_IsReadonly(const PyObject *v)
+{
+    return is_readonly((XndObject *)v);
+}
+
+/*
+ * Pin the memory block of 'v' while a computation reads it ('write' == 0) or
+ * writes it ('write' != 0) without holding the GIL.  A memory block can have
+ * several readers or a single writer.  Pinned memory blocks cannot be
+ * assigned to.  All functions must be called with the GIL held.
+ *
+ * Xnd_CheckPin() reports whether 'v' can be pinned.  A computation checks
+ * all of its arguments before it pins any of them, so an argument may be
+ * both read and written by the same computation.
+ */
+static int
+Xnd_CheckPin(const PyObject *v, int write)
+{
+    const MemoryBlockObject *mblock = ((XndObject *)v)->mblock;
+
+    if (mblock->writers > 0 || (write && mblock->readers > 0)) {
+        PyErr_SetString(PyExc_BufferError,
+            "memory block is in use by a running computation");
+        return -1;
+    }
+
+    return 0;
+}
+
+static void
+Xnd_Pin(const PyObject *v, int write)
+{
+    MemoryBlockObject *mblock = ((XndObject *)v)->mblock;
+
+    if (write) {
+        mblock->writers++;
+    }
+    else {
+        mblock->readers++;
+    }
+}
+
+static void
+Xnd_Unpin(const PyObject *v, int write)
+{
+    MemoryBlockObject *mblock = ((XndObject *)v)->mblock;
+
+    if (write) {
+        mblock->writers--;
+    }
+    else {
+        mblock->readers--;
+    }
+}
+
 
 static PyObject *
 init_api(void)
@@ -2527,6 +2987,10 @@ init_api(void)
     xnd_api[Xnd_EmptyFromType_INDEX] = (void *)Xnd_EmptyFromType;
     xnd_api[Xnd_ViewMoveNdt_INDEX] = (void *)Xnd_ViewMoveNdt;
     xnd_api[Xnd_FromXnd_INDEX] = (void *)Xnd_FromXnd;
+    xnd_api[Xnd_IsReadonly_INDEX] = (void *)Xnd_IsReadonly;
+    xnd_api[Xnd_CheckPin_INDEX] = (void *)Xnd_CheckPin;
+    xnd_api[Xnd_Pin_INDEX] = (void *)Xnd_Pin;
+    xnd_api[Xnd_Unpin_INDEX] = (void *)Xnd_Unpin;
 
     return PyCapsule_New(xnd_api, "xnd._xnd._API", NULL);
 }
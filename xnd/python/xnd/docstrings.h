@@ -100,6 +100,18 @@ is None, the representation is not abbreviated.\n\
     [1, 2, ...]\n\
 \n");
 
+PyDoc_STRVAR(doc_save,
+"save($self, path, /)\n--\n\n\
+Write the container to a file that can be mapped with xnd.mmap().  The file\n\
+contains the type, the data, the validity bitmaps and the string and bytes\n\
+values.  Views must be copied to a new container before they can be saved.\n\
+\n\
+    >>> x = xnd([\"a\", \"b\", None])\n\
+    >>> x.save(\"x.xnd\")\n\
+    >>> xnd.mmap(\"x.xnd\")\n\
+    xnd(['a', 'b', None], type='3 * ?string')\n\
+\n");
+
 PyDoc_STRVAR(doc_empty,
 "empty($type, type, /)\n--\n\n\
 Class method that constructs a new xnd container according to the type\n\
@@ -66,6 +66,8 @@ typedef struct {
     PyObject *type;    /* type owner */
     xnd_master_t *xnd; /* memblock owner */
     Py_buffer *view;   /* PEP-3118 imports */
+    Py_ssize_t readers; /* computations without the GIL that read the memory */
+    Py_ssize_t writers; /* computations without the GIL that write the memory */
 } MemoryBlockObject;
 
 
@@ -88,6 +90,7 @@ typedef struct {
 #define XND_INDEX(v) (((XndObject *)v)->xnd.index)
 #define XND_TYPE(v) (((XndObject *)v)->xnd.type)
 #define XND_PTR(v) (((XndObject *)v)->xnd.ptr)
+#define XND_FLAGS(v) (((XndObject *)v)->mblock->xnd->flags)
 
 
 /****************************************************************************/
@@ -118,7 +121,23 @@ typedef struct {
 #define Xnd_FromXnd_RETURN PyObject *
 #define Xnd_FromXnd_ARGS (PyTypeObject *, xnd_t *x)
 
-#define XND_MAX_API 6
+#define Xnd_IsReadonly_INDEX 6
+#define Xnd_IsReadonly_RETURN int
+#define Xnd_IsReadonly_ARGS (const PyObject *)
+
+#define Xnd_CheckPin_INDEX 7
+#define Xnd_CheckPin_RETURN int
+#define Xnd_CheckPin_ARGS (const PyObject *, int write)
+
+#define Xnd_Pin_INDEX 8
+#define Xnd_Pin_RETURN void
+#define Xnd_Pin_ARGS (const PyObject *, int write)
+
+#define Xnd_Unpin_INDEX 9
+#define Xnd_Unpin_RETURN void
+#define Xnd_Unpin_ARGS (const PyObject *, int write)
+
+#define XND_MAX_API 10
 
 
 #ifdef XND_MODULE
@@ -128,6 +147,10 @@ static CONST_XND_RETURN CONST_XND CONST_XND_ARGS;
 static Xnd_EmptyFromType_RETURN Xnd_EmptyFromType Xnd_EmptyFromType_ARGS;
 static Xnd_ViewMoveNdt_RETURN Xnd_ViewMoveNdt Xnd_ViewMoveNdt_ARGS;
 static Xnd_FromXnd_RETURN Xnd_FromXnd Xnd_FromXnd_ARGS;
+static Xnd_IsReadonly_RETURN Xnd_IsReadonly Xnd_IsReadonly_ARGS;
+static Xnd_CheckPin_RETURN Xnd_CheckPin Xnd_CheckPin_ARGS;
+static Xnd_Pin_RETURN Xnd_Pin Xnd_Pin_ARGS;
+static Xnd_Unpin_RETURN Xnd_Unpin Xnd_Unpin_ARGS;
 #else
 static void **_xnd_api;
 
@@ -149,6 +172,18 @@ static void **_xnd_api;
 #define Xnd_FromXnd \
     (*(Xnd_FromXnd_RETURN (*)Xnd_FromXnd_ARGS) _xnd_api[Xnd_FromXnd_INDEX])
 
+#define Xnd_IsReadonly \
+    (*(Xnd_IsReadonly_RETURN (*)Xnd_IsReadonly_ARGS) _xnd_api[Xnd_IsReadonly_INDEX])
+
+#define Xnd_CheckPin \
+    (*(Xnd_CheckPin_RETURN (*)Xnd_CheckPin_ARGS) _xnd_api[Xnd_CheckPin_INDEX])
+
+#define Xnd_Pin \
+    (*(Xnd_Pin_RETURN (*)Xnd_Pin_ARGS) _xnd_api[Xnd_Pin_INDEX])
+
+#define Xnd_Unpin \
+    (*(Xnd_Unpin_RETURN (*)Xnd_Unpin_ARGS) _xnd_api[Xnd_Unpin_INDEX])
+
 static int
 import_xnd(void)
 {